@@ -2756,6 +2756,11 @@ class ThreadOutputGenerator(OutputGenerator):
             'vkDestroyInstance',
             'vkAllocateCommandBuffers',
             'vkFreeCommandBuffers',
+            'vkDestroyCommandPool',
+            'vkResetCommandPool',
+            'vkBeginCommandBuffer',
+            'vkEndCommandBuffer',
+            'vkResetCommandBuffer',
             'vkCreateDebugReportCallbackEXT',
             'vkDestroyDebugReportCallbackEXT',
         ]
@@ -2790,6 +2795,7 @@ class ThreadOutputGenerator(OutputGenerator):
         self.appendSection('command', '')
         self.appendSection('command', decls[0][:-1])
         self.appendSection('command', '{')
+        self.appendSection('command', '    LAYER_PROFILE_ENTRY_POINT(profiler, "' + name + '");')
         # setup common to call wrappers
         # first parameter is always dispatchable
         dispatchable_type = cmdinfo.elem.find('param/type').text
@@ -2800,6 +2806,12 @@ class ThreadOutputGenerator(OutputGenerator):
             self.appendSection('command', '    VkLayerInstanceDispatchTable *pTable = my_data->instance_dispatch_table;')
         else:
             self.appendSection('command', '    VkLayerDispatchTable *pTable = my_data->device_dispatch_table;')
+        params = cmdinfo.elem.findall('param/name')
+        paramstext = ','.join([str(param.text) for param in params])
+        API = cmdinfo.elem.attrib.get('name').replace('vk','pTable->',1)
+        # Calls that are not sampled go straight down the chain
+        self.appendSection('command', '    if (!sampleCall())')
+        self.appendSection('command', '        return LAYER_PROFILE_DISPATCH(profiler, ' + API + '(' + paramstext + '));')
         # Declare result variable, if any.
         resulttype = cmdinfo.elem.find('proto/type')
         if (resulttype != None and resulttype.text == 'void'):
@@ -2811,10 +2823,7 @@ class ThreadOutputGenerator(OutputGenerator):
             assignresult = ''
 
         self.appendSection('command', str(startthreadsafety))
-        params = cmdinfo.elem.findall('param/name')
-        paramstext = ','.join([str(param.text) for param in params])
-        API = cmdinfo.elem.attrib.get('name').replace('vk','pTable->',1)
-        self.appendSection('command', '    ' + assignresult + API + '(' + paramstext + ');')
+        self.appendSection('command', '    ' + assignresult + 'LAYER_PROFILE_DISPATCH(profiler, ' + API + '(' + paramstext + '));')
         self.appendSection('command', str(finishthreadsafety))
         # Return result variable, if any.
         if (resulttype != None):
@@ -33,6 +33,8 @@
 #include <SPIRV/spirv.hpp>
 #include <algorithm>
 #include <assert.h>
+#include <condition_variable>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <map>
@@ -42,6 +44,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <string>
+#include <thread>
 #include <tuple>
 
 #include "vk_loader_platform.h"
@@ -59,8 +62,16 @@
 #include "vk_layer_data.h"
 #include "vk_layer_extension_utils.h"
 #include "vk_layer_utils.h"
+#include "vk_layer_profile.h"
 #include "spirv-tools/libspirv.h"
 
+#if !defined(_WIN32)
+#include <errno.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #if defined __ANDROID__
 #include <android/log.h>
 #define LOGCONSOLE(...) ((void)__android_log_print(ANDROID_LOG_INFO, "DS", __VA_ARGS__))
@@ -97,7 +108,10 @@ static const VkDeviceMemory MEMTRACKER_SWAP_CHAIN_IMAGE_KEY = (VkDeviceMemory)(-
 struct CMD_POOL_INFO {
     VkCommandPoolCreateFlags createFlags;
     uint32_t queueFamilyIndex;
-    list<VkCommandBuffer> commandBuffers; // list container of cmd buffers allocated from this pool
+    unordered_set<VkCommandBuffer> commandBuffers; // cmd buffers allocated from this pool
+    // Nodes of freed cmd buffers, already reset. Later allocations from the pool reuse them so the containers inside
+    // keep the storage they grew while recording.
+    vector<GLOBAL_CB_NODE *> freeNodes;
 };
 
 struct devExts {
@@ -108,6 +122,12 @@ struct devExts {
 
 // fwd decls
 struct shader_module;
+class validation_worker_pool;
+
+// Number of locks the command buffer back-references of device objects are sharded across
+static const size_t BINDING_LOCK_SHARD_COUNT = 16;
+// vkUpdateDescriptorSets() calls with at least this many writes have them validated on the worker pool
+static const uint32_t PARALLEL_DESCRIPTOR_WRITE_COUNT = 256;
 
 // TODO : Split this into separate structs for instance and device level data?
 struct layer_data {
@@ -138,15 +158,28 @@ struct layer_data {
     unordered_map<VkFence, FENCE_NODE> fenceMap;
     unordered_map<VkQueue, QUEUE_NODE> queueMap;
     unordered_map<VkEvent, EVENT_NODE> eventMap;
-    unordered_map<QueryObject, bool> queryToStateMap;
     unordered_map<VkQueryPool, QUERY_POOL_NODE> queryPoolMap;
     unordered_map<VkSemaphore, SEMAPHORE_NODE> semaphoreMap;
     unordered_map<VkCommandBuffer, GLOBAL_CB_NODE *> commandBufferMap;
     unordered_map<VkFramebuffer, FRAMEBUFFER_NODE> frameBufferMap;
-    unordered_map<VkImage, vector<ImageSubresourcePair>> imageSubresourceMap;
-    unordered_map<ImageSubresourcePair, IMAGE_LAYOUT_NODE> imageLayoutMap;
+    unordered_map<VkImage, ImageLayoutMap<VkImageLayout>> imageLayoutMap;
     unordered_map<VkRenderPass, RENDER_PASS_NODE *> renderPassMap;
     unordered_map<VkShaderModule, unique_ptr<shader_module>> shaderModuleMap;
+    // Guard CB back-references (memory object and descriptor set bindings) updated while global_lock is held shared
+    std::mutex bindingLocks[BINDING_LOCK_SHARD_COUNT];
+    // Threads used to validate the create infos of a vkCreateGraphicsPipelines batch in parallel; created on first use
+    validation_worker_pool *pipelineWorkers;
+    // Bumped when a buffer or memory object is destroyed or a buffer is bound to memory, as draw-time descriptor
+    // validation results cached in LAST_BOUND_STATE depend on those lookups
+    uint64_t descriptorResourceVersion;
+    // Shadow mapped non-coherent memory with page protection rather than a fill pattern, from the
+    // lunarg_core_validation.noncoherent_memory_shadow setting
+    bool guardPageShadows;
+    // Skip the checks of vkCmd* entry points whose state is not needed at submit time, from the
+    // lunarg_core_validation.validation_mode setting
+    bool submitOnlyValidation;
+    // Check categories left enabled by the lunarg_core_validation.disabled_checks setting
+    CheckFlags enabledChecks;
     VkDevice device;
 
     // Device specific data
@@ -155,11 +188,55 @@ struct layer_data {
 
     layer_data()
         : report_data(nullptr), device_dispatch_table(nullptr), instance_dispatch_table(nullptr), device_extensions(),
-          device(VK_NULL_HANDLE), phys_dev_properties{}, phys_dev_mem_props{} {};
+          pipelineWorkers(nullptr), descriptorResourceVersion(0), guardPageShadows(false), submitOnlyValidation(false),
+          enabledChecks(CHECK_ALL), device(VK_NULL_HANDLE),
+          phys_dev_properties{}, phys_dev_mem_props{} {};
 };
 
-// TODO : Do we need to guard access to layer_data_map w/ lock?
-static unordered_map<void *, layer_data *> layer_data_map;
+static dispatch_key_map<layer_data> layer_data_map;
+static layer_profiler profiler;
+
+static const std::unordered_map<std::string, VkFlags> check_option_definitions = {
+    {std::string("draw_state"), CHECK_DRAW_STATE},
+    {std::string("descriptor_sets"), CHECK_DESCRIPTOR_SETS},
+    {std::string("barriers"), CHECK_BARRIERS},
+    {std::string("render_pass_dependencies"), CHECK_RENDER_PASS_DEPS},
+    {std::string("memory_aliasing"), CHECK_MEMORY_ALIASING},
+    {std::string("memory_contents"), CHECK_MEMORY_CONTENTS},
+    {std::string("none"), 0}};
+
+// Read the check categories left enabled by lunarg_core_validation.disabled_checks. A category that is not recognized is
+// reported rather than skipped silently, so that a misspelled category is not left enabled unnoticed.
+static CheckFlags getEnabledChecks(debug_report_data *report_data, VkDevice device) {
+    CheckFlags disabled = 0;
+    std::string option_list = getLayerOption("lunarg_core_validation.disabled_checks");
+    size_t begin = 0;
+    while (begin < option_list.size()) {
+        size_t end = option_list.find(',', begin);
+        if (end == std::string::npos)
+            end = option_list.size();
+        size_t first = option_list.find_first_not_of(" \t", begin);
+        size_t last = option_list.find_last_not_of(" \t", end - 1);
+        if (first < end && last != std::string::npos && last >= first) {
+            std::string option = option_list.substr(first, last - first + 1);
+            auto check = check_option_definitions.find(option);
+            if (check != check_option_definitions.end()) {
+                disabled |= check->second;
+            } else {
+                log_msg(report_data, VK_DEBUG_REPORT_WARNING_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, (uint64_t)device,
+                        __LINE__, DRAWSTATE_INVALID_LAYER_SETTING, "DS",
+                        "lunarg_core_validation.disabled_checks: ignoring unknown check category '%s'. Known categories are "
+                        "draw_state, descriptor_sets, barriers, render_pass_dependencies, memory_aliasing, memory_contents "
+                        "and none.",
+                        option.c_str());
+            }
+        }
+        begin = end + 1;
+    }
+    return CHECK_ALL & ~disabled;
+}
+
+static inline bool checkEnabled(const layer_data *dev_data, CheckFlagBits check) { return (dev_data->enabledChecks & check) != 0; }
 
 static const VkLayerProperties global_layer = {
     "VK_LAYER_LUNARG_core_validation", VK_LAYER_API_VERSION, 1, "LunarG Validation Layer",
@@ -227,17 +304,73 @@ struct spirv_inst_iter {
     spirv_inst_iter const &operator*() const { return *this; }
 };
 
+typedef std::pair<unsigned, unsigned> location_t;
+typedef std::pair<unsigned, unsigned> descriptor_slot_t;
+
+struct interface_var {
+    uint32_t id;
+    uint32_t type_id;
+    uint32_t offset;
+    bool is_patch;
+    bool is_block_member;
+    /* TODO: collect the name, too? Isn't required to be present. */
+};
+
+/* the OpDecorate decorations the shader checker cares about, for a single id */
+struct decoration_set {
+    int location; /* -1 if not decorated */
+    int builtin;  /* -1 if not decorated */
+    unsigned component;
+    unsigned set;
+    unsigned binding;
+    bool is_block;
+    bool is_patch;
+
+    decoration_set() : location(-1), builtin(-1), component(0), set(0), binding(0), is_block(false), is_patch(false) {}
+};
+
+/* everything pipeline creation needs to know about one entrypoint. computed the first time a pipeline
+ * uses the entrypoint and shared by every later pipeline built from the same module.
+ */
+struct entrypoint_reflection {
+    /* user-defined interface variables by location; empty for compute */
+    std::map<location_t, interface_var> inputs;
+    std::map<location_t, interface_var> outputs;
+    /* ids referenced by the static call tree of the entrypoint */
+    std::unordered_set<uint32_t> accessible_ids;
+    std::map<descriptor_slot_t, interface_var> descriptor_uses;
+    /* variables whose descriptor slot was already claimed by another variable: <slot, variable id> */
+    std::vector<std::pair<descriptor_slot_t, uint32_t>> descriptor_conflicts;
+    /* offsets of the push constant block members the entrypoint can access */
+    std::vector<unsigned> push_constant_offsets;
+};
+
 struct shader_module {
     /* the spirv image itself */
     vector<uint32_t> words;
     /* a mapping of <id> to the first word of its def. this is useful because walking type
      * trees, constant expressions, etc requires jumping all over the instruction stream.
+     * ids are dense in [0, bound) so this is indexed directly by id; 0 (an offset inside the
+     * header) means the id has no def we care about. the index is sized from the bound, but no larger
+     * than the module; defs of ids beyond that (valid only if the ids are sparse) go in sparse_defs.
+     */
+    vector<unsigned> def_index;
+    unordered_map<unsigned, unsigned> sparse_defs;
+    /* the id bound from the header, and the first id defined at or above it (0 if none) */
+    uint32_t id_bound;
+    unsigned out_of_bound_id;
+    /* decorations by id, and the capabilities the module declares. gathered in the same pass as def_index. */
+    unordered_map<unsigned, decoration_set> decorations;
+    vector<uint32_t> capabilities;
+    /* per-entrypoint reflection, keyed by the offset of the OpEntryPoint instruction. filled lazily by
+     * get_entrypoint_reflection(); reflection_lock allows pipelines using the module to be validated concurrently.
      */
-    unordered_map<unsigned, unsigned> def_index;
+    mutable std::mutex reflection_lock;
+    mutable unordered_map<unsigned, unique_ptr<entrypoint_reflection>> entrypoint_reflections;
 
     shader_module(VkShaderModuleCreateInfo const *pCreateInfo)
         : words((uint32_t *)pCreateInfo->pCode, (uint32_t *)pCreateInfo->pCode + pCreateInfo->codeSize / sizeof(uint32_t)),
-          def_index() {
+          def_index(), id_bound(0), out_of_bound_id(0) {
 
         build_def_index(this);
     }
@@ -250,16 +383,234 @@ struct shader_module {
 
     /* gets an iterator to the definition of an id */
     spirv_inst_iter get_def(unsigned id) const {
-        auto it = def_index.find(id);
-        if (it == def_index.end()) {
+        if (id >= def_index.size()) {
+            auto it = sparse_defs.find(id);
+            return it == sparse_defs.end() ? end() : at(it->second);
+        }
+        if (!def_index[id]) {
             return end();
         }
-        return at(it->second);
+        return at(def_index[id]);
+    }
+
+    /* gets the decorations applied to an id; undecorated ids get the defaults */
+    decoration_set get_decorations(unsigned id) const {
+        auto it = decorations.find(id);
+        if (it == decorations.end()) {
+            return decoration_set();
+        }
+        return it->second;
+    }
+};
+
+// Reader-writer lock guarding the device-wide maps in layer_data.
+//  Entry points that create, destroy or submit objects take it exclusively (lock/unlock) and may touch any state.
+//  Command recording entry points take it shared (lock_shared/unlock_shared) and only modify the state of the command
+//  buffer they record into, so recording on separate command buffers can proceed in parallel. Readers only touch two
+//  atomics on the fast path; the mutex/condition variable pair is used only while a writer is pending.
+class rw_lock {
+  public:
+    rw_lock() : readers_(0), writer_(false) {}
+
+    void lock() {
+        writer_mutex_.lock();
+        std::unique_lock<std::mutex> wait_lock(wait_mutex_);
+        writer_.store(true);
+        wait_cv_.wait(wait_lock, [this] { return readers_.load() == 0; });
+    }
+    void unlock() {
+        {
+            std::lock_guard<std::mutex> wait_lock(wait_mutex_);
+            writer_.store(false);
+        }
+        wait_cv_.notify_all();
+        writer_mutex_.unlock();
+    }
+    void lock_shared() {
+        for (;;) {
+            readers_.fetch_add(1);
+            if (!writer_.load())
+                return;
+            // A writer owns or is acquiring the lock, back out and wait for it to be released
+            unlock_shared();
+            std::unique_lock<std::mutex> wait_lock(wait_mutex_);
+            wait_cv_.wait(wait_lock, [this] { return !writer_.load(); });
+        }
+    }
+    void unlock_shared() {
+        if ((readers_.fetch_sub(1) == 1) && writer_.load()) {
+            std::lock_guard<std::mutex> wait_lock(wait_mutex_);
+            wait_cv_.notify_all();
+        }
     }
+
+  private:
+    std::atomic<uint32_t> readers_;
+    std::atomic<bool> writer_;
+    std::mutex writer_mutex_;
+    std::mutex wait_mutex_;
+    std::condition_variable wait_cv_;
 };
 
-// TODO : This can be much smarter, using separate locks for separate global data
-static std::mutex global_lock;
+static rw_lock global_lock;
+
+// Scoped lock used by command recording entry points. Holds global_lock shared, plus the lock of the command buffer
+// being recorded. Cross-object references created while recording (e.g. memory object and descriptor set bindings back
+// to the command buffer) must additionally be guarded with getBindingLock().
+class cb_recording_lock {
+  public:
+    cb_recording_lock(layer_data const *dev_data, VkCommandBuffer cb) : cb_node_(nullptr), locked_(true) {
+        global_lock.lock_shared();
+        auto cb_it = dev_data->commandBufferMap.find(cb);
+        if (cb_it != dev_data->commandBufferMap.end()) {
+            cb_node_ = cb_it->second;
+            cb_node_->record_lock.lock();
+        }
+    }
+    ~cb_recording_lock() { unlock(); }
+
+    void unlock() {
+        if (locked_) {
+            if (cb_node_)
+                cb_node_->record_lock.unlock();
+            global_lock.unlock_shared();
+            locked_ = false;
+        }
+    }
+
+  private:
+    cb_recording_lock(const cb_recording_lock &) = delete;
+    cb_recording_lock &operator=(const cb_recording_lock &) = delete;
+
+    GLOBAL_CB_NODE *cb_node_;
+    bool locked_;
+};
+
+// Return the shard lock protecting the command buffer back-references of the given object
+static std::mutex &getBindingLock(layer_data *dev_data, const void *object) {
+    return dev_data->bindingLocks[(reinterpret_cast<uintptr_t>(object) >> 4) % BINDING_LOCK_SHARD_COUNT];
+}
+
+// Pool of worker threads used to validate the independent items of a batch (e.g. the create infos passed to
+// vkCreateGraphicsPipelines) in parallel. The thread calling parallel_for() takes part in the work, so a pool without
+// workers simply runs the batch serially. Work items must only read shared layer state; the caller holds global_lock
+// on their behalf. Use parallelValidate() so that messages logged by the items reach the callbacks on the calling thread.
+class validation_worker_pool {
+  public:
+    explicit validation_worker_pool(uint32_t worker_count)
+        : func_(nullptr), count_(0), next_(0), active_(0), generation_(0), stop_(false) {
+        for (uint32_t i = 0; i < worker_count; i++) {
+            workers_.emplace_back(&validation_worker_pool::worker_loop, this);
+        }
+    }
+    ~validation_worker_pool() {
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            stop_ = true;
+        }
+        work_cv_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    // Call func(i) for each i in [0, count) and return once every call has completed
+    void parallel_for(uint32_t count, std::function<void(uint32_t)> const &func) {
+        if (workers_.empty() || count < 2) {
+            for (uint32_t i = 0; i < count; i++) {
+                func(i);
+            }
+            return;
+        }
+        std::lock_guard<std::mutex> batch_lock(batch_lock_);
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            func_ = &func;
+            count_ = count;
+            next_.store(0);
+            active_ = static_cast<uint32_t>(workers_.size());
+            generation_++;
+        }
+        work_cv_.notify_all();
+        run_items();
+        std::unique_lock<std::mutex> lock(lock_);
+        done_cv_.wait(lock, [this] { return active_ == 0; });
+        func_ = nullptr;
+    }
+
+  private:
+    validation_worker_pool(const validation_worker_pool &) = delete;
+    validation_worker_pool &operator=(const validation_worker_pool &) = delete;
+
+    void worker_loop() {
+        uint64_t seen_generation = 0;
+        std::unique_lock<std::mutex> lock(lock_);
+        for (;;) {
+            work_cv_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+            if (stop_)
+                return;
+            seen_generation = generation_;
+            lock.unlock();
+            run_items();
+            lock.lock();
+            if (--active_ == 0)
+                done_cv_.notify_one();
+        }
+    }
+    void run_items() {
+        uint32_t i;
+        while ((i = next_.fetch_add(1)) < count_) {
+            (*func_)(i);
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    // Serializes parallel_for() callers
+    std::mutex batch_lock_;
+    // Guards the batch description below and the worker wake-up/completion handshake
+    std::mutex lock_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    std::function<void(uint32_t)> const *func_;
+    uint32_t count_;
+    std::atomic<uint32_t> next_;
+    uint32_t active_;
+    uint64_t generation_;
+    bool stop_;
+};
+
+// Return the pool used for pipeline and descriptor update validation, creating it on first use. Pool size comes from
+// the lunarg_core_validation.pipeline_validation_threads setting, defaulting to one thread per core.
+static validation_worker_pool *getPipelineWorkers(layer_data *dev_data) {
+    if (!dev_data->pipelineWorkers) {
+        uint32_t thread_count =
+            (uint32_t)strtoul(getLayerOption("lunarg_core_validation.pipeline_validation_threads"), nullptr, 10);
+        if (!thread_count) {
+            thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        // The calling thread is one of the validation threads
+        dev_data->pipelineWorkers = new validation_worker_pool(thread_count - 1);
+    }
+    return dev_data->pipelineWorkers;
+}
+
+// Run validate(i) for each i in [0, count) on the worker pool. Messages each item logs are held back and delivered on
+// this thread once the batch is done, in item order, so callbacks never run on a worker thread. Returns true if any
+// item, or any callback while its messages were delivered, asked for the call to be skipped.
+static bool parallelValidate(layer_data *dev_data, uint32_t count, std::function<bool(uint32_t)> const &validate) {
+    vector<uint8_t> itemSkip(count, 0);
+    vector<debug_report_deferred_log> itemMessages(count);
+    getPipelineWorkers(dev_data)->parallel_for(count, [&](uint32_t index) {
+        debug_report_defer_scope defer(&itemMessages[index]);
+        itemSkip[index] = validate(index);
+    });
+    bool skip_call = false;
+    for (uint32_t i = 0; i < count; i++) {
+        skip_call |= (itemSkip[i] != 0);
+        skip_call |= debug_report_deliver_deferred(dev_data->report_data, itemMessages[i]);
+    }
+    return skip_call;
+}
 
 // Return ImageViewCreateInfo ptr for specified imageView or else NULL
 VkImageViewCreateInfo *getImageViewData(const layer_data *dev_data, VkImageView image_view) {
@@ -293,6 +644,32 @@ BUFFER_NODE *getBufferNode(const layer_data *dev_data, VkBuffer buffer) {
     }
     return buff_it->second.get();
 }
+// Return query pool node for specified queryPool or else NULL
+static QUERY_POOL_NODE *getQueryPoolNode(layer_data *dev_data, VkQueryPool queryPool) {
+    auto pool_it = dev_data->queryPoolMap.find(queryPool);
+    if (pool_it == dev_data->queryPoolMap.end()) {
+        return nullptr;
+    }
+    return &pool_it->second;
+}
+// Return the number of queries in queryPool, or 0 if the pool is unknown
+static uint32_t getQueryPoolSize(layer_data *dev_data, VkQueryPool queryPool) {
+    auto pool_node = getQueryPoolNode(dev_data, queryPool);
+    return pool_node ? pool_node->createInfo.queryCount : 0;
+}
+// Verify that [firstQuery, firstQuery + queryCount) lies within queryPool. Query state is only tracked for ranges that
+// pass, which keeps the per pool bitsets no larger than the pool.
+static bool validateQueryRange(layer_data *dev_data, VkQueryPool queryPool, uint32_t firstQuery, uint32_t queryCount,
+                               const char *caller) {
+    auto pool_node = getQueryPoolNode(dev_data, queryPool);
+    if (!pool_node || uint64_t(firstQuery) + queryCount <= pool_node->createInfo.queryCount)
+        return false;
+    return log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_QUERY_POOL_EXT,
+                   reinterpret_cast<uint64_t &>(queryPool), __LINE__, DRAWSTATE_INVALID_QUERY, "DS",
+                   "%s: query range [%u, %" PRIu64 ") is outside queryPool 0x%" PRIx64 ", which holds %u queries.", caller,
+                   firstQuery, uint64_t(firstQuery) + queryCount, reinterpret_cast<uint64_t &>(queryPool),
+                   pool_node->createInfo.queryCount);
+}
 // Return swapchain node for specified swapchain or else NULL
 SWAPCHAIN_NODE *getSwapchainNode(const layer_data *dev_data, VkSwapchainKHR swapchain) {
     auto swp_it = dev_data->device_extensions.swapchainMap.find(swapchain);
@@ -444,6 +821,61 @@ static void set_memory_valid(layer_data *dev_data, VkDeviceMemory mem, bool vali
     }
 }
 
+// clear() on an unordered container rewrites its whole bucket array even when it holds no elements. CB nodes are
+// recycled within their command pool and keep the buckets they grew while recording, so only clear what was used.
+template <typename Container> static void clearIfUsed(Container &container) {
+    if (!container.empty())
+        container.clear();
+}
+
+// Queue a memory validity op on pCB for replay at submit. An op is dropped, or folded into the op last queued for the same
+// memory, when that op already determines its outcome: a read after a read or a write of valid contents cannot report
+// anything new, and consecutive writes leave only the last one visible.
+static void addDeferredMemoryOp(GLOBAL_CB_NODE *pCB, DEFERRED_MEMORY_OP::Type type, VkDeviceMemory mem, VkImage image,
+                                const char *functionName) {
+    size_t *last_index = nullptr;
+    if (mem == MEMTRACKER_SWAP_CHAIN_IMAGE_KEY) {
+        last_index = &pCB->lastSwapchainImageOp.emplace(image, SIZE_MAX).first->second;
+    } else {
+        last_index = &pCB->lastMemoryOp.emplace(mem, SIZE_MAX).first->second;
+    }
+    if (*last_index != SIZE_MAX) {
+        auto &last_op = pCB->memoryOps[*last_index];
+        if (type == DEFERRED_MEMORY_OP::VALIDATE) {
+            if (last_op.type != DEFERRED_MEMORY_OP::SET_INVALID)
+                return;
+        } else if (last_op.type != DEFERRED_MEMORY_OP::VALIDATE) {
+            last_op.type = type;
+            return;
+        }
+    }
+    *last_index = pCB->memoryOps.size();
+    pCB->memoryOps.push_back({type, mem, image, functionName});
+}
+
+static void deferValidateMemory(GLOBAL_CB_NODE *pCB, VkDeviceMemory mem, const char *functionName,
+                                VkImage image = VK_NULL_HANDLE) {
+    addDeferredMemoryOp(pCB, DEFERRED_MEMORY_OP::VALIDATE, mem, image, functionName);
+}
+
+static void deferSetMemoryValid(GLOBAL_CB_NODE *pCB, VkDeviceMemory mem, bool valid, VkImage image = VK_NULL_HANDLE) {
+    addDeferredMemoryOp(pCB, valid ? DEFERRED_MEMORY_OP::SET_VALID : DEFERRED_MEMORY_OP::SET_INVALID, mem, image, nullptr);
+}
+
+static bool runDeferredMemoryOps(layer_data *dev_data, GLOBAL_CB_NODE *pCB) {
+    bool skip_call = false;
+    for (auto const &op : pCB->memoryOps) {
+        if (op.type == DEFERRED_MEMORY_OP::VALIDATE) {
+            // Draws do not record their storage writes in submit-only mode, so contents can't be checked
+            if (!dev_data->submitOnlyValidation && checkEnabled(dev_data, CHECK_MEMORY_CONTENTS))
+                skip_call |= validate_memory_is_valid(dev_data, op.mem, op.functionName, op.image);
+        } else {
+            set_memory_valid(dev_data, op.mem, op.type == DEFERRED_MEMORY_OP::SET_VALID, op.image);
+        }
+    }
+    return skip_call;
+}
+
 // Find CB Info and add mem reference to list container
 // Find Mem Obj Info and add CB reference to list container
 static bool update_cmd_buf_and_mem_references(layer_data *dev_data, const VkCommandBuffer cb, const VkDeviceMemory mem,
@@ -456,7 +888,10 @@ static bool update_cmd_buf_and_mem_references(layer_data *dev_data, const VkComm
         // First update CB binding in MemObj mini CB list
         DEVICE_MEM_INFO *pMemInfo = getMemObjInfo(dev_data, mem);
         if (pMemInfo) {
-            pMemInfo->commandBufferBindings.insert(cb);
+            {
+                std::lock_guard<std::mutex> binding_lock(getBindingLock(dev_data, pMemInfo));
+                pMemInfo->commandBufferBindings.insert(cb);
+            }
             // Now update CBInfo's Mem reference list
             GLOBAL_CB_NODE *pCBNode = getCBNode(dev_data, cb);
             // TODO: keep track of all destroyed CBs so we know if this is a stale or simply invalid object
@@ -479,7 +914,9 @@ static void clear_cmd_buf_and_mem_references(layer_data *dev_data, GLOBAL_CB_NOD
             }
             pCBNode->memObjs.clear();
         }
-        pCBNode->validate_functions.clear();
+        pCBNode->memoryOps.clear();
+        clearIfUsed(pCBNode->lastMemoryOp);
+        clearIfUsed(pCBNode->lastSwapchainImageOp);
     }
 }
 // Overloaded call to above function when GLOBAL_CB_NODE has not already been looked-up
@@ -487,6 +924,196 @@ static void clear_cmd_buf_and_mem_references(layer_data *dev_data, const VkComma
     clear_cmd_buf_and_mem_references(dev_data, getCBNode(dev_data, cb));
 }
 
+#if !defined(_WIN32)
+// Shadow of a mapped range of non-coherent memory, handed to the application in place of the driver's pointer, built
+// from page protection instead of a fill pattern. Data pages start out read-only: the first write to a page faults, the
+// fault handler marks the page dirty and makes it writable, and a flush copies only dirty pages to the driver's mapping
+// before making them read-only again. Inaccessible guard pages on either side of the data catch overruns, which are
+// reported at the next flush. Nothing is allocated or touched up front beyond the reservation itself.
+class guarded_shadow {
+  public:
+    // Returns nullptr if the shadow cannot be set up, in which case the caller falls back to a fill pattern shadow
+    static guarded_shadow *create(void *driver_data, size_t size, size_t alignment) {
+        static std::once_flag handler_installed;
+        std::call_once(handler_installed, [] {
+            struct sigaction action = {};
+            action.sa_sigaction = handle_fault;
+            action.sa_flags = SA_SIGINFO;
+            sigemptyset(&action.sa_mask);
+            sigaction(SIGSEGV, &action, &previous_segv_action);
+#if defined(__APPLE__)
+            sigaction(SIGBUS, &action, &previous_bus_action);
+#endif
+        });
+        size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t data_pages = (size + page_size - 1) / page_size;
+        size_t mapping_size = (data_pages + 2) * page_size;
+        void *base = mmap(nullptr, mapping_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED)
+            return nullptr;
+        if (mprotect(static_cast<char *>(base) + page_size, data_pages * page_size, PROT_READ)) {
+            munmap(base, mapping_size);
+            return nullptr;
+        }
+        auto shadow = new guarded_shadow(static_cast<char *>(base), mapping_size, page_size, size, alignment, driver_data);
+        for (auto &slot : registry) {
+            guarded_shadow *expected = nullptr;
+            if (slot.compare_exchange_strong(expected, shadow))
+                return shadow;
+        }
+        delete shadow;
+        return nullptr;
+    }
+
+    ~guarded_shadow() {
+        for (auto &slot : registry) {
+            guarded_shadow *expected = this;
+            if (slot.compare_exchange_strong(expected, nullptr))
+                break;
+        }
+        // A handler running on another thread may have loaded this shadow before its slot was cleared; wait for it to
+        // finish before the pages and dirty flags go away. Handlers that start from here on can no longer find it.
+        while (active_handlers.load() != 0) {
+            std::this_thread::yield();
+        }
+        munmap(base_, mapping_size_);
+    }
+
+    void *data() const { return data_; }
+
+    // Copy the dirty pages overlapping [offset, offset + size) of the shadowed range to the driver's mapping. Returns
+    // true if the application wrote outside the range since the last flush.
+    bool flush(size_t offset, size_t size) {
+        bool overrun = overrun_.exchange(false);
+        if (overrun) {
+            mprotect(base_, page_size_, PROT_NONE);
+            mprotect(base_ + mapping_size_ - page_size_, page_size_, PROT_NONE);
+        }
+        if (offset >= size_ || !size)
+            return overrun;
+        size = std::min(size, size_ - offset);
+        char *data_begin = data_;
+        char *data_end = data_ + size_;
+        size_t first_page = page_index(data_ + offset);
+        size_t last_page = page_index(data_ + offset + size - 1);
+        for (size_t page = first_page; page <= last_page; ++page) {
+            if (!dirty_[page - 1].load())
+                continue;
+            char *page_begin = base_ + page * page_size_;
+            char *page_end = page_begin + page_size_;
+            // Protect the page again before copying it, so a write racing with the copy faults and is flushed later
+            dirty_[page - 1].store(0);
+            mprotect(page_begin, page_size_, PROT_READ);
+            // The first and last data pages hold alignment padding around the data, which must still be zero
+            for (char *padding = page_begin; padding < data_begin; ++padding) {
+                overrun |= (*padding != 0);
+            }
+            for (char *padding = std::max(page_begin, data_end); padding < page_end; ++padding) {
+                overrun |= (*padding != 0);
+            }
+            char *copy_begin = std::max(page_begin, data_begin);
+            char *copy_end = std::min(page_end, data_end);
+            memcpy(driver_data_ + (copy_begin - data_begin), copy_begin, copy_end - copy_begin);
+        }
+        return overrun;
+    }
+
+  private:
+    // Everything the fault handler touches must be usable from a signal handler, i.e. lock-free
+    static_assert(ATOMIC_POINTER_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_CHAR_LOCK_FREE == 2 &&
+                      ATOMIC_BOOL_LOCK_FREE == 2,
+                  "guarded_shadow requires lock-free atomics");
+
+    static const size_t REGISTRY_SIZE = 256;
+    static std::atomic<guarded_shadow *> registry[REGISTRY_SIZE];
+    // Number of fault handlers currently scanning the registry or inside on_fault
+    static std::atomic<uint32_t> active_handlers;
+    static struct sigaction previous_segv_action;
+    static struct sigaction previous_bus_action;
+
+    guarded_shadow(char *base, size_t mapping_size, size_t page_size, size_t size, size_t alignment, void *driver_data)
+        : base_(base), mapping_size_(mapping_size), page_size_(page_size), size_(size),
+          driver_data_(static_cast<char *>(driver_data)), data_pages_(mapping_size / page_size - 2),
+          dirty_(new std::atomic<uint8_t>[data_pages_]), overrun_(false) {
+        for (size_t page = 0; page < data_pages_; ++page) {
+            dirty_[page].store(0);
+        }
+        // Place the data as close to the back guard page as the required alignment allows
+        size_t padding = ((mapping_size_ - 2 * page_size_) - size_) & ~(std::max(alignment, size_t(1)) - 1);
+        data_ = base_ + page_size_ + padding;
+    }
+
+    size_t page_index(const char *address) const { return static_cast<size_t>(address - base_) / page_size_; }
+
+    // Called from the fault handler. Returns false if address is not part of this shadow.
+    bool on_fault(char *address) {
+        if (address < base_ || address >= base_ + mapping_size_)
+            return false;
+        size_t page = page_index(address);
+        if (page == 0 || page == data_pages_ + 1) {
+            overrun_.store(true);
+        } else {
+            dirty_[page - 1].store(1);
+        }
+        mprotect(base_ + page * page_size_, page_size_, PROT_READ | PROT_WRITE);
+        return true;
+    }
+
+    static void handle_fault(int signal_number, siginfo_t *info, void *context) {
+        char *address = static_cast<char *>(info->si_addr);
+        // on_fault calls mprotect, which must not clobber the errno seen by the interrupted code
+        int saved_errno = errno;
+        active_handlers.fetch_add(1);
+        bool handled = false;
+        for (auto &slot : registry) {
+            guarded_shadow *shadow = slot.load();
+            if (shadow && shadow->on_fault(address)) {
+                handled = true;
+                break;
+            }
+        }
+        active_handlers.fetch_sub(1);
+        errno = saved_errno;
+        if (handled)
+            return;
+        // Not a shadow access: hand the fault to whoever had the signal before us. The previous handler may never
+        // return, so this happens outside the active_handlers count.
+        struct sigaction &previous = (signal_number == SIGSEGV) ? previous_segv_action : previous_bus_action;
+        if (previous.sa_flags & SA_SIGINFO) {
+            previous.sa_sigaction(signal_number, info, context);
+        } else if (previous.sa_handler == SIG_DFL || previous.sa_handler == SIG_IGN) {
+            // Returning re-executes the faulting access, which now takes the default action
+            signal(signal_number, SIG_DFL);
+        } else {
+            previous.sa_handler(signal_number);
+        }
+    }
+
+    char *base_;
+    size_t mapping_size_;
+    size_t page_size_;
+    size_t size_;
+    char *data_;
+    char *driver_data_;
+    size_t data_pages_;
+    std::unique_ptr<std::atomic<uint8_t>[]> dirty_; // One entry per data page, set by the fault handler
+    std::atomic<bool> overrun_;
+};
+
+std::atomic<guarded_shadow *> guarded_shadow::registry[guarded_shadow::REGISTRY_SIZE];
+std::atomic<uint32_t> guarded_shadow::active_handlers(0);
+struct sigaction guarded_shadow::previous_segv_action;
+struct sigaction guarded_shadow::previous_bus_action;
+#endif
+
+// Drop the page protected shadow of mem_info's mapping, if it has one
+static void releaseGuardedShadow(DEVICE_MEM_INFO *mem_info) {
+#if !defined(_WIN32)
+    delete mem_info->pGuardedShadow;
+#endif
+    mem_info->pGuardedShadow = nullptr;
+}
+
 // For given MemObjInfo, report Obj & CB bindings
 static bool reportMemReferencesAndCleanUp(layer_data *dev_data, DEVICE_MEM_INFO *pMemObjInfo) {
     bool skipCall = false;
@@ -527,6 +1154,7 @@ static bool deleteMemObjInfo(layer_data *my_data, void *object, VkDeviceMemory m
     bool skipCall = false;
     auto item = my_data->memObjMap.find(mem);
     if (item != my_data->memObjMap.end()) {
+        releaseGuardedShadow(item->second.get());
         my_data->memObjMap.erase(item);
     } else {
         skipCall = log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_MEMORY_EXT,
@@ -890,7 +1518,26 @@ static string cmdTypeToString(CMD_TYPE cmd) {
 }
 
 // SPIRV utility functions
+static void set_def(shader_module *module, unsigned id, unsigned offset) {
+    if (id < module->def_index.size()) {
+        module->def_index[id] = offset;
+    } else if (id < module->id_bound) {
+        module->sparse_defs[id] = offset;
+    } else if (!module->out_of_bound_id) {
+        /* invalid; remember it so the module can be reported, but never size anything from it */
+        module->out_of_bound_id = id;
+    }
+}
+
 static void build_def_index(shader_module *module) {
+    /* size the index from the id bound in header word 3. a module can't define more ids than it has
+     * words, so clamp a bogus bound rather than allocate for it.
+     */
+    if (module->words.size() > 3) {
+        module->id_bound = module->words[3];
+        module->def_index.assign(std::min<size_t>(module->id_bound, module->words.size()), 0);
+    }
+
     for (auto insn : *module) {
         switch (insn.opcode()) {
         /* Types */
@@ -914,7 +1561,7 @@ static void build_def_index(shader_module *module) {
         case spv::OpTypeReserveId:
         case spv::OpTypeQueue:
         case spv::OpTypePipe:
-            module->def_index[insn.word(1)] = insn.offset();
+            set_def(module, insn.word(1), insn.offset());
             break;
 
         /* Fixed constants */
@@ -924,7 +1571,7 @@ static void build_def_index(shader_module *module) {
         case spv::OpConstantComposite:
         case spv::OpConstantSampler:
         case spv::OpConstantNull:
-            module->def_index[insn.word(2)] = insn.offset();
+            set_def(module, insn.word(2), insn.offset());
             break;
 
         /* Specialization constants */
@@ -933,17 +1580,50 @@ static void build_def_index(shader_module *module) {
         case spv::OpSpecConstant:
         case spv::OpSpecConstantComposite:
         case spv::OpSpecConstantOp:
-            module->def_index[insn.word(2)] = insn.offset();
+            set_def(module, insn.word(2), insn.offset());
             break;
 
         /* Variables */
         case spv::OpVariable:
-            module->def_index[insn.word(2)] = insn.offset();
+            set_def(module, insn.word(2), insn.offset());
             break;
 
         /* Functions */
         case spv::OpFunction:
-            module->def_index[insn.word(2)] = insn.offset();
+            set_def(module, insn.word(2), insn.offset());
+            break;
+
+        /* Decorations */
+        case spv::OpDecorate: {
+            auto &decorations = module->decorations[insn.word(1)];
+            switch (insn.word(2)) {
+            case spv::DecorationLocation:
+                decorations.location = insn.word(3);
+                break;
+            case spv::DecorationBuiltIn:
+                decorations.builtin = insn.word(3);
+                break;
+            case spv::DecorationComponent:
+                decorations.component = insn.word(3);
+                break;
+            case spv::DecorationDescriptorSet:
+                decorations.set = insn.word(3);
+                break;
+            case spv::DecorationBinding:
+                decorations.binding = insn.word(3);
+                break;
+            case spv::DecorationBlock:
+                decorations.is_block = true;
+                break;
+            case spv::DecorationPatch:
+                decorations.is_patch = true;
+                break;
+            }
+            break;
+        }
+
+        case spv::OpCapability:
+            module->capabilities.push_back(insn.word(1));
             break;
 
         default:
@@ -1174,14 +1854,6 @@ static bool types_match(shader_module const *a, shader_module const *b, unsigned
     }
 }
 
-static int value_or_default(std::unordered_map<unsigned, unsigned> const &map, unsigned id, int def) {
-    auto it = map.find(id);
-    if (it == map.end())
-        return def;
-    else
-        return it->second;
-}
-
 static unsigned get_locations_consumed_by_type(shader_module const *src, unsigned type, bool strip_array_level) {
     auto insn = src->get_def(type);
     assert(insn != src->end());
@@ -1232,18 +1904,6 @@ static unsigned get_locations_consumed_by_format(VkFormat format) {
     }
 }
 
-typedef std::pair<unsigned, unsigned> location_t;
-typedef std::pair<unsigned, unsigned> descriptor_slot_t;
-
-struct interface_var {
-    uint32_t id;
-    uint32_t type_id;
-    uint32_t offset;
-    bool is_patch;
-    bool is_block_member;
-    /* TODO: collect the name, too? Isn't required to be present. */
-};
-
 struct shader_stage_attributes {
     char const *const name;
     bool arrayed_input;
@@ -1275,12 +1935,11 @@ static spirv_inst_iter get_struct_type(shader_module const *src, spirv_inst_iter
 }
 
 static void collect_interface_block_members(shader_module const *src,
-                                            std::map<location_t, interface_var> &out,
-                                            std::unordered_map<unsigned, unsigned> const &blocks, bool is_array_of_verts,
+                                            std::map<location_t, interface_var> &out, bool is_array_of_verts,
                                             uint32_t id, uint32_t type_id, bool is_patch) {
     /* Walk down the type_id presented, trying to determine whether it's actually an interface block. */
     auto type = get_struct_type(src, src->get_def(type_id), is_array_of_verts && !is_patch);
-    if (type == src->end() || blocks.find(type.word(1)) == blocks.end()) {
+    if (type == src->end() || !src->get_decorations(type.word(1)).is_block) {
         /* this isn't an interface block. */
         return;
     }
@@ -1329,39 +1988,9 @@ static void collect_interface_block_members(shader_module const *src,
 static void collect_interface_by_location(shader_module const *src, spirv_inst_iter entrypoint,
                                           spv::StorageClass sinterface, std::map<location_t, interface_var> &out,
                                           bool is_array_of_verts) {
-    std::unordered_map<unsigned, unsigned> var_locations;
-    std::unordered_map<unsigned, unsigned> var_builtins;
-    std::unordered_map<unsigned, unsigned> var_components;
-    std::unordered_map<unsigned, unsigned> blocks;
-    std::unordered_map<unsigned, unsigned> var_patch;
-
-    for (auto insn : *src) {
-
-        /* We consider two interface models: SSO rendezvous-by-location, and
-         * builtins. Complain about anything that fits neither model.
-         */
-        if (insn.opcode() == spv::OpDecorate) {
-            if (insn.word(2) == spv::DecorationLocation) {
-                var_locations[insn.word(1)] = insn.word(3);
-            }
-
-            if (insn.word(2) == spv::DecorationBuiltIn) {
-                var_builtins[insn.word(1)] = insn.word(3);
-            }
-
-            if (insn.word(2) == spv::DecorationComponent) {
-                var_components[insn.word(1)] = insn.word(3);
-            }
-
-            if (insn.word(2) == spv::DecorationBlock) {
-                blocks[insn.word(1)] = 1;
-            }
-
-            if (insn.word(2) == spv::DecorationPatch) {
-                var_patch[insn.word(1)] = 1;
-            }
-        }
-    }
+    /* We consider two interface models: SSO rendezvous-by-location, and
+     * builtins. Complain about anything that fits neither model.
+     */
 
     /* TODO: handle grouped decorations */
     /* TODO: handle index=1 dual source outputs from FS -- two vars will
@@ -1385,10 +2014,11 @@ static void collect_interface_by_location(shader_module const *src, spirv_inst_i
             unsigned id = insn.word(2);
             unsigned type = insn.word(1);
 
-            int location = value_or_default(var_locations, id, -1);
-            int builtin = value_or_default(var_builtins, id, -1);
-            unsigned component = value_or_default(var_components, id, 0); /* unspecified is OK, is 0 */
-            bool is_patch = var_patch.find(id) != var_patch.end();
+            auto decorations = src->get_decorations(id);
+            int location = decorations.location;
+            int builtin = decorations.builtin;
+            unsigned component = decorations.component; /* unspecified is OK, is 0 */
+            bool is_patch = decorations.is_patch;
 
             /* All variables and interface block members in the Input or Output storage classes
              * must be decorated with either a builtin or an explicit location.
@@ -1413,51 +2043,32 @@ static void collect_interface_by_location(shader_module const *src, spirv_inst_i
                 }
             } else if (builtin == -1) {
                 /* An interface block instance */
-                collect_interface_block_members(src, out, blocks, is_array_of_verts, id, type, is_patch);
+                collect_interface_block_members(src, out, is_array_of_verts, id, type, is_patch);
             }
         }
     }
 }
 
-static void collect_interface_by_descriptor_slot(debug_report_data *report_data, shader_module const *src,
-                                                 std::unordered_set<uint32_t> const &accessible_ids,
-                                                 std::map<descriptor_slot_t, interface_var> &out) {
-
-    std::unordered_map<unsigned, unsigned> var_sets;
-    std::unordered_map<unsigned, unsigned> var_bindings;
-
-    for (auto insn : *src) {
-        /* All variables in the Uniform or UniformConstant storage classes are required to be decorated with both
-         * DecorationDescriptorSet and DecorationBinding.
-         */
-        if (insn.opcode() == spv::OpDecorate) {
-            if (insn.word(2) == spv::DecorationDescriptorSet) {
-                var_sets[insn.word(1)] = insn.word(3);
-            }
-
-            if (insn.word(2) == spv::DecorationBinding) {
-                var_bindings[insn.word(1)] = insn.word(3);
-            }
-        }
-    }
-
+static void collect_interface_by_descriptor_slot(shader_module const *src, std::unordered_set<uint32_t> const &accessible_ids,
+                                                 std::map<descriptor_slot_t, interface_var> &out,
+                                                 std::vector<std::pair<descriptor_slot_t, uint32_t>> &conflicts) {
     for (auto id : accessible_ids) {
         auto insn = src->get_def(id);
         assert(insn != src->end());
 
+        /* All variables in the Uniform or UniformConstant storage classes are required to be decorated with both
+         * DecorationDescriptorSet and DecorationBinding.
+         */
         if (insn.opcode() == spv::OpVariable &&
             (insn.word(3) == spv::StorageClassUniform || insn.word(3) == spv::StorageClassUniformConstant)) {
-            unsigned set = value_or_default(var_sets, insn.word(2), 0);
-            unsigned binding = value_or_default(var_bindings, insn.word(2), 0);
+            auto decorations = src->get_decorations(insn.word(2));
+            unsigned set = decorations.set;
+            unsigned binding = decorations.binding;
 
             auto existing_it = out.find(std::make_pair(set, binding));
             if (existing_it != out.end()) {
-                /* conflict within spv image */
-                log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VkDebugReportObjectTypeEXT(0), 0,
-                        __LINE__, SHADER_CHECKER_INCONSISTENT_SPIRV, "SC",
-                        "var %d (type %d) in %s interface in descriptor slot (%u,%u) conflicts with existing definition",
-                        insn.word(2), insn.word(1), storage_class_name(insn.word(3)), existing_it->first.first,
-                        existing_it->first.second);
+                /* conflict within spv image; reported by each pipeline using the entrypoint */
+                conflicts.push_back(std::make_pair(existing_it->first, insn.word(2)));
             }
 
             interface_var v;
@@ -1472,17 +2083,15 @@ static void collect_interface_by_descriptor_slot(debug_report_data *report_data,
 }
 
 static bool validate_interface_between_stages(debug_report_data *report_data, shader_module const *producer,
-                                              spirv_inst_iter producer_entrypoint, shader_stage_attributes const *producer_stage,
-                                              shader_module const *consumer, spirv_inst_iter consumer_entrypoint,
+                                              entrypoint_reflection const *producer_reflection,
+                                              shader_stage_attributes const *producer_stage, shader_module const *consumer,
+                                              entrypoint_reflection const *consumer_reflection,
                                               shader_stage_attributes const *consumer_stage) {
-    std::map<location_t, interface_var> outputs;
-    std::map<location_t, interface_var> inputs;
+    auto const &outputs = producer_reflection->outputs;
+    auto const &inputs = consumer_reflection->inputs;
 
     bool pass = true;
 
-    collect_interface_by_location(producer, producer_entrypoint, spv::StorageClassOutput, outputs, producer_stage->arrayed_output);
-    collect_interface_by_location(consumer, consumer_entrypoint, spv::StorageClassInput, inputs, consumer_stage->arrayed_input);
-
     auto a_it = outputs.begin();
     auto b_it = inputs.begin();
 
@@ -1658,12 +2267,10 @@ static bool validate_vi_consistency(debug_report_data *report_data, VkPipelineVe
 }
 
 static bool validate_vi_against_vs_inputs(debug_report_data *report_data, VkPipelineVertexInputStateCreateInfo const *vi,
-                                          shader_module const *vs, spirv_inst_iter entrypoint) {
-    std::map<location_t, interface_var> inputs;
+                                          shader_module const *vs, entrypoint_reflection const *reflection) {
+    auto const &inputs = reflection->inputs;
     bool pass = true;
 
-    collect_interface_by_location(vs, entrypoint, spv::StorageClassInput, inputs, false);
-
     /* Build index by location */
     std::map<uint32_t, VkVertexInputAttributeDescription const *> attribs;
     if (vi) {
@@ -1722,8 +2329,9 @@ static bool validate_vi_against_vs_inputs(debug_report_data *report_data, VkPipe
 }
 
 static bool validate_fs_outputs_against_render_pass(debug_report_data *report_data, shader_module const *fs,
-                                                    spirv_inst_iter entrypoint, RENDER_PASS_NODE const *rp, uint32_t subpass) {
-    std::map<location_t, interface_var> outputs;
+                                                    entrypoint_reflection const *reflection, RENDER_PASS_NODE const *rp,
+                                                    uint32_t subpass) {
+    auto const &outputs = reflection->outputs;
     std::map<uint32_t, VkFormat> color_attachments;
     for (auto i = 0u; i < rp->subpassColorFormats[subpass].size(); i++) {
         if (rp->subpassColorFormats[subpass][i] != VK_FORMAT_UNDEFINED) {
@@ -1735,8 +2343,6 @@ static bool validate_fs_outputs_against_render_pass(debug_report_data *report_da
 
     /* TODO: dual source blend index (spv::DecIndex, zero if not provided) */
 
-    collect_interface_by_location(fs, entrypoint, spv::StorageClassOutput, outputs, false);
-
     auto it_a = outputs.begin();
     auto it_b = color_attachments.begin();
 
@@ -1900,54 +2506,63 @@ static void mark_accessible_ids(shader_module const *src, spirv_inst_iter entryp
     }
 }
 
-static bool validate_push_constant_block_against_pipeline(debug_report_data *report_data,
-                                                          std::vector<VkPushConstantRange> const *pushConstantRanges,
-                                                          shader_module const *src, spirv_inst_iter type,
-                                                          VkShaderStageFlagBits stage) {
-    bool pass = true;
+/* gather the member offsets of every push constant block accessible from an entrypoint */
+static void collect_push_constant_offsets(shader_module const *src, std::unordered_set<uint32_t> const &accessible_ids,
+                                          std::vector<unsigned> &out) {
+    for (auto id : accessible_ids) {
+        auto def_insn = src->get_def(id);
+        if (def_insn.opcode() == spv::OpVariable && def_insn.word(3) == spv::StorageClassPushConstant) {
+            /* strip off ptrs etc */
+            auto type = get_struct_type(src, src->get_def(def_insn.word(1)), false);
+            assert(type != src->end());
+
+            for (auto insn : *src) {
+                if (insn.opcode() == spv::OpMemberDecorate && insn.word(1) == type.word(1) &&
+                    insn.word(3) == spv::DecorationOffset) {
+                    out.push_back(insn.word(4));
+                }
+            }
+        }
+    }
+}
 
-    /* strip off ptrs etc */
-    type = get_struct_type(src, type, false);
-    assert(type != src->end());
+static bool validate_push_constant_usage(debug_report_data *report_data,
+                                         std::vector<VkPushConstantRange> const *pushConstantRanges,
+                                         entrypoint_reflection const *reflection, VkShaderStageFlagBits stage) {
+    bool pass = true;
 
     /* validate directly off the offsets. this isn't quite correct for arrays
      * and matrices, but is a good first step. TODO: arrays, matrices, weird
      * sizes */
-    for (auto insn : *src) {
-        if (insn.opcode() == spv::OpMemberDecorate && insn.word(1) == type.word(1)) {
-
-            if (insn.word(3) == spv::DecorationOffset) {
-                unsigned offset = insn.word(4);
-                auto size = 4; /* bytes; TODO: calculate this based on the type */
-
-                bool found_range = false;
-                for (auto const &range : *pushConstantRanges) {
-                    if (range.offset <= offset && range.offset + range.size >= offset + size) {
-                        found_range = true;
-
-                        if ((range.stageFlags & stage) == 0) {
-                            if (log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VkDebugReportObjectTypeEXT(0), 0,
-                                        __LINE__, SHADER_CHECKER_PUSH_CONSTANT_NOT_ACCESSIBLE_FROM_STAGE, "SC",
-                                        "Push constant range covering variable starting at "
-                                        "offset %u not accessible from stage %s",
-                                        offset, string_VkShaderStageFlagBits(stage))) {
-                                pass = false;
-                            }
-                        }
+    for (auto offset : reflection->push_constant_offsets) {
+        auto size = 4; /* bytes; TODO: calculate this based on the type */
 
-                        break;
-                    }
-                }
+        bool found_range = false;
+        for (auto const &range : *pushConstantRanges) {
+            if (range.offset <= offset && range.offset + range.size >= offset + size) {
+                found_range = true;
 
-                if (!found_range) {
+                if ((range.stageFlags & stage) == 0) {
                     if (log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VkDebugReportObjectTypeEXT(0), 0,
-                                __LINE__, SHADER_CHECKER_PUSH_CONSTANT_OUT_OF_RANGE, "SC",
+                                __LINE__, SHADER_CHECKER_PUSH_CONSTANT_NOT_ACCESSIBLE_FROM_STAGE, "SC",
                                 "Push constant range covering variable starting at "
-                                "offset %u not declared in layout",
-                                offset)) {
+                                "offset %u not accessible from stage %s",
+                                offset, string_VkShaderStageFlagBits(stage))) {
                         pass = false;
                     }
                 }
+
+                break;
+            }
+        }
+
+        if (!found_range) {
+            if (log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VkDebugReportObjectTypeEXT(0), 0,
+                        __LINE__, SHADER_CHECKER_PUSH_CONSTANT_OUT_OF_RANGE, "SC",
+                        "Push constant range covering variable starting at "
+                        "offset %u not declared in layout",
+                        offset)) {
+                pass = false;
             }
         }
     }
@@ -1955,20 +2570,33 @@ static bool validate_push_constant_block_against_pipeline(debug_report_data *rep
     return pass;
 }
 
-static bool validate_push_constant_usage(debug_report_data *report_data,
-                                         std::vector<VkPushConstantRange> const *pushConstantRanges, shader_module const *src,
-                                         std::unordered_set<uint32_t> accessible_ids, VkShaderStageFlagBits stage) {
-    bool pass = true;
+/* get the reflection data for an entrypoint of a module, computing it if this is the first pipeline to use it */
+static entrypoint_reflection const *get_entrypoint_reflection(shader_module const *src, spirv_inst_iter entrypoint,
+                                                              VkShaderStageFlagBits stage) {
+    if (entrypoint == src->end()) {
+        /* missing entrypoint has already been reported; there is nothing to reflect */
+        static const entrypoint_reflection empty_reflection;
+        return &empty_reflection;
+    }
 
-    for (auto id : accessible_ids) {
-        auto def_insn = src->get_def(id);
-        if (def_insn.opcode() == spv::OpVariable && def_insn.word(3) == spv::StorageClassPushConstant) {
-            pass &= validate_push_constant_block_against_pipeline(report_data, pushConstantRanges, src,
-                                                                 src->get_def(def_insn.word(1)), stage);
+    std::lock_guard<std::mutex> lock(src->reflection_lock);
+    auto &reflection = src->entrypoint_reflections[entrypoint.offset()];
+    if (!reflection) {
+        reflection.reset(new entrypoint_reflection);
+
+        uint32_t stage_id = get_shader_stage_id(stage);
+        if (stage_id < sizeof(shader_stage_attribs) / sizeof(shader_stage_attribs[0])) {
+            collect_interface_by_location(src, entrypoint, spv::StorageClassInput, reflection->inputs,
+                                          shader_stage_attribs[stage_id].arrayed_input);
+            collect_interface_by_location(src, entrypoint, spv::StorageClassOutput, reflection->outputs,
+                                          shader_stage_attribs[stage_id].arrayed_output);
         }
+        mark_accessible_ids(src, entrypoint, reflection->accessible_ids);
+        collect_interface_by_descriptor_slot(src, reflection->accessible_ids, reflection->descriptor_uses,
+                                             reflection->descriptor_conflicts);
+        collect_push_constant_offsets(src, reflection->accessible_ids, reflection->push_constant_offsets);
     }
-
-    return pass;
+    return reflection.get();
 }
 
 // For given pipelineLayout verify that the set_layout_node at slot.first
@@ -1986,7 +2614,7 @@ static VkDescriptorSetLayoutBinding const * get_descriptor_binding(PIPELINE_LAYO
 
 // Block of code at start here for managing/tracking Pipeline state that this layer cares about
 
-static uint64_t g_drawCount[NUM_DRAW_TYPES] = {0, 0, 0, 0};
+static std::atomic<uint64_t> g_drawCount[NUM_DRAW_TYPES] = {{0}, {0}, {0}, {0}};
 
 // TODO : Should be tracking lastBound per commandBuffer and when draws occur, report based on that cmd buffer lastBound
 //   Then need to synchronize the accesses based on cmd buffer so that if I'm reading state on one cmd buffer, updates
@@ -2369,135 +2997,132 @@ static bool validate_shader_capabilities(debug_report_data *report_data, shader_
                                          VkPhysicalDeviceFeatures const *enabledFeatures) {
     bool pass = true;
 
+    for (auto capability : src->capabilities) {
+        switch (capability) {
+        case spv::CapabilityMatrix:
+        case spv::CapabilityShader:
+        case spv::CapabilityInputAttachment:
+        case spv::CapabilitySampled1D:
+        case spv::CapabilityImage1D:
+        case spv::CapabilitySampledBuffer:
+        case spv::CapabilityImageBuffer:
+        case spv::CapabilityImageQuery:
+        case spv::CapabilityDerivativeControl:
+            // Always supported by a Vulkan 1.0 implementation -- no feature bits.
+            break;
 
-    for (auto insn : *src) {
-        if (insn.opcode() == spv::OpCapability) {
-            switch (insn.word(1)) {
-            case spv::CapabilityMatrix:
-            case spv::CapabilityShader:
-            case spv::CapabilityInputAttachment:
-            case spv::CapabilitySampled1D:
-            case spv::CapabilityImage1D:
-            case spv::CapabilitySampledBuffer:
-            case spv::CapabilityImageBuffer:
-            case spv::CapabilityImageQuery:
-            case spv::CapabilityDerivativeControl:
-                // Always supported by a Vulkan 1.0 implementation -- no feature bits.
-                break;
-
-            case spv::CapabilityGeometry:
-                pass &= require_feature(report_data, enabledFeatures->geometryShader, "geometryShader");
-                break;
+        case spv::CapabilityGeometry:
+            pass &= require_feature(report_data, enabledFeatures->geometryShader, "geometryShader");
+            break;
 
-            case spv::CapabilityTessellation:
-                pass &= require_feature(report_data, enabledFeatures->tessellationShader, "tessellationShader");
-                break;
+        case spv::CapabilityTessellation:
+            pass &= require_feature(report_data, enabledFeatures->tessellationShader, "tessellationShader");
+            break;
 
-            case spv::CapabilityFloat64:
-                pass &= require_feature(report_data, enabledFeatures->shaderFloat64, "shaderFloat64");
-                break;
+        case spv::CapabilityFloat64:
+            pass &= require_feature(report_data, enabledFeatures->shaderFloat64, "shaderFloat64");
+            break;
 
-            case spv::CapabilityInt64:
-                pass &= require_feature(report_data, enabledFeatures->shaderInt64, "shaderInt64");
-                break;
+        case spv::CapabilityInt64:
+            pass &= require_feature(report_data, enabledFeatures->shaderInt64, "shaderInt64");
+            break;
 
-            case spv::CapabilityTessellationPointSize:
-            case spv::CapabilityGeometryPointSize:
-                pass &= require_feature(report_data, enabledFeatures->shaderTessellationAndGeometryPointSize,
-                                        "shaderTessellationAndGeometryPointSize");
-                break;
+        case spv::CapabilityTessellationPointSize:
+        case spv::CapabilityGeometryPointSize:
+            pass &= require_feature(report_data, enabledFeatures->shaderTessellationAndGeometryPointSize,
+                                    "shaderTessellationAndGeometryPointSize");
+            break;
 
-            case spv::CapabilityImageGatherExtended:
-                pass &= require_feature(report_data, enabledFeatures->shaderImageGatherExtended, "shaderImageGatherExtended");
-                break;
+        case spv::CapabilityImageGatherExtended:
+            pass &= require_feature(report_data, enabledFeatures->shaderImageGatherExtended, "shaderImageGatherExtended");
+            break;
 
-            case spv::CapabilityStorageImageMultisample:
-                pass &= require_feature(report_data, enabledFeatures->shaderStorageImageMultisample, "shaderStorageImageMultisample");
-                break;
+        case spv::CapabilityStorageImageMultisample:
+            pass &= require_feature(report_data, enabledFeatures->shaderStorageImageMultisample, "shaderStorageImageMultisample");
+            break;
 
-            case spv::CapabilityUniformBufferArrayDynamicIndexing:
-                pass &= require_feature(report_data, enabledFeatures->shaderUniformBufferArrayDynamicIndexing,
-                                        "shaderUniformBufferArrayDynamicIndexing");
-                break;
+        case spv::CapabilityUniformBufferArrayDynamicIndexing:
+            pass &= require_feature(report_data, enabledFeatures->shaderUniformBufferArrayDynamicIndexing,
+                                    "shaderUniformBufferArrayDynamicIndexing");
+            break;
 
-            case spv::CapabilitySampledImageArrayDynamicIndexing:
-                pass &= require_feature(report_data, enabledFeatures->shaderSampledImageArrayDynamicIndexing,
-                                        "shaderSampledImageArrayDynamicIndexing");
-                break;
+        case spv::CapabilitySampledImageArrayDynamicIndexing:
+            pass &= require_feature(report_data, enabledFeatures->shaderSampledImageArrayDynamicIndexing,
+                                    "shaderSampledImageArrayDynamicIndexing");
+            break;
 
-            case spv::CapabilityStorageBufferArrayDynamicIndexing:
-                pass &= require_feature(report_data, enabledFeatures->shaderStorageBufferArrayDynamicIndexing,
-                                        "shaderStorageBufferArrayDynamicIndexing");
-                break;
+        case spv::CapabilityStorageBufferArrayDynamicIndexing:
+            pass &= require_feature(report_data, enabledFeatures->shaderStorageBufferArrayDynamicIndexing,
+                                    "shaderStorageBufferArrayDynamicIndexing");
+            break;
 
-            case spv::CapabilityStorageImageArrayDynamicIndexing:
-                pass &= require_feature(report_data, enabledFeatures->shaderStorageImageArrayDynamicIndexing,
-                                        "shaderStorageImageArrayDynamicIndexing");
-                break;
+        case spv::CapabilityStorageImageArrayDynamicIndexing:
+            pass &= require_feature(report_data, enabledFeatures->shaderStorageImageArrayDynamicIndexing,
+                                    "shaderStorageImageArrayDynamicIndexing");
+            break;
 
-            case spv::CapabilityClipDistance:
-                pass &= require_feature(report_data, enabledFeatures->shaderClipDistance, "shaderClipDistance");
-                break;
+        case spv::CapabilityClipDistance:
+            pass &= require_feature(report_data, enabledFeatures->shaderClipDistance, "shaderClipDistance");
+            break;
 
-            case spv::CapabilityCullDistance:
-                pass &= require_feature(report_data, enabledFeatures->shaderCullDistance, "shaderCullDistance");
-                break;
+        case spv::CapabilityCullDistance:
+            pass &= require_feature(report_data, enabledFeatures->shaderCullDistance, "shaderCullDistance");
+            break;
 
-            case spv::CapabilityImageCubeArray:
-                pass &= require_feature(report_data, enabledFeatures->imageCubeArray, "imageCubeArray");
-                break;
+        case spv::CapabilityImageCubeArray:
+            pass &= require_feature(report_data, enabledFeatures->imageCubeArray, "imageCubeArray");
+            break;
 
-            case spv::CapabilitySampleRateShading:
-                pass &= require_feature(report_data, enabledFeatures->sampleRateShading, "sampleRateShading");
-                break;
+        case spv::CapabilitySampleRateShading:
+            pass &= require_feature(report_data, enabledFeatures->sampleRateShading, "sampleRateShading");
+            break;
 
-            case spv::CapabilitySparseResidency:
-                pass &= require_feature(report_data, enabledFeatures->shaderResourceResidency, "shaderResourceResidency");
-                break;
+        case spv::CapabilitySparseResidency:
+            pass &= require_feature(report_data, enabledFeatures->shaderResourceResidency, "shaderResourceResidency");
+            break;
 
-            case spv::CapabilityMinLod:
-                pass &= require_feature(report_data, enabledFeatures->shaderResourceMinLod, "shaderResourceMinLod");
-                break;
+        case spv::CapabilityMinLod:
+            pass &= require_feature(report_data, enabledFeatures->shaderResourceMinLod, "shaderResourceMinLod");
+            break;
 
-            case spv::CapabilitySampledCubeArray:
-                pass &= require_feature(report_data, enabledFeatures->imageCubeArray, "imageCubeArray");
-                break;
+        case spv::CapabilitySampledCubeArray:
+            pass &= require_feature(report_data, enabledFeatures->imageCubeArray, "imageCubeArray");
+            break;
 
-            case spv::CapabilityImageMSArray:
-                pass &= require_feature(report_data, enabledFeatures->shaderStorageImageMultisample, "shaderStorageImageMultisample");
-                break;
+        case spv::CapabilityImageMSArray:
+            pass &= require_feature(report_data, enabledFeatures->shaderStorageImageMultisample, "shaderStorageImageMultisample");
+            break;
 
-            case spv::CapabilityStorageImageExtendedFormats:
-                pass &= require_feature(report_data, enabledFeatures->shaderStorageImageExtendedFormats,
-                                        "shaderStorageImageExtendedFormats");
-                break;
+        case spv::CapabilityStorageImageExtendedFormats:
+            pass &= require_feature(report_data, enabledFeatures->shaderStorageImageExtendedFormats,
+                                    "shaderStorageImageExtendedFormats");
+            break;
 
-            case spv::CapabilityInterpolationFunction:
-                pass &= require_feature(report_data, enabledFeatures->sampleRateShading, "sampleRateShading");
-                break;
+        case spv::CapabilityInterpolationFunction:
+            pass &= require_feature(report_data, enabledFeatures->sampleRateShading, "sampleRateShading");
+            break;
 
-            case spv::CapabilityStorageImageReadWithoutFormat:
-                pass &= require_feature(report_data, enabledFeatures->shaderStorageImageReadWithoutFormat,
-                                        "shaderStorageImageReadWithoutFormat");
-                break;
+        case spv::CapabilityStorageImageReadWithoutFormat:
+            pass &= require_feature(report_data, enabledFeatures->shaderStorageImageReadWithoutFormat,
+                                    "shaderStorageImageReadWithoutFormat");
+            break;
 
-            case spv::CapabilityStorageImageWriteWithoutFormat:
-                pass &= require_feature(report_data, enabledFeatures->shaderStorageImageWriteWithoutFormat,
-                                        "shaderStorageImageWriteWithoutFormat");
-                break;
+        case spv::CapabilityStorageImageWriteWithoutFormat:
+            pass &= require_feature(report_data, enabledFeatures->shaderStorageImageWriteWithoutFormat,
+                                    "shaderStorageImageWriteWithoutFormat");
+            break;
 
-            case spv::CapabilityMultiViewport:
-                pass &= require_feature(report_data, enabledFeatures->multiViewport, "multiViewport");
-                break;
+        case spv::CapabilityMultiViewport:
+            pass &= require_feature(report_data, enabledFeatures->multiViewport, "multiViewport");
+            break;
 
-            default:
-                if (log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VkDebugReportObjectTypeEXT(0), 0,
-                            __LINE__, SHADER_CHECKER_BAD_CAPABILITY, "SC",
-                            "Shader declares capability %u, not supported in Vulkan.",
-                            insn.word(1)))
-                    pass = false;
-                break;
-            }
+        default:
+            if (log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VkDebugReportObjectTypeEXT(0), 0,
+                        __LINE__, SHADER_CHECKER_BAD_CAPABILITY, "SC",
+                        "Shader declares capability %u, not supported in Vulkan.",
+                        capability))
+                pass = false;
+            break;
         }
     }
 
@@ -2508,7 +3133,7 @@ static bool validate_pipeline_shader_stage(debug_report_data *report_data,
                                            VkPipelineShaderStageCreateInfo const *pStage,
                                            PIPELINE_NODE *pipeline,
                                            shader_module **out_module,
-                                           spirv_inst_iter *out_entrypoint,
+                                           entrypoint_reflection const **out_reflection,
                                            VkPhysicalDeviceFeatures const *enabledFeatures,
                                            std::unordered_map<VkShaderModule,
                                            std::unique_ptr<shader_module>> const &shaderModuleMap) {
@@ -2518,7 +3143,7 @@ static bool validate_pipeline_shader_stage(debug_report_data *report_data,
     pass &= validate_specialization_offsets(report_data, pStage);
 
     /* find the entrypoint */
-    auto entrypoint = *out_entrypoint = find_entrypoint(module, pStage->pName, pStage->stage);
+    auto entrypoint = find_entrypoint(module, pStage->pName, pStage->stage);
     if (entrypoint == module->end()) {
         if (log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VkDebugReportObjectTypeEXT(0), 0,
                     __LINE__, SHADER_CHECKER_MISSING_ENTRYPOINT, "SC",
@@ -2531,22 +3156,24 @@ static bool validate_pipeline_shader_stage(debug_report_data *report_data,
     /* validate shader capabilities against enabled device features */
     pass &= validate_shader_capabilities(report_data, module, enabledFeatures);
 
-    /* mark accessible ids */
-    std::unordered_set<uint32_t> accessible_ids;
-    mark_accessible_ids(module, entrypoint, accessible_ids);
+    /* accessible ids, interfaces and resource uses of the entrypoint */
+    auto reflection = *out_reflection = get_entrypoint_reflection(module, entrypoint, pStage->stage);
 
-    /* validate descriptor set layout against what the entrypoint actually uses */
-    std::map<descriptor_slot_t, interface_var> descriptor_uses;
-    collect_interface_by_descriptor_slot(report_data, module, accessible_ids, descriptor_uses);
+    for (auto const &conflict : reflection->descriptor_conflicts) {
+        auto insn = module->get_def(conflict.second);
+        log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VkDebugReportObjectTypeEXT(0), 0,
+                __LINE__, SHADER_CHECKER_INCONSISTENT_SPIRV, "SC",
+                "var %d (type %d) in %s interface in descriptor slot (%u,%u) conflicts with existing definition",
+                insn.word(2), insn.word(1), storage_class_name(insn.word(3)), conflict.first.first, conflict.first.second);
+    }
 
     auto pipelineLayout = pipeline->pipelineLayout;
 
     /* validate push constant usage */
-    pass &= validate_push_constant_usage(report_data, &pipelineLayout->pushConstantRanges,
-                                        module, accessible_ids, pStage->stage);
+    pass &= validate_push_constant_usage(report_data, &pipelineLayout->pushConstantRanges, reflection, pStage->stage);
 
-    /* validate descriptor use */
-    for (auto use : descriptor_uses) {
+    /* validate descriptor set layout against what the entrypoint actually uses */
+    for (auto const &use : reflection->descriptor_uses) {
         // While validating shaders capture which slots are used by the pipeline
         pipeline->active_slots[use.first.first].insert(use.first.second);
 
@@ -2607,8 +3234,8 @@ static bool validate_and_capture_pipeline_shader_state(debug_report_data *report
 
     shader_module *shaders[5];
     memset(shaders, 0, sizeof(shaders));
-    spirv_inst_iter entrypoints[5];
-    memset(entrypoints, 0, sizeof(entrypoints));
+    entrypoint_reflection const *reflections[5];
+    memset(reflections, 0, sizeof(reflections));
     VkPipelineVertexInputStateCreateInfo const *vi = 0;
     bool pass = true;
 
@@ -2616,7 +3243,7 @@ static bool validate_and_capture_pipeline_shader_state(debug_report_data *report
         auto pStage = &pCreateInfo->pStages[i];
         auto stage_id = get_shader_stage_id(pStage->stage);
         pass &= validate_pipeline_shader_stage(report_data, pStage, pPipeline,
-                                               &shaders[stage_id], &entrypoints[stage_id],
+                                               &shaders[stage_id], &reflections[stage_id],
                                                enabledFeatures, shaderModuleMap);
     }
 
@@ -2627,7 +3254,7 @@ static bool validate_and_capture_pipeline_shader_state(debug_report_data *report
     }
 
     if (shaders[vertex_stage]) {
-        pass &= validate_vi_against_vs_inputs(report_data, vi, shaders[vertex_stage], entrypoints[vertex_stage]);
+        pass &= validate_vi_against_vs_inputs(report_data, vi, shaders[vertex_stage], reflections[vertex_stage]);
     }
 
     int producer = get_shader_stage_id(VK_SHADER_STAGE_VERTEX_BIT);
@@ -2642,15 +3269,15 @@ static bool validate_and_capture_pipeline_shader_state(debug_report_data *report
         assert(shaders[producer]);
         if (shaders[consumer]) {
             pass &= validate_interface_between_stages(report_data,
-                                                      shaders[producer], entrypoints[producer], &shader_stage_attribs[producer],
-                                                      shaders[consumer], entrypoints[consumer], &shader_stage_attribs[consumer]);
+                                                      shaders[producer], reflections[producer], &shader_stage_attribs[producer],
+                                                      shaders[consumer], reflections[consumer], &shader_stage_attribs[consumer]);
 
             producer = consumer;
         }
     }
 
     if (shaders[fragment_stage] && pPipeline->renderPass) {
-        pass &= validate_fs_outputs_against_render_pass(report_data, shaders[fragment_stage], entrypoints[fragment_stage],
+        pass &= validate_fs_outputs_against_render_pass(report_data, shaders[fragment_stage], reflections[fragment_stage],
                                                         pPipeline->renderPass, pCreateInfo->subpass);
     }
 
@@ -2662,10 +3289,10 @@ static bool validate_compute_pipeline(debug_report_data *report_data, PIPELINE_N
     auto pCreateInfo = pPipeline->computePipelineCI.ptr();
 
     shader_module *module;
-    spirv_inst_iter entrypoint;
+    entrypoint_reflection const *reflection;
 
     return validate_pipeline_shader_stage(report_data, &pCreateInfo->stage, pPipeline,
-                                          &module, &entrypoint, enabledFeatures, shaderModuleMap);
+                                          &module, &reflection, enabledFeatures, shaderModuleMap);
 }
 // Return Set node ptr for specified set or else NULL
 cvdescriptorset::DescriptorSet *getSetNode(const layer_data *my_data, VkDescriptorSet set) {
@@ -2682,10 +3309,12 @@ cvdescriptorset::DescriptorSet *getSetNode(const layer_data *my_data, VkDescript
 //     descriptor update must not overflow the size of its buffer being updated
 //  2. Grow updateImages for given pCB to include any bound STORAGE_IMAGE descriptor images
 //  3. Grow updateBuffers for pCB to include buffers from STORAGE*_BUFFER descriptor buffers
+// *failed is set if any set fails validation, whether or not the callback asked for the call to be skipped
 static bool validate_and_update_drawtime_descriptor_state(
     layer_data *dev_data, GLOBAL_CB_NODE *pCB,
     const vector<std::tuple<cvdescriptorset::DescriptorSet *, unordered_set<uint32_t>,
-                            std::vector<uint32_t> const *>> &activeSetBindingsPairs) {
+                            std::vector<uint32_t> const *>> &activeSetBindingsPairs,
+    bool *failed) {
     bool result = false;
     for (auto set_bindings_pair : activeSetBindingsPairs) {
         cvdescriptorset::DescriptorSet *set_node = std::get<0>(set_bindings_pair);
@@ -2693,6 +3322,7 @@ static bool validate_and_update_drawtime_descriptor_state(
         if (!set_node->ValidateDrawState(std::get<1>(set_bindings_pair), *std::get<2>(set_bindings_pair),
                                          &err_str)) {
             // Report error here
+            *failed = true;
             auto set = set_node->GetSet();
             result |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_SET_EXT,
                               reinterpret_cast<const uint64_t &>(set), __LINE__, DRAWSTATE_DESCRIPTOR_SET_NOT_UPDATED, "DS",
@@ -2838,11 +3468,36 @@ static bool validatePipelineDrawtimeState(layer_data const *my_data,
     return skip_call;
 }
 
+// Return true if the descriptor state bound at state passed draw-time validation at an earlier draw and neither the
+// bindings, the bound sets nor the resources they reference have changed since
+static bool drawtime_descriptor_state_cached(const layer_data *dev_data, const LAST_BOUND_STATE &state) {
+    if (state.validatedVersion != state.version || state.validatedResourceVersion != dev_data->descriptorResourceVersion)
+        return false;
+    for (auto const &set_version : state.validatedSets) {
+        if (set_version.first->GetVersion() != set_version.second)
+            return false;
+    }
+    return true;
+}
+
+static void cache_drawtime_descriptor_state(
+    const layer_data *dev_data, LAST_BOUND_STATE &state,
+    const vector<std::tuple<cvdescriptorset::DescriptorSet *, unordered_set<uint32_t>, std::vector<uint32_t> const *>>
+        &activeSetBindingsPairs) {
+    state.validatedVersion = state.version;
+    state.validatedResourceVersion = dev_data->descriptorResourceVersion;
+    state.validatedSets.clear();
+    for (auto const &set_bindings_pair : activeSetBindingsPairs) {
+        auto set_node = std::get<0>(set_bindings_pair);
+        state.validatedSets.push_back(std::make_pair(set_node, set_node->GetVersion()));
+    }
+}
+
 // Validate overall state at the time of a draw call
 static bool validate_and_update_draw_state(layer_data *my_data, GLOBAL_CB_NODE *pCB, const bool indexedDraw,
                                            const VkPipelineBindPoint bindPoint) {
     bool result = false;
-    auto const &state = pCB->lastBound[bindPoint];
+    auto &state = pCB->lastBound[bindPoint];
     PIPELINE_NODE *pPipe = getPipeline(my_data, state.pipeline);
     if (nullptr == pPipe) {
         result |= log_msg(
@@ -2854,11 +3509,24 @@ static bool validate_and_update_draw_state(layer_data *my_data, GLOBAL_CB_NODE *
             return true;
     }
     // First check flag states
-    if (VK_PIPELINE_BIND_POINT_GRAPHICS == bindPoint)
+    if (VK_PIPELINE_BIND_POINT_GRAPHICS == bindPoint && checkEnabled(my_data, CHECK_DRAW_STATE))
         result = validate_draw_state_flags(my_data, pCB, pPipe, indexedDraw);
 
-    // Now complete other state checks
-    if (state.pipelineLayout) {
+    if (!checkEnabled(my_data, CHECK_DESCRIPTOR_SETS)) {
+        if (!pPipe)
+            return result;
+        // Still collect the storage resources the bound sets expose, as their contents are marked written by the draw
+        for (auto &setBindingPair : pPipe->active_slots) {
+            if (setBindingPair.first < state.boundDescriptorSets.size() && state.boundDescriptorSets[setBindingPair.first]) {
+                state.boundDescriptorSets[setBindingPair.first]->GetStorageUpdates(setBindingPair.second, &pCB->updateBuffers,
+                                                                                   &pCB->updateImages);
+            }
+        }
+    } else if (state.pipelineLayout && !drawtime_descriptor_state_cached(my_data, state)) {
+        // Now complete other state checks, unless the descriptor state is unchanged since a draw it passed at. The
+        // callback's return value only says whether to skip the call, so track failures separately for the cache.
+        bool descriptor_result = false;
+        bool descriptor_failed = false;
         string errorString;
         auto pipelineLayout = (bindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS) ? pPipe->graphicsPipelineCI.layout : pPipe->computePipelineCI.layout;
 
@@ -2868,15 +3536,18 @@ static bool validate_and_update_draw_state(layer_data *my_data, GLOBAL_CB_NODE *
             uint32_t setIndex = setBindingPair.first;
             // If valid set is not bound throw an error
             if ((state.boundDescriptorSets.size() <= setIndex) || (!state.boundDescriptorSets[setIndex])) {
-                result |= log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0, __LINE__,
-                                  DRAWSTATE_DESCRIPTOR_SET_NOT_BOUND, "DS",
-                                  "VkPipeline 0x%" PRIxLEAST64 " uses set #%u but that set is not bound.", (uint64_t)pPipe->pipeline,
-                                  setIndex);
+                descriptor_failed = true;
+                descriptor_result |=
+                    log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0, __LINE__,
+                            DRAWSTATE_DESCRIPTOR_SET_NOT_BOUND, "DS",
+                            "VkPipeline 0x%" PRIxLEAST64 " uses set #%u but that set is not bound.", (uint64_t)pPipe->pipeline,
+                            setIndex);
             } else if (!verify_set_layout_compatibility(my_data, state.boundDescriptorSets[setIndex],
                                                         pipelineLayout, setIndex, errorString)) {
                 // Set is bound but not compatible w/ overlapping pipelineLayout from PSO
                 VkDescriptorSet setHandle = state.boundDescriptorSets[setIndex]->GetSet();
-                result |=
+                descriptor_failed = true;
+                descriptor_result |=
                     log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_SET_EXT,
                             (uint64_t)setHandle, __LINE__, DRAWSTATE_PIPELINE_LAYOUTS_INCOMPATIBLE, "DS",
                             "VkDescriptorSet (0x%" PRIxLEAST64
@@ -2893,7 +3564,8 @@ static bool validate_and_update_draw_state(layer_data *my_data, GLOBAL_CB_NODE *
                 if (!pSet->IsUpdated()) {
                     for (auto binding : setBindingPair.second) {
                         if (!pSet->GetImmutableSamplerPtrFromBinding(binding)) {
-                            result |= log_msg(
+                            descriptor_failed = true;
+                            descriptor_result |= log_msg(
                                 my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_SET_EXT,
                                 (uint64_t)pSet->GetSet(), __LINE__, DRAWSTATE_DESCRIPTOR_SET_NOT_UPDATED, "DS",
                                 "DS 0x%" PRIxLEAST64 " bound but it was never updated. It is now being used to draw so "
@@ -2905,11 +3577,15 @@ static bool validate_and_update_draw_state(layer_data *my_data, GLOBAL_CB_NODE *
             }
         }
         // For given active slots, verify any dynamic descriptors and record updated images & buffers
-        result |= validate_and_update_drawtime_descriptor_state(my_data, pCB, activeSetBindingsPairs);
+        descriptor_result |=
+            validate_and_update_drawtime_descriptor_state(my_data, pCB, activeSetBindingsPairs, &descriptor_failed);
+        if (!descriptor_failed)
+            cache_drawtime_descriptor_state(my_data, state, activeSetBindingsPairs);
+        result |= descriptor_result;
     }
 
     // Check general pipeline state that needs to be validated at drawtime
-    if (VK_PIPELINE_BIND_POINT_GRAPHICS == bindPoint)
+    if (VK_PIPELINE_BIND_POINT_GRAPHICS == bindPoint && checkEnabled(my_data, CHECK_DRAW_STATE))
         result |= validatePipelineDrawtimeState(my_data, state, pCB, pPipe);
 
     return result;
@@ -2941,8 +3617,8 @@ static bool verifyLineWidth(layer_data *my_data, DRAW_STATE_ERROR dsError, const
 }
 
 // Verify that create state for a pipeline is valid
-static bool verifyPipelineCreateState(layer_data *my_data, const VkDevice device, std::vector<PIPELINE_NODE *> pPipelines,
-                                      int pipelineIndex) {
+static bool verifyPipelineCreateState(layer_data *my_data, const VkDevice device,
+                                      std::vector<PIPELINE_NODE *> const &pPipelines, int pipelineIndex) {
     bool skipCall = false;
 
     PIPELINE_NODE *pPipeline = pPipelines[pipelineIndex];
@@ -3243,193 +3919,74 @@ static bool validateUpdateConsistency(layer_data *my_data, const VkDevice device
     }
     return skipCall;
 }
-//TODO: Consolidate functions
-bool FindLayout(const GLOBAL_CB_NODE *pCB, ImageSubresourcePair imgpair, IMAGE_CMD_BUF_LAYOUT_NODE &node, const VkImageAspectFlags aspectMask) {
-    layer_data *my_data = get_my_data_ptr(get_dispatch_key(pCB->commandBuffer), layer_data_map);
-    if (!(imgpair.subresource.aspectMask & aspectMask)) {
-        return false;
-    }
-    VkImageAspectFlags oldAspectMask = imgpair.subresource.aspectMask;
-    imgpair.subresource.aspectMask = aspectMask;
-    auto imgsubIt = pCB->imageLayoutMap.find(imgpair);
-    if (imgsubIt == pCB->imageLayoutMap.end()) {
-        return false;
-    }
-    if (node.layout != VK_IMAGE_LAYOUT_MAX_ENUM && node.layout != imgsubIt->second.layout) {
-        log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT,
-                reinterpret_cast<uint64_t&>(imgpair.image), __LINE__, DRAWSTATE_INVALID_LAYOUT, "DS",
-                "Cannot query for VkImage 0x%" PRIx64 " layout when combined aspect mask %d has multiple layout types: %s and %s",
-                reinterpret_cast<uint64_t&>(imgpair.image), oldAspectMask, string_VkImageLayout(node.layout), string_VkImageLayout(imgsubIt->second.layout));
-    }
-    if (node.initialLayout != VK_IMAGE_LAYOUT_MAX_ENUM && node.initialLayout != imgsubIt->second.initialLayout) {
-        log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT,
-                reinterpret_cast<uint64_t&>(imgpair.image), __LINE__, DRAWSTATE_INVALID_LAYOUT, "DS",
-                "Cannot query for VkImage 0x%" PRIx64 " layout when combined aspect mask %d has multiple initial layout types: %s and %s",
-                reinterpret_cast<uint64_t&>(imgpair.image), oldAspectMask, string_VkImageLayout(node.initialLayout), string_VkImageLayout(imgsubIt->second.initialLayout));
-    }
-    node = imgsubIt->second;
-    return true;
-}
-
-bool FindLayout(const layer_data *my_data, ImageSubresourcePair imgpair, VkImageLayout &layout, const VkImageAspectFlags aspectMask) {
-    if (!(imgpair.subresource.aspectMask & aspectMask)) {
-        return false;
-    }
-    VkImageAspectFlags oldAspectMask = imgpair.subresource.aspectMask;
-    imgpair.subresource.aspectMask = aspectMask;
-    auto imgsubIt = my_data->imageLayoutMap.find(imgpair);
-    if (imgsubIt == my_data->imageLayoutMap.end()) {
-        return false;
-    }
-    if (layout != VK_IMAGE_LAYOUT_MAX_ENUM && layout != imgsubIt->second.layout) {
-        log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT,
-                reinterpret_cast<uint64_t&>(imgpair.image), __LINE__, DRAWSTATE_INVALID_LAYOUT, "DS",
-                "Cannot query for VkImage 0x%" PRIx64 " layout when combined aspect mask %d has multiple layout types: %s and %s",
-                reinterpret_cast<uint64_t&>(imgpair.image), oldAspectMask, string_VkImageLayout(layout), string_VkImageLayout(imgsubIt->second.layout));
-    }
-    layout = imgsubIt->second.layout;
-    return true;
-}
-
-// find layout(s) on the cmd buf level
-bool FindLayout(const GLOBAL_CB_NODE *pCB, VkImage image, VkImageSubresource range, IMAGE_CMD_BUF_LAYOUT_NODE &node) {
-    ImageSubresourcePair imgpair = {image, true, range};
-    node = IMAGE_CMD_BUF_LAYOUT_NODE(VK_IMAGE_LAYOUT_MAX_ENUM, VK_IMAGE_LAYOUT_MAX_ENUM);
-    FindLayout(pCB, imgpair, node, VK_IMAGE_ASPECT_COLOR_BIT);
-    FindLayout(pCB, imgpair, node, VK_IMAGE_ASPECT_DEPTH_BIT);
-    FindLayout(pCB, imgpair, node, VK_IMAGE_ASPECT_STENCIL_BIT);
-    FindLayout(pCB, imgpair, node, VK_IMAGE_ASPECT_METADATA_BIT);
-    if (node.layout == VK_IMAGE_LAYOUT_MAX_ENUM) {
-        imgpair = {image, false, VkImageSubresource()};
-        auto imgsubIt = pCB->imageLayoutMap.find(imgpair);
-        if (imgsubIt == pCB->imageLayoutMap.end())
-            return false;
-        node = imgsubIt->second;
-    }
-    return true;
-}
-
-// find layout(s) on the global level
-bool FindLayout(const layer_data *my_data, ImageSubresourcePair imgpair, VkImageLayout &layout) {
-    layout = VK_IMAGE_LAYOUT_MAX_ENUM;
-    FindLayout(my_data, imgpair, layout, VK_IMAGE_ASPECT_COLOR_BIT);
-    FindLayout(my_data, imgpair, layout, VK_IMAGE_ASPECT_DEPTH_BIT);
-    FindLayout(my_data, imgpair, layout, VK_IMAGE_ASPECT_STENCIL_BIT);
-    FindLayout(my_data, imgpair, layout, VK_IMAGE_ASPECT_METADATA_BIT);
-    if (layout == VK_IMAGE_LAYOUT_MAX_ENUM) {
-        imgpair = {imgpair.image, false, VkImageSubresource()};
-        auto imgsubIt = my_data->imageLayoutMap.find(imgpair);
-        if (imgsubIt == my_data->imageLayoutMap.end())
-            return false;
-        layout = imgsubIt->second.layout;
+// Layout state of image as tracked by pCB, created on first use with the image's dimensions
+static ImageLayoutMap<IMAGE_CMD_BUF_LAYOUT_NODE> &GetCBImageLayouts(const layer_data *dev_data, GLOBAL_CB_NODE *pCB,
+                                                                    VkImage image) {
+    auto it = pCB->imageLayoutMap.find(image);
+    if (it == pCB->imageLayoutMap.end()) {
+        auto image_node = getImageNode(dev_data, image);
+        uint32_t mip_levels = image_node ? image_node->createInfo.mipLevels : 1;
+        uint32_t array_layers = image_node ? image_node->createInfo.arrayLayers : 1;
+        it = pCB->imageLayoutMap.emplace(image, ImageLayoutMap<IMAGE_CMD_BUF_LAYOUT_NODE>(mip_levels, array_layers)).first;
     }
-    return true;
+    return it->second;
 }
 
-bool FindLayout(const layer_data *my_data, VkImage image, VkImageSubresource range, VkImageLayout &layout) {
-    ImageSubresourcePair imgpair = {image, true, range};
-    return FindLayout(my_data, imgpair, layout);
+// Update the cmd buf level layout of every subresource in range. fn(begin, end, node) is called once per piece of the
+// range with uniform state, with node nullptr where the cmd buf has not used the subresources yet, and returns the
+// new state of the piece.
+template <typename Fn>
+static void UpdateCBImageLayouts(const layer_data *dev_data, GLOBAL_CB_NODE *pCB, VkImage image,
+                                 const VkImageSubresourceRange &range, Fn fn) {
+    auto &layouts = GetCBImageLayouts(dev_data, pCB, image);
+    layouts.ForEachInterval(range, [&](uint64_t begin, uint64_t end) { layouts.Update(begin, end, fn); });
 }
 
+// Collect the distinct layouts of an image's subresources on the global level. Subresources of an aspect that has
+// been transitioned are reported individually, others are still in the layout the image was created with.
 bool FindLayouts(const layer_data *my_data, VkImage image, std::vector<VkImageLayout> &layouts) {
-    auto sub_data = my_data->imageSubresourceMap.find(image);
-    if (sub_data == my_data->imageSubresourceMap.end())
+    auto image_layouts_it = my_data->imageLayoutMap.find(image);
+    if (image_layouts_it == my_data->imageLayoutMap.end())
         return false;
-    auto img_node = getImageNode(my_data, image);
-    if (!img_node)
-        return false;
-    bool ignoreGlobal = false;
-    // TODO: Make this robust for >1 aspect mask. Now it will just say ignore
-    // potential errors in this case.
-    if (sub_data->second.size() >= (img_node->createInfo.arrayLayers * img_node->createInfo.mipLevels + 1)) {
-        ignoreGlobal = true;
-    }
-    for (auto imgsubpair : sub_data->second) {
-        if (ignoreGlobal && !imgsubpair.hasSubresource)
-            continue;
-        auto img_data = my_data->imageLayoutMap.find(imgsubpair);
-        if (img_data != my_data->imageLayoutMap.end()) {
-            layouts.push_back(img_data->second.layout);
-        }
-    }
-    return true;
-}
-
-// Set the layout on the global level
-void SetLayout(layer_data *my_data, ImageSubresourcePair imgpair, const VkImageLayout &layout) {
-    VkImage &image = imgpair.image;
-    // TODO (mlentine): Maybe set format if new? Not used atm.
-    my_data->imageLayoutMap[imgpair].layout = layout;
-    // TODO (mlentine): Maybe make vector a set?
-    auto subresource = std::find(my_data->imageSubresourceMap[image].begin(), my_data->imageSubresourceMap[image].end(), imgpair);
-    if (subresource == my_data->imageSubresourceMap[image].end()) {
-        my_data->imageSubresourceMap[image].push_back(imgpair);
-    }
-}
-
-// Set the layout on the cmdbuf level
-void SetLayout(GLOBAL_CB_NODE *pCB, ImageSubresourcePair imgpair, const IMAGE_CMD_BUF_LAYOUT_NODE &node) {
-    pCB->imageLayoutMap[imgpair] = node;
-    // TODO (mlentine): Maybe make vector a set?
-    auto subresource =
-        std::find(pCB->imageSubresourceMap[imgpair.image].begin(), pCB->imageSubresourceMap[imgpair.image].end(), imgpair);
-    if (subresource == pCB->imageSubresourceMap[imgpair.image].end()) {
-        pCB->imageSubresourceMap[imgpair.image].push_back(imgpair);
-    }
-}
-
-void SetLayout(GLOBAL_CB_NODE *pCB, ImageSubresourcePair imgpair, const VkImageLayout &layout) {
-    // TODO (mlentine): Maybe make vector a set?
-    if (std::find(pCB->imageSubresourceMap[imgpair.image].begin(), pCB->imageSubresourceMap[imgpair.image].end(), imgpair) !=
-        pCB->imageSubresourceMap[imgpair.image].end()) {
-        pCB->imageLayoutMap[imgpair].layout = layout;
-    } else {
-        // TODO (mlentine): Could be expensive and might need to be removed.
-        assert(imgpair.hasSubresource);
-        IMAGE_CMD_BUF_LAYOUT_NODE node;
-        if (!FindLayout(pCB, imgpair.image, imgpair.subresource, node)) {
-            node.initialLayout = layout;
-        }
-        SetLayout(pCB, imgpair, {node.initialLayout, layout});
+    const auto &image_layouts = image_layouts_it->second;
+    auto add_layout = [&layouts](VkImageLayout layout) {
+        if (std::find(layouts.begin(), layouts.end(), layout) == layouts.end())
+            layouts.push_back(layout);
+    };
+    const VkImageLayout *image_layout = image_layouts.GetImageLayout();
+    if (image_layouts.Empty()) {
+        if (image_layout)
+            add_layout(*image_layout);
+        return true;
     }
-}
-
-template <class OBJECT, class LAYOUT>
-void SetLayout(OBJECT *pObject, ImageSubresourcePair imgpair, const LAYOUT &layout, VkImageAspectFlags aspectMask) {
-    if (imgpair.subresource.aspectMask & aspectMask) {
-        imgpair.subresource.aspectMask = aspectMask;
-        SetLayout(pObject, imgpair, layout);
+    for (uint32_t aspect = 0; aspect < ImageLayoutMap<VkImageLayout>::ASPECT_COUNT; ++aspect) {
+        VkImageSubresourceRange range = {VkImageAspectFlags(1) << aspect, 0, VK_REMAINING_MIP_LEVELS, 0,
+                                         VK_REMAINING_ARRAY_LAYERS};
+        image_layouts.ForEachInterval(range, [&](uint64_t begin, uint64_t end) {
+            bool aspect_used = false;
+            bool has_untracked = false;
+            image_layouts.ForEach(begin, end, [&](uint64_t, uint64_t, const VkImageLayout *layout) {
+                if (layout) {
+                    aspect_used = true;
+                    add_layout(*layout);
+                } else {
+                    has_untracked = true;
+                }
+            });
+            if (aspect_used && has_untracked && image_layout)
+                add_layout(*image_layout);
+        });
     }
-}
-
-template <class OBJECT, class LAYOUT>
-void SetLayout(OBJECT *pObject, VkImage image, VkImageSubresource range, const LAYOUT &layout) {
-    ImageSubresourcePair imgpair = {image, true, range};
-    SetLayout(pObject, imgpair, layout, VK_IMAGE_ASPECT_COLOR_BIT);
-    SetLayout(pObject, imgpair, layout, VK_IMAGE_ASPECT_DEPTH_BIT);
-    SetLayout(pObject, imgpair, layout, VK_IMAGE_ASPECT_STENCIL_BIT);
-    SetLayout(pObject, imgpair, layout, VK_IMAGE_ASPECT_METADATA_BIT);
-}
-
-template <class OBJECT, class LAYOUT> void SetLayout(OBJECT *pObject, VkImage image, const LAYOUT &layout) {
-    ImageSubresourcePair imgpair = {image, false, VkImageSubresource()};
-    SetLayout(pObject, image, imgpair, layout);
+    return true;
 }
 
 void SetLayout(const layer_data *dev_data, GLOBAL_CB_NODE *pCB, VkImageView imageView, const VkImageLayout &layout) {
     auto iv_data = getImageViewData(dev_data, imageView);
     assert(iv_data);
-    const VkImage &image = iv_data->image;
-    const VkImageSubresourceRange &subRange = iv_data->subresourceRange;
-    // TODO: Do not iterate over every possibility - consolidate where possible
-    for (uint32_t j = 0; j < subRange.levelCount; j++) {
-        uint32_t level = subRange.baseMipLevel + j;
-        for (uint32_t k = 0; k < subRange.layerCount; k++) {
-            uint32_t layer = subRange.baseArrayLayer + k;
-            VkImageSubresource sub = {subRange.aspectMask, level, layer};
-            SetLayout(pCB, image, sub, layout);
-        }
-    }
+    UpdateCBImageLayouts(dev_data, pCB, iv_data->image, iv_data->subresourceRange,
+                         [&](uint64_t, uint64_t, const IMAGE_CMD_BUF_LAYOUT_NODE *node) {
+                             return IMAGE_CMD_BUF_LAYOUT_NODE(node ? node->initialLayout : layout, layout);
+                         });
 }
 
 // Validate that given set is valid and that it's not being used by an in-flight CmdBuffer
@@ -3511,13 +4068,16 @@ static GLOBAL_CB_NODE *getCBNode(layer_data const *my_data, const VkCommandBuffe
 // Free all CB Nodes
 // NOTE : Calls to this function should be wrapped in mutex
 static void deleteCommandBuffers(layer_data *my_data) {
-    if (my_data->commandBufferMap.empty()) {
-        return;
-    }
     for (auto ii = my_data->commandBufferMap.begin(); ii != my_data->commandBufferMap.end(); ++ii) {
         delete (*ii).second;
     }
     my_data->commandBufferMap.clear();
+    for (auto &pool : my_data->commandPoolMap) {
+        for (auto node : pool.second.freeNodes) {
+            delete node;
+        }
+        pool.second.freeNodes.clear();
+    }
 }
 
 static bool report_error_no_cb_begin(const layer_data *dev_data, const VkCommandBuffer cb, const char *caller_name) {
@@ -3646,6 +4206,7 @@ static bool addCmd(const layer_data *my_data, GLOBAL_CB_NODE *pCB, const CMD_TYP
 }
 // Reset the command buffer state
 //  Maintain the createInfo and set state to CB_NEW, but clear all other state
+//  Cost is proportional to the state the CB accumulated since its last reset
 static void resetCB(layer_data *dev_data, const VkCommandBuffer cb) {
     GLOBAL_CB_NODE *pCB = dev_data->commandBufferMap[cb];
     if (pCB) {
@@ -3677,29 +4238,29 @@ static void resetCB(layer_data *dev_data, const VkCommandBuffer cb) {
         pCB->activeSubpass = 0;
         pCB->lastSubmittedFence = VK_NULL_HANDLE;
         pCB->lastSubmittedQueue = VK_NULL_HANDLE;
-        pCB->destroyedSets.clear();
-        pCB->updatedSets.clear();
-        pCB->destroyedFramebuffers.clear();
-        pCB->waitedEvents.clear();
+        clearIfUsed(pCB->destroyedSets);
+        clearIfUsed(pCB->updatedSets);
+        clearIfUsed(pCB->destroyedFramebuffers);
+        clearIfUsed(pCB->waitedEvents);
         pCB->semaphores.clear();
         pCB->events.clear();
-        pCB->waitedEventsBeforeQueryReset.clear();
-        pCB->queryToStateMap.clear();
-        pCB->activeQueries.clear();
-        pCB->startedQueries.clear();
-        pCB->imageSubresourceMap.clear();
-        pCB->imageLayoutMap.clear();
-        pCB->eventToStageMap.clear();
-        pCB->drawData.clear();
+        clearIfUsed(pCB->waitedEventsBeforeQueryReset);
+        clearIfUsed(pCB->queryToStateMap);
+        clearIfUsed(pCB->activeQueries);
+        clearIfUsed(pCB->startedQueries);
+        clearIfUsed(pCB->imageLayoutMap);
+        clearIfUsed(pCB->eventToStageMap);
+        clearIfUsed(pCB->drawBuffers);
         pCB->currentDrawData.buffers.clear();
+        pCB->submitResources.clear();
         pCB->primaryCommandBuffer = VK_NULL_HANDLE;
         // Make sure any secondaryCommandBuffers are removed from globalInFlight
         for (auto secondary_cb : pCB->secondaryCommandBuffers) {
             dev_data->globalInFlightCmdBuffers.erase(secondary_cb);
         }
-        pCB->secondaryCommandBuffers.clear();
-        pCB->updateImages.clear();
-        pCB->updateBuffers.clear();
+        clearIfUsed(pCB->secondaryCommandBuffers);
+        clearIfUsed(pCB->updateImages);
+        clearIfUsed(pCB->updateBuffers);
         clear_cmd_buf_and_mem_references(dev_data, pCB);
         pCB->eventUpdates.clear();
         pCB->queryUpdates.clear();
@@ -3710,7 +4271,7 @@ static void resetCB(layer_data *dev_data, const VkCommandBuffer cb) {
             if (fbNode)
                 fbNode->referencingCmdBuffers.erase(pCB->commandBuffer);
         }
-        pCB->framebuffers.clear();
+        clearIfUsed(pCB->framebuffers);
         pCB->activeFramebuffer = VK_NULL_HANDLE;
     }
 }
@@ -3838,11 +4399,13 @@ static bool outsideRenderPass(const layer_data *my_data, GLOBAL_CB_NODE *pCB, co
 static void init_core_validation(layer_data *instance_data, const VkAllocationCallbacks *pAllocator) {
 
     layer_debug_actions(instance_data->report_data, instance_data->logging_callback, pAllocator, "lunarg_core_validation");
+    layer_profile_start(&profiler, "lunarg_core_validation");
 
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkInstance *pInstance) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateInstance");
     VkLayerInstanceCreateInfo *chain_info = get_chain_info(pCreateInfo, VK_LAYER_LINK_INFO);
 
     assert(chain_info->u.pLayerInfo);
@@ -3854,7 +4417,7 @@ CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallba
     // Advance the link info for the next element on the chain
     chain_info->u.pLayerInfo = chain_info->u.pLayerInfo->pNext;
 
-    VkResult result = fpCreateInstance(pCreateInfo, pAllocator, pInstance);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, fpCreateInstance(pCreateInfo, pAllocator, pInstance));
     if (result != VK_SUCCESS)
         return result;
 
@@ -3876,15 +4439,16 @@ CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallba
 
 /* hook DestroyInstance to remove tableInstanceMap entry */
 VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyInstance");
     // TODOSC : Shouldn't need any customization here
     dispatch_key key = get_dispatch_key(instance);
     // TBD: Need any locking this early, in case this function is called at the
     // same time by more than one thread?
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
     VkLayerInstanceDispatchTable *pTable = my_data->instance_dispatch_table;
-    pTable->DestroyInstance(instance, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, pTable->DestroyInstance(instance, pAllocator));
 
-    std::lock_guard<std::mutex> lock(global_lock);
+    std::lock_guard<rw_lock> lock(global_lock);
     // Clean up logging callback, if any
     while (my_data->logging_callback.size() > 0) {
         VkDebugReportCallbackEXT callback = my_data->logging_callback.back();
@@ -3893,6 +4457,7 @@ VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocati
     }
 
     layer_debug_report_destroy_instance(my_data->report_data);
+    layer_profile_stop(&profiler);
     delete my_data->instance_dispatch_table;
     layer_data_map.erase(key);
 }
@@ -3920,6 +4485,7 @@ static void createDeviceRegisterExtensions(const VkDeviceCreateInfo *pCreateInfo
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice gpu, const VkDeviceCreateInfo *pCreateInfo,
                                             const VkAllocationCallbacks *pAllocator, VkDevice *pDevice) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDevice");
     layer_data *my_instance_data = get_my_data_ptr(get_dispatch_key(gpu), layer_data_map);
     VkLayerDeviceCreateInfo *chain_info = get_chain_info(pCreateInfo, VK_LAYER_LINK_INFO);
 
@@ -3934,12 +4500,12 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice gpu, const VkDevice
     // Advance the link info for the next element on the chain
     chain_info->u.pLayerInfo = chain_info->u.pLayerInfo->pNext;
 
-    VkResult result = fpCreateDevice(gpu, pCreateInfo, pAllocator, pDevice);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, fpCreateDevice(gpu, pCreateInfo, pAllocator, pDevice));
     if (result != VK_SUCCESS) {
         return result;
     }
 
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     layer_data *my_device_data = get_my_data_ptr(get_dispatch_key(*pDevice), layer_data_map);
 
     // Setup device dispatch table
@@ -3950,12 +4516,14 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice gpu, const VkDevice
     my_device_data->report_data = layer_debug_report_create_device(my_instance_data->report_data, *pDevice);
     createDeviceRegisterExtensions(pCreateInfo, *pDevice);
     // Get physical device limits for this device
-    my_instance_data->instance_dispatch_table->GetPhysicalDeviceProperties(gpu, &(my_device_data->phys_dev_properties.properties));
+    LAYER_PROFILE_DISPATCH(profiler, my_instance_data->instance_dispatch_table->GetPhysicalDeviceProperties(
+        gpu, &(my_device_data->phys_dev_properties.properties)));
     uint32_t count;
-    my_instance_data->instance_dispatch_table->GetPhysicalDeviceQueueFamilyProperties(gpu, &count, nullptr);
+    LAYER_PROFILE_DISPATCH(profiler, my_instance_data->instance_dispatch_table->GetPhysicalDeviceQueueFamilyProperties(gpu, &count,
+                                                                                                                       nullptr));
     my_device_data->phys_dev_properties.queue_family_properties.resize(count);
-    my_instance_data->instance_dispatch_table->GetPhysicalDeviceQueueFamilyProperties(
-        gpu, &count, &my_device_data->phys_dev_properties.queue_family_properties[0]);
+    LAYER_PROFILE_DISPATCH(profiler, my_instance_data->instance_dispatch_table->GetPhysicalDeviceQueueFamilyProperties(
+        gpu, &count, &my_device_data->phys_dev_properties.queue_family_properties[0]));
     // TODO: device limits should make sure these are compatible
     if (pCreateInfo->pEnabledFeatures) {
         my_device_data->phys_dev_properties.features = *pCreateInfo->pEnabledFeatures;
@@ -3963,7 +4531,11 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice gpu, const VkDevice
         memset(&my_device_data->phys_dev_properties.features, 0, sizeof(VkPhysicalDeviceFeatures));
     }
     // Store physical device mem limits into device layer_data struct
-    my_instance_data->instance_dispatch_table->GetPhysicalDeviceMemoryProperties(gpu, &my_device_data->phys_dev_mem_props);
+    LAYER_PROFILE_DISPATCH(profiler, my_instance_data->instance_dispatch_table->GetPhysicalDeviceMemoryProperties(
+        gpu, &my_device_data->phys_dev_mem_props));
+    my_device_data->guardPageShadows = !strcmp(getLayerOption("lunarg_core_validation.noncoherent_memory_shadow"), "guard_pages");
+    my_device_data->submitOnlyValidation = !strcmp(getLayerOption("lunarg_core_validation.validation_mode"), "submit_only");
+    my_device_data->enabledChecks = getEnabledChecks(my_device_data->report_data, *pDevice);
     lock.unlock();
 
     ValidateLayerOrdering(*pCreateInfo);
@@ -3974,11 +4546,12 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice gpu, const VkDevice
 // prototype
 static void deleteRenderPasses(layer_data *);
 VKAPI_ATTR void VKAPI_CALL DestroyDevice(VkDevice device, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDevice");
     // TODOSC : Shouldn't need any customization here
     dispatch_key key = get_dispatch_key(device);
     layer_data *dev_data = get_my_data_ptr(key, layer_data_map);
     // Free all the memory
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     deletePipelines(dev_data);
     deleteRenderPasses(dev_data);
     deleteCommandBuffers(dev_data);
@@ -3992,12 +4565,13 @@ VKAPI_ATTR void VKAPI_CALL DestroyDevice(VkDevice device, const VkAllocationCall
     dev_data->descriptorSetLayoutMap.clear();
     dev_data->imageViewMap.clear();
     dev_data->imageMap.clear();
-    dev_data->imageSubresourceMap.clear();
     dev_data->imageLayoutMap.clear();
     dev_data->bufferViewMap.clear();
     dev_data->bufferMap.clear();
     // Queues persist until device is destroyed
     dev_data->queueMap.clear();
+    delete dev_data->pipelineWorkers;
+    dev_data->pipelineWorkers = nullptr;
     lock.unlock();
 #if MTMERGESOURCE
     bool skipCall = false;
@@ -4032,10 +4606,10 @@ VKAPI_ATTR void VKAPI_CALL DestroyDevice(VkDevice device, const VkAllocationCall
 #endif
     VkLayerDispatchTable *pDisp = dev_data->device_dispatch_table;
     if (!skipCall) {
-        pDisp->DestroyDevice(device, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, pDisp->DestroyDevice(device, pAllocator));
     }
 #else
-    dev_data->device_dispatch_table->DestroyDevice(device, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DestroyDevice(device, pAllocator));
 #endif
     delete dev_data->device_dispatch_table;
     layer_data_map.erase(key);
@@ -4048,71 +4622,91 @@ static const VkExtensionProperties instance_extensions[] = {{VK_EXT_DEBUG_REPORT
 // as the global IMAGE layout
 static bool ValidateCmdBufImageLayouts(layer_data *dev_data, GLOBAL_CB_NODE *pCB) {
     bool skip_call = false;
-    for (auto cb_image_data : pCB->imageLayoutMap) {
-        VkImageLayout imageLayout;
-        if (!FindLayout(dev_data, cb_image_data.first, imageLayout)) {
+    for (auto const &cb_image_data : pCB->imageLayoutMap) {
+        VkImage image = cb_image_data.first;
+        auto image_layouts_it = dev_data->imageLayoutMap.find(image);
+        if (image_layouts_it == dev_data->imageLayoutMap.end() || !image_layouts_it->second.GetImageLayout() ||
+            image_layouts_it->second.MipLevels() != cb_image_data.second.MipLevels() ||
+            image_layouts_it->second.ArrayLayers() != cb_image_data.second.ArrayLayers()) {
             skip_call |=
                 log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT, 0,
                         __LINE__, DRAWSTATE_INVALID_IMAGE_LAYOUT, "DS", "Cannot submit cmd buffer using deleted image 0x%" PRIx64 ".",
-                        reinterpret_cast<const uint64_t &>(cb_image_data.first));
-        } else {
-            if (cb_image_data.second.initialLayout == VK_IMAGE_LAYOUT_UNDEFINED) {
-                // TODO: Set memory invalid which is in mem_tracker currently
-            } else if (imageLayout != cb_image_data.second.initialLayout) {
-                if (cb_image_data.first.hasSubresource) {
+                        reinterpret_cast<uint64_t &>(image));
+            continue;
+        }
+        auto &image_layouts = image_layouts_it->second;
+        const VkImageLayout image_layout = *image_layouts.GetImageLayout();
+        cb_image_data.second.ForEachRun([&](uint64_t begin, uint64_t end, const IMAGE_CMD_BUF_LAYOUT_NODE &cb_node) {
+            image_layouts.Update(begin, end, [&](uint64_t piece_begin, uint64_t, const VkImageLayout *layout) {
+                VkImageLayout imageLayout = layout ? *layout : image_layout;
+                if (cb_node.initialLayout == VK_IMAGE_LAYOUT_UNDEFINED) {
+                    // TODO: Set memory invalid which is in mem_tracker currently
+                } else if (imageLayout != cb_node.initialLayout) {
+                    VkImageSubresource sub = image_layouts.Subresource(piece_begin);
                     skip_call |= log_msg(
                         dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT,
                         reinterpret_cast<uint64_t &>(pCB->commandBuffer), __LINE__, DRAWSTATE_INVALID_IMAGE_LAYOUT, "DS",
                         "Cannot submit cmd buffer using image (0x%" PRIx64 ") [sub-resource: aspectMask 0x%X array layer %u, mip level %u], "
                         "with layout %s when first use is %s.",
-                        reinterpret_cast<const uint64_t &>(cb_image_data.first.image), cb_image_data.first.subresource.aspectMask,
-                                cb_image_data.first.subresource.arrayLayer,
-                                cb_image_data.first.subresource.mipLevel, string_VkImageLayout(imageLayout),
-                        string_VkImageLayout(cb_image_data.second.initialLayout));
-                } else {
-                    skip_call |= log_msg(
-                        dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT,
-                        reinterpret_cast<uint64_t &>(pCB->commandBuffer), __LINE__, DRAWSTATE_INVALID_IMAGE_LAYOUT, "DS",
-                        "Cannot submit cmd buffer using image (0x%" PRIx64 ") with layout %s when "
-                        "first use is %s.",
-                        reinterpret_cast<const uint64_t &>(cb_image_data.first.image), string_VkImageLayout(imageLayout),
-                        string_VkImageLayout(cb_image_data.second.initialLayout));
+                        reinterpret_cast<uint64_t &>(image), sub.aspectMask, sub.arrayLayer, sub.mipLevel,
+                        string_VkImageLayout(imageLayout), string_VkImageLayout(cb_node.initialLayout));
                 }
-            }
-            SetLayout(dev_data, cb_image_data.first, cb_image_data.second.layout);
-        }
+                return cb_node.layout;
+            });
+        });
     }
     return skip_call;
 }
 
+// Collapse the resources referenced while recording pCB into its submit list, dropping duplicates. Descriptor sets are
+// kept as handles since a set may be freed, or its pool reset, before the cmd buffer is submitted.
+static void buildSubmitResources(GLOBAL_CB_NODE *pCB) {
+    auto &resources = pCB->submitResources;
+    resources.clear();
+    resources.buffers.assign(pCB->drawBuffers.begin(), pCB->drawBuffers.end());
+    std::unordered_set<VkDescriptorSet> sets;
+    for (uint32_t i = 0; i < VK_PIPELINE_BIND_POINT_RANGE_SIZE; ++i) {
+        for (auto set : pCB->lastBound[i].uniqueBoundSets) {
+            sets.insert(set->GetSet());
+        }
+    }
+    resources.descriptorSets.assign(sets.begin(), sets.end());
+    std::unordered_set<VkEvent> events(pCB->events.begin(), pCB->events.end());
+    resources.events.assign(events.begin(), events.end());
+}
+
+// Semaphores come from the VkSubmitInfo rather than from recording, so they join the submit list at each submit
+static void setSubmitSemaphores(GLOBAL_CB_NODE *pCB, const vector<VkSemaphore> &semaphores) {
+    pCB->semaphores = semaphores;
+    std::unordered_set<VkSemaphore> unique_semaphores(semaphores.begin(), semaphores.end());
+    pCB->submitResources.semaphores.assign(unique_semaphores.begin(), unique_semaphores.end());
+}
+
 // Track which resources are in-flight by atomically incrementing their "in_use" count
 static bool validateAndIncrementResources(layer_data *my_data, GLOBAL_CB_NODE *pCB) {
     bool skip_call = false;
-    for (auto drawDataElement : pCB->drawData) {
-        for (auto buffer : drawDataElement.buffers) {
-            auto buffer_node = getBufferNode(my_data, buffer);
-            if (!buffer_node) {
-                skip_call |= log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT,
-                                     (uint64_t)(buffer), __LINE__, DRAWSTATE_INVALID_BUFFER, "DS",
-                                     "Cannot submit cmd buffer using deleted buffer 0x%" PRIx64 ".", (uint64_t)(buffer));
-            } else {
-                buffer_node->in_use.fetch_add(1);
-            }
+    for (auto buffer : pCB->submitResources.buffers) {
+        auto buffer_node = getBufferNode(my_data, buffer);
+        if (!buffer_node) {
+            skip_call |= log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT,
+                                 (uint64_t)(buffer), __LINE__, DRAWSTATE_INVALID_BUFFER, "DS",
+                                 "Cannot submit cmd buffer using deleted buffer 0x%" PRIx64 ".", (uint64_t)(buffer));
+        } else {
+            buffer_node->in_use.fetch_add(1);
         }
     }
-    for (uint32_t i = 0; i < VK_PIPELINE_BIND_POINT_RANGE_SIZE; ++i) {
-        for (auto set : pCB->lastBound[i].uniqueBoundSets) {
-            if (!my_data->setMap.count(set->GetSet())) {
-                skip_call |=
-                    log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_SET_EXT,
-                            (uint64_t)(set), __LINE__, DRAWSTATE_INVALID_DESCRIPTOR_SET, "DS",
-                            "Cannot submit cmd buffer using deleted descriptor set 0x%" PRIx64 ".", (uint64_t)(set));
-            } else {
-                set->in_use.fetch_add(1);
-            }
+    for (auto set : pCB->submitResources.descriptorSets) {
+        auto set_node = my_data->setMap.find(set);
+        if (set_node == my_data->setMap.end()) {
+            skip_call |= log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_SET_EXT,
+                                 reinterpret_cast<uint64_t &>(set), __LINE__, DRAWSTATE_INVALID_DESCRIPTOR_SET, "DS",
+                                 "Cannot submit cmd buffer using deleted descriptor set 0x%" PRIx64 ".",
+                                 reinterpret_cast<uint64_t &>(set));
+        } else {
+            set_node->second->in_use.fetch_add(1);
         }
     }
-    for (auto semaphore : pCB->semaphores) {
+    for (auto semaphore : pCB->submitResources.semaphores) {
         auto semaphoreNode = my_data->semaphoreMap.find(semaphore);
         if (semaphoreNode == my_data->semaphoreMap.end()) {
             skip_call |=
@@ -4123,7 +4717,7 @@ static bool validateAndIncrementResources(layer_data *my_data, GLOBAL_CB_NODE *p
             semaphoreNode->second.in_use.fetch_add(1);
         }
     }
-    for (auto event : pCB->events) {
+    for (auto event : pCB->submitResources.events) {
         auto eventNode = my_data->eventMap.find(event);
         if (eventNode == my_data->eventMap.end()) {
             skip_call |=
@@ -4147,14 +4741,28 @@ static bool cleanInFlightCmdBuffer(layer_data *my_data, VkCommandBuffer cmdBuffe
     bool skip_call = false;
     GLOBAL_CB_NODE *pCB = getCBNode(my_data, cmdBuffer);
     if (pCB) {
-        for (auto queryEventsPair : pCB->waitedEventsBeforeQueryReset) {
-            for (auto event : queryEventsPair.second) {
-                if (my_data->eventMap[event].needsSignaled) {
+        // Only the latest reset of a query determines the events guarding it. Walking the resets from the back, a query
+        // seen for the first time is at its latest reset.
+        QuerySet reset_queries;
+        auto &resets = pCB->waitedEventsBeforeQueryReset;
+        for (auto reset = resets.rbegin(); reset != resets.rend(); ++reset) {
+            uint32_t pool_size = getQueryPoolSize(my_data, reset->pool);
+            auto &seen = reset_queries[reset->pool];
+            std::vector<VkEvent> unsignaled;
+            for (auto event : reset->waitedEvents) {
+                if (my_data->eventMap[event].needsSignaled)
+                    unsignaled.push_back(event);
+            }
+            for (uint32_t index = reset->firstQuery; index - reset->firstQuery < reset->queryCount && index < pool_size; ++index) {
+                if (seen.Test(index))
+                    continue;
+                seen.Set(index, 1, true, pool_size);
+                for (auto event : unsignaled) {
                     skip_call |= log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT,
                                          VK_DEBUG_REPORT_OBJECT_TYPE_QUERY_POOL_EXT, 0, 0, DRAWSTATE_INVALID_QUERY, "DS",
                                          "Cannot get query results on queryPool 0x%" PRIx64
                                          " with index %d which was guarded by unsignaled event 0x%" PRIx64 ".",
-                                         (uint64_t)(queryEventsPair.first.pool), queryEventsPair.first.index, (uint64_t)(event));
+                                         (uint64_t)(reset->pool), index, (uint64_t)(event));
                 }
             }
         }
@@ -4173,26 +4781,25 @@ static inline void removeInFlightCmdBuffer(layer_data *dev_data, VkCommandBuffer
 
 static void decrementResources(layer_data *my_data, VkCommandBuffer cmdBuffer) {
     GLOBAL_CB_NODE *pCB = getCBNode(my_data, cmdBuffer);
-    for (auto drawDataElement : pCB->drawData) {
-        for (auto buffer : drawDataElement.buffers) {
-            auto buffer_node = getBufferNode(my_data, buffer);
-            if (buffer_node) {
-                buffer_node->in_use.fetch_sub(1);
-            }
+    for (auto buffer : pCB->submitResources.buffers) {
+        auto buffer_node = getBufferNode(my_data, buffer);
+        if (buffer_node) {
+            buffer_node->in_use.fetch_sub(1);
         }
     }
-    for (uint32_t i = 0; i < VK_PIPELINE_BIND_POINT_RANGE_SIZE; ++i) {
-        for (auto set : pCB->lastBound[i].uniqueBoundSets) {
-            set->in_use.fetch_sub(1);
+    for (auto set : pCB->submitResources.descriptorSets) {
+        auto set_node = my_data->setMap.find(set);
+        if (set_node != my_data->setMap.end()) {
+            set_node->second->in_use.fetch_sub(1);
         }
     }
-    for (auto semaphore : pCB->semaphores) {
+    for (auto semaphore : pCB->submitResources.semaphores) {
         auto semaphoreNode = my_data->semaphoreMap.find(semaphore);
         if (semaphoreNode != my_data->semaphoreMap.end()) {
             semaphoreNode->second.in_use.fetch_sub(1);
         }
     }
-    for (auto event : pCB->events) {
+    for (auto event : pCB->submitResources.events) {
         auto eventNode = my_data->eventMap.find(event);
         if (eventNode != my_data->eventMap.end()) {
             eventNode->second.in_use.fetch_sub(1);
@@ -4204,8 +4811,11 @@ static void decrementResources(layer_data *my_data, VkCommandBuffer cmdBuffer) {
             eventNode->second.write_in_use--;
         }
     }
-    for (auto queryStatePair : pCB->queryToStateMap) {
-        my_data->queryToStateMap[queryStatePair.first] = queryStatePair.second;
+    for (auto const &pool_state : pCB->queryToStateMap) {
+        auto pool_node = getQueryPoolNode(my_data, pool_state.first);
+        if (pool_node) {
+            pool_node->queryStates.Merge(pool_state.second);
+        }
     }
     for (auto eventStagePair : pCB->eventToStageMap) {
         my_data->eventMap[eventStagePair.first].stageMask = eventStagePair.second;
@@ -4309,9 +4919,7 @@ static void updateTrackedCommandBuffers(layer_data *dev_data, VkQueue queue, VkQ
     for (auto eventStagePair : other_queue_data->second.eventToStageMap) {
         queue_data->second.eventToStageMap[eventStagePair.first] = eventStagePair.second;
     }
-    for (auto queryStatePair : other_queue_data->second.queryToStateMap) {
-        queue_data->second.queryToStateMap[queryStatePair.first] = queryStatePair.second;
-    }
+    MergeQueryStates(queue_data->second.queryToStateMap, other_queue_data->second.queryToStateMap);
 }
 
 // This is the core function for tracking command buffers. There are two primary ways command
@@ -4501,19 +5109,128 @@ static bool validatePrimaryCommandBufferState(layer_data *dev_data, GLOBAL_CB_NO
             }
         }
     }
-    skipCall |= validateCommandBufferState(dev_data, pCB);
-    // If USAGE_SIMULTANEOUS_USE_BIT not set then CB cannot already be executing
-    // on device
-    skipCall |= validateCommandBufferSimultaneousUse(dev_data, pCB);
-    return skipCall;
+    skipCall |= validateCommandBufferState(dev_data, pCB);
+    // If USAGE_SIMULTANEOUS_USE_BIT not set then CB cannot already be executing
+    // on device
+    skipCall |= validateCommandBufferSimultaneousUse(dev_data, pCB);
+    return skipCall;
+}
+
+static void setEventStageMask(layer_data *dev_data, VkQueue queue, GLOBAL_CB_NODE *pCB, VkEvent event,
+                              VkPipelineStageFlags stageMask) {
+    pCB->eventToStageMap[event] = stageMask;
+    auto queue_data = dev_data->queueMap.find(queue);
+    if (queue_data != dev_data->queueMap.end()) {
+        queue_data->second.eventToStageMap[event] = stageMask;
+    }
+}
+
+static bool validateEventStageMask(layer_data *dev_data, VkQueue queue, GLOBAL_CB_NODE *pCB, uint32_t eventCount,
+                                   size_t firstEventIndex, VkPipelineStageFlags sourceStageMask) {
+    bool skip_call = false;
+    VkPipelineStageFlags stageMask = 0;
+    for (uint32_t i = 0; i < eventCount; ++i) {
+        auto event = pCB->events[firstEventIndex + i];
+        auto queue_data = dev_data->queueMap.find(queue);
+        if (queue_data == dev_data->queueMap.end())
+            return false;
+        auto event_data = queue_data->second.eventToStageMap.find(event);
+        if (event_data != queue_data->second.eventToStageMap.end()) {
+            stageMask |= event_data->second;
+        } else {
+            auto global_event_data = dev_data->eventMap.find(event);
+            if (global_event_data == dev_data->eventMap.end()) {
+                skip_call |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_EVENT_EXT,
+                                     reinterpret_cast<const uint64_t &>(event), __LINE__, DRAWSTATE_INVALID_EVENT, "DS",
+                                     "Event 0x%" PRIx64 " cannot be waited on if it has never been set.",
+                                     reinterpret_cast<const uint64_t &>(event));
+            } else {
+                stageMask |= global_event_data->second.stageMask;
+            }
+        }
+    }
+    // TODO: Need to validate that host_bit is only set if set event is called
+    // but set event can be called at any time.
+    if (sourceStageMask != stageMask && sourceStageMask != (stageMask | VK_PIPELINE_STAGE_HOST_BIT)) {
+        skip_call |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0, __LINE__,
+                             DRAWSTATE_INVALID_EVENT, "DS", "Submitting cmdbuffer with call to VkCmdWaitEvents "
+                                                            "using srcStageMask 0x%x which must be the bitwise "
+                                                            "OR of the stageMask parameters used in calls to "
+                                                            "vkCmdSetEvent and VK_PIPELINE_STAGE_HOST_BIT if "
+                                                            "used with vkSetEvent but instead is 0x%x.",
+                             sourceStageMask, stageMask);
+    }
+    return skip_call;
+}
+
+static void setQueryState(layer_data *dev_data, VkQueue queue, GLOBAL_CB_NODE *pCB, VkQueryPool queryPool, uint32_t firstQuery,
+                          uint32_t queryCount, bool value) {
+    uint32_t pool_size = getQueryPoolSize(dev_data, queryPool);
+    pCB->queryToStateMap[queryPool].Set(firstQuery, queryCount, value, pool_size);
+    auto queue_data = dev_data->queueMap.find(queue);
+    if (queue_data != dev_data->queueMap.end()) {
+        queue_data->second.queryToStateMap[queryPool].Set(firstQuery, queryCount, value, pool_size);
+    }
+}
+
+static bool validateQuery(layer_data *dev_data, VkQueue queue, VkQueryPool queryPool, uint32_t queryCount, uint32_t firstQuery) {
+    bool skip_call = false;
+    auto queue_data = dev_data->queueMap.find(queue);
+    if (queue_data == dev_data->queueMap.end())
+        return false;
+    auto queue_pool_data = queue_data->second.queryToStateMap.find(queryPool);
+    const QUERY_POOL_STATE *queue_states =
+        queue_pool_data != queue_data->second.queryToStateMap.end() ? &queue_pool_data->second : nullptr;
+    auto pool_node = getQueryPoolNode(dev_data, queryPool);
+    for (uint32_t i = 0; i < queryCount; i++) {
+        bool available = false;
+        if (!queue_states || !queue_states->Find(firstQuery + i, &available)) {
+            if (!pool_node || !pool_node->queryStates.Find(firstQuery + i, &available)) {
+                available = false;
+            }
+        }
+        if (!available) {
+            skip_call |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0, __LINE__,
+                                 DRAWSTATE_INVALID_QUERY, "DS",
+                                 "Requesting a copy from query to buffer with invalid query: queryPool 0x%" PRIx64 ", index %d",
+                                 reinterpret_cast<uint64_t &>(queryPool), firstQuery + i);
+        }
+    }
+    return skip_call;
+}
+
+static bool runDeferredEventOps(layer_data *dev_data, VkQueue queue, GLOBAL_CB_NODE *pCB) {
+    bool skip_call = false;
+    for (auto const &op : pCB->eventUpdates) {
+        if (op.type == DEFERRED_EVENT_OP::SET) {
+            setEventStageMask(dev_data, queue, pCB, op.event, op.stageMask);
+        } else {
+            skip_call |= validateEventStageMask(dev_data, queue, pCB, op.eventCount, op.firstEventIndex, op.stageMask);
+        }
+    }
+    return skip_call;
+}
+
+static bool runDeferredQueryOps(layer_data *dev_data, VkQueue queue, GLOBAL_CB_NODE *pCB) {
+    bool skip_call = false;
+    for (auto const &op : pCB->queryUpdates) {
+        if (op.type == DEFERRED_QUERY_OP::VALIDATE) {
+            skip_call |= validateQuery(dev_data, queue, op.queryPool, op.queryCount, op.firstQuery);
+        } else {
+            setQueryState(dev_data, queue, pCB, op.queryPool, op.firstQuery, op.queryCount,
+                          op.type == DEFERRED_QUERY_OP::SET_AVAILABLE);
+        }
+    }
+    return skip_call;
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 QueueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo *pSubmits, VkFence fence) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkQueueSubmit");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(queue), layer_data_map);
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     // First verify that fence is not in use
     if (fence != VK_NULL_HANDLE) {
         if ((submitCount != 0) && dev_data->fenceMap[fence].in_use.load()) {
@@ -4580,38 +5297,35 @@ QueueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo *pSubmits, V
             auto pCBNode = getCBNode(dev_data, submit->pCommandBuffers[i]);
             skipCall |= ValidateCmdBufImageLayouts(dev_data, pCBNode);
             if (pCBNode) {
-                pCBNode->semaphores = semaphoreList;
+                setSubmitSemaphores(pCBNode, semaphoreList);
                 pCBNode->submitCount++; // increment submit count
                 pCBNode->lastSubmittedFence = fence;
                 pCBNode->lastSubmittedQueue = queue;
                 skipCall |= validatePrimaryCommandBufferState(dev_data, pCBNode);
                 // Call submit-time functions to validate/update state
-                for (auto &function : pCBNode->validate_functions) {
-                    skipCall |= function();
-                }
-                for (auto &function : pCBNode->eventUpdates) {
-                    skipCall |= function(queue);
-                }
-                for (auto &function : pCBNode->queryUpdates) {
-                    skipCall |= function(queue);
-                }
+                skipCall |= runDeferredMemoryOps(dev_data, pCBNode);
+                skipCall |= runDeferredEventOps(dev_data, queue, pCBNode);
+                skipCall |= runDeferredQueryOps(dev_data, queue, pCBNode);
             }
         }
     }
     markCommandBuffersInFlight(dev_data, queue, submitCount, pSubmits, fence);
     lock.unlock();
     if (!skipCall)
-        result = dev_data->device_dispatch_table->QueueSubmit(queue, submitCount, pSubmits, fence);
+        result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->QueueSubmit(queue, submitCount, pSubmits,
+                                                                                               fence));
 
     return result;
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL AllocateMemory(VkDevice device, const VkMemoryAllocateInfo *pAllocateInfo,
                                               const VkAllocationCallbacks *pAllocator, VkDeviceMemory *pMemory) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkAllocateMemory");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = my_data->device_dispatch_table->AllocateMemory(device, pAllocateInfo, pAllocator, pMemory);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->AllocateMemory(device, pAllocateInfo,
+                                                                                                      pAllocator, pMemory));
     // TODO : Track allocations and overall size here
-    std::lock_guard<std::mutex> lock(global_lock);
+    std::lock_guard<rw_lock> lock(global_lock);
     add_mem_obj_info(my_data, device, *pMemory, pAllocateInfo);
     print_mem_list(my_data);
     return result;
@@ -4619,6 +5333,7 @@ VKAPI_ATTR VkResult VKAPI_CALL AllocateMemory(VkDevice device, const VkMemoryAll
 
 VKAPI_ATTR void VKAPI_CALL
 FreeMemory(VkDevice device, VkDeviceMemory mem, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkFreeMemory");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
     // From spec : A memory object is freed by calling vkFreeMemory() when it is no longer needed.
@@ -4628,12 +5343,13 @@ FreeMemory(VkDevice device, VkDeviceMemory mem, const VkAllocationCallbacks *pAl
     // buffers (on host or device) for anything other than destroying those objects will result in
     // undefined behavior.
 
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
+    my_data->descriptorResourceVersion++;
     freeMemObjInfo(my_data, device, mem, false);
     print_mem_list(my_data);
     printCBList(my_data);
     lock.unlock();
-    my_data->device_dispatch_table->FreeMemory(device, mem, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->FreeMemory(device, mem, pAllocator));
 }
 
 static bool validateMemRange(layer_data *my_data, VkDeviceMemory mem, VkDeviceSize offset, VkDeviceSize size) {
@@ -4700,6 +5416,7 @@ static bool deleteMemRanges(layer_data *my_data, VkDeviceMemory mem) {
             free(mem_info->pData);
             mem_info->pData = 0;
         }
+        releaseGuardedShadow(mem_info);
     }
     return skipCall;
 }
@@ -4718,6 +5435,19 @@ static void initializeAndTrackMemory(layer_data *dev_data, VkDeviceMemory mem, V
                 size = mem_info->allocInfo.allocationSize;
             }
             size_t convSize = (size_t)(size);
+#if !defined(_WIN32)
+            if (dev_data->guardPageShadows) {
+                size_t alignment = dev_data->phys_dev_properties.properties.limits.minMemoryMapAlignment;
+                VkDeviceSize mapped_size = mem_info->memRange.size == VK_WHOLE_SIZE
+                                               ? mem_info->allocInfo.allocationSize - mem_info->memRange.offset
+                                               : mem_info->memRange.size;
+                mem_info->pGuardedShadow = guarded_shadow::create(*ppData, (size_t)mapped_size, alignment);
+                if (mem_info->pGuardedShadow) {
+                    *ppData = mem_info->pGuardedShadow->data();
+                    return;
+                }
+            }
+#endif
             mem_info->pData = malloc(2 * convSize);
             memset(mem_info->pData, NoncoherentMemoryFillValue, 2 * convSize);
             *ppData = static_cast<char *>(mem_info->pData) + (convSize / 2);
@@ -4755,10 +5485,11 @@ static inline bool verifyWaitFenceState(VkDevice device, VkFence fence, const ch
 
 VKAPI_ATTR VkResult VKAPI_CALL
 WaitForFences(VkDevice device, uint32_t fenceCount, const VkFence *pFences, VkBool32 waitAll, uint64_t timeout) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkWaitForFences");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     bool skip_call = false;
     // Verify fence status of submitted fences
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     for (uint32_t i = 0; i < fenceCount; i++) {
         skip_call |= verifyWaitFenceState(device, pFences[i], "vkWaitForFences");
     }
@@ -4766,7 +5497,8 @@ WaitForFences(VkDevice device, uint32_t fenceCount, const VkFence *pFences, VkBo
     if (skip_call)
         return VK_ERROR_VALIDATION_FAILED_EXT;
 
-    VkResult result = dev_data->device_dispatch_table->WaitForFences(device, fenceCount, pFences, waitAll, timeout);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->WaitForFences(device, fenceCount, pFences,
+                                                                                                      waitAll, timeout));
 
     if (result == VK_SUCCESS) {
         lock.lock();
@@ -4785,17 +5517,18 @@ WaitForFences(VkDevice device, uint32_t fenceCount, const VkFence *pFences, VkBo
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL GetFenceStatus(VkDevice device, VkFence fence) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetFenceStatus");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     bool skipCall = false;
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     skipCall = verifyWaitFenceState(device, fence, "vkGetFenceStatus");
     lock.unlock();
 
     if (skipCall)
         return result;
 
-    result = dev_data->device_dispatch_table->GetFenceStatus(device, fence);
+    result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->GetFenceStatus(device, fence));
     bool skip_call = false;
     lock.lock();
     if (result == VK_SUCCESS) {
@@ -4809,9 +5542,10 @@ VKAPI_ATTR VkResult VKAPI_CALL GetFenceStatus(VkDevice device, VkFence fence) {
 
 VKAPI_ATTR void VKAPI_CALL GetDeviceQueue(VkDevice device, uint32_t queueFamilyIndex, uint32_t queueIndex,
                                                             VkQueue *pQueue) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetDeviceQueue");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    dev_data->device_dispatch_table->GetDeviceQueue(device, queueFamilyIndex, queueIndex, pQueue);
-    std::lock_guard<std::mutex> lock(global_lock);
+    LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->GetDeviceQueue(device, queueFamilyIndex, queueIndex, pQueue));
+    std::lock_guard<rw_lock> lock(global_lock);
 
     // Add queue to tracking set only if it is new
     auto result = dev_data->queues.emplace(*pQueue);
@@ -4822,19 +5556,21 @@ VKAPI_ATTR void VKAPI_CALL GetDeviceQueue(VkDevice device, uint32_t queueFamilyI
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL QueueWaitIdle(VkQueue queue) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkQueueWaitIdle");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(queue), layer_data_map);
     bool skip_call = false;
     skip_call |= decrementResources(dev_data, queue);
     if (skip_call)
         return VK_ERROR_VALIDATION_FAILED_EXT;
-    VkResult result = dev_data->device_dispatch_table->QueueWaitIdle(queue);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->QueueWaitIdle(queue));
     return result;
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL DeviceWaitIdle(VkDevice device) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDeviceWaitIdle");
     bool skip_call = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     for (auto queue : dev_data->queues) {
         skip_call |= decrementResources(dev_data, queue);
     }
@@ -4842,14 +5578,15 @@ VKAPI_ATTR VkResult VKAPI_CALL DeviceWaitIdle(VkDevice device) {
     lock.unlock();
     if (skip_call)
         return VK_ERROR_VALIDATION_FAILED_EXT;
-    VkResult result = dev_data->device_dispatch_table->DeviceWaitIdle(device);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DeviceWaitIdle(device));
     return result;
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyFence(VkDevice device, VkFence fence, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyFence");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     bool skipCall = false;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     auto fence_pair = dev_data->fenceMap.find(fence);
     if (fence_pair != dev_data->fenceMap.end()) {
         if (fence_pair->second.in_use.load()) {
@@ -4862,14 +5599,15 @@ VKAPI_ATTR void VKAPI_CALL DestroyFence(VkDevice device, VkFence fence, const Vk
     lock.unlock();
 
     if (!skipCall)
-        dev_data->device_dispatch_table->DestroyFence(device, fence, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DestroyFence(device, fence, pAllocator));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroySemaphore(VkDevice device, VkSemaphore semaphore, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroySemaphore");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    dev_data->device_dispatch_table->DestroySemaphore(device, semaphore, pAllocator);
-    std::lock_guard<std::mutex> lock(global_lock);
+    LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DestroySemaphore(device, semaphore, pAllocator));
+    std::lock_guard<rw_lock> lock(global_lock);
     auto item = dev_data->semaphoreMap.find(semaphore);
     if (item != dev_data->semaphoreMap.end()) {
         if (item->second.in_use.load()) {
@@ -4883,9 +5621,10 @@ DestroySemaphore(VkDevice device, VkSemaphore semaphore, const VkAllocationCallb
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyEvent(VkDevice device, VkEvent event, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyEvent");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     bool skip_call = false;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     auto event_data = dev_data->eventMap.find(event);
     if (event_data != dev_data->eventMap.end()) {
         if (event_data->second.in_use.load()) {
@@ -4898,61 +5637,90 @@ VKAPI_ATTR void VKAPI_CALL DestroyEvent(VkDevice device, VkEvent event, const Vk
     }
     lock.unlock();
     if (!skip_call)
-        dev_data->device_dispatch_table->DestroyEvent(device, event, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DestroyEvent(device, event, pAllocator));
     // TODO : Clean up any internal data structures using this obj.
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyQueryPool(VkDevice device, VkQueryPool queryPool, const VkAllocationCallbacks *pAllocator) {
-    get_my_data_ptr(get_dispatch_key(device), layer_data_map)
-        ->device_dispatch_table->DestroyQueryPool(device, queryPool, pAllocator);
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyQueryPool");
+    LAYER_PROFILE_DISPATCH(profiler, get_my_data_ptr(
+        get_dispatch_key(device), layer_data_map)->device_dispatch_table->DestroyQueryPool(device, queryPool, pAllocator));
     // TODO : Clean up any internal data structures using this obj.
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL GetQueryPoolResults(VkDevice device, VkQueryPool queryPool, uint32_t firstQuery,
                                                    uint32_t queryCount, size_t dataSize, void *pData, VkDeviceSize stride,
                                                    VkQueryResultFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetQueryPoolResults");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    unordered_map<QueryObject, vector<VkCommandBuffer>> queriesInFlight;
-    std::unique_lock<std::mutex> lock(global_lock);
+    // Query states of the in flight cmd buffers that use queryPool
+    vector<const QUERY_POOL_STATE *> inFlightStates;
+    vector<GLOBAL_CB_NODE *> inFlightCBs;
+    std::unique_lock<rw_lock> lock(global_lock);
     for (auto cmdBuffer : dev_data->globalInFlightCmdBuffers) {
         auto pCB = getCBNode(dev_data, cmdBuffer);
-        for (auto queryStatePair : pCB->queryToStateMap) {
-            queriesInFlight[queryStatePair.first].push_back(cmdBuffer);
+        auto pool_state = pCB->queryToStateMap.find(queryPool);
+        if (pool_state != pCB->queryToStateMap.end()) {
+            inFlightStates.push_back(&pool_state->second);
+            inFlightCBs.push_back(pCB);
         }
     }
-    bool skip_call = false;
+    auto pool_node = getQueryPoolNode(dev_data, queryPool);
+    bool skip_call = validateQueryRange(dev_data, queryPool, firstQuery, queryCount, "vkGetQueryPoolResults()");
+    if (skip_call)
+        return VK_ERROR_VALIDATION_FAILED_EXT;
+    // Latest reset of each requested query, per in flight cmd buffer and indexed from firstQuery. Built on first use from
+    // a single pass over the cmd buffer's resets.
+    vector<vector<const QUERY_RESET_EVENTS *>> latestResets(inFlightCBs.size());
+    auto getLatestReset = [&](size_t cb, uint32_t index) -> const QUERY_RESET_EVENTS * {
+        auto &latest = latestResets[cb];
+        if (latest.empty()) {
+            latest.resize(queryCount, nullptr);
+            for (auto const &reset : inFlightCBs[cb]->waitedEventsBeforeQueryReset) {
+                if (reset.pool != queryPool)
+                    continue;
+                uint64_t begin = std::max<uint64_t>(reset.firstQuery, firstQuery);
+                uint64_t end = std::min<uint64_t>(uint64_t(reset.firstQuery) + reset.queryCount, uint64_t(firstQuery) + queryCount);
+                for (uint64_t query = begin; query < end; ++query) {
+                    latest[static_cast<size_t>(query - firstQuery)] = &reset;
+                }
+            }
+        }
+        return latest[index - firstQuery];
+    };
+    vector<size_t> queryCBs;
     for (uint32_t i = 0; i < queryCount; ++i) {
-        QueryObject query = {queryPool, firstQuery + i};
-        auto queryElement = queriesInFlight.find(query);
-        auto queryToStateElement = dev_data->queryToStateMap.find(query);
-        if (queryToStateElement != dev_data->queryToStateMap.end()) {
+        uint32_t index = firstQuery + i;
+        bool make_available = false;
+        queryCBs.clear();
+        for (size_t cb = 0; cb < inFlightStates.size(); ++cb) {
+            bool cb_available = false;
+            if (inFlightStates[cb]->Find(index, &cb_available)) {
+                queryCBs.push_back(cb);
+                make_available |= cb_available;
+            }
+        }
+        bool available = false;
+        if (pool_node && pool_node->queryStates.Find(index, &available)) {
             // Available and in flight
-            if (queryElement != queriesInFlight.end() && queryToStateElement != dev_data->queryToStateMap.end() &&
-                queryToStateElement->second) {
-                for (auto cmdBuffer : queryElement->second) {
-                    auto pCB = getCBNode(dev_data, cmdBuffer);
-                    auto queryEventElement = pCB->waitedEventsBeforeQueryReset.find(query);
-                    if (queryEventElement == pCB->waitedEventsBeforeQueryReset.end()) {
+            if (!queryCBs.empty() && available) {
+                for (auto cb : queryCBs) {
+                    const QUERY_RESET_EVENTS *queryEventElement = getLatestReset(cb, index);
+                    if (!queryEventElement) {
                         skip_call |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT,
                                              VK_DEBUG_REPORT_OBJECT_TYPE_QUERY_POOL_EXT, 0, __LINE__, DRAWSTATE_INVALID_QUERY, "DS",
                                              "Cannot get query results on queryPool 0x%" PRIx64 " with index %d which is in flight.",
                                              (uint64_t)(queryPool), firstQuery + i);
                     } else {
-                        for (auto event : queryEventElement->second) {
+                        for (auto event : queryEventElement->waitedEvents) {
                             dev_data->eventMap[event].needsSignaled = true;
                         }
                     }
                 }
                 // Unavailable and in flight
-            } else if (queryElement != queriesInFlight.end() && queryToStateElement != dev_data->queryToStateMap.end() &&
-                       !queryToStateElement->second) {
+            } else if (!queryCBs.empty() && !available) {
                 // TODO : Can there be the same query in use by multiple command buffers in flight?
-                bool make_available = false;
-                for (auto cmdBuffer : queryElement->second) {
-                    auto pCB = getCBNode(dev_data, cmdBuffer);
-                    make_available |= pCB->queryToStateMap[query];
-                }
                 if (!(((flags & VK_QUERY_RESULT_PARTIAL_BIT) || (flags & VK_QUERY_RESULT_WAIT_BIT)) && make_available)) {
                     skip_call |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT,
                                          VK_DEBUG_REPORT_OBJECT_TYPE_QUERY_POOL_EXT, 0, __LINE__, DRAWSTATE_INVALID_QUERY, "DS",
@@ -4960,26 +5728,26 @@ VKAPI_ATTR VkResult VKAPI_CALL GetQueryPoolResults(VkDevice device, VkQueryPool
                                          (uint64_t)(queryPool), firstQuery + i);
                 }
                 // Unavailable
-            } else if (queryToStateElement != dev_data->queryToStateMap.end() && !queryToStateElement->second) {
+            } else if (!available) {
                 skip_call |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT,
                                      VK_DEBUG_REPORT_OBJECT_TYPE_QUERY_POOL_EXT, 0, __LINE__, DRAWSTATE_INVALID_QUERY, "DS",
                                      "Cannot get query results on queryPool 0x%" PRIx64 " with index %d which is unavailable.",
                                      (uint64_t)(queryPool), firstQuery + i);
-                // Unitialized
-            } else if (queryToStateElement == dev_data->queryToStateMap.end()) {
-                skip_call |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT,
-                                     VK_DEBUG_REPORT_OBJECT_TYPE_QUERY_POOL_EXT, 0, __LINE__, DRAWSTATE_INVALID_QUERY, "DS",
-                                     "Cannot get query results on queryPool 0x%" PRIx64
-                                     " with index %d as data has not been collected for this index.",
-                                     (uint64_t)(queryPool), firstQuery + i);
             }
+            // Unitialized
+        } else {
+            skip_call |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_QUERY_POOL_EXT,
+                                 0, __LINE__, DRAWSTATE_INVALID_QUERY, "DS",
+                                 "Cannot get query results on queryPool 0x%" PRIx64
+                                 " with index %d as data has not been collected for this index.",
+                                 (uint64_t)(queryPool), firstQuery + i);
         }
     }
     lock.unlock();
     if (skip_call)
         return VK_ERROR_VALIDATION_FAILED_EXT;
-    return dev_data->device_dispatch_table->GetQueryPoolResults(device, queryPool, firstQuery, queryCount, dataSize, pData, stride,
-                                                                flags);
+    return LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->GetQueryPoolResults(
+        device, queryPool, firstQuery, queryCount, dataSize, pData, stride, flags));
 }
 
 static bool validateIdleBuffer(const layer_data *my_data, VkBuffer buffer) {
@@ -5012,50 +5780,44 @@ static bool print_memory_range_error(layer_data *dev_data, const uint64_t object
     }
 }
 
-static bool validate_memory_range(layer_data *dev_data, const vector<MEMORY_RANGE> &ranges, const MEMORY_RANGE &new_range,
+static bool validate_memory_range(layer_data *dev_data, const MemoryRangeIndex &ranges, const MEMORY_RANGE &new_range,
                                   VkDebugReportObjectTypeEXT object_type) {
     bool skip_call = false;
-
-    for (auto range : ranges) {
-        if ((range.end & ~(dev_data->phys_dev_properties.properties.limits.bufferImageGranularity - 1)) <
-            (new_range.start & ~(dev_data->phys_dev_properties.properties.limits.bufferImageGranularity - 1)))
-            continue;
-        if ((range.start & ~(dev_data->phys_dev_properties.properties.limits.bufferImageGranularity - 1)) >
-            (new_range.end & ~(dev_data->phys_dev_properties.properties.limits.bufferImageGranularity - 1)))
-            continue;
+    if (new_range.end < new_range.start)
+        return skip_call;
+    // Two ranges alias if they touch the same bufferImageGranularity-sized page, so widen the query to the pages
+    // covered by new_range and compare against the raw bound ranges.
+    VkDeviceSize granularity = std::max<VkDeviceSize>(dev_data->phys_dev_properties.properties.limits.bufferImageGranularity, 1);
+    VkDeviceSize query_start = new_range.start & ~(granularity - 1);
+    VkDeviceSize query_end = new_range.end | (granularity - 1);
+    ranges.for_each_overlap(query_start, query_end, [&](const MEMORY_RANGE &range) {
         skip_call |= print_memory_range_error(dev_data, new_range.handle, range.handle, object_type);
-    }
+    });
     return skip_call;
 }
 
+// Record the range an object is bound to. A zero size binds no bytes; it is returned as an empty range (end < start),
+// which is neither stored nor overlaps anything, rather than letting end wrap around.
 static MEMORY_RANGE insert_memory_ranges(uint64_t handle, VkDeviceMemory mem, VkDeviceSize memoryOffset,
-                                         VkMemoryRequirements memRequirements, vector<MEMORY_RANGE> &ranges) {
+                                         VkMemoryRequirements memRequirements, MemoryRangeIndex &ranges) {
     MEMORY_RANGE range;
     range.handle = handle;
     range.memory = mem;
-    range.start = memoryOffset;
-    range.end = memoryOffset + memRequirements.size - 1;
-    ranges.push_back(range);
+    range.start = memRequirements.size ? memoryOffset : 1;
+    range.end = memRequirements.size ? memoryOffset + memRequirements.size - 1 : 0;
+    ranges.insert(range);
     return range;
 }
 
-static void remove_memory_ranges(uint64_t handle, VkDeviceMemory mem, vector<MEMORY_RANGE> &ranges) {
-    for (uint32_t item = 0; item < ranges.size(); item++) {
-        if ((ranges[item].handle == handle) && (ranges[item].memory == mem)) {
-            ranges.erase(ranges.begin() + item);
-            break;
-        }
-    }
-}
-
 VKAPI_ATTR void VKAPI_CALL DestroyBuffer(VkDevice device, VkBuffer buffer,
                                          const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyBuffer");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     bool skipCall = false;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     if (!validateIdleBuffer(dev_data, buffer) && !skipCall) {
         lock.unlock();
-        dev_data->device_dispatch_table->DestroyBuffer(device, buffer, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DestroyBuffer(device, buffer, pAllocator));
         lock.lock();
     }
     // Clean up memory binding and range information for buffer
@@ -5063,18 +5825,20 @@ VKAPI_ATTR void VKAPI_CALL DestroyBuffer(VkDevice device, VkBuffer buffer,
     if (buff_it != dev_data->bufferMap.end()) {
         auto mem_info = getMemObjInfo(dev_data, buff_it->second.get()->mem);
         if (mem_info) {
-            remove_memory_ranges(reinterpret_cast<uint64_t &>(buffer), buff_it->second.get()->mem, mem_info->bufferRanges);
+            mem_info->bufferRanges.erase(reinterpret_cast<uint64_t &>(buffer));
         }
         clear_object_binding(dev_data, reinterpret_cast<uint64_t &>(buffer), VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT);
         dev_data->bufferMap.erase(buff_it);
+        dev_data->descriptorResourceVersion++;
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyBufferView(VkDevice device, VkBufferView bufferView, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyBufferView");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    dev_data->device_dispatch_table->DestroyBufferView(device, bufferView, pAllocator);
-    std::lock_guard<std::mutex> lock(global_lock);
+    LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DestroyBufferView(device, bufferView, pAllocator));
+    std::lock_guard<rw_lock> lock(global_lock);
     auto item = dev_data->bufferViewMap.find(bufferView);
     if (item != dev_data->bufferViewMap.end()) {
         dev_data->bufferViewMap.erase(item);
@@ -5082,39 +5846,35 @@ DestroyBufferView(VkDevice device, VkBufferView bufferView, const VkAllocationCa
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyImage");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     bool skipCall = false;
     if (!skipCall) {
-        dev_data->device_dispatch_table->DestroyImage(device, image, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DestroyImage(device, image, pAllocator));
     }
 
-    std::lock_guard<std::mutex> lock(global_lock);
+    std::lock_guard<rw_lock> lock(global_lock);
     const auto &imageEntry = dev_data->imageMap.find(image);
     if (imageEntry != dev_data->imageMap.end()) {
         // Clean up memory mapping, bindings and range references for image
         auto mem_info = getMemObjInfo(dev_data, imageEntry->second.get()->mem);
         if (mem_info) {
-            remove_memory_ranges(reinterpret_cast<uint64_t &>(image), imageEntry->second.get()->mem, mem_info->imageRanges);
+            mem_info->imageRanges.erase(reinterpret_cast<uint64_t &>(image));
             clear_object_binding(dev_data, reinterpret_cast<uint64_t &>(image), VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT);
             mem_info->image = VK_NULL_HANDLE;
         }
         // Remove image from imageMap
         dev_data->imageMap.erase(imageEntry);
     }
-    const auto& subEntry = dev_data->imageSubresourceMap.find(image);
-    if (subEntry != dev_data->imageSubresourceMap.end()) {
-        for (const auto& pair : subEntry->second) {
-            dev_data->imageLayoutMap.erase(pair);
-        }
-        dev_data->imageSubresourceMap.erase(subEntry);
-    }
+    dev_data->imageLayoutMap.erase(image);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 BindBufferMemory(VkDevice device, VkBuffer buffer, VkDeviceMemory mem, VkDeviceSize memoryOffset) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkBindBufferMemory");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     // Track objects tied to memory
     uint64_t buffer_handle = (uint64_t)(buffer);
     bool skipCall =
@@ -5122,15 +5882,18 @@ BindBufferMemory(VkDevice device, VkBuffer buffer, VkDeviceMemory mem, VkDeviceS
     auto buffer_node = getBufferNode(dev_data, buffer);
     if (buffer_node) {
         buffer_node->mem = mem;
+        dev_data->descriptorResourceVersion++;
         VkMemoryRequirements memRequirements;
-        dev_data->device_dispatch_table->GetBufferMemoryRequirements(device, buffer, &memRequirements);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->GetBufferMemoryRequirements(device, buffer,
+                                                                                                      &memRequirements));
 
         // Track and validate bound memory range information
         auto mem_info = getMemObjInfo(dev_data, mem);
         if (mem_info) {
             const MEMORY_RANGE range =
                 insert_memory_ranges(buffer_handle, mem, memoryOffset, memRequirements, mem_info->bufferRanges);
-            skipCall |= validate_memory_range(dev_data, mem_info->imageRanges, range, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT);
+            if (checkEnabled(dev_data, CHECK_MEMORY_ALIASING))
+                skipCall |= validate_memory_range(dev_data, mem_info->imageRanges, range, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT);
         }
 
         // Validate memory requirements alignment
@@ -5181,75 +5944,92 @@ BindBufferMemory(VkDevice device, VkBuffer buffer, VkDeviceMemory mem, VkDeviceS
     print_mem_list(dev_data);
     lock.unlock();
     if (!skipCall) {
-        result = dev_data->device_dispatch_table->BindBufferMemory(device, buffer, mem, memoryOffset);
+        result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->BindBufferMemory(device, buffer, mem,
+                                                                                                    memoryOffset));
     }
     return result;
 }
 
 VKAPI_ATTR void VKAPI_CALL
 GetBufferMemoryRequirements(VkDevice device, VkBuffer buffer, VkMemoryRequirements *pMemoryRequirements) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetBufferMemoryRequirements");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     // TODO : What to track here?
     //   Could potentially save returned mem requirements and validate values passed into BindBufferMemory
-    my_data->device_dispatch_table->GetBufferMemoryRequirements(device, buffer, pMemoryRequirements);
+    LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->GetBufferMemoryRequirements(device, buffer,
+                                                                                                 pMemoryRequirements));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 GetImageMemoryRequirements(VkDevice device, VkImage image, VkMemoryRequirements *pMemoryRequirements) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetImageMemoryRequirements");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     // TODO : What to track here?
     //   Could potentially save returned mem requirements and validate values passed into BindImageMemory
-    my_data->device_dispatch_table->GetImageMemoryRequirements(device, image, pMemoryRequirements);
+    LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->GetImageMemoryRequirements(device, image,
+                                                                                                pMemoryRequirements));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyImageView(VkDevice device, VkImageView imageView, const VkAllocationCallbacks *pAllocator) {
-    get_my_data_ptr(get_dispatch_key(device), layer_data_map)
-        ->device_dispatch_table->DestroyImageView(device, imageView, pAllocator);
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyImageView");
+    LAYER_PROFILE_DISPATCH(profiler, get_my_data_ptr(
+        get_dispatch_key(device), layer_data_map)->device_dispatch_table->DestroyImageView(device, imageView, pAllocator));
     // TODO : Clean up any internal data structures using this obj.
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyShaderModule(VkDevice device, VkShaderModule shaderModule, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyShaderModule");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     my_data->shaderModuleMap.erase(shaderModule);
     lock.unlock();
 
-    my_data->device_dispatch_table->DestroyShaderModule(device, shaderModule, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->DestroyShaderModule(device, shaderModule, pAllocator));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyPipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks *pAllocator) {
-    get_my_data_ptr(get_dispatch_key(device), layer_data_map)->device_dispatch_table->DestroyPipeline(device, pipeline, pAllocator);
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyPipeline");
+    LAYER_PROFILE_DISPATCH(profiler, get_my_data_ptr(
+        get_dispatch_key(device), layer_data_map)->device_dispatch_table->DestroyPipeline(device, pipeline, pAllocator));
     // TODO : Clean up any internal data structures using this obj.
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyPipelineLayout(VkDevice device, VkPipelineLayout pipelineLayout, const VkAllocationCallbacks *pAllocator) {
-    get_my_data_ptr(get_dispatch_key(device), layer_data_map)
-        ->device_dispatch_table->DestroyPipelineLayout(device, pipelineLayout, pAllocator);
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyPipelineLayout");
+    LAYER_PROFILE_DISPATCH(profiler, get_my_data_ptr(get_dispatch_key(device),
+                                                     layer_data_map)->device_dispatch_table->DestroyPipelineLayout(device,
+                                                     pipelineLayout, pAllocator));
     // TODO : Clean up any internal data structures using this obj.
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroySampler(VkDevice device, VkSampler sampler, const VkAllocationCallbacks *pAllocator) {
-    get_my_data_ptr(get_dispatch_key(device), layer_data_map)->device_dispatch_table->DestroySampler(device, sampler, pAllocator);
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroySampler");
+    LAYER_PROFILE_DISPATCH(profiler, get_my_data_ptr(
+        get_dispatch_key(device), layer_data_map)->device_dispatch_table->DestroySampler(device, sampler, pAllocator));
     // TODO : Clean up any internal data structures using this obj.
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyDescriptorSetLayout(VkDevice device, VkDescriptorSetLayout descriptorSetLayout, const VkAllocationCallbacks *pAllocator) {
-    get_my_data_ptr(get_dispatch_key(device), layer_data_map)
-        ->device_dispatch_table->DestroyDescriptorSetLayout(device, descriptorSetLayout, pAllocator);
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDescriptorSetLayout");
+    LAYER_PROFILE_DISPATCH(profiler, get_my_data_ptr(get_dispatch_key(device),
+                                                     layer_data_map)->device_dispatch_table->DestroyDescriptorSetLayout(device,
+                                                     descriptorSetLayout, pAllocator));
     // TODO : Clean up any internal data structures using this obj.
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool, const VkAllocationCallbacks *pAllocator) {
-    get_my_data_ptr(get_dispatch_key(device), layer_data_map)
-        ->device_dispatch_table->DestroyDescriptorPool(device, descriptorPool, pAllocator);
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDescriptorPool");
+    LAYER_PROFILE_DISPATCH(profiler, get_my_data_ptr(get_dispatch_key(device),
+                                                     layer_data_map)->device_dispatch_table->DestroyDescriptorPool(device,
+                                                     descriptorPool, pAllocator));
     // TODO : Clean up any internal data structures using this obj.
 }
 // Verify cmdBuffer in given cb_node is not in global in-flight set, and return skip_call result
@@ -5289,40 +6069,45 @@ static bool checkAndClearCommandBuffersInFlight(layer_data *dev_data, const VkCo
 
 VKAPI_ATTR void VKAPI_CALL
 FreeCommandBuffers(VkDevice device, VkCommandPool commandPool, uint32_t commandBufferCount, const VkCommandBuffer *pCommandBuffers) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkFreeCommandBuffers");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
     bool skip_call = false;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
+    auto &pool_info = dev_data->commandPoolMap[commandPool];
     for (uint32_t i = 0; i < commandBufferCount; i++) {
         auto cb_pair = dev_data->commandBufferMap.find(pCommandBuffers[i]);
         skip_call |= checkAndClearCommandBufferInFlight(dev_data, cb_pair->second, "free");
-        // Delete CB information structure, and remove from commandBufferMap
+        // Return CB information structure to its pool, and remove from commandBufferMap
         if (cb_pair != dev_data->commandBufferMap.end()) {
-            // reset prior to delete for data clean-up
+            // reset prior to reuse for data clean-up
             resetCB(dev_data, (*cb_pair).second->commandBuffer);
-            delete (*cb_pair).second;
+            pool_info.freeNodes.push_back((*cb_pair).second);
             dev_data->commandBufferMap.erase(cb_pair);
         }
 
         // Remove commandBuffer reference from commandPoolMap
-        dev_data->commandPoolMap[commandPool].commandBuffers.remove(pCommandBuffers[i]);
+        pool_info.commandBuffers.erase(pCommandBuffers[i]);
     }
     printCBList(dev_data);
     lock.unlock();
 
     if (!skip_call)
-        dev_data->device_dispatch_table->FreeCommandBuffers(device, commandPool, commandBufferCount, pCommandBuffers);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->FreeCommandBuffers(device, commandPool,
+                                                                                             commandBufferCount, pCommandBuffers));
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateCommandPool(VkDevice device, const VkCommandPoolCreateInfo *pCreateInfo,
                                                  const VkAllocationCallbacks *pAllocator,
                                                  VkCommandPool *pCommandPool) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateCommandPool");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
-    VkResult result = dev_data->device_dispatch_table->CreateCommandPool(device, pCreateInfo, pAllocator, pCommandPool);
+    VkResult result = LAYER_PROFILE_DISPATCH(
+        profiler, dev_data->device_dispatch_table->CreateCommandPool(device, pCreateInfo, pAllocator, pCommandPool));
 
     if (VK_SUCCESS == result) {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         dev_data->commandPoolMap[*pCommandPool].createFlags = pCreateInfo->flags;
         dev_data->commandPoolMap[*pCommandPool].queueFamilyIndex = pCreateInfo->queueFamilyIndex;
     }
@@ -5331,12 +6116,17 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateCommandPool(VkDevice device, const VkComman
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateQueryPool(VkDevice device, const VkQueryPoolCreateInfo *pCreateInfo,
                                                const VkAllocationCallbacks *pAllocator, VkQueryPool *pQueryPool) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateQueryPool");
 
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->CreateQueryPool(device, pCreateInfo, pAllocator, pQueryPool);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CreateQueryPool(device, pCreateInfo,
+                                                                                                        pAllocator, pQueryPool));
     if (result == VK_SUCCESS) {
-        std::lock_guard<std::mutex> lock(global_lock);
-        dev_data->queryPoolMap[*pQueryPool].createInfo = *pCreateInfo;
+        std::lock_guard<rw_lock> lock(global_lock);
+        QUERY_POOL_NODE &pool_node = dev_data->queryPoolMap[*pQueryPool];
+        pool_node.createInfo = *pCreateInfo;
+        pool_node.queryStates.known.Reserve(pCreateInfo->queryCount, pCreateInfo->queryCount);
+        pool_node.queryStates.available.Reserve(pCreateInfo->queryCount, pCreateInfo->queryCount);
     }
     return result;
 }
@@ -5344,9 +6134,10 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateQueryPool(VkDevice device, const VkQueryPoo
 // Destroy commandPool along with all of the commandBuffers allocated from that pool
 VKAPI_ATTR void VKAPI_CALL
 DestroyCommandPool(VkDevice device, VkCommandPool commandPool, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyCommandPool");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     bool skipCall = false;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     // Verify that command buffers in pool are complete (not in-flight)
     VkBool32 result = checkAndClearCommandBuffersInFlight(dev_data, commandPool, "destroy command pool with");
     // Must remove cmdpool from cmdpoolmap, after removing all cmdbuffers in its list from the commandPoolMap
@@ -5358,6 +6149,9 @@ DestroyCommandPool(VkDevice device, VkCommandPool commandPool, const VkAllocatio
             delete del_cb->second;                  // delete CB info structure
             dev_data->commandBufferMap.erase(del_cb); // Remove this command buffer
         }
+        for (auto node : pool_it->second.freeNodes) {
+            delete node;
+        }
     }
     dev_data->commandPoolMap.erase(commandPool);
 
@@ -5367,11 +6161,12 @@ DestroyCommandPool(VkDevice device, VkCommandPool commandPool, const VkAllocatio
         return;
 
     if (!skipCall)
-        dev_data->device_dispatch_table->DestroyCommandPool(device, commandPool, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DestroyCommandPool(device, commandPool, pAllocator));
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 ResetCommandPool(VkDevice device, VkCommandPool commandPool, VkCommandPoolResetFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkResetCommandPool");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     bool skipCall = false;
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
@@ -5380,25 +6175,34 @@ ResetCommandPool(VkDevice device, VkCommandPool commandPool, VkCommandPoolResetF
         return VK_ERROR_VALIDATION_FAILED_EXT;
 
     if (!skipCall)
-        result = dev_data->device_dispatch_table->ResetCommandPool(device, commandPool, flags);
+        result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->ResetCommandPool(device, commandPool, flags));
 
     // Reset all of the CBs allocated from this pool
     if (VK_SUCCESS == result) {
-        std::lock_guard<std::mutex> lock(global_lock);
-        auto it = dev_data->commandPoolMap[commandPool].commandBuffers.begin();
-        while (it != dev_data->commandPoolMap[commandPool].commandBuffers.end()) {
+        std::lock_guard<rw_lock> lock(global_lock);
+        auto &pool_info = dev_data->commandPoolMap[commandPool];
+        auto it = pool_info.commandBuffers.begin();
+        while (it != pool_info.commandBuffers.end()) {
             resetCB(dev_data, (*it));
             ++it;
         }
+        // The app asked for the pool's memory back, so drop the nodes kept for reuse along with their storage
+        if (flags & VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT) {
+            for (auto node : pool_info.freeNodes) {
+                delete node;
+            }
+            vector<GLOBAL_CB_NODE *>().swap(pool_info.freeNodes);
+        }
     }
     return result;
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL ResetFences(VkDevice device, uint32_t fenceCount, const VkFence *pFences) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkResetFences");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     for (uint32_t i = 0; i < fenceCount; ++i) {
         auto fence_item = dev_data->fenceMap.find(pFences[i]);
         if (fence_item != dev_data->fenceMap.end()) {
@@ -5415,14 +6219,15 @@ VKAPI_ATTR VkResult VKAPI_CALL ResetFences(VkDevice device, uint32_t fenceCount,
     }
     lock.unlock();
     if (!skipCall)
-        result = dev_data->device_dispatch_table->ResetFences(device, fenceCount, pFences);
+        result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->ResetFences(device, fenceCount, pFences));
     return result;
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyFramebuffer(VkDevice device, VkFramebuffer framebuffer, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyFramebuffer");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     auto fbNode = dev_data->frameBufferMap.find(framebuffer);
     if (fbNode != dev_data->frameBufferMap.end()) {
         for (auto cb : fbNode->second.referencingCmdBuffers) {
@@ -5437,25 +6242,28 @@ DestroyFramebuffer(VkDevice device, VkFramebuffer framebuffer, const VkAllocatio
         dev_data->frameBufferMap.erase(fbNode);
     }
     lock.unlock();
-    dev_data->device_dispatch_table->DestroyFramebuffer(device, framebuffer, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DestroyFramebuffer(device, framebuffer, pAllocator));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyRenderPass(VkDevice device, VkRenderPass renderPass, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyRenderPass");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    dev_data->device_dispatch_table->DestroyRenderPass(device, renderPass, pAllocator);
-    std::lock_guard<std::mutex> lock(global_lock);
+    LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DestroyRenderPass(device, renderPass, pAllocator));
+    std::lock_guard<rw_lock> lock(global_lock);
     dev_data->renderPassMap.erase(renderPass);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateBuffer(VkDevice device, const VkBufferCreateInfo *pCreateInfo,
                                             const VkAllocationCallbacks *pAllocator, VkBuffer *pBuffer) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateBuffer");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
-    VkResult result = dev_data->device_dispatch_table->CreateBuffer(device, pCreateInfo, pAllocator, pBuffer);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CreateBuffer(device, pCreateInfo,
+                                                                                                     pAllocator, pBuffer));
 
     if (VK_SUCCESS == result) {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         // TODO : This doesn't create deep copy of pQueueFamilyIndices so need to fix that if/when we want that data to be valid
         dev_data->bufferMap.insert(std::make_pair(*pBuffer, unique_ptr<BUFFER_NODE>(new BUFFER_NODE(pCreateInfo))));
     }
@@ -5464,10 +6272,12 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateBuffer(VkDevice device, const VkBufferCreat
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateBufferView(VkDevice device, const VkBufferViewCreateInfo *pCreateInfo,
                                                 const VkAllocationCallbacks *pAllocator, VkBufferView *pView) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateBufferView");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->CreateBufferView(device, pCreateInfo, pAllocator, pView);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CreateBufferView(device, pCreateInfo,
+                                                                                                         pAllocator, pView));
     if (VK_SUCCESS == result) {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         dev_data->bufferViewMap[*pView] = unique_ptr<VkBufferViewCreateInfo>(new VkBufferViewCreateInfo(*pCreateInfo));
         // In order to create a valid buffer view, the buffer must have been created with at least one of the
         // following flags:  UNIFORM_TEXEL_BUFFER_BIT or STORAGE_TEXEL_BUFFER_BIT
@@ -5480,19 +6290,18 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateBufferView(VkDevice device, const VkBufferV
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateImage(VkDevice device, const VkImageCreateInfo *pCreateInfo,
                                            const VkAllocationCallbacks *pAllocator, VkImage *pImage) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateImage");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
-    VkResult result = dev_data->device_dispatch_table->CreateImage(device, pCreateInfo, pAllocator, pImage);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CreateImage(device, pCreateInfo, pAllocator,
+                                                                                                    pImage));
 
     if (VK_SUCCESS == result) {
-        std::lock_guard<std::mutex> lock(global_lock);
-        IMAGE_LAYOUT_NODE image_node;
-        image_node.layout = pCreateInfo->initialLayout;
-        image_node.format = pCreateInfo->format;
+        std::lock_guard<rw_lock> lock(global_lock);
         dev_data->imageMap.insert(std::make_pair(*pImage, unique_ptr<IMAGE_NODE>(new IMAGE_NODE(pCreateInfo))));
-        ImageSubresourcePair subpair = {*pImage, false, VkImageSubresource()};
-        dev_data->imageSubresourceMap[*pImage].push_back(subpair);
-        dev_data->imageLayoutMap[subpair] = image_node;
+        ImageLayoutMap<VkImageLayout> image_layouts(pCreateInfo->mipLevels, pCreateInfo->arrayLayers);
+        image_layouts.SetImageLayout(pCreateInfo->initialLayout);
+        dev_data->imageLayoutMap[*pImage] = image_layouts;
     }
     return result;
 }
@@ -5516,33 +6325,15 @@ static void ResolveRemainingLevelsLayers(layer_data *dev_data, VkImageSubresourc
     }
 }
 
-// Return the correct layer/level counts if the caller used the special
-// values VK_REMAINING_MIP_LEVELS or VK_REMAINING_ARRAY_LAYERS.
-static void ResolveRemainingLevelsLayers(layer_data *dev_data, uint32_t *levels, uint32_t *layers, VkImageSubresourceRange range,
-                                         VkImage image) {
-    /* expects global_lock to be held by caller */
-
-    *levels = range.levelCount;
-    *layers = range.layerCount;
-    auto image_node = getImageNode(dev_data, image);
-    if (image_node) {
-        if (range.levelCount == VK_REMAINING_MIP_LEVELS) {
-            *levels = image_node->createInfo.mipLevels - range.baseMipLevel;
-        }
-        if (range.layerCount == VK_REMAINING_ARRAY_LAYERS) {
-            *layers = image_node->createInfo.arrayLayers - range.baseArrayLayer;
-        }
-    }
-}
-
 VKAPI_ATTR VkResult VKAPI_CALL CreateImageView(VkDevice device, const VkImageViewCreateInfo *pCreateInfo,
                                                const VkAllocationCallbacks *pAllocator, VkImageView *pView) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateImageView");
     bool skipCall = false;
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     {
         // Validate that img has correct usage flags set
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         skipCall |= validate_image_usage_flags(dev_data, pCreateInfo->image,
                 VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT |
                 VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
@@ -5550,11 +6341,12 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateImageView(VkDevice device, const VkImageVie
     }
 
     if (!skipCall) {
-        result = dev_data->device_dispatch_table->CreateImageView(device, pCreateInfo, pAllocator, pView);
+        result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CreateImageView(device, pCreateInfo, pAllocator,
+                                                                                                   pView));
     }
 
     if (VK_SUCCESS == result) {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         dev_data->imageViewMap[*pView] = unique_ptr<VkImageViewCreateInfo>(new VkImageViewCreateInfo(*pCreateInfo));
         ResolveRemainingLevelsLayers(dev_data, &dev_data->imageViewMap[*pView].get()->subresourceRange, pCreateInfo->image);
     }
@@ -5564,10 +6356,12 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateImageView(VkDevice device, const VkImageVie
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateFence(VkDevice device, const VkFenceCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkFence *pFence) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateFence");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->CreateFence(device, pCreateInfo, pAllocator, pFence);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CreateFence(device, pCreateInfo, pAllocator,
+                                                                                                    pFence));
     if (VK_SUCCESS == result) {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         auto &fence_node = dev_data->fenceMap[*pFence];
         fence_node.createInfo = *pCreateInfo;
         fence_node.needsSignaled = true;
@@ -5583,28 +6377,35 @@ CreateFence(VkDevice device, const VkFenceCreateInfo *pCreateInfo, const VkAlloc
 // TODO handle pipeline caches
 VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineCache(VkDevice device, const VkPipelineCacheCreateInfo *pCreateInfo,
                                                    const VkAllocationCallbacks *pAllocator, VkPipelineCache *pPipelineCache) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreatePipelineCache");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->CreatePipelineCache(device, pCreateInfo, pAllocator, pPipelineCache);
+    VkResult result = LAYER_PROFILE_DISPATCH(
+        profiler, dev_data->device_dispatch_table->CreatePipelineCache(device, pCreateInfo, pAllocator, pPipelineCache));
     return result;
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyPipelineCache(VkDevice device, VkPipelineCache pipelineCache, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyPipelineCache");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    dev_data->device_dispatch_table->DestroyPipelineCache(device, pipelineCache, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DestroyPipelineCache(device, pipelineCache, pAllocator));
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 GetPipelineCacheData(VkDevice device, VkPipelineCache pipelineCache, size_t *pDataSize, void *pData) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPipelineCacheData");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->GetPipelineCacheData(device, pipelineCache, pDataSize, pData);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->GetPipelineCacheData(device, pipelineCache,
+                                                                                                             pDataSize, pData));
     return result;
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 MergePipelineCaches(VkDevice device, VkPipelineCache dstCache, uint32_t srcCacheCount, const VkPipelineCache *pSrcCaches) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkMergePipelineCaches");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->MergePipelineCaches(device, dstCache, srcCacheCount, pSrcCaches);
+    VkResult result = LAYER_PROFILE_DISPATCH(
+        profiler, dev_data->device_dispatch_table->MergePipelineCaches(device, dstCache, srcCacheCount, pSrcCaches));
     return result;
 }
 
@@ -5633,6 +6434,7 @@ VKAPI_ATTR VkResult VKAPI_CALL
 CreateGraphicsPipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t count,
                         const VkGraphicsPipelineCreateInfo *pCreateInfos, const VkAllocationCallbacks *pAllocator,
                         VkPipeline *pPipelines) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateGraphicsPipelines");
     VkResult result = VK_SUCCESS;
     // TODO What to do with pipelineCache?
     // The order of operations here is a little convoluted but gets the job done
@@ -5645,21 +6447,25 @@ CreateGraphicsPipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
     uint32_t i = 0;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
 
     for (i = 0; i < count; i++) {
         pPipeNode[i] = new PIPELINE_NODE;
         pPipeNode[i]->initGraphicsPipeline(&pCreateInfos[i]);
+        set_pipeline_state(pPipeNode[i]);
         pPipeNode[i]->renderPass = getRenderPass(dev_data, pCreateInfos[i].renderPass);
         pPipeNode[i]->pipelineLayout = getPipelineLayout(dev_data, pCreateInfos[i].layout);
-
-        skipCall |= verifyPipelineCreateState(dev_data, device, pPipeNode, i);
     }
 
+    // Validation of each pipeline only reads device state and writes its own PIPELINE_NODE, so spread the batch
+    //  across the worker pool and merge the results in order
+    skipCall |= parallelValidate(dev_data, count,
+                                 [&](uint32_t index) { return verifyPipelineCreateState(dev_data, device, pPipeNode, index); });
+
     if (!skipCall) {
         lock.unlock();
-        result = dev_data->device_dispatch_table->CreateGraphicsPipelines(device, pipelineCache, count, pCreateInfos, pAllocator,
-                                                                          pPipelines);
+        result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CreateGraphicsPipelines(
+            device, pipelineCache, count, pCreateInfos, pAllocator, pPipelines));
         lock.lock();
         for (i = 0; i < count; i++) {
             pPipeNode[i]->pipeline = pPipelines[i];
@@ -5680,6 +6486,7 @@ VKAPI_ATTR VkResult VKAPI_CALL
 CreateComputePipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t count,
                        const VkComputePipelineCreateInfo *pCreateInfos, const VkAllocationCallbacks *pAllocator,
                        VkPipeline *pPipelines) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateComputePipelines");
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
 
@@ -5688,7 +6495,7 @@ CreateComputePipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
     uint32_t i = 0;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     for (i = 0; i < count; i++) {
         // TODO: Verify compute stage bits
 
@@ -5707,8 +6514,8 @@ CreateComputePipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t
 
     if (!skipCall) {
         lock.unlock();
-        result = dev_data->device_dispatch_table->CreateComputePipelines(device, pipelineCache, count, pCreateInfos, pAllocator,
-                                                                         pPipelines);
+        result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CreateComputePipelines(
+            device, pipelineCache, count, pCreateInfos, pAllocator, pPipelines));
         lock.lock();
         for (i = 0; i < count; i++) {
             pPipeNode[i]->pipeline = pPipelines[i];
@@ -5728,10 +6535,12 @@ CreateComputePipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateSampler(VkDevice device, const VkSamplerCreateInfo *pCreateInfo,
                                              const VkAllocationCallbacks *pAllocator, VkSampler *pSampler) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateSampler");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->CreateSampler(device, pCreateInfo, pAllocator, pSampler);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CreateSampler(device, pCreateInfo,
+                                                                                                      pAllocator, pSampler));
     if (VK_SUCCESS == result) {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         dev_data->samplerMap[*pSampler] = unique_ptr<SAMPLER_NODE>(new SAMPLER_NODE(pSampler, pCreateInfo));
     }
     return result;
@@ -5740,11 +6549,13 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateSampler(VkDevice device, const VkSamplerCre
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateDescriptorSetLayout(VkDevice device, const VkDescriptorSetLayoutCreateInfo *pCreateInfo,
                           const VkAllocationCallbacks *pAllocator, VkDescriptorSetLayout *pSetLayout) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDescriptorSetLayout");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->CreateDescriptorSetLayout(device, pCreateInfo, pAllocator, pSetLayout);
+    VkResult result = LAYER_PROFILE_DISPATCH(
+        profiler, dev_data->device_dispatch_table->CreateDescriptorSetLayout(device, pCreateInfo, pAllocator, pSetLayout));
     if (VK_SUCCESS == result) {
         // TODOSC : Capture layout bindings set
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         dev_data->descriptorSetLayoutMap[*pSetLayout] =
             new cvdescriptorset::DescriptorSetLayout(dev_data->report_data, pCreateInfo, *pSetLayout);
     }
@@ -5818,6 +6629,7 @@ static bool validatePushConstantRange(const layer_data *dev_data, const uint32_t
 
 VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineLayout(VkDevice device, const VkPipelineLayoutCreateInfo *pCreateInfo,
                                                     const VkAllocationCallbacks *pAllocator, VkPipelineLayout *pPipelineLayout) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreatePipelineLayout");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     // Push Constant Range checks
@@ -5853,9 +6665,10 @@ VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineLayout(VkDevice device, const VkPip
     if (skipCall)
         return VK_ERROR_VALIDATION_FAILED_EXT;
 
-    VkResult result = dev_data->device_dispatch_table->CreatePipelineLayout(device, pCreateInfo, pAllocator, pPipelineLayout);
+    VkResult result = LAYER_PROFILE_DISPATCH(
+        profiler, dev_data->device_dispatch_table->CreatePipelineLayout(device, pCreateInfo, pAllocator, pPipelineLayout));
     if (VK_SUCCESS == result) {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         PIPELINE_LAYOUT_NODE &plNode = dev_data->pipelineLayoutMap[*pPipelineLayout];
         plNode.descriptorSetLayouts.resize(pCreateInfo->setLayoutCount);
         plNode.setLayouts.resize(pCreateInfo->setLayoutCount);
@@ -5874,8 +6687,10 @@ VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineLayout(VkDevice device, const VkPip
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateDescriptorPool(VkDevice device, const VkDescriptorPoolCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator,
                      VkDescriptorPool *pDescriptorPool) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDescriptorPool");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->CreateDescriptorPool(device, pCreateInfo, pAllocator, pDescriptorPool);
+    VkResult result = LAYER_PROFILE_DISPATCH(
+        profiler, dev_data->device_dispatch_table->CreateDescriptorPool(device, pCreateInfo, pAllocator, pDescriptorPool));
     if (VK_SUCCESS == result) {
         // Insert this pool into Global Pool LL at head
         if (log_msg(dev_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_POOL_EXT,
@@ -5889,7 +6704,7 @@ CreateDescriptorPool(VkDevice device, const VkDescriptorPoolCreateInfo *pCreateI
                         "Out of memory while attempting to allocate DESCRIPTOR_POOL_NODE in vkCreateDescriptorPool()"))
                 return VK_ERROR_VALIDATION_FAILED_EXT;
         } else {
-            std::lock_guard<std::mutex> lock(global_lock);
+            std::lock_guard<rw_lock> lock(global_lock);
             dev_data->descriptorPoolMap[*pDescriptorPool] = pNewNode;
         }
     } else {
@@ -5900,10 +6715,12 @@ CreateDescriptorPool(VkDevice device, const VkDescriptorPoolCreateInfo *pCreateI
 
 VKAPI_ATTR VkResult VKAPI_CALL
 ResetDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool, VkDescriptorPoolResetFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkResetDescriptorPool");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->ResetDescriptorPool(device, descriptorPool, flags);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->ResetDescriptorPool(device, descriptorPool,
+                                                                                                            flags));
     if (VK_SUCCESS == result) {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         clearDescriptorPool(dev_data, device, descriptorPool, flags);
     }
     return result;
@@ -5927,8 +6744,9 @@ static void PostCallRecordAllocateDescriptorSets(layer_data *dev_data, const VkD
 
 VKAPI_ATTR VkResult VKAPI_CALL
 AllocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo *pAllocateInfo, VkDescriptorSet *pDescriptorSets) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkAllocateDescriptorSets");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     cvdescriptorset::AllocateDescriptorSetsData common_data(pAllocateInfo->descriptorSetCount);
     bool skip_call = PreCallValidateAllocateDescriptorSets(dev_data, pAllocateInfo, &common_data);
     lock.unlock();
@@ -5936,7 +6754,8 @@ AllocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo *pAllo
     if (skip_call)
         return VK_ERROR_VALIDATION_FAILED_EXT;
 
-    VkResult result = dev_data->device_dispatch_table->AllocateDescriptorSets(device, pAllocateInfo, pDescriptorSets);
+    VkResult result = LAYER_PROFILE_DISPATCH(
+        profiler, dev_data->device_dispatch_table->AllocateDescriptorSets(device, pAllocateInfo, pDescriptorSets));
 
     if (VK_SUCCESS == result) {
         lock.lock();
@@ -5986,14 +6805,16 @@ static void PostCallRecordFreeDescriptorSets(layer_data *dev_data, VkDescriptorP
 
 VKAPI_ATTR VkResult VKAPI_CALL
 FreeDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool, uint32_t count, const VkDescriptorSet *pDescriptorSets) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkFreeDescriptorSets");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     // Make sure that no sets being destroyed are in-flight
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     bool skipCall = PreCallValidateFreeDescriptorSets(dev_data, descriptorPool, count, pDescriptorSets);
     lock.unlock();
     if (skipCall)
         return VK_ERROR_VALIDATION_FAILED_EXT;
-    VkResult result = dev_data->device_dispatch_table->FreeDescriptorSets(device, descriptorPool, count, pDescriptorSets);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->FreeDescriptorSets(device, descriptorPool,
+                                                                                                           count, pDescriptorSets));
     if (VK_SUCCESS == result) {
         lock.lock();
         PostCallRecordFreeDescriptorSets(dev_data, descriptorPool, count, pDescriptorSets);
@@ -6006,57 +6827,80 @@ FreeDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool, uint32_t co
 //  keeping it all together here to prove out design
 // PreCallValidate* handles validating all of the state prior to calling down chain to UpdateDescriptorSets()
 static bool PreCallValidateUpdateDescriptorSets(layer_data *dev_data, uint32_t descriptorWriteCount,
+                                                const vector<cvdescriptorset::WriteUpdateGroup> &writeGroups,
                                                 const VkWriteDescriptorSet *pDescriptorWrites, uint32_t descriptorCopyCount,
                                                 const VkCopyDescriptorSet *pDescriptorCopies) {
     // First thing to do is perform map look-ups.
     // NOTE : UpdateDescriptorSets is somewhat unique in that it's operating on a number of DescriptorSets
-    //  so we can't just do a single map look-up up-front, but do them individually in functions below
+    //  so we can't just do a single map look-up up-front, but do them once per destination set in functions below
 
     // Now make call(s) that validate state, but don't perform state updates in this function
     // Note, here DescriptorSets is unique in that we don't yet have an instance. Using a helper function in the
     //  namespace which will parse params and make calls into specific class instances
-    return cvdescriptorset::ValidateUpdateDescriptorSets(dev_data->report_data, dev_data, descriptorWriteCount, pDescriptorWrites,
-                                                         descriptorCopyCount, pDescriptorCopies);
+    // Each group of writes targets its own set, so large batches are spread across the worker pool
+    auto validateGroup = [&](uint32_t index) {
+        return cvdescriptorset::ValidateWriteUpdateGroup(dev_data->report_data, dev_data, pDescriptorWrites, writeGroups[index]);
+    };
+    bool skip_call = false;
+    if (descriptorWriteCount >= PARALLEL_DESCRIPTOR_WRITE_COUNT) {
+        skip_call |= parallelValidate(dev_data, static_cast<uint32_t>(writeGroups.size()), validateGroup);
+    } else {
+        for (uint32_t i = 0; i < writeGroups.size(); i++) {
+            skip_call |= validateGroup(i);
+        }
+    }
+    skip_call |= cvdescriptorset::ValidateCopyUpdates(dev_data->report_data, dev_data, descriptorCopyCount, pDescriptorCopies);
+    return skip_call;
 }
 // PostCallRecord* handles recording state updates following call down chain to UpdateDescriptorSets()
-static void PostCallRecordUpdateDescriptorSets(layer_data *dev_data, uint32_t descriptorWriteCount,
+static void PostCallRecordUpdateDescriptorSets(layer_data *dev_data, const vector<cvdescriptorset::WriteUpdateGroup> &writeGroups,
                                                const VkWriteDescriptorSet *pDescriptorWrites, uint32_t descriptorCopyCount,
                                                const VkCopyDescriptorSet *pDescriptorCopies) {
-    cvdescriptorset::PerformUpdateDescriptorSets(dev_data, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount,
-                                                 pDescriptorCopies);
+    cvdescriptorset::PerformUpdateDescriptorSets(dev_data, writeGroups, pDescriptorWrites, descriptorCopyCount, pDescriptorCopies);
 }
 
 VKAPI_ATTR void VKAPI_CALL
 UpdateDescriptorSets(VkDevice device, uint32_t descriptorWriteCount, const VkWriteDescriptorSet *pDescriptorWrites,
                      uint32_t descriptorCopyCount, const VkCopyDescriptorSet *pDescriptorCopies) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkUpdateDescriptorSets");
     // Only map look-up at top level is for device-level layer_data
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
-    bool skip_call = PreCallValidateUpdateDescriptorSets(dev_data, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount,
-                                                         pDescriptorCopies);
+    vector<cvdescriptorset::WriteUpdateGroup> writeGroups;
+    cvdescriptorset::GroupWriteUpdates(descriptorWriteCount, pDescriptorWrites, &writeGroups);
+    std::unique_lock<rw_lock> lock(global_lock);
+    bool skip_call =
+        PreCallValidateUpdateDescriptorSets(dev_data, descriptorWriteCount, writeGroups, pDescriptorWrites, descriptorCopyCount,
+                                            pDescriptorCopies);
     lock.unlock();
     if (!skip_call) {
-        dev_data->device_dispatch_table->UpdateDescriptorSets(device, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount,
-                                                              pDescriptorCopies);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->UpdateDescriptorSets(
+            device, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount, pDescriptorCopies));
         lock.lock();
         // Since UpdateDescriptorSets() is void, nothing to check prior to updating state
-        PostCallRecordUpdateDescriptorSets(dev_data, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount,
-                                           pDescriptorCopies);
+        PostCallRecordUpdateDescriptorSets(dev_data, writeGroups, pDescriptorWrites, descriptorCopyCount, pDescriptorCopies);
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 AllocateCommandBuffers(VkDevice device, const VkCommandBufferAllocateInfo *pCreateInfo, VkCommandBuffer *pCommandBuffer) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkAllocateCommandBuffers");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->AllocateCommandBuffers(device, pCreateInfo, pCommandBuffer);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->AllocateCommandBuffers(device, pCreateInfo,
+                                                                                                               pCommandBuffer));
     if (VK_SUCCESS == result) {
-        std::unique_lock<std::mutex> lock(global_lock);
+        std::unique_lock<rw_lock> lock(global_lock);
         auto const &cp_it = dev_data->commandPoolMap.find(pCreateInfo->commandPool);
         if (cp_it != dev_data->commandPoolMap.end()) {
             for (uint32_t i = 0; i < pCreateInfo->commandBufferCount; i++) {
                 // Add command buffer to its commandPool map
-                cp_it->second.commandBuffers.push_back(pCommandBuffer[i]);
-                GLOBAL_CB_NODE *pCB = new GLOBAL_CB_NODE;
+                cp_it->second.commandBuffers.insert(pCommandBuffer[i]);
+                GLOBAL_CB_NODE *pCB;
+                if (!cp_it->second.freeNodes.empty()) {
+                    pCB = cp_it->second.freeNodes.back();
+                    cp_it->second.freeNodes.pop_back();
+                } else {
+                    pCB = new GLOBAL_CB_NODE;
+                }
                 // Add command buffer to map
                 dev_data->commandBufferMap[pCommandBuffer[i]] = pCB;
                 resetCB(dev_data, pCommandBuffer[i]);
@@ -6072,9 +6916,10 @@ AllocateCommandBuffers(VkDevice device, const VkCommandBufferAllocateInfo *pCrea
 
 VKAPI_ATTR VkResult VKAPI_CALL
 BeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo *pBeginInfo) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkBeginCommandBuffer");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     // Validate command buffer level
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
@@ -6204,16 +7049,18 @@ BeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo
     if (skipCall) {
         return VK_ERROR_VALIDATION_FAILED_EXT;
     }
-    VkResult result = dev_data->device_dispatch_table->BeginCommandBuffer(commandBuffer, pBeginInfo);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->BeginCommandBuffer(commandBuffer,
+                                                                                                           pBeginInfo));
 
     return result;
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL EndCommandBuffer(VkCommandBuffer commandBuffer) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEndCommandBuffer");
     bool skipCall = false;
     VkResult result = VK_SUCCESS;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         if ((VK_COMMAND_BUFFER_LEVEL_PRIMARY == pCB->createInfo.level) || !(pCB->beginInfo.flags & VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT)) {
@@ -6222,18 +7069,21 @@ VKAPI_ATTR VkResult VKAPI_CALL EndCommandBuffer(VkCommandBuffer commandBuffer) {
             skipCall |= insideRenderPass(dev_data, pCB, "vkEndCommandBuffer");
         }
         skipCall |= addCmd(dev_data, pCB, CMD_END, "vkEndCommandBuffer()");
-        for (auto query : pCB->activeQueries) {
-            skipCall |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0, __LINE__,
-                                DRAWSTATE_INVALID_QUERY, "DS",
-                                "Ending command buffer with in progress query: queryPool 0x%" PRIx64 ", index %d",
-                                (uint64_t)(query.pool), query.index);
+        for (auto const &pool_queries : pCB->activeQueries) {
+            pool_queries.second.ForEach([&](uint32_t index) {
+                skipCall |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0,
+                                    __LINE__, DRAWSTATE_INVALID_QUERY, "DS",
+                                    "Ending command buffer with in progress query: queryPool 0x%" PRIx64 ", index %d",
+                                    (uint64_t)(pool_queries.first), index);
+            });
         }
     }
     if (!skipCall) {
         lock.unlock();
-        result = dev_data->device_dispatch_table->EndCommandBuffer(commandBuffer);
+        result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->EndCommandBuffer(commandBuffer));
         lock.lock();
         if (VK_SUCCESS == result) {
+            buildSubmitResources(pCB);
             pCB->state = CB_RECORDED;
             // Reset CB status flags
             pCB->status = 0;
@@ -6248,9 +7098,10 @@ VKAPI_ATTR VkResult VKAPI_CALL EndCommandBuffer(VkCommandBuffer commandBuffer) {
 
 VKAPI_ATTR VkResult VKAPI_CALL
 ResetCommandBuffer(VkCommandBuffer commandBuffer, VkCommandBufferResetFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkResetCommandBuffer");
     bool skip_call = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     VkCommandPool cmdPool = pCB->createInfo.commandPool;
     if (!(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT & dev_data->commandPoolMap[cmdPool].createFlags)) {
@@ -6264,7 +7115,7 @@ ResetCommandBuffer(VkCommandBuffer commandBuffer, VkCommandBufferResetFlags flag
     lock.unlock();
     if (skip_call)
         return VK_ERROR_VALIDATION_FAILED_EXT;
-    VkResult result = dev_data->device_dispatch_table->ResetCommandBuffer(commandBuffer, flags);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->ResetCommandBuffer(commandBuffer, flags));
     if (VK_SUCCESS == result) {
         lock.lock();
         resetCB(dev_data, commandBuffer);
@@ -6275,9 +7126,10 @@ ResetCommandBuffer(VkCommandBuffer commandBuffer, VkCommandBufferResetFlags flag
 
 VKAPI_ATTR void VKAPI_CALL
 CmdBindPipeline(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipeline pipeline) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBindPipeline");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_BINDPIPELINE, "vkCmdBindPipeline()");
@@ -6292,8 +7144,8 @@ CmdBindPipeline(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindP
         PIPELINE_NODE *pPN = getPipeline(dev_data, pipeline);
         if (pPN) {
             pCB->lastBound[pipelineBindPoint].pipeline = pipeline;
+            pCB->lastBound[pipelineBindPoint].version++;
             set_cb_pso_status(pCB, pPN);
-            set_pipeline_state(pPN);
         } else {
             skipCall |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_PIPELINE_EXT,
                                 (uint64_t)pipeline, __LINE__, DRAWSTATE_INVALID_PIPELINE, "DS",
@@ -6302,14 +7154,21 @@ CmdBindPipeline(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindP
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdBindPipeline(commandBuffer, pipelineBindPoint, pipeline);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdBindPipeline(commandBuffer, pipelineBindPoint,
+                                                                                          pipeline));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetViewport(VkCommandBuffer commandBuffer, uint32_t firstViewport, uint32_t viewportCount, const VkViewport *pViewports) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetViewport");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    if (dev_data->submitOnlyValidation) {
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetViewport(commandBuffer, firstViewport,
+                                                                                         viewportCount, pViewports));
+        return;
+    }
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_SETVIEWPORTSTATE, "vkCmdSetViewport()");
@@ -6319,14 +7178,21 @@ CmdSetViewport(VkCommandBuffer commandBuffer, uint32_t firstViewport, uint32_t v
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdSetViewport(commandBuffer, firstViewport, viewportCount, pViewports);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetViewport(commandBuffer, firstViewport,
+                                                                                         viewportCount, pViewports));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetScissor(VkCommandBuffer commandBuffer, uint32_t firstScissor, uint32_t scissorCount, const VkRect2D *pScissors) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetScissor");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    if (dev_data->submitOnlyValidation) {
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetScissor(commandBuffer, firstScissor, scissorCount,
+                                                                                        pScissors));
+        return;
+    }
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_SETSCISSORSTATE, "vkCmdSetScissor()");
@@ -6336,13 +7202,19 @@ CmdSetScissor(VkCommandBuffer commandBuffer, uint32_t firstScissor, uint32_t sci
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdSetScissor(commandBuffer, firstScissor, scissorCount, pScissors);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetScissor(commandBuffer, firstScissor, scissorCount,
+                                                                                        pScissors));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdSetLineWidth(VkCommandBuffer commandBuffer, float lineWidth) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetLineWidth");
     bool skip_call = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    if (dev_data->submitOnlyValidation) {
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetLineWidth(commandBuffer, lineWidth));
+        return;
+    }
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skip_call |= addCmd(dev_data, pCB, CMD_SETLINEWIDTHSTATE, "vkCmdSetLineWidth()");
@@ -6360,14 +7232,20 @@ VKAPI_ATTR void VKAPI_CALL CmdSetLineWidth(VkCommandBuffer commandBuffer, float
     }
     lock.unlock();
     if (!skip_call)
-        dev_data->device_dispatch_table->CmdSetLineWidth(commandBuffer, lineWidth);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetLineWidth(commandBuffer, lineWidth));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetDepthBias(VkCommandBuffer commandBuffer, float depthBiasConstantFactor, float depthBiasClamp, float depthBiasSlopeFactor) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetDepthBias");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    if (dev_data->submitOnlyValidation) {
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetDepthBias(commandBuffer, depthBiasConstantFactor,
+                                                                                          depthBiasClamp, depthBiasSlopeFactor));
+        return;
+    }
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_SETDEPTHBIASSTATE, "vkCmdSetDepthBias()");
@@ -6375,14 +7253,19 @@ CmdSetDepthBias(VkCommandBuffer commandBuffer, float depthBiasConstantFactor, fl
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdSetDepthBias(commandBuffer, depthBiasConstantFactor, depthBiasClamp,
-                                                         depthBiasSlopeFactor);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetDepthBias(commandBuffer, depthBiasConstantFactor,
+                                                                                          depthBiasClamp, depthBiasSlopeFactor));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdSetBlendConstants(VkCommandBuffer commandBuffer, const float blendConstants[4]) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetBlendConstants");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    if (dev_data->submitOnlyValidation) {
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetBlendConstants(commandBuffer, blendConstants));
+        return;
+    }
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_SETBLENDSTATE, "vkCmdSetBlendConstants()");
@@ -6390,14 +7273,20 @@ VKAPI_ATTR void VKAPI_CALL CmdSetBlendConstants(VkCommandBuffer commandBuffer, c
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdSetBlendConstants(commandBuffer, blendConstants);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetBlendConstants(commandBuffer, blendConstants));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetDepthBounds(VkCommandBuffer commandBuffer, float minDepthBounds, float maxDepthBounds) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetDepthBounds");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    if (dev_data->submitOnlyValidation) {
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetDepthBounds(commandBuffer, minDepthBounds,
+                                                                                            maxDepthBounds));
+        return;
+    }
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_SETDEPTHBOUNDSSTATE, "vkCmdSetDepthBounds()");
@@ -6405,14 +7294,21 @@ CmdSetDepthBounds(VkCommandBuffer commandBuffer, float minDepthBounds, float max
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdSetDepthBounds(commandBuffer, minDepthBounds, maxDepthBounds);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetDepthBounds(commandBuffer, minDepthBounds,
+                                                                                            maxDepthBounds));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetStencilCompareMask(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceMask, uint32_t compareMask) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetStencilCompareMask");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    if (dev_data->submitOnlyValidation) {
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetStencilCompareMask(commandBuffer, faceMask,
+                                                                                                   compareMask));
+        return;
+    }
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_SETSTENCILREADMASKSTATE, "vkCmdSetStencilCompareMask()");
@@ -6420,14 +7316,21 @@ CmdSetStencilCompareMask(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceM
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdSetStencilCompareMask(commandBuffer, faceMask, compareMask);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetStencilCompareMask(commandBuffer, faceMask,
+                                                                                                   compareMask));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetStencilWriteMask(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceMask, uint32_t writeMask) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetStencilWriteMask");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    if (dev_data->submitOnlyValidation) {
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetStencilWriteMask(commandBuffer, faceMask,
+                                                                                                 writeMask));
+        return;
+    }
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_SETSTENCILWRITEMASKSTATE, "vkCmdSetStencilWriteMask()");
@@ -6435,14 +7338,21 @@ CmdSetStencilWriteMask(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceMas
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdSetStencilWriteMask(commandBuffer, faceMask, writeMask);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetStencilWriteMask(commandBuffer, faceMask,
+                                                                                                 writeMask));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetStencilReference(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceMask, uint32_t reference) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetStencilReference");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    if (dev_data->submitOnlyValidation) {
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetStencilReference(commandBuffer, faceMask,
+                                                                                                 reference));
+        return;
+    }
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_SETSTENCILREFERENCESTATE, "vkCmdSetStencilReference()");
@@ -6450,19 +7360,22 @@ CmdSetStencilReference(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceMas
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdSetStencilReference(commandBuffer, faceMask, reference);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetStencilReference(commandBuffer, faceMask,
+                                                                                                 reference));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdBindDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout layout,
                       uint32_t firstSet, uint32_t setCount, const VkDescriptorSet *pDescriptorSets, uint32_t dynamicOffsetCount,
                       const uint32_t *pDynamicOffsets) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBindDescriptorSets");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         if (pCB->state == CB_RECORDING) {
+            pCB->lastBound[pipelineBindPoint].version++;
             // Track total count of dynamic descriptor types to make sure we have an offset for each one
             uint32_t totalDynamicDescriptors = 0;
             string errorString = "";
@@ -6476,7 +7389,10 @@ CmdBindDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelin
                 cvdescriptorset::DescriptorSet *pSet = getSetNode(dev_data, pDescriptorSets[i]);
                 if (pSet) {
                     pCB->lastBound[pipelineBindPoint].uniqueBoundSets.insert(pSet);
-                    pSet->BindCommandBuffer(pCB);
+                    {
+                        std::lock_guard<std::mutex> binding_lock(getBindingLock(dev_data, pSet));
+                        pSet->BindCommandBuffer(pCB);
+                    }
                     pCB->lastBound[pipelineBindPoint].pipelineLayout = layout;
                     pCB->lastBound[pipelineBindPoint].boundDescriptorSets[i + firstSet] = pSet;
                     skipCall |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT,
@@ -6618,23 +7534,23 @@ CmdBindDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelin
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdBindDescriptorSets(commandBuffer, pipelineBindPoint, layout, firstSet, setCount,
-                                                               pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdBindDescriptorSets(
+            commandBuffer, pipelineBindPoint, layout, firstSet, setCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdBindIndexBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBindIndexBuffer");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     // TODO : Somewhere need to verify that IBs have correct usage state flagged
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     VkDeviceMemory mem;
     skipCall =
         get_mem_binding_from_object(dev_data, (uint64_t)buffer, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, &mem);
     auto cb_data = dev_data->commandBufferMap.find(commandBuffer);
     if (cb_data != dev_data->commandBufferMap.end()) {
-        std::function<bool()> function = [=]() { return validate_memory_is_valid(dev_data, mem, "vkCmdBindIndexBuffer()"); };
-        cb_data->second->validate_functions.push_back(function);
+        deferValidateMemory(cb_data->second, mem, "vkCmdBindIndexBuffer()");
         skipCall |= addCmd(dev_data, cb_data->second, CMD_BINDINDEXBUFFER, "vkCmdBindIndexBuffer()");
         VkDeviceSize offset_align = 0;
         switch (indexType) {
@@ -6658,7 +7574,8 @@ CmdBindIndexBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdBindIndexBuffer(commandBuffer, buffer, offset, indexType);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdBindIndexBuffer(commandBuffer, buffer, offset,
+                                                                                             indexType));
 }
 
 void updateResourceTracking(GLOBAL_CB_NODE *pCB, uint32_t firstBinding, uint32_t bindingCount, const VkBuffer *pBuffers) {
@@ -6671,23 +7588,25 @@ void updateResourceTracking(GLOBAL_CB_NODE *pCB, uint32_t firstBinding, uint32_t
     }
 }
 
-static inline void updateResourceTrackingOnDraw(GLOBAL_CB_NODE *pCB) { pCB->drawData.push_back(pCB->currentDrawData); }
+static inline void updateResourceTrackingOnDraw(GLOBAL_CB_NODE *pCB) {
+    pCB->drawBuffers.insert(pCB->currentDrawData.buffers.begin(), pCB->currentDrawData.buffers.end());
+}
 
 VKAPI_ATTR void VKAPI_CALL CmdBindVertexBuffers(VkCommandBuffer commandBuffer, uint32_t firstBinding,
                                                 uint32_t bindingCount, const VkBuffer *pBuffers,
                                                 const VkDeviceSize *pOffsets) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBindVertexBuffers");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     // TODO : Somewhere need to verify that VBs have correct usage state flagged
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     auto cb_data = dev_data->commandBufferMap.find(commandBuffer);
     if (cb_data != dev_data->commandBufferMap.end()) {
         for (uint32_t i = 0; i < bindingCount; ++i) {
             VkDeviceMemory mem;
             skipCall |= get_mem_binding_from_object(dev_data, (uint64_t)pBuffers[i], VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, &mem);
 
-            std::function<bool()> function = [=]() { return validate_memory_is_valid(dev_data, mem, "vkCmdBindVertexBuffers()"); };
-            cb_data->second->validate_functions.push_back(function);
+            deferValidateMemory(cb_data->second, mem, "vkCmdBindVertexBuffers()");
         }
         addCmd(dev_data, cb_data->second, CMD_BINDVERTEXBUFFER, "vkCmdBindVertexBuffer()");
         updateResourceTracking(cb_data->second, firstBinding, bindingCount, pBuffers);
@@ -6696,7 +7615,8 @@ VKAPI_ATTR void VKAPI_CALL CmdBindVertexBuffers(VkCommandBuffer commandBuffer, u
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdBindVertexBuffers(commandBuffer, firstBinding, bindingCount, pBuffers, pOffsets);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdBindVertexBuffers(commandBuffer, firstBinding,
+                                                                                               bindingCount, pBuffers, pOffsets));
 }
 
 /* expects global_lock to be held by caller */
@@ -6711,84 +7631,84 @@ static bool markStoreImagesAndBuffersAsWritten(layer_data *dev_data, GLOBAL_CB_N
         VkDeviceMemory mem;
         skip_call |=
             get_mem_binding_from_object(dev_data, (uint64_t)image, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT, &mem);
-        std::function<bool()> function = [=]() {
-            set_memory_valid(dev_data, mem, true, image);
-            return false;
-        };
-        pCB->validate_functions.push_back(function);
+        deferSetMemoryValid(pCB, mem, true, image);
     }
     for (auto buffer : pCB->updateBuffers) {
         VkDeviceMemory mem;
         skip_call |= get_mem_binding_from_object(dev_data, (uint64_t)buffer,
                                                  VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, &mem);
-        std::function<bool()> function = [=]() {
-            set_memory_valid(dev_data, mem, true);
-            return false;
-        };
-        pCB->validate_functions.push_back(function);
+        deferSetMemoryValid(pCB, mem, true);
     }
     return skip_call;
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t instanceCount,
                                    uint32_t firstVertex, uint32_t firstInstance) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdDraw");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_DRAW, "vkCmdDraw()");
         pCB->drawCount[DRAW]++;
-        skipCall |= validate_and_update_draw_state(dev_data, pCB, false, VK_PIPELINE_BIND_POINT_GRAPHICS);
-        skipCall |= markStoreImagesAndBuffersAsWritten(dev_data, pCB);
-        // TODO : Need to pass commandBuffer as srcObj here
-        skipCall |=
-            log_msg(dev_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT, 0,
-                    __LINE__, DRAWSTATE_NONE, "DS", "vkCmdDraw() call 0x%" PRIx64 ", reporting DS state:", g_drawCount[DRAW]++);
-        skipCall |= synchAndPrintDSConfig(dev_data, commandBuffer);
+        if (!dev_data->submitOnlyValidation) {
+            skipCall |= validate_and_update_draw_state(dev_data, pCB, false, VK_PIPELINE_BIND_POINT_GRAPHICS);
+            skipCall |= markStoreImagesAndBuffersAsWritten(dev_data, pCB);
+            // TODO : Need to pass commandBuffer as srcObj here
+            skipCall |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT,
+                                VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT, 0, __LINE__, DRAWSTATE_NONE, "DS",
+                                "vkCmdDraw() call 0x%" PRIx64 ", reporting DS state:", g_drawCount[DRAW]++);
+            skipCall |= synchAndPrintDSConfig(dev_data, commandBuffer);
+            skipCall |= outsideRenderPass(dev_data, pCB, "vkCmdDraw");
+        }
         if (!skipCall) {
             updateResourceTrackingOnDraw(pCB);
         }
-        skipCall |= outsideRenderPass(dev_data, pCB, "vkCmdDraw");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdDraw(commandBuffer, vertexCount, instanceCount,
+                                                                                  firstVertex, firstInstance));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdDrawIndexed(VkCommandBuffer commandBuffer, uint32_t indexCount,
                                           uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset,
                                                             uint32_t firstInstance) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdDrawIndexed");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     bool skipCall = false;
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_DRAWINDEXED, "vkCmdDrawIndexed()");
         pCB->drawCount[DRAW_INDEXED]++;
-        skipCall |= validate_and_update_draw_state(dev_data, pCB, true, VK_PIPELINE_BIND_POINT_GRAPHICS);
-        skipCall |= markStoreImagesAndBuffersAsWritten(dev_data, pCB);
-        // TODO : Need to pass commandBuffer as srcObj here
-        skipCall |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT,
-                            VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT, 0, __LINE__, DRAWSTATE_NONE, "DS",
-                            "vkCmdDrawIndexed() call 0x%" PRIx64 ", reporting DS state:", g_drawCount[DRAW_INDEXED]++);
-        skipCall |= synchAndPrintDSConfig(dev_data, commandBuffer);
+        if (!dev_data->submitOnlyValidation) {
+            skipCall |= validate_and_update_draw_state(dev_data, pCB, true, VK_PIPELINE_BIND_POINT_GRAPHICS);
+            skipCall |= markStoreImagesAndBuffersAsWritten(dev_data, pCB);
+            // TODO : Need to pass commandBuffer as srcObj here
+            skipCall |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT,
+                                VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT, 0, __LINE__, DRAWSTATE_NONE, "DS",
+                                "vkCmdDrawIndexed() call 0x%" PRIx64 ", reporting DS state:", g_drawCount[DRAW_INDEXED]++);
+            skipCall |= synchAndPrintDSConfig(dev_data, commandBuffer);
+            skipCall |= outsideRenderPass(dev_data, pCB, "vkCmdDrawIndexed");
+        }
         if (!skipCall) {
             updateResourceTrackingOnDraw(pCB);
         }
-        skipCall |= outsideRenderPass(dev_data, pCB, "vkCmdDrawIndexed");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset,
-                                                        firstInstance);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdDrawIndexed(commandBuffer, indexCount, instanceCount,
+                                                                                         firstIndex, vertexOffset, firstInstance));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdDrawIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, uint32_t count, uint32_t stride) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdDrawIndirect");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     bool skipCall = false;
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     VkDeviceMemory mem;
     // MTMTODO : merge with code below
     skipCall =
@@ -6798,28 +7718,32 @@ CmdDrawIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize off
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_DRAWINDIRECT, "vkCmdDrawIndirect()");
         pCB->drawCount[DRAW_INDIRECT]++;
-        skipCall |= validate_and_update_draw_state(dev_data, pCB, false, VK_PIPELINE_BIND_POINT_GRAPHICS);
-        skipCall |= markStoreImagesAndBuffersAsWritten(dev_data, pCB);
-        // TODO : Need to pass commandBuffer as srcObj here
-        skipCall |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT,
-                            VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT, 0, __LINE__, DRAWSTATE_NONE, "DS",
-                            "vkCmdDrawIndirect() call 0x%" PRIx64 ", reporting DS state:", g_drawCount[DRAW_INDIRECT]++);
-        skipCall |= synchAndPrintDSConfig(dev_data, commandBuffer);
+        if (!dev_data->submitOnlyValidation) {
+            skipCall |= validate_and_update_draw_state(dev_data, pCB, false, VK_PIPELINE_BIND_POINT_GRAPHICS);
+            skipCall |= markStoreImagesAndBuffersAsWritten(dev_data, pCB);
+            // TODO : Need to pass commandBuffer as srcObj here
+            skipCall |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT,
+                                VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT, 0, __LINE__, DRAWSTATE_NONE, "DS",
+                                "vkCmdDrawIndirect() call 0x%" PRIx64 ", reporting DS state:", g_drawCount[DRAW_INDIRECT]++);
+            skipCall |= synchAndPrintDSConfig(dev_data, commandBuffer);
+            skipCall |= outsideRenderPass(dev_data, pCB, "vkCmdDrawIndirect");
+        }
         if (!skipCall) {
             updateResourceTrackingOnDraw(pCB);
         }
-        skipCall |= outsideRenderPass(dev_data, pCB, "vkCmdDrawIndirect");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdDrawIndirect(commandBuffer, buffer, offset, count, stride);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdDrawIndirect(commandBuffer, buffer, offset, count,
+                                                                                          stride));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdDrawIndexedIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, uint32_t count, uint32_t stride) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdDrawIndexedIndirect");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     VkDeviceMemory mem;
     // MTMTODO : merge with code below
     skipCall =
@@ -6829,66 +7753,76 @@ CmdDrawIndexedIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceS
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_DRAWINDEXEDINDIRECT, "vkCmdDrawIndexedIndirect()");
         pCB->drawCount[DRAW_INDEXED_INDIRECT]++;
-        skipCall |= validate_and_update_draw_state(dev_data, pCB, true, VK_PIPELINE_BIND_POINT_GRAPHICS);
-        skipCall |= markStoreImagesAndBuffersAsWritten(dev_data, pCB);
-        // TODO : Need to pass commandBuffer as srcObj here
-        skipCall |=
-            log_msg(dev_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT, 0,
-                    __LINE__, DRAWSTATE_NONE, "DS", "vkCmdDrawIndexedIndirect() call 0x%" PRIx64 ", reporting DS state:",
-                    g_drawCount[DRAW_INDEXED_INDIRECT]++);
-        skipCall |= synchAndPrintDSConfig(dev_data, commandBuffer);
+        if (!dev_data->submitOnlyValidation) {
+            skipCall |= validate_and_update_draw_state(dev_data, pCB, true, VK_PIPELINE_BIND_POINT_GRAPHICS);
+            skipCall |= markStoreImagesAndBuffersAsWritten(dev_data, pCB);
+            // TODO : Need to pass commandBuffer as srcObj here
+            skipCall |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT,
+                                VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT, 0, __LINE__, DRAWSTATE_NONE, "DS",
+                                "vkCmdDrawIndexedIndirect() call 0x%" PRIx64 ", reporting DS state:",
+                                g_drawCount[DRAW_INDEXED_INDIRECT]++);
+            skipCall |= synchAndPrintDSConfig(dev_data, commandBuffer);
+            skipCall |= outsideRenderPass(dev_data, pCB, "vkCmdDrawIndexedIndirect");
+        }
         if (!skipCall) {
             updateResourceTrackingOnDraw(pCB);
         }
-        skipCall |= outsideRenderPass(dev_data, pCB, "vkCmdDrawIndexedIndirect");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdDrawIndexedIndirect(commandBuffer, buffer, offset, count, stride);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdDrawIndexedIndirect(commandBuffer, buffer, offset,
+                                                                                                 count, stride));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdDispatch(VkCommandBuffer commandBuffer, uint32_t x, uint32_t y, uint32_t z) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdDispatch");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
-        skipCall |= validate_and_update_draw_state(dev_data, pCB, false, VK_PIPELINE_BIND_POINT_COMPUTE);
-        skipCall |= markStoreImagesAndBuffersAsWritten(dev_data, pCB);
+        if (!dev_data->submitOnlyValidation) {
+            skipCall |= validate_and_update_draw_state(dev_data, pCB, false, VK_PIPELINE_BIND_POINT_COMPUTE);
+            skipCall |= markStoreImagesAndBuffersAsWritten(dev_data, pCB);
+        }
         skipCall |= addCmd(dev_data, pCB, CMD_DISPATCH, "vkCmdDispatch()");
         skipCall |= insideRenderPass(dev_data, pCB, "vkCmdDispatch");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdDispatch(commandBuffer, x, y, z);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdDispatch(commandBuffer, x, y, z));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdDispatchIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdDispatchIndirect");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     VkDeviceMemory mem;
     skipCall =
         get_mem_binding_from_object(dev_data, (uint64_t)buffer, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, &mem);
     skipCall |= update_cmd_buf_and_mem_references(dev_data, commandBuffer, mem, "vkCmdDispatchIndirect");
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
-        skipCall |= validate_and_update_draw_state(dev_data, pCB, false, VK_PIPELINE_BIND_POINT_COMPUTE);
-        skipCall |= markStoreImagesAndBuffersAsWritten(dev_data, pCB);
+        if (!dev_data->submitOnlyValidation) {
+            skipCall |= validate_and_update_draw_state(dev_data, pCB, false, VK_PIPELINE_BIND_POINT_COMPUTE);
+            skipCall |= markStoreImagesAndBuffersAsWritten(dev_data, pCB);
+        }
         skipCall |= addCmd(dev_data, pCB, CMD_DISPATCHINDIRECT, "vkCmdDispatchIndirect()");
         skipCall |= insideRenderPass(dev_data, pCB, "vkCmdDispatchIndirect");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdDispatchIndirect(commandBuffer, buffer, offset);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdDispatchIndirect(commandBuffer, buffer, offset));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdCopyBuffer(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkBuffer dstBuffer,
                                          uint32_t regionCount, const VkBufferCopy *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdCopyBuffer");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     VkDeviceMemory src_mem, dst_mem;
     skipCall = get_mem_binding_from_object(dev_data, (uint64_t)srcBuffer, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, &src_mem);
     skipCall |= update_cmd_buf_and_mem_references(dev_data, commandBuffer, src_mem, "vkCmdCopyBuffer");
@@ -6902,20 +7836,16 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyBuffer(VkCommandBuffer commandBuffer, VkBuffer
                                             "vkCmdCopyBuffer()", "VK_BUFFER_USAGE_TRANSFER_DST_BIT");
     auto cb_data = dev_data->commandBufferMap.find(commandBuffer);
     if (cb_data != dev_data->commandBufferMap.end()) {
-        std::function<bool()> function = [=]() { return validate_memory_is_valid(dev_data, src_mem, "vkCmdCopyBuffer()"); };
-        cb_data->second->validate_functions.push_back(function);
-        function = [=]() {
-            set_memory_valid(dev_data, dst_mem, true);
-            return false;
-        };
-        cb_data->second->validate_functions.push_back(function);
+        deferValidateMemory(cb_data->second, src_mem, "vkCmdCopyBuffer()");
+        deferSetMemoryValid(cb_data->second, dst_mem, true);
 
         skipCall |= addCmd(dev_data, cb_data->second, CMD_COPYBUFFER, "vkCmdCopyBuffer()");
         skipCall |= insideRenderPass(dev_data, cb_data->second, "vkCmdCopyBuffer");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, regionCount, pRegions);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer,
+                                                                                        regionCount, pRegions));
 }
 
 static bool VerifySourceImageLayout(VkCommandBuffer cmdBuffer, VkImage srcImage, VkImageSubresourceLayers subLayers,
@@ -6924,23 +7854,21 @@ static bool VerifySourceImageLayout(VkCommandBuffer cmdBuffer, VkImage srcImage,
 
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(cmdBuffer), layer_data_map);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, cmdBuffer);
-    for (uint32_t i = 0; i < subLayers.layerCount; ++i) {
-        uint32_t layer = i + subLayers.baseArrayLayer;
-        VkImageSubresource sub = {subLayers.aspectMask, subLayers.mipLevel, layer};
-        IMAGE_CMD_BUF_LAYOUT_NODE node;
-        if (!FindLayout(pCB, srcImage, sub, node)) {
-            SetLayout(pCB, srcImage, sub, IMAGE_CMD_BUF_LAYOUT_NODE(srcImageLayout, srcImageLayout));
-            continue;
-        }
-        if (node.layout != srcImageLayout) {
+    VkImageSubresourceRange range = {subLayers.aspectMask, subLayers.mipLevel, 1, subLayers.baseArrayLayer, subLayers.layerCount};
+    UpdateCBImageLayouts(dev_data, pCB, srcImage, range,
+                         [&](uint64_t, uint64_t, const IMAGE_CMD_BUF_LAYOUT_NODE *node) -> IMAGE_CMD_BUF_LAYOUT_NODE {
+        if (!node)
+            return IMAGE_CMD_BUF_LAYOUT_NODE(srcImageLayout, srcImageLayout);
+        if (node->layout != srcImageLayout) {
             // TODO: Improve log message in the next pass
             skip_call |=
                 log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT, 0,
                         __LINE__, DRAWSTATE_INVALID_IMAGE_LAYOUT, "DS", "Cannot copy from an image whose source layout is %s "
                                                                         "and doesn't match the current layout %s.",
-                        string_VkImageLayout(srcImageLayout), string_VkImageLayout(node.layout));
+                        string_VkImageLayout(srcImageLayout), string_VkImageLayout(node->layout));
         }
-    }
+        return *node;
+    });
     if (srcImageLayout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
         if (srcImageLayout == VK_IMAGE_LAYOUT_GENERAL) {
             // LAYOUT_GENERAL is allowed, but may not be performance optimal, flag as perf warning.
@@ -6963,22 +7891,20 @@ static bool VerifyDestImageLayout(VkCommandBuffer cmdBuffer, VkImage destImage,
 
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(cmdBuffer), layer_data_map);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, cmdBuffer);
-    for (uint32_t i = 0; i < subLayers.layerCount; ++i) {
-        uint32_t layer = i + subLayers.baseArrayLayer;
-        VkImageSubresource sub = {subLayers.aspectMask, subLayers.mipLevel, layer};
-        IMAGE_CMD_BUF_LAYOUT_NODE node;
-        if (!FindLayout(pCB, destImage, sub, node)) {
-            SetLayout(pCB, destImage, sub, IMAGE_CMD_BUF_LAYOUT_NODE(destImageLayout, destImageLayout));
-            continue;
-        }
-        if (node.layout != destImageLayout) {
+    VkImageSubresourceRange range = {subLayers.aspectMask, subLayers.mipLevel, 1, subLayers.baseArrayLayer, subLayers.layerCount};
+    UpdateCBImageLayouts(dev_data, pCB, destImage, range,
+                         [&](uint64_t, uint64_t, const IMAGE_CMD_BUF_LAYOUT_NODE *node) -> IMAGE_CMD_BUF_LAYOUT_NODE {
+        if (!node)
+            return IMAGE_CMD_BUF_LAYOUT_NODE(destImageLayout, destImageLayout);
+        if (node->layout != destImageLayout) {
             skip_call |=
                 log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT, 0,
                         __LINE__, DRAWSTATE_INVALID_IMAGE_LAYOUT, "DS", "Cannot copy from an image whose dest layout is %s and "
                                                                         "doesn't match the current layout %s.",
-                        string_VkImageLayout(destImageLayout), string_VkImageLayout(node.layout));
+                        string_VkImageLayout(destImageLayout), string_VkImageLayout(node->layout));
         }
-    }
+        return *node;
+    });
     if (destImageLayout != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
         if (destImageLayout == VK_IMAGE_LAYOUT_GENERAL) {
             // LAYOUT_GENERAL is allowed, but may not be performance optimal, flag as perf warning.
@@ -6998,9 +7924,10 @@ static bool VerifyDestImageLayout(VkCommandBuffer cmdBuffer, VkImage destImage,
 VKAPI_ATTR void VKAPI_CALL
 CmdCopyImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage,
              VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageCopy *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdCopyImage");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     VkDeviceMemory src_mem, dst_mem;
     // Validate that src & dst images have correct usage flags set
     skipCall = get_mem_binding_from_object(dev_data, (uint64_t)srcImage, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT, &src_mem);
@@ -7014,15 +7941,8 @@ CmdCopyImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcI
                                            "vkCmdCopyImage()", "VK_IMAGE_USAGE_TRANSFER_DST_BIT");
     auto cb_data = dev_data->commandBufferMap.find(commandBuffer);
     if (cb_data != dev_data->commandBufferMap.end()) {
-        std::function<bool()> function = [=]() {
-            return validate_memory_is_valid(dev_data, src_mem, "vkCmdCopyImage()", srcImage);
-        };
-        cb_data->second->validate_functions.push_back(function);
-        function = [=]() {
-            set_memory_valid(dev_data, dst_mem, true, dstImage);
-            return false;
-        };
-        cb_data->second->validate_functions.push_back(function);
+        deferValidateMemory(cb_data->second, src_mem, "vkCmdCopyImage()", srcImage);
+        deferSetMemoryValid(cb_data->second, dst_mem, true, dstImage);
 
         skipCall |= addCmd(dev_data, cb_data->second, CMD_COPYIMAGE, "vkCmdCopyImage()");
         skipCall |= insideRenderPass(dev_data, cb_data->second, "vkCmdCopyImage");
@@ -7033,16 +7953,17 @@ CmdCopyImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcI
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdCopyImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout,
-                                                      regionCount, pRegions);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdCopyImage(
+            commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdBlitImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage,
              VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageBlit *pRegions, VkFilter filter) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBlitImage");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     VkDeviceMemory src_mem, dst_mem;
     // Validate that src & dst images have correct usage flags set
     skipCall = get_mem_binding_from_object(dev_data, (uint64_t)srcImage, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT, &src_mem);
@@ -7057,31 +7978,25 @@ CmdBlitImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcI
 
     auto cb_data = dev_data->commandBufferMap.find(commandBuffer);
     if (cb_data != dev_data->commandBufferMap.end()) {
-        std::function<bool()> function = [=]() {
-            return validate_memory_is_valid(dev_data, src_mem, "vkCmdBlitImage()", srcImage);
-        };
-        cb_data->second->validate_functions.push_back(function);
-        function = [=]() {
-            set_memory_valid(dev_data, dst_mem, true, dstImage);
-            return false;
-        };
-        cb_data->second->validate_functions.push_back(function);
+        deferValidateMemory(cb_data->second, src_mem, "vkCmdBlitImage()", srcImage);
+        deferSetMemoryValid(cb_data->second, dst_mem, true, dstImage);
 
         skipCall |= addCmd(dev_data, cb_data->second, CMD_BLITIMAGE, "vkCmdBlitImage()");
         skipCall |= insideRenderPass(dev_data, cb_data->second, "vkCmdBlitImage");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdBlitImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout,
-                                                      regionCount, pRegions, filter);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdBlitImage(
+            commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions, filter));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer srcBuffer,
                                                 VkImage dstImage, VkImageLayout dstImageLayout,
                                                 uint32_t regionCount, const VkBufferImageCopy *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdCopyBufferToImage");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     VkDeviceMemory dst_mem, src_mem;
     skipCall = get_mem_binding_from_object(dev_data, (uint64_t)dstImage, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT, &dst_mem);
     skipCall |= update_cmd_buf_and_mem_references(dev_data, commandBuffer, dst_mem, "vkCmdCopyBufferToImage");
@@ -7095,13 +8010,8 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImage(VkCommandBuffer commandBuffer, V
                                            "VK_IMAGE_USAGE_TRANSFER_DST_BIT");
     auto cb_data = dev_data->commandBufferMap.find(commandBuffer);
     if (cb_data != dev_data->commandBufferMap.end()) {
-        std::function<bool()> function = [=]() {
-            set_memory_valid(dev_data, dst_mem, true, dstImage);
-            return false;
-        };
-        cb_data->second->validate_functions.push_back(function);
-        function = [=]() { return validate_memory_is_valid(dev_data, src_mem, "vkCmdCopyBufferToImage()"); };
-        cb_data->second->validate_functions.push_back(function);
+        deferSetMemoryValid(cb_data->second, dst_mem, true, dstImage);
+        deferValidateMemory(cb_data->second, src_mem, "vkCmdCopyBufferToImage()");
 
         skipCall |= addCmd(dev_data, cb_data->second, CMD_COPYBUFFERTOIMAGE, "vkCmdCopyBufferToImage()");
         skipCall |= insideRenderPass(dev_data, cb_data->second, "vkCmdCopyBufferToImage");
@@ -7111,16 +8021,17 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImage(VkCommandBuffer commandBuffer, V
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdCopyBufferToImage(commandBuffer, srcBuffer, dstImage, dstImageLayout, regionCount,
-                                                              pRegions);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdCopyBufferToImage(
+            commandBuffer, srcBuffer, dstImage, dstImageLayout, regionCount, pRegions));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdCopyImageToBuffer(VkCommandBuffer commandBuffer, VkImage srcImage,
                                                 VkImageLayout srcImageLayout, VkBuffer dstBuffer,
                                                 uint32_t regionCount, const VkBufferImageCopy *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdCopyImageToBuffer");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     VkDeviceMemory src_mem, dst_mem;
     skipCall = get_mem_binding_from_object(dev_data, (uint64_t)srcImage, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT, &src_mem);
     skipCall |= update_cmd_buf_and_mem_references(dev_data, commandBuffer, src_mem, "vkCmdCopyImageToBuffer");
@@ -7135,15 +8046,8 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyImageToBuffer(VkCommandBuffer commandBuffer, V
 
     auto cb_data = dev_data->commandBufferMap.find(commandBuffer);
     if (cb_data != dev_data->commandBufferMap.end()) {
-        std::function<bool()> function = [=]() {
-            return validate_memory_is_valid(dev_data, src_mem, "vkCmdCopyImageToBuffer()", srcImage);
-        };
-        cb_data->second->validate_functions.push_back(function);
-        function = [=]() {
-            set_memory_valid(dev_data, dst_mem, true);
-            return false;
-        };
-        cb_data->second->validate_functions.push_back(function);
+        deferValidateMemory(cb_data->second, src_mem, "vkCmdCopyImageToBuffer()", srcImage);
+        deferSetMemoryValid(cb_data->second, dst_mem, true);
 
         skipCall |= addCmd(dev_data, cb_data->second, CMD_COPYIMAGETOBUFFER, "vkCmdCopyImageToBuffer()");
         skipCall |= insideRenderPass(dev_data, cb_data->second, "vkCmdCopyImageToBuffer");
@@ -7153,15 +8057,16 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyImageToBuffer(VkCommandBuffer commandBuffer, V
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdCopyImageToBuffer(commandBuffer, srcImage, srcImageLayout, dstBuffer, regionCount,
-                                                              pRegions);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdCopyImageToBuffer(
+            commandBuffer, srcImage, srcImageLayout, dstBuffer, regionCount, pRegions));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdUpdateBuffer(VkCommandBuffer commandBuffer, VkBuffer dstBuffer,
                                            VkDeviceSize dstOffset, VkDeviceSize dataSize, const uint32_t *pData) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdUpdateBuffer");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     VkDeviceMemory mem;
     skipCall =
         get_mem_binding_from_object(dev_data, (uint64_t)dstBuffer, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, &mem);
@@ -7172,25 +8077,23 @@ VKAPI_ATTR void VKAPI_CALL CmdUpdateBuffer(VkCommandBuffer commandBuffer, VkBuff
 
     auto cb_data = dev_data->commandBufferMap.find(commandBuffer);
     if (cb_data != dev_data->commandBufferMap.end()) {
-        std::function<bool()> function = [=]() {
-            set_memory_valid(dev_data, mem, true);
-            return false;
-        };
-        cb_data->second->validate_functions.push_back(function);
+        deferSetMemoryValid(cb_data->second, mem, true);
 
         skipCall |= addCmd(dev_data, cb_data->second, CMD_UPDATEBUFFER, "vkCmdUpdateBuffer()");
         skipCall |= insideRenderPass(dev_data, cb_data->second, "vkCmdCopyUpdateBuffer");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdUpdateBuffer(commandBuffer, dstBuffer, dstOffset, dataSize, pData);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdUpdateBuffer(commandBuffer, dstBuffer, dstOffset,
+                                                                                          dataSize, pData));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdFillBuffer(VkCommandBuffer commandBuffer, VkBuffer dstBuffer, VkDeviceSize dstOffset, VkDeviceSize size, uint32_t data) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdFillBuffer");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     VkDeviceMemory mem;
     skipCall =
         get_mem_binding_from_object(dev_data, (uint64_t)dstBuffer, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, &mem);
@@ -7201,26 +8104,29 @@ CmdFillBuffer(VkCommandBuffer commandBuffer, VkBuffer dstBuffer, VkDeviceSize ds
 
     auto cb_data = dev_data->commandBufferMap.find(commandBuffer);
     if (cb_data != dev_data->commandBufferMap.end()) {
-        std::function<bool()> function = [=]() {
-            set_memory_valid(dev_data, mem, true);
-            return false;
-        };
-        cb_data->second->validate_functions.push_back(function);
+        deferSetMemoryValid(cb_data->second, mem, true);
 
         skipCall |= addCmd(dev_data, cb_data->second, CMD_FILLBUFFER, "vkCmdFillBuffer()");
         skipCall |= insideRenderPass(dev_data, cb_data->second, "vkCmdCopyFillBuffer");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdFillBuffer(commandBuffer, dstBuffer, dstOffset, size, data);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdFillBuffer(commandBuffer, dstBuffer, dstOffset, size,
+                                                                                        data));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdClearAttachments(VkCommandBuffer commandBuffer, uint32_t attachmentCount,
                                                const VkClearAttachment *pAttachments, uint32_t rectCount,
                                                const VkClearRect *pRects) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdClearAttachments");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    if (dev_data->submitOnlyValidation) {
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdClearAttachments(commandBuffer, attachmentCount,
+                                                                                              pAttachments, rectCount, pRects));
+        return;
+    }
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_CLEARATTACHMENTS, "vkCmdClearAttachments()");
@@ -7282,69 +8188,66 @@ VKAPI_ATTR void VKAPI_CALL CmdClearAttachments(VkCommandBuffer commandBuffer, ui
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdClearAttachments(commandBuffer, attachmentCount, pAttachments, rectCount, pRects);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdClearAttachments(commandBuffer, attachmentCount,
+                                                                                              pAttachments, rectCount, pRects));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdClearColorImage(VkCommandBuffer commandBuffer, VkImage image,
                                               VkImageLayout imageLayout, const VkClearColorValue *pColor,
                                               uint32_t rangeCount, const VkImageSubresourceRange *pRanges) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdClearColorImage");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     // TODO : Verify memory is in VK_IMAGE_STATE_CLEAR state
     VkDeviceMemory mem;
     skipCall = get_mem_binding_from_object(dev_data, (uint64_t)image, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT, &mem);
     skipCall |= update_cmd_buf_and_mem_references(dev_data, commandBuffer, mem, "vkCmdClearColorImage");
     auto cb_data = dev_data->commandBufferMap.find(commandBuffer);
     if (cb_data != dev_data->commandBufferMap.end()) {
-        std::function<bool()> function = [=]() {
-            set_memory_valid(dev_data, mem, true, image);
-            return false;
-        };
-        cb_data->second->validate_functions.push_back(function);
+        deferSetMemoryValid(cb_data->second, mem, true, image);
 
         skipCall |= addCmd(dev_data, cb_data->second, CMD_CLEARCOLORIMAGE, "vkCmdClearColorImage()");
         skipCall |= insideRenderPass(dev_data, cb_data->second, "vkCmdClearColorImage");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdClearColorImage(commandBuffer, image, imageLayout, pColor, rangeCount, pRanges);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdClearColorImage(commandBuffer, image, imageLayout,
+                                                                                             pColor, rangeCount, pRanges));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdClearDepthStencilImage(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout imageLayout,
                           const VkClearDepthStencilValue *pDepthStencil, uint32_t rangeCount,
                           const VkImageSubresourceRange *pRanges) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdClearDepthStencilImage");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     // TODO : Verify memory is in VK_IMAGE_STATE_CLEAR state
     VkDeviceMemory mem;
     skipCall = get_mem_binding_from_object(dev_data, (uint64_t)image, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT, &mem);
     skipCall |= update_cmd_buf_and_mem_references(dev_data, commandBuffer, mem, "vkCmdClearDepthStencilImage");
     auto cb_data = dev_data->commandBufferMap.find(commandBuffer);
     if (cb_data != dev_data->commandBufferMap.end()) {
-        std::function<bool()> function = [=]() {
-            set_memory_valid(dev_data, mem, true, image);
-            return false;
-        };
-        cb_data->second->validate_functions.push_back(function);
+        deferSetMemoryValid(cb_data->second, mem, true, image);
 
         skipCall |= addCmd(dev_data, cb_data->second, CMD_CLEARDEPTHSTENCILIMAGE, "vkCmdClearDepthStencilImage()");
         skipCall |= insideRenderPass(dev_data, cb_data->second, "vkCmdClearDepthStencilImage");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdClearDepthStencilImage(commandBuffer, image, imageLayout, pDepthStencil, rangeCount,
-                                                                   pRanges);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdClearDepthStencilImage(
+            commandBuffer, image, imageLayout, pDepthStencil, rangeCount, pRanges));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdResolveImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage,
                 VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageResolve *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdResolveImage");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     VkDeviceMemory src_mem, dst_mem;
     skipCall = get_mem_binding_from_object(dev_data, (uint64_t)srcImage, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT, &src_mem);
     skipCall |= update_cmd_buf_and_mem_references(dev_data, commandBuffer, src_mem, "vkCmdResolveImage");
@@ -7353,43 +8256,24 @@ CmdResolveImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout s
     skipCall |= update_cmd_buf_and_mem_references(dev_data, commandBuffer, dst_mem, "vkCmdResolveImage");
     auto cb_data = dev_data->commandBufferMap.find(commandBuffer);
     if (cb_data != dev_data->commandBufferMap.end()) {
-        std::function<bool()> function = [=]() {
-            return validate_memory_is_valid(dev_data, src_mem, "vkCmdResolveImage()", srcImage);
-        };
-        cb_data->second->validate_functions.push_back(function);
-        function = [=]() {
-            set_memory_valid(dev_data, dst_mem, true, dstImage);
-            return false;
-        };
-        cb_data->second->validate_functions.push_back(function);
+        deferValidateMemory(cb_data->second, src_mem, "vkCmdResolveImage()", srcImage);
+        deferSetMemoryValid(cb_data->second, dst_mem, true, dstImage);
 
         skipCall |= addCmd(dev_data, cb_data->second, CMD_RESOLVEIMAGE, "vkCmdResolveImage()");
         skipCall |= insideRenderPass(dev_data, cb_data->second, "vkCmdResolveImage");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdResolveImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout,
-                                                         regionCount, pRegions);
-}
-
-bool setEventStageMask(VkQueue queue, VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags stageMask) {
-    layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
-    if (pCB) {
-        pCB->eventToStageMap[event] = stageMask;
-    }
-    auto queue_data = dev_data->queueMap.find(queue);
-    if (queue_data != dev_data->queueMap.end()) {
-        queue_data->second.eventToStageMap[event] = stageMask;
-    }
-    return false;
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdResolveImage(
+            commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags stageMask) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetEvent");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_SETEVENT, "vkCmdSetEvent()");
@@ -7398,20 +8282,19 @@ CmdSetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags s
         if (!pCB->waitedEvents.count(event)) {
             pCB->writeEventsBeforeWait.push_back(event);
         }
-        std::function<bool(VkQueue)> eventUpdate =
-            std::bind(setEventStageMask, std::placeholders::_1, commandBuffer, event, stageMask);
-        pCB->eventUpdates.push_back(eventUpdate);
+        pCB->eventUpdates.push_back({DEFERRED_EVENT_OP::SET, event, stageMask, 0, 0});
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdSetEvent(commandBuffer, event, stageMask);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdSetEvent(commandBuffer, event, stageMask));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdResetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags stageMask) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdResetEvent");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_RESETEVENT, "vkCmdResetEvent()");
@@ -7420,13 +8303,11 @@ CmdResetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags
         if (!pCB->waitedEvents.count(event)) {
             pCB->writeEventsBeforeWait.push_back(event);
         }
-        std::function<bool(VkQueue)> eventUpdate =
-            std::bind(setEventStageMask, std::placeholders::_1, commandBuffer, event, VkPipelineStageFlags(0));
-        pCB->eventUpdates.push_back(eventUpdate);
+        pCB->eventUpdates.push_back({DEFERRED_EVENT_OP::SET, event, VkPipelineStageFlags(0), 0, 0});
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdResetEvent(commandBuffer, event, stageMask);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdResetEvent(commandBuffer, event, stageMask));
 }
 
 static bool TransitionImageLayouts(VkCommandBuffer cmdBuffer, uint32_t memBarrierCount,
@@ -7434,39 +8315,25 @@ static bool TransitionImageLayouts(VkCommandBuffer cmdBuffer, uint32_t memBarrie
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(cmdBuffer), layer_data_map);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, cmdBuffer);
     bool skip = false;
-    uint32_t levelCount = 0;
-    uint32_t layerCount = 0;
 
     for (uint32_t i = 0; i < memBarrierCount; ++i) {
         auto mem_barrier = &pImgMemBarriers[i];
         if (!mem_barrier)
             continue;
-        // TODO: Do not iterate over every possibility - consolidate where
-        // possible
-        ResolveRemainingLevelsLayers(dev_data, &levelCount, &layerCount, mem_barrier->subresourceRange, mem_barrier->image);
-
-        for (uint32_t j = 0; j < levelCount; j++) {
-            uint32_t level = mem_barrier->subresourceRange.baseMipLevel + j;
-            for (uint32_t k = 0; k < layerCount; k++) {
-                uint32_t layer = mem_barrier->subresourceRange.baseArrayLayer + k;
-                VkImageSubresource sub = {mem_barrier->subresourceRange.aspectMask, level, layer};
-                IMAGE_CMD_BUF_LAYOUT_NODE node;
-                if (!FindLayout(pCB, mem_barrier->image, sub, node)) {
-                    SetLayout(pCB, mem_barrier->image, sub,
-                              IMAGE_CMD_BUF_LAYOUT_NODE(mem_barrier->oldLayout, mem_barrier->newLayout));
-                    continue;
-                }
-                if (mem_barrier->oldLayout == VK_IMAGE_LAYOUT_UNDEFINED) {
-                    // TODO: Set memory invalid which is in mem_tracker currently
-                } else if (node.layout != mem_barrier->oldLayout) {
-                    skip |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0,
-                                    __LINE__, DRAWSTATE_INVALID_IMAGE_LAYOUT, "DS", "You cannot transition the layout from %s "
-                                                                                    "when current layout is %s.",
-                                    string_VkImageLayout(mem_barrier->oldLayout), string_VkImageLayout(node.layout));
-                }
-                SetLayout(pCB, mem_barrier->image, sub, mem_barrier->newLayout);
+        UpdateCBImageLayouts(dev_data, pCB, mem_barrier->image, mem_barrier->subresourceRange,
+                             [&](uint64_t, uint64_t, const IMAGE_CMD_BUF_LAYOUT_NODE *node) -> IMAGE_CMD_BUF_LAYOUT_NODE {
+            if (!node)
+                return IMAGE_CMD_BUF_LAYOUT_NODE(mem_barrier->oldLayout, mem_barrier->newLayout);
+            if (mem_barrier->oldLayout == VK_IMAGE_LAYOUT_UNDEFINED) {
+                // TODO: Set memory invalid which is in mem_tracker currently
+            } else if (node->layout != mem_barrier->oldLayout) {
+                skip |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0, __LINE__,
+                                DRAWSTATE_INVALID_IMAGE_LAYOUT, "DS", "You cannot transition the layout from %s "
+                                                                      "when current layout is %s.",
+                                string_VkImageLayout(mem_barrier->oldLayout), string_VkImageLayout(node->layout));
             }
-        }
+            return IMAGE_CMD_BUF_LAYOUT_NODE(node->initialLayout, mem_barrier->newLayout);
+        });
     }
     return skip;
 }
@@ -7760,52 +8627,15 @@ static bool ValidateBarriers(const char *funcName, VkCommandBuffer cmdBuffer, ui
     return skip_call;
 }
 
-bool validateEventStageMask(VkQueue queue, GLOBAL_CB_NODE *pCB, uint32_t eventCount, size_t firstEventIndex, VkPipelineStageFlags sourceStageMask) {
-    bool skip_call = false;
-    VkPipelineStageFlags stageMask = 0;
-    layer_data *dev_data = get_my_data_ptr(get_dispatch_key(queue), layer_data_map);
-    for (uint32_t i = 0; i < eventCount; ++i) {
-        auto event = pCB->events[firstEventIndex + i];
-        auto queue_data = dev_data->queueMap.find(queue);
-        if (queue_data == dev_data->queueMap.end())
-            return false;
-        auto event_data = queue_data->second.eventToStageMap.find(event);
-        if (event_data != queue_data->second.eventToStageMap.end()) {
-            stageMask |= event_data->second;
-        } else {
-            auto global_event_data = dev_data->eventMap.find(event);
-            if (global_event_data == dev_data->eventMap.end()) {
-                skip_call |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_EVENT_EXT,
-                                     reinterpret_cast<const uint64_t &>(event), __LINE__, DRAWSTATE_INVALID_EVENT, "DS",
-                                     "Event 0x%" PRIx64 " cannot be waited on if it has never been set.",
-                                     reinterpret_cast<const uint64_t &>(event));
-            } else {
-                stageMask |= global_event_data->second.stageMask;
-            }
-        }
-    }
-    // TODO: Need to validate that host_bit is only set if set event is called
-    // but set event can be called at any time.
-    if (sourceStageMask != stageMask && sourceStageMask != (stageMask | VK_PIPELINE_STAGE_HOST_BIT)) {
-        skip_call |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0, __LINE__,
-                             DRAWSTATE_INVALID_EVENT, "DS", "Submitting cmdbuffer with call to VkCmdWaitEvents "
-                                                            "using srcStageMask 0x%x which must be the bitwise "
-                                                            "OR of the stageMask parameters used in calls to "
-                                                            "vkCmdSetEvent and VK_PIPELINE_STAGE_HOST_BIT if "
-                                                            "used with vkSetEvent but instead is 0x%x.",
-                             sourceStageMask, stageMask);
-    }
-    return skip_call;
-}
-
 VKAPI_ATTR void VKAPI_CALL
 CmdWaitEvents(VkCommandBuffer commandBuffer, uint32_t eventCount, const VkEvent *pEvents, VkPipelineStageFlags sourceStageMask,
               VkPipelineStageFlags dstStageMask, uint32_t memoryBarrierCount, const VkMemoryBarrier *pMemoryBarriers,
               uint32_t bufferMemoryBarrierCount, const VkBufferMemoryBarrier *pBufferMemoryBarriers,
               uint32_t imageMemoryBarrierCount, const VkImageMemoryBarrier *pImageMemoryBarriers) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdWaitEvents");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         auto firstEventIndex = pCB->events.size();
@@ -7813,24 +8643,23 @@ CmdWaitEvents(VkCommandBuffer commandBuffer, uint32_t eventCount, const VkEvent
             pCB->waitedEvents.insert(pEvents[i]);
             pCB->events.push_back(pEvents[i]);
         }
-        std::function<bool(VkQueue)> eventUpdate =
-            std::bind(validateEventStageMask, std::placeholders::_1, pCB, eventCount, firstEventIndex, sourceStageMask);
-        pCB->eventUpdates.push_back(eventUpdate);
+        pCB->eventUpdates.push_back({DEFERRED_EVENT_OP::WAIT, VK_NULL_HANDLE, sourceStageMask, eventCount, firstEventIndex});
         if (pCB->state == CB_RECORDING) {
             skipCall |= addCmd(dev_data, pCB, CMD_WAITEVENTS, "vkCmdWaitEvents()");
         } else {
             skipCall |= report_error_no_cb_begin(dev_data, commandBuffer, "vkCmdWaitEvents()");
         }
         skipCall |= TransitionImageLayouts(commandBuffer, imageMemoryBarrierCount, pImageMemoryBarriers);
-        skipCall |=
-            ValidateBarriers("vkCmdWaitEvents", commandBuffer, memoryBarrierCount, pMemoryBarriers, bufferMemoryBarrierCount,
-                             pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers);
+        if (checkEnabled(dev_data, CHECK_BARRIERS))
+            skipCall |= ValidateBarriers("vkCmdWaitEvents", commandBuffer, memoryBarrierCount, pMemoryBarriers,
+                                         bufferMemoryBarrierCount, pBufferMemoryBarriers, imageMemoryBarrierCount,
+                                         pImageMemoryBarriers);
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdWaitEvents(commandBuffer, eventCount, pEvents, sourceStageMask, dstStageMask,
-                                                       memoryBarrierCount, pMemoryBarriers, bufferMemoryBarrierCount,
-                                                       pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdWaitEvents(
+            commandBuffer, eventCount, pEvents, sourceStageMask, dstStageMask, memoryBarrierCount, pMemoryBarriers,
+            bufferMemoryBarrierCount, pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers));
 }
 
 VKAPI_ATTR void VKAPI_CALL
@@ -7838,73 +8667,65 @@ CmdPipelineBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStageM
                    VkDependencyFlags dependencyFlags, uint32_t memoryBarrierCount, const VkMemoryBarrier *pMemoryBarriers,
                    uint32_t bufferMemoryBarrierCount, const VkBufferMemoryBarrier *pBufferMemoryBarriers,
                    uint32_t imageMemoryBarrierCount, const VkImageMemoryBarrier *pImageMemoryBarriers) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdPipelineBarrier");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= addCmd(dev_data, pCB, CMD_PIPELINEBARRIER, "vkCmdPipelineBarrier()");
         skipCall |= TransitionImageLayouts(commandBuffer, imageMemoryBarrierCount, pImageMemoryBarriers);
-        skipCall |=
-            ValidateBarriers("vkCmdPipelineBarrier", commandBuffer, memoryBarrierCount, pMemoryBarriers, bufferMemoryBarrierCount,
-                             pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers);
+        if (checkEnabled(dev_data, CHECK_BARRIERS))
+            skipCall |= ValidateBarriers("vkCmdPipelineBarrier", commandBuffer, memoryBarrierCount, pMemoryBarriers,
+                                         bufferMemoryBarrierCount, pBufferMemoryBarriers, imageMemoryBarrierCount,
+                                         pImageMemoryBarriers);
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, dependencyFlags,
-                                                            memoryBarrierCount, pMemoryBarriers, bufferMemoryBarrierCount,
-                                                            pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers);
-}
-
-bool setQueryState(VkQueue queue, VkCommandBuffer commandBuffer, QueryObject object, bool value) {
-    layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
-    if (pCB) {
-        pCB->queryToStateMap[object] = value;
-    }
-    auto queue_data = dev_data->queueMap.find(queue);
-    if (queue_data != dev_data->queueMap.end()) {
-        queue_data->second.queryToStateMap[object] = value;
-    }
-    return false;
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdPipelineBarrier(
+            commandBuffer, srcStageMask, dstStageMask, dependencyFlags, memoryBarrierCount, pMemoryBarriers,
+            bufferMemoryBarrierCount, pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdBeginQuery(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t slot, VkFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBeginQuery");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
-        QueryObject query = {queryPool, slot};
-        pCB->activeQueries.insert(query);
-        if (!pCB->startedQueries.count(query)) {
-            pCB->startedQueries.insert(query);
+        if (validateQueryRange(dev_data, queryPool, slot, 1, "vkCmdBeginQuery()")) {
+            skipCall = true;
+        } else {
+            uint32_t pool_size = getQueryPoolSize(dev_data, queryPool);
+            pCB->activeQueries[queryPool].Set(slot, 1, true, pool_size);
+            pCB->startedQueries[queryPool].Set(slot, 1, true, pool_size);
         }
         skipCall |= addCmd(dev_data, pCB, CMD_BEGINQUERY, "vkCmdBeginQuery()");
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdBeginQuery(commandBuffer, queryPool, slot, flags);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdBeginQuery(commandBuffer, queryPool, slot, flags));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdEndQuery(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t slot) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdEndQuery");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
-        QueryObject query = {queryPool, slot};
-        if (!pCB->activeQueries.count(query)) {
+        auto pool_queries = pCB->activeQueries.find(queryPool);
+        if (pool_queries == pCB->activeQueries.end() || !pool_queries->second.Test(slot)) {
             skipCall |=
                 log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0, __LINE__,
                         DRAWSTATE_INVALID_QUERY, "DS", "Ending a query before it was started: queryPool 0x%" PRIx64 ", index %d",
                         (uint64_t)(queryPool), slot);
         } else {
-            pCB->activeQueries.erase(query);
+            pool_queries->second.Set(slot, 1, false, getQueryPoolSize(dev_data, queryPool));
         }
-        std::function<bool(VkQueue)> queryUpdate = std::bind(setQueryState, std::placeholders::_1, commandBuffer, query, true);
-        pCB->queryUpdates.push_back(queryUpdate);
+        pCB->queryUpdates.push_back({DEFERRED_QUERY_OP::SET_AVAILABLE, queryPool, slot, 1});
         if (pCB->state == CB_RECORDING) {
             skipCall |= addCmd(dev_data, pCB, CMD_ENDQUERY, "VkCmdEndQuery()");
         } else {
@@ -7913,21 +8734,22 @@ VKAPI_ATTR void VKAPI_CALL CmdEndQuery(VkCommandBuffer commandBuffer, VkQueryPoo
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdEndQuery(commandBuffer, queryPool, slot);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdEndQuery(commandBuffer, queryPool, slot));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdResetQueryPool(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t firstQuery, uint32_t queryCount) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdResetQueryPool");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
-        for (uint32_t i = 0; i < queryCount; i++) {
-            QueryObject query = {queryPool, firstQuery + i};
-            pCB->waitedEventsBeforeQueryReset[query] = pCB->waitedEvents;
-            std::function<bool(VkQueue)> queryUpdate = std::bind(setQueryState, std::placeholders::_1, commandBuffer, query, false);
-            pCB->queryUpdates.push_back(queryUpdate);
+        if (validateQueryRange(dev_data, queryPool, firstQuery, queryCount, "vkCmdResetQueryPool()")) {
+            skipCall = true;
+        } else {
+            pCB->waitedEventsBeforeQueryReset.push_back({queryPool, firstQuery, queryCount, pCB->waitedEvents});
+            pCB->queryUpdates.push_back({DEFERRED_QUERY_OP::SET_UNAVAILABLE, queryPool, firstQuery, queryCount});
         }
         if (pCB->state == CB_RECORDING) {
             skipCall |= addCmd(dev_data, pCB, CMD_RESETQUERYPOOL, "VkCmdResetQueryPool()");
@@ -7938,49 +8760,17 @@ CmdResetQueryPool(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdResetQueryPool(commandBuffer, queryPool, firstQuery, queryCount);
-}
-
-bool validateQuery(VkQueue queue, GLOBAL_CB_NODE *pCB, VkQueryPool queryPool, uint32_t queryCount, uint32_t firstQuery) {
-    bool skip_call = false;
-    layer_data *dev_data = get_my_data_ptr(get_dispatch_key(pCB->commandBuffer), layer_data_map);
-    auto queue_data = dev_data->queueMap.find(queue);
-    if (queue_data == dev_data->queueMap.end())
-        return false;
-    for (uint32_t i = 0; i < queryCount; i++) {
-        QueryObject query = {queryPool, firstQuery + i};
-        auto query_data = queue_data->second.queryToStateMap.find(query);
-        bool fail = false;
-        if (query_data != queue_data->second.queryToStateMap.end()) {
-            if (!query_data->second) {
-                fail = true;
-            }
-        } else {
-            auto global_query_data = dev_data->queryToStateMap.find(query);
-            if (global_query_data != dev_data->queryToStateMap.end()) {
-                if (!global_query_data->second) {
-                    fail = true;
-                }
-            } else {
-                fail = true;
-            }
-        }
-        if (fail) {
-            skip_call |= log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0, __LINE__,
-                                 DRAWSTATE_INVALID_QUERY, "DS",
-                                 "Requesting a copy from query to buffer with invalid query: queryPool 0x%" PRIx64 ", index %d",
-                                 reinterpret_cast<uint64_t &>(queryPool), firstQuery + i);
-        }
-    }
-    return skip_call;
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdResetQueryPool(commandBuffer, queryPool, firstQuery,
+                                                                                            queryCount));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdCopyQueryPoolResults(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t firstQuery, uint32_t queryCount,
                         VkBuffer dstBuffer, VkDeviceSize dstOffset, VkDeviceSize stride, VkQueryResultFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdCopyQueryPoolResults");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
 #if MTMERGESOURCE
     VkDeviceMemory mem;
@@ -7988,11 +8778,7 @@ CmdCopyQueryPoolResults(VkCommandBuffer commandBuffer, VkQueryPool queryPool, ui
     skipCall |=
         get_mem_binding_from_object(dev_data, (uint64_t)dstBuffer, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, &mem);
     if (cb_data != dev_data->commandBufferMap.end()) {
-        std::function<bool()> function = [=]() {
-            set_memory_valid(dev_data, mem, true);
-            return false;
-        };
-        cb_data->second->validate_functions.push_back(function);
+        deferSetMemoryValid(cb_data->second, mem, true);
     }
     skipCall |= update_cmd_buf_and_mem_references(dev_data, commandBuffer, mem, "vkCmdCopyQueryPoolResults");
     // Validate that DST buffer has correct usage flags set
@@ -8000,9 +8786,11 @@ CmdCopyQueryPoolResults(VkCommandBuffer commandBuffer, VkQueryPool queryPool, ui
                                             "vkCmdCopyQueryPoolResults()", "VK_BUFFER_USAGE_TRANSFER_DST_BIT");
 #endif
     if (pCB) {
-        std::function<bool(VkQueue)> queryUpdate =
-            std::bind(validateQuery, std::placeholders::_1, pCB, queryPool, queryCount, firstQuery);
-        pCB->queryUpdates.push_back(queryUpdate);
+        if (validateQueryRange(dev_data, queryPool, firstQuery, queryCount, "vkCmdCopyQueryPoolResults()")) {
+            skipCall = true;
+        } else {
+            pCB->queryUpdates.push_back({DEFERRED_QUERY_OP::VALIDATE, queryPool, firstQuery, queryCount});
+        }
         if (pCB->state == CB_RECORDING) {
             skipCall |= addCmd(dev_data, pCB, CMD_COPYQUERYPOOLRESULTS, "vkCmdCopyQueryPoolResults()");
         } else {
@@ -8012,16 +8800,22 @@ CmdCopyQueryPoolResults(VkCommandBuffer commandBuffer, VkQueryPool queryPool, ui
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdCopyQueryPoolResults(commandBuffer, queryPool, firstQuery, queryCount, dstBuffer,
-                                                                 dstOffset, stride, flags);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdCopyQueryPoolResults(
+            commandBuffer, queryPool, firstQuery, queryCount, dstBuffer, dstOffset, stride, flags));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdPushConstants(VkCommandBuffer commandBuffer, VkPipelineLayout layout,
                                             VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size,
                                             const void *pValues) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdPushConstants");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    if (dev_data->submitOnlyValidation) {
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdPushConstants(commandBuffer, layout, stageFlags,
+                                                                                           offset, size, pValues));
+        return;
+    }
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         if (pCB->state == CB_RECORDING) {
@@ -8110,19 +8904,23 @@ VKAPI_ATTR void VKAPI_CALL CmdPushConstants(VkCommandBuffer commandBuffer, VkPip
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdPushConstants(commandBuffer, layout, stageFlags, offset, size, pValues);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdPushConstants(commandBuffer, layout, stageFlags,
+                                                                                           offset, size, pValues));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdWriteTimestamp(VkCommandBuffer commandBuffer, VkPipelineStageFlagBits pipelineStage, VkQueryPool queryPool, uint32_t slot) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdWriteTimestamp");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    cb_recording_lock lock(dev_data, commandBuffer);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
-        QueryObject query = {queryPool, slot};
-        std::function<bool(VkQueue)> queryUpdate = std::bind(setQueryState, std::placeholders::_1, commandBuffer, query, true);
-        pCB->queryUpdates.push_back(queryUpdate);
+        if (validateQueryRange(dev_data, queryPool, slot, 1, "vkCmdWriteTimestamp()")) {
+            skipCall = true;
+        } else {
+            pCB->queryUpdates.push_back({DEFERRED_QUERY_OP::SET_AVAILABLE, queryPool, slot, 1});
+        }
         if (pCB->state == CB_RECORDING) {
             skipCall |= addCmd(dev_data, pCB, CMD_WRITETIMESTAMP, "vkCmdWriteTimestamp()");
         } else {
@@ -8131,17 +8929,20 @@ CmdWriteTimestamp(VkCommandBuffer commandBuffer, VkPipelineStageFlagBits pipelin
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdWriteTimestamp(commandBuffer, pipelineStage, queryPool, slot);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdWriteTimestamp(commandBuffer, pipelineStage, queryPool,
+                                                                                            slot));
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateFramebuffer(VkDevice device, const VkFramebufferCreateInfo *pCreateInfo,
                                                  const VkAllocationCallbacks *pAllocator,
                                                  VkFramebuffer *pFramebuffer) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateFramebuffer");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->CreateFramebuffer(device, pCreateInfo, pAllocator, pFramebuffer);
+    VkResult result = LAYER_PROFILE_DISPATCH(
+        profiler, dev_data->device_dispatch_table->CreateFramebuffer(device, pCreateInfo, pAllocator, pFramebuffer));
     if (VK_SUCCESS == result) {
         // Shadow create info and store in map
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
 
         auto & fbNode = dev_data->frameBufferMap[*pFramebuffer];
         fbNode.createInfo = *pCreateInfo;
@@ -8513,6 +9314,7 @@ static bool CreatePassDAG(const layer_data *my_data, VkDevice device, const VkRe
 VKAPI_ATTR VkResult VKAPI_CALL CreateShaderModule(VkDevice device, const VkShaderModuleCreateInfo *pCreateInfo,
                                                   const VkAllocationCallbacks *pAllocator,
                                                   VkShaderModule *pShaderModule) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateShaderModule");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     bool skip_call = false;
 
@@ -8533,14 +9335,32 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateShaderModule(VkDevice device, const VkShade
     spvDiagnosticDestroy(diag);
     spvContextDestroy(ctx);
 
+    /* Parsing trusts the instruction word counts, so only a module the validator accepted is indexed before the call
+     * goes down the chain. The index build never sizes anything from an id above the header bound; report such ids here.
+     */
+    unique_ptr<shader_module> module;
+    if (result == SPV_SUCCESS) {
+        module.reset(new shader_module(pCreateInfo));
+        if (module->out_of_bound_id) {
+            skip_call |= log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VkDebugReportObjectTypeEXT(0), 0,
+                                 __LINE__, SHADER_CHECKER_INCONSISTENT_SPIRV, "SC",
+                                 "SPIR-V module not valid: id %u is not below the id bound %u in the module header",
+                                 module->out_of_bound_id, module->id_bound);
+        }
+    }
+
     if (skip_call)
         return VK_ERROR_VALIDATION_FAILED_EXT;
 
-    VkResult res = my_data->device_dispatch_table->CreateShaderModule(device, pCreateInfo, pAllocator, pShaderModule);
+    VkResult res = LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->CreateShaderModule(device, pCreateInfo,
+                                                                                                       pAllocator, pShaderModule));
 
     if (res == VK_SUCCESS) {
-        std::lock_guard<std::mutex> lock(global_lock);
-        my_data->shaderModuleMap[*pShaderModule] = unique_ptr<shader_module>(new shader_module(pCreateInfo));
+        // A module the validator objected to is only parsed once the driver has accepted it
+        if (!module)
+            module.reset(new shader_module(pCreateInfo));
+        std::lock_guard<rw_lock> lock(global_lock);
+        my_data->shaderModuleMap[*pShaderModule] = std::move(module);
     }
     return res;
 }
@@ -8548,13 +9368,14 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateShaderModule(VkDevice device, const VkShade
 VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass(VkDevice device, const VkRenderPassCreateInfo *pCreateInfo,
                                                 const VkAllocationCallbacks *pAllocator,
                                                 VkRenderPass *pRenderPass) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateRenderPass");
     bool skip_call = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     // Create DAG
     std::vector<bool> has_self_dependency(pCreateInfo->subpassCount);
     std::vector<DAGNode> subpass_to_node(pCreateInfo->subpassCount);
     {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         skip_call |= CreatePassDAG(dev_data, device, pCreateInfo, subpass_to_node, has_self_dependency);
         // Validate
         skip_call |= ValidateLayouts(dev_data, device, pCreateInfo);
@@ -8562,7 +9383,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass(VkDevice device, const VkRenderP
             return VK_ERROR_VALIDATION_FAILED_EXT;
         }
     }
-    VkResult result = dev_data->device_dispatch_table->CreateRenderPass(device, pCreateInfo, pAllocator, pRenderPass);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CreateRenderPass(device, pCreateInfo,
+                                                                                                         pAllocator, pRenderPass));
     if (VK_SUCCESS == result) {
         // TODOSC : Merge in tracking of renderpass from shader_checker
         // Shadow create info and store in map
@@ -8703,7 +9525,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass(VkDevice device, const VkRenderP
         }
 #endif
         {
-            std::lock_guard<std::mutex> lock(global_lock);
+            std::lock_guard<rw_lock> lock(global_lock);
             dev_data->renderPassMap[*pRenderPass] = render_pass;
         }
     }
@@ -8752,32 +9574,23 @@ static bool VerifyFramebufferAndRenderPassLayouts(layer_data *dev_data, GLOBAL_C
         const VkImageView &image_view = framebufferInfo.pAttachments[i];
         auto image_data = getImageViewData(dev_data, image_view);
         assert(image_data);
-        const VkImage &image = image_data->image;
-        const VkImageSubresourceRange &subRange = image_data->subresourceRange;
         IMAGE_CMD_BUF_LAYOUT_NODE newNode = {pRenderPassInfo->pAttachments[i].initialLayout,
                                              pRenderPassInfo->pAttachments[i].initialLayout};
-        // TODO: Do not iterate over every possibility - consolidate where possible
-        for (uint32_t j = 0; j < subRange.levelCount; j++) {
-            uint32_t level = subRange.baseMipLevel + j;
-            for (uint32_t k = 0; k < subRange.layerCount; k++) {
-                uint32_t layer = subRange.baseArrayLayer + k;
-                VkImageSubresource sub = {subRange.aspectMask, level, layer};
-                IMAGE_CMD_BUF_LAYOUT_NODE node;
-                if (!FindLayout(pCB, image, sub, node)) {
-                    SetLayout(pCB, image, sub, newNode);
-                    continue;
-                }
-                if (newNode.layout != node.layout) {
-                    skip_call |=
-                        log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0, __LINE__,
-                                DRAWSTATE_INVALID_RENDERPASS, "DS", "You cannot start a render pass using attachment %i "
-                                                                    "where the "
-                                                                    "initial layout is %s and the layout of the attachment at the "
-                                                                    "start of the render pass is %s. The layouts must match.",
-                                i, string_VkImageLayout(newNode.layout), string_VkImageLayout(node.layout));
-                }
+        UpdateCBImageLayouts(dev_data, pCB, image_data->image, image_data->subresourceRange,
+                             [&](uint64_t, uint64_t, const IMAGE_CMD_BUF_LAYOUT_NODE *node) -> IMAGE_CMD_BUF_LAYOUT_NODE {
+            if (!node)
+                return newNode;
+            if (newNode.layout != node->layout) {
+                skip_call |=
+                    log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0, __LINE__,
+                            DRAWSTATE_INVALID_RENDERPASS, "DS", "You cannot start a render pass using attachment %i "
+                                                                "where the "
+                                                                "initial layout is %s and the layout of the attachment at the "
+                                                                "start of the render pass is %s. The layouts must match.",
+                            i, string_VkImageLayout(newNode.layout), string_VkImageLayout(node->layout));
             }
-        }
+            return *node;
+        });
     }
     return skip_call;
 }
@@ -8855,9 +9668,10 @@ static bool VerifyRenderAreaBounds(const layer_data *my_data, const VkRenderPass
 
 VKAPI_ATTR void VKAPI_CALL
 CmdBeginRenderPass(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo *pRenderPassBegin, VkSubpassContents contents) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBeginRenderPass");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     auto renderPass = pRenderPassBegin ? getRenderPass(dev_data, pRenderPassBegin->renderPass) : nullptr;
     auto framebuffer = pRenderPassBegin ? getFramebuffer(dev_data, pRenderPassBegin->framebuffer) : nullptr;
@@ -8869,28 +9683,14 @@ CmdBeginRenderPass(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo *p
                 MT_FB_ATTACHMENT_INFO &fb_info = framebuffer->attachments[i];
                 if (renderPass->attachments[i].load_op == VK_ATTACHMENT_LOAD_OP_CLEAR) {
                     ++clear_op_count;
-                    std::function<bool()> function = [=]() {
-                        set_memory_valid(dev_data, fb_info.mem, true, fb_info.image);
-                        return false;
-                    };
-                    pCB->validate_functions.push_back(function);
+                    deferSetMemoryValid(pCB, fb_info.mem, true, fb_info.image);
                 } else if (renderPass->attachments[i].load_op == VK_ATTACHMENT_LOAD_OP_DONT_CARE) {
-                    std::function<bool()> function = [=]() {
-                        set_memory_valid(dev_data, fb_info.mem, false, fb_info.image);
-                        return false;
-                    };
-                    pCB->validate_functions.push_back(function);
+                    deferSetMemoryValid(pCB, fb_info.mem, false, fb_info.image);
                 } else if (renderPass->attachments[i].load_op == VK_ATTACHMENT_LOAD_OP_LOAD) {
-                    std::function<bool()> function = [=]() {
-                        return validate_memory_is_valid(dev_data, fb_info.mem, "vkCmdBeginRenderPass()", fb_info.image);
-                    };
-                    pCB->validate_functions.push_back(function);
+                    deferValidateMemory(pCB, fb_info.mem, "vkCmdBeginRenderPass()", fb_info.image);
                 }
                 if (renderPass->attachment_first_read[renderPass->attachments[i].attachment]) {
-                    std::function<bool()> function = [=]() {
-                        return validate_memory_is_valid(dev_data, fb_info.mem, "vkCmdBeginRenderPass()", fb_info.image);
-                    };
-                    pCB->validate_functions.push_back(function);
+                    deferValidateMemory(pCB, fb_info.mem, "vkCmdBeginRenderPass()", fb_info.image);
                 }
             }
             if (clear_op_count > pRenderPassBegin->clearValueCount) {
@@ -8905,7 +9705,8 @@ CmdBeginRenderPass(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo *p
             skipCall |= VerifyRenderAreaBounds(dev_data, pRenderPassBegin);
             skipCall |= VerifyFramebufferAndRenderPassLayouts(dev_data, pCB, pRenderPassBegin);
             skipCall |= insideRenderPass(dev_data, pCB, "vkCmdBeginRenderPass");
-            skipCall |= ValidateDependencies(dev_data, framebuffer, renderPass);
+            if (checkEnabled(dev_data, CHECK_RENDER_PASS_DEPS))
+                skipCall |= ValidateDependencies(dev_data, framebuffer, renderPass);
             pCB->activeRenderPass = renderPass;
             skipCall |= validatePrimaryCommandBuffer(dev_data, pCB, "vkCmdBeginRenderPass");
             skipCall |= addCmd(dev_data, pCB, CMD_BEGINRENDERPASS, "vkCmdBeginRenderPass()");
@@ -8924,14 +9725,16 @@ CmdBeginRenderPass(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo *p
     }
     lock.unlock();
     if (!skipCall) {
-        dev_data->device_dispatch_table->CmdBeginRenderPass(commandBuffer, pRenderPassBegin, contents);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdBeginRenderPass(commandBuffer, pRenderPassBegin,
+                                                                                             contents));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdNextSubpass(VkCommandBuffer commandBuffer, VkSubpassContents contents) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdNextSubpass");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         skipCall |= validatePrimaryCommandBuffer(dev_data, pCB, "vkCmdNextSubpass");
@@ -8943,13 +9746,14 @@ VKAPI_ATTR void VKAPI_CALL CmdNextSubpass(VkCommandBuffer commandBuffer, VkSubpa
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdNextSubpass(commandBuffer, contents);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdNextSubpass(commandBuffer, contents));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdEndRenderPass(VkCommandBuffer commandBuffer) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdEndRenderPass");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     auto pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         RENDER_PASS_NODE* pRPNode = pCB->activeRenderPass;
@@ -8958,17 +9762,9 @@ VKAPI_ATTR void VKAPI_CALL CmdEndRenderPass(VkCommandBuffer commandBuffer) {
             for (size_t i = 0; i < pRPNode->attachments.size(); ++i) {
                 MT_FB_ATTACHMENT_INFO &fb_info = framebuffer->attachments[i];
                 if (pRPNode->attachments[i].store_op == VK_ATTACHMENT_STORE_OP_STORE) {
-                    std::function<bool()> function = [=]() {
-                        set_memory_valid(dev_data, fb_info.mem, true, fb_info.image);
-                        return false;
-                    };
-                    pCB->validate_functions.push_back(function);
+                    deferSetMemoryValid(pCB, fb_info.mem, true, fb_info.image);
                 } else if (pRPNode->attachments[i].store_op == VK_ATTACHMENT_STORE_OP_DONT_CARE) {
-                    std::function<bool()> function = [=]() {
-                        set_memory_valid(dev_data, fb_info.mem, false, fb_info.image);
-                        return false;
-                    };
-                    pCB->validate_functions.push_back(function);
+                    deferSetMemoryValid(pCB, fb_info.mem, false, fb_info.image);
                 }
             }
         }
@@ -8982,7 +9778,7 @@ VKAPI_ATTR void VKAPI_CALL CmdEndRenderPass(VkCommandBuffer commandBuffer) {
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdEndRenderPass(commandBuffer);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdEndRenderPass(commandBuffer));
 }
 
 static bool logInvalidAttachmentMessage(layer_data *dev_data, VkCommandBuffer secondaryBuffer, RENDER_PASS_NODE const *secondaryPass,
@@ -9165,9 +9961,9 @@ static bool validateFramebuffer(layer_data *dev_data, VkCommandBuffer primaryBuf
 static bool validateSecondaryCommandBufferState(layer_data *dev_data, GLOBAL_CB_NODE *pCB, GLOBAL_CB_NODE *pSubCB) {
     bool skipCall = false;
     unordered_set<int> activeTypes;
-    for (auto queryObject : pCB->activeQueries) {
-        auto queryPoolData = dev_data->queryPoolMap.find(queryObject.pool);
-        if (queryPoolData != dev_data->queryPoolMap.end()) {
+    for (auto const &pool_queries : pCB->activeQueries) {
+        auto queryPoolData = dev_data->queryPoolMap.find(pool_queries.first);
+        if (pool_queries.second.Any() && queryPoolData != dev_data->queryPoolMap.end()) {
             if (queryPoolData->second.createInfo.queryType == VK_QUERY_TYPE_PIPELINE_STATISTICS &&
                 pSubCB->beginInfo.pInheritanceInfo) {
                 VkQueryPipelineStatisticFlags cmdBufStatistics = pSubCB->beginInfo.pInheritanceInfo->pipelineStatistics;
@@ -9184,9 +9980,10 @@ static bool validateSecondaryCommandBufferState(layer_data *dev_data, GLOBAL_CB_
             activeTypes.insert(queryPoolData->second.createInfo.queryType);
         }
     }
-    for (auto queryObject : pSubCB->startedQueries) {
-        auto queryPoolData = dev_data->queryPoolMap.find(queryObject.pool);
-        if (queryPoolData != dev_data->queryPoolMap.end() && activeTypes.count(queryPoolData->second.createInfo.queryType)) {
+    for (auto const &pool_queries : pSubCB->startedQueries) {
+        auto queryPoolData = dev_data->queryPoolMap.find(pool_queries.first);
+        if (pool_queries.second.Any() && queryPoolData != dev_data->queryPoolMap.end() &&
+            activeTypes.count(queryPoolData->second.createInfo.queryType)) {
             skipCall |=
                 log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, 0, __LINE__,
                         DRAWSTATE_INVALID_SECONDARY_COMMAND_BUFFER, "DS",
@@ -9202,9 +9999,10 @@ static bool validateSecondaryCommandBufferState(layer_data *dev_data, GLOBAL_CB_
 
 VKAPI_ATTR void VKAPI_CALL
 CmdExecuteCommands(VkCommandBuffer commandBuffer, uint32_t commandBuffersCount, const VkCommandBuffer *pCommandBuffers) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdExecuteCommands");
     bool skipCall = false;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     GLOBAL_CB_NODE *pCB = getCBNode(dev_data, commandBuffer);
     if (pCB) {
         GLOBAL_CB_NODE *pSubCB = NULL;
@@ -9288,7 +10086,7 @@ CmdExecuteCommands(VkCommandBuffer commandBuffer, uint32_t commandBuffersCount,
                     pCB->beginInfo.flags &= ~VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
                 }
             }
-            if (!pCB->activeQueries.empty() && !dev_data->phys_dev_properties.features.inheritedQueries) {
+            if (AnyQueries(pCB->activeQueries) && !dev_data->phys_dev_properties.features.inheritedQueries) {
                 skipCall |=
                     log_msg(dev_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT,
                             reinterpret_cast<uint64_t>(pCommandBuffers[i]), __LINE__, DRAWSTATE_INVALID_COMMAND_BUFFER, "DS",
@@ -9307,7 +10105,8 @@ CmdExecuteCommands(VkCommandBuffer commandBuffer, uint32_t commandBuffersCount,
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->CmdExecuteCommands(commandBuffer, commandBuffersCount, pCommandBuffers);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CmdExecuteCommands(commandBuffer, commandBuffersCount,
+                                                                                             pCommandBuffers));
 }
 
 static bool ValidateMapImageLayouts(VkDevice device, VkDeviceMemory mem) {
@@ -9332,11 +10131,12 @@ static bool ValidateMapImageLayouts(VkDevice device, VkDeviceMemory mem) {
 
 VKAPI_ATTR VkResult VKAPI_CALL
 MapMemory(VkDevice device, VkDeviceMemory mem, VkDeviceSize offset, VkDeviceSize size, VkFlags flags, void **ppData) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkMapMemory");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
     bool skip_call = false;
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
 #if MTMERGESOURCE
     DEVICE_MEM_INFO *pMemObj = getMemObjInfo(dev_data, mem);
     if (pMemObj) {
@@ -9355,7 +10155,8 @@ MapMemory(VkDevice device, VkDeviceMemory mem, VkDeviceSize offset, VkDeviceSize
     lock.unlock();
 
     if (!skip_call) {
-        result = dev_data->device_dispatch_table->MapMemory(device, mem, offset, size, flags, ppData);
+        result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->MapMemory(device, mem, offset, size, flags,
+                                                                                             ppData));
         if (VK_SUCCESS == result) {
 #if MTMERGESOURCE
             lock.lock();
@@ -9369,14 +10170,15 @@ MapMemory(VkDevice device, VkDeviceMemory mem, VkDeviceSize offset, VkDeviceSize
 }
 
 VKAPI_ATTR void VKAPI_CALL UnmapMemory(VkDevice device, VkDeviceMemory mem) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkUnmapMemory");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     bool skipCall = false;
 
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     skipCall |= deleteMemRanges(my_data, mem);
     lock.unlock();
     if (!skipCall) {
-        my_data->device_dispatch_table->UnmapMemory(device, mem);
+        LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->UnmapMemory(device, mem));
     }
 }
 
@@ -9418,6 +10220,17 @@ static bool validateAndCopyNoncoherentMemoryToDriver(layer_data *my_data, uint32
     for (uint32_t i = 0; i < memRangeCount; ++i) {
         auto mem_info = getMemObjInfo(my_data, pMemRanges[i].memory);
         if (mem_info) {
+#if !defined(_WIN32)
+            if (mem_info->pGuardedShadow && pMemRanges[i].offset >= mem_info->memRange.offset) {
+                size_t size = (pMemRanges[i].size == VK_WHOLE_SIZE) ? SIZE_MAX : (size_t)pMemRanges[i].size;
+                if (mem_info->pGuardedShadow->flush((size_t)(pMemRanges[i].offset - mem_info->memRange.offset), size)) {
+                    skipCall |= log_msg(my_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                        VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_MEMORY_EXT, (uint64_t)pMemRanges[i].memory, __LINE__,
+                                        MEMTRACK_INVALID_MAP, "MEM", "Memory overflow was detected on mem obj 0x%" PRIxLEAST64,
+                                        (uint64_t)pMemRanges[i].memory);
+                }
+            }
+#endif
             if (mem_info->pData) {
                 VkDeviceSize size = mem_info->memRange.size;
                 VkDeviceSize half_size = (size / 2);
@@ -9447,40 +10260,45 @@ static bool validateAndCopyNoncoherentMemoryToDriver(layer_data *my_data, uint32
 
 VkResult VKAPI_CALL
 FlushMappedMemoryRanges(VkDevice device, uint32_t memRangeCount, const VkMappedMemoryRange *pMemRanges) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkFlushMappedMemoryRanges");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     skipCall |= validateAndCopyNoncoherentMemoryToDriver(my_data, memRangeCount, pMemRanges);
     skipCall |= validateMemoryIsMapped(my_data, "vkFlushMappedMemoryRanges", memRangeCount, pMemRanges);
     lock.unlock();
     if (!skipCall) {
-        result = my_data->device_dispatch_table->FlushMappedMemoryRanges(device, memRangeCount, pMemRanges);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->FlushMappedMemoryRanges(device, memRangeCount,
+                                                                                                          pMemRanges));
     }
     return result;
 }
 
 VkResult VKAPI_CALL
 InvalidateMappedMemoryRanges(VkDevice device, uint32_t memRangeCount, const VkMappedMemoryRange *pMemRanges) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkInvalidateMappedMemoryRanges");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     skipCall |= validateMemoryIsMapped(my_data, "vkInvalidateMappedMemoryRanges", memRangeCount, pMemRanges);
     lock.unlock();
     if (!skipCall) {
-        result = my_data->device_dispatch_table->InvalidateMappedMemoryRanges(device, memRangeCount, pMemRanges);
+        result = LAYER_PROFILE_DISPATCH(
+            profiler, my_data->device_dispatch_table->InvalidateMappedMemoryRanges(device, memRangeCount, pMemRanges));
     }
     return result;
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL BindImageMemory(VkDevice device, VkImage image, VkDeviceMemory mem, VkDeviceSize memoryOffset) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkBindImageMemory");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     auto image_node = getImageNode(dev_data, image);
     if (image_node) {
         // Track objects tied to memory
@@ -9488,7 +10306,8 @@ VKAPI_ATTR VkResult VKAPI_CALL BindImageMemory(VkDevice device, VkImage image, V
         skipCall = set_mem_binding(dev_data, mem, image_handle, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT, "vkBindImageMemory");
         VkMemoryRequirements memRequirements;
         lock.unlock();
-        dev_data->device_dispatch_table->GetImageMemoryRequirements(device, image, &memRequirements);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->GetImageMemoryRequirements(device, image,
+                                                                                                     &memRequirements));
         lock.lock();
 
         // Track and validate bound memory range information
@@ -9496,13 +10315,15 @@ VKAPI_ATTR VkResult VKAPI_CALL BindImageMemory(VkDevice device, VkImage image, V
         if (mem_info) {
             const MEMORY_RANGE range =
                 insert_memory_ranges(image_handle, mem, memoryOffset, memRequirements, mem_info->imageRanges);
-            skipCall |= validate_memory_range(dev_data, mem_info->bufferRanges, range, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT);
+            if (checkEnabled(dev_data, CHECK_MEMORY_ALIASING))
+                skipCall |= validate_memory_range(dev_data, mem_info->bufferRanges, range, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT);
         }
 
         print_mem_list(dev_data);
         lock.unlock();
         if (!skipCall) {
-            result = dev_data->device_dispatch_table->BindImageMemory(device, image, mem, memoryOffset);
+            result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->BindImageMemory(device, image, mem,
+                                                                                                       memoryOffset));
             lock.lock();
             dev_data->memObjMap[mem].get()->image = image;
             image_node->mem = mem;
@@ -9520,10 +10341,11 @@ VKAPI_ATTR VkResult VKAPI_CALL BindImageMemory(VkDevice device, VkImage image, V
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL SetEvent(VkDevice device, VkEvent event) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkSetEvent");
     bool skip_call = false;
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     auto event_node = dev_data->eventMap.find(event);
     if (event_node != dev_data->eventMap.end()) {
         event_node->second.needsSignaled = false;
@@ -9546,16 +10368,17 @@ VKAPI_ATTR VkResult VKAPI_CALL SetEvent(VkDevice device, VkEvent event) {
         }
     }
     if (!skip_call)
-        result = dev_data->device_dispatch_table->SetEvent(device, event);
+        result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->SetEvent(device, event));
     return result;
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 QueueBindSparse(VkQueue queue, uint32_t bindInfoCount, const VkBindSparseInfo *pBindInfo, VkFence fence) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkQueueBindSparse");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(queue), layer_data_map);
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skip_call = false;
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     // First verify that fence is not in use
     if (fence != VK_NULL_HANDLE) {
         auto fence_data = dev_data->fenceMap.find(fence);
@@ -9635,17 +10458,20 @@ QueueBindSparse(VkQueue queue, uint32_t bindInfoCount, const VkBindSparseInfo *p
     lock.unlock();
 
     if (!skip_call)
-        return dev_data->device_dispatch_table->QueueBindSparse(queue, bindInfoCount, pBindInfo, fence);
+        return LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->QueueBindSparse(queue, bindInfoCount, pBindInfo,
+                                                                                                 fence));
 
     return result;
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateSemaphore(VkDevice device, const VkSemaphoreCreateInfo *pCreateInfo,
                                                const VkAllocationCallbacks *pAllocator, VkSemaphore *pSemaphore) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateSemaphore");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->CreateSemaphore(device, pCreateInfo, pAllocator, pSemaphore);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CreateSemaphore(device, pCreateInfo,
+                                                                                                        pAllocator, pSemaphore));
     if (result == VK_SUCCESS) {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         SEMAPHORE_NODE* sNode = &dev_data->semaphoreMap[*pSemaphore];
         sNode->signaled = false;
         sNode->queue = VK_NULL_HANDLE;
@@ -9656,10 +10482,12 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateSemaphore(VkDevice device, const VkSemaphor
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateEvent(VkDevice device, const VkEventCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkEvent *pEvent) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateEvent");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->CreateEvent(device, pCreateInfo, pAllocator, pEvent);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CreateEvent(device, pCreateInfo, pAllocator,
+                                                                                                    pEvent));
     if (result == VK_SUCCESS) {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         dev_data->eventMap[*pEvent].needsSignaled = false;
         dev_data->eventMap[*pEvent].in_use.store(0);
         dev_data->eventMap[*pEvent].stageMask = VkPipelineStageFlags(0);
@@ -9670,11 +10498,13 @@ CreateEvent(VkDevice device, const VkEventCreateInfo *pCreateInfo, const VkAlloc
 VKAPI_ATTR VkResult VKAPI_CALL CreateSwapchainKHR(VkDevice device, const VkSwapchainCreateInfoKHR *pCreateInfo,
                                                   const VkAllocationCallbacks *pAllocator,
                                                   VkSwapchainKHR *pSwapchain) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateSwapchainKHR");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->CreateSwapchainKHR(device, pCreateInfo, pAllocator, pSwapchain);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->CreateSwapchainKHR(device, pCreateInfo,
+                                                                                                           pAllocator, pSwapchain));
 
     if (VK_SUCCESS == result) {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         dev_data->device_extensions.swapchainMap[*pSwapchain] = unique_ptr<SWAPCHAIN_NODE>(new SWAPCHAIN_NODE(pCreateInfo));
     }
 
@@ -9683,24 +10513,16 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateSwapchainKHR(VkDevice device, const VkSwapc
 
 VKAPI_ATTR void VKAPI_CALL
 DestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroySwapchainKHR");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     bool skipCall = false;
 
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     auto swapchain_data = getSwapchainNode(dev_data, swapchain);
     if (swapchain_data) {
         if (swapchain_data->images.size() > 0) {
             for (auto swapchain_image : swapchain_data->images) {
-                auto image_sub = dev_data->imageSubresourceMap.find(swapchain_image);
-                if (image_sub != dev_data->imageSubresourceMap.end()) {
-                    for (auto imgsubpair : image_sub->second) {
-                        auto image_item = dev_data->imageLayoutMap.find(imgsubpair);
-                        if (image_item != dev_data->imageLayoutMap.end()) {
-                            dev_data->imageLayoutMap.erase(image_item);
-                        }
-                    }
-                    dev_data->imageSubresourceMap.erase(image_sub);
-                }
+                dev_data->imageLayoutMap.erase(swapchain_image);
                 skipCall = clear_object_binding(dev_data, (uint64_t)swapchain_image,
                                                 VK_DEBUG_REPORT_OBJECT_TYPE_SWAPCHAIN_KHR_EXT);
                 dev_data->imageMap.erase(swapchain_image);
@@ -9710,19 +10532,21 @@ DestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocatio
     }
     lock.unlock();
     if (!skipCall)
-        dev_data->device_dispatch_table->DestroySwapchainKHR(device, swapchain, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DestroySwapchainKHR(device, swapchain, pAllocator));
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t *pCount, VkImage *pSwapchainImages) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetSwapchainImagesKHR");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    VkResult result = dev_data->device_dispatch_table->GetSwapchainImagesKHR(device, swapchain, pCount, pSwapchainImages);
+    VkResult result = LAYER_PROFILE_DISPATCH(
+        profiler, dev_data->device_dispatch_table->GetSwapchainImagesKHR(device, swapchain, pCount, pSwapchainImages));
 
     if (result == VK_SUCCESS && pSwapchainImages != NULL) {
         // This should never happen and is checked by param checker.
         if (!pCount)
             return result;
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         const size_t count = *pCount;
         auto swapchain_node = getSwapchainNode(dev_data, swapchain);
         if (swapchain_node && !swapchain_node->images.empty()) {
@@ -9739,9 +10563,6 @@ GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t *pCoun
             }
         }
         for (uint32_t i = 0; i < *pCount; ++i) {
-            IMAGE_LAYOUT_NODE image_layout_node;
-            image_layout_node.layout = VK_IMAGE_LAYOUT_UNDEFINED;
-            image_layout_node.format = swapchain_node->createInfo.imageFormat;
             // Add imageMap entries for each swapchain image
             VkImageCreateInfo image_ci = {};
             image_ci.mipLevels = 1;
@@ -9756,9 +10577,9 @@ GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t *pCoun
             image_node->valid = false;
             image_node->mem = MEMTRACKER_SWAP_CHAIN_IMAGE_KEY;
             swapchain_node->images.push_back(pSwapchainImages[i]);
-            ImageSubresourcePair subpair = {pSwapchainImages[i], false, VkImageSubresource()};
-            dev_data->imageSubresourceMap[pSwapchainImages[i]].push_back(subpair);
-            dev_data->imageLayoutMap[subpair] = image_layout_node;
+            ImageLayoutMap<VkImageLayout> image_layouts(image_ci.mipLevels, image_ci.arrayLayers);
+            image_layouts.SetImageLayout(VK_IMAGE_LAYOUT_UNDEFINED);
+            dev_data->imageLayoutMap[pSwapchainImages[i]] = image_layouts;
             dev_data->device_extensions.imageToSwapchainMap[pSwapchainImages[i]] = swapchain;
         }
     }
@@ -9766,12 +10587,13 @@ GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t *pCoun
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL QueuePresentKHR(VkQueue queue, const VkPresentInfoKHR *pPresentInfo) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkQueuePresentKHR");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(queue), layer_data_map);
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skip_call = false;
 
     if (pPresentInfo) {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         for (uint32_t i = 0; i < pPresentInfo->waitSemaphoreCount; ++i) {
             const VkSemaphore &semaphore = pPresentInfo->pWaitSemaphores[i];
             if (dev_data->semaphoreMap.find(semaphore) != dev_data->semaphoreMap.end()) {
@@ -9814,18 +10636,19 @@ VKAPI_ATTR VkResult VKAPI_CALL QueuePresentKHR(VkQueue queue, const VkPresentInf
     }
 
     if (!skip_call)
-        result = dev_data->device_dispatch_table->QueuePresentKHR(queue, pPresentInfo);
+        result = LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->QueuePresentKHR(queue, pPresentInfo));
 
     return result;
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL AcquireNextImageKHR(VkDevice device, VkSwapchainKHR swapchain, uint64_t timeout,
                                                    VkSemaphore semaphore, VkFence fence, uint32_t *pImageIndex) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkAcquireNextImageKHR");
     layer_data *dev_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
 
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<rw_lock> lock(global_lock);
     if (semaphore != VK_NULL_HANDLE &&
         dev_data->semaphoreMap.find(semaphore) != dev_data->semaphoreMap.end()) {
         if (dev_data->semaphoreMap[semaphore].signaled) {
@@ -9843,7 +10666,8 @@ VKAPI_ATTR VkResult VKAPI_CALL AcquireNextImageKHR(VkDevice device, VkSwapchainK
 
     if (!skipCall) {
         result =
-            dev_data->device_dispatch_table->AcquireNextImageKHR(device, swapchain, timeout, semaphore, fence, pImageIndex);
+            LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->AcquireNextImageKHR(device, swapchain, timeout,
+                                                                                                  semaphore, fence, pImageIndex));
     }
 
     return result;
@@ -9852,11 +10676,13 @@ VKAPI_ATTR VkResult VKAPI_CALL AcquireNextImageKHR(VkDevice device, VkSwapchainK
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateDebugReportCallbackEXT(VkInstance instance, const VkDebugReportCallbackCreateInfoEXT *pCreateInfo,
                              const VkAllocationCallbacks *pAllocator, VkDebugReportCallbackEXT *pMsgCallback) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDebugReportCallbackEXT");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
     VkLayerInstanceDispatchTable *pTable = my_data->instance_dispatch_table;
-    VkResult res = pTable->CreateDebugReportCallbackEXT(instance, pCreateInfo, pAllocator, pMsgCallback);
+    VkResult res = LAYER_PROFILE_DISPATCH(profiler, pTable->CreateDebugReportCallbackEXT(instance, pCreateInfo, pAllocator,
+                                                                                         pMsgCallback));
     if (VK_SUCCESS == res) {
-        std::lock_guard<std::mutex> lock(global_lock);
+        std::lock_guard<rw_lock> lock(global_lock);
         res = layer_create_msg_callback(my_data->report_data, false, pCreateInfo, pAllocator, pMsgCallback);
     }
     return res;
@@ -9865,33 +10691,38 @@ CreateDebugReportCallbackEXT(VkInstance instance, const VkDebugReportCallbackCre
 VKAPI_ATTR void VKAPI_CALL DestroyDebugReportCallbackEXT(VkInstance instance,
                                                          VkDebugReportCallbackEXT msgCallback,
                                                          const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDebugReportCallbackEXT");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
     VkLayerInstanceDispatchTable *pTable = my_data->instance_dispatch_table;
-    pTable->DestroyDebugReportCallbackEXT(instance, msgCallback, pAllocator);
-    std::lock_guard<std::mutex> lock(global_lock);
+    LAYER_PROFILE_DISPATCH(profiler, pTable->DestroyDebugReportCallbackEXT(instance, msgCallback, pAllocator));
+    std::lock_guard<rw_lock> lock(global_lock);
     layer_destroy_msg_callback(my_data->report_data, msgCallback, pAllocator);
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DebugReportMessageEXT(VkInstance instance, VkDebugReportFlagsEXT flags, VkDebugReportObjectTypeEXT objType, uint64_t object,
                       size_t location, int32_t msgCode, const char *pLayerPrefix, const char *pMsg) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDebugReportMessageEXT");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
-    my_data->instance_dispatch_table->DebugReportMessageEXT(instance, flags, objType, object, location, msgCode, pLayerPrefix,
-                                                            pMsg);
+    LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->DebugReportMessageEXT(
+        instance, flags, objType, object, location, msgCode, pLayerPrefix, pMsg));
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateInstanceLayerProperties(uint32_t *pCount, VkLayerProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateInstanceLayerProperties");
     return util_GetLayerProperties(1, &global_layer, pCount, pProperties);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateDeviceLayerProperties(VkPhysicalDevice physicalDevice, uint32_t *pCount, VkLayerProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateDeviceLayerProperties");
     return util_GetLayerProperties(1, &global_layer, pCount, pProperties);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateInstanceExtensionProperties(const char *pLayerName, uint32_t *pCount, VkExtensionProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateInstanceExtensionProperties");
     if (pLayerName && !strcmp(pLayerName, global_layer.layerName))
         return util_GetExtensionProperties(1, instance_extensions, pCount, pProperties);
 
@@ -9901,6 +10732,7 @@ EnumerateInstanceExtensionProperties(const char *pLayerName, uint32_t *pCount, V
 VKAPI_ATTR VkResult VKAPI_CALL EnumerateDeviceExtensionProperties(VkPhysicalDevice physicalDevice,
                                                                   const char *pLayerName, uint32_t *pCount,
                                                                   VkExtensionProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateDeviceExtensionProperties");
     if (pLayerName && !strcmp(pLayerName, global_layer.layerName))
         return util_GetExtensionProperties(0, NULL, pCount, pProperties);
 
@@ -9908,7 +10740,8 @@ VKAPI_ATTR VkResult VKAPI_CALL EnumerateDeviceExtensionProperties(VkPhysicalDevi
 
     dispatch_key key = get_dispatch_key(physicalDevice);
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
-    return my_data->instance_dispatch_table->EnumerateDeviceExtensionProperties(physicalDevice, NULL, pCount, pProperties);
+    return LAYER_PROFILE_DISPATCH(
+        profiler, my_data->instance_dispatch_table->EnumerateDeviceExtensionProperties(physicalDevice, NULL, pCount, pProperties));
 }
 
 static PFN_vkVoidFunction
@@ -9921,6 +10754,7 @@ static PFN_vkVoidFunction
 intercept_khr_swapchain_command(const char *name, VkDevice dev);
 
 VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice dev, const char *funcName) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetDeviceProcAddr");
     PFN_vkVoidFunction proc = intercept_core_device_command(funcName);
     if (proc)
         return proc;
@@ -9938,11 +10772,12 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice dev, const c
     {
         if (pTable->GetDeviceProcAddr == NULL)
             return NULL;
-        return pTable->GetDeviceProcAddr(dev, funcName);
+        return LAYER_PROFILE_DISPATCH(profiler, pTable->GetDeviceProcAddr(dev, funcName));
     }
 }
 
 VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance, const char *funcName) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetInstanceProcAddr");
     PFN_vkVoidFunction proc = intercept_core_instance_command(funcName);
     if (!proc)
         proc = intercept_core_device_command(funcName);
@@ -9962,7 +10797,7 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance
     VkLayerInstanceDispatchTable *pTable = my_data->instance_dispatch_table;
     if (pTable->GetInstanceProcAddr == NULL)
         return NULL;
-    return pTable->GetInstanceProcAddr(instance, funcName);
+    return LAYER_PROFILE_DISPATCH(profiler, pTable->GetInstanceProcAddr(instance, funcName));
 }
 
 static PFN_vkVoidFunction
@@ -93,6 +93,21 @@
 // TODO : Is there a way to track when Cmd Buffer finishes & remove mem references at that point?
 // TODO : Could potentially store a list of freed mem allocs to flag when they're incorrectly used
 
+// Categories of checks that can be turned off with the lunarg_core_validation.disabled_checks setting. Each is tested
+// before its work is done, so a disabled category costs one branch on the entry points that would run it.
+typedef VkFlags CheckFlags;
+enum CheckFlagBits {
+    // clang-format off
+    CHECK_DRAW_STATE        = 0x00000001,   // Dynamic state, vertex bindings and pipeline/render pass state at draw time
+    CHECK_DESCRIPTOR_SETS   = 0x00000002,   // Bound descriptor sets and their contents at draw and dispatch time
+    CHECK_BARRIERS          = 0x00000004,   // Barrier queue families, access masks and layouts
+    CHECK_RENDER_PASS_DEPS  = 0x00000008,   // Subpass dependencies of overlapping attachments at vkCmdBeginRenderPass
+    CHECK_MEMORY_ALIASING   = 0x00000010,   // Linear/non-linear resources sharing a bufferImageGranularity page
+    CHECK_MEMORY_CONTENTS   = 0x00000020,   // Reads of memory that has not been written, checked at submit
+    CHECK_ALL               = 0x0000003F,
+    // clang-format on
+};
+
 struct MT_FB_ATTACHMENT_INFO {
     VkImage image;
     VkDeviceMemory mem;
@@ -120,11 +135,6 @@ struct GENERIC_HEADER {
     const void *pNext;
 };
 
-struct IMAGE_LAYOUT_NODE {
-    VkImageLayout layout;
-    VkFormat format;
-};
-
 // Store layouts and pushconstants for PipelineLayout
 struct PIPELINE_LAYOUT_NODE {
     std::vector<VkDescriptorSetLayout> descriptorSetLayouts;
@@ -250,12 +260,13 @@ class QUEUE_NODE {
 #endif
     std::vector<VkCommandBuffer> untrackedCmdBuffers;
     std::unordered_map<VkEvent, VkPipelineStageFlags> eventToStageMap;
-    std::unordered_map<QueryObject, bool> queryToStateMap; // 0 is unavailable, 1 is available
+    QueryStateMap queryToStateMap;
 };
 
 class QUERY_POOL_NODE : public BASE_NODE {
   public:
     VkQueryPoolCreateInfo createInfo;
+    QUERY_POOL_STATE queryStates; // Device level availability, updated as submitted cmd buffers complete
 };
 
 class FRAMEBUFFER_NODE {
@@ -214,6 +214,7 @@ enum DRAW_STATE_ERROR {
     DRAWSTATE_INVALID_QUEUE_INDEX,           // Specified queue index exceeds number
                                              // of queried queue families
     DRAWSTATE_PUSH_CONSTANTS_ERROR,          // Push constants exceed maxPushConstantSize
+    DRAWSTATE_INVALID_LAYER_SETTING,         // Layer setting has a value that is not recognized
 };
 
 enum SHADER_CHECKER_ERROR {
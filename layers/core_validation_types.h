@@ -45,12 +45,17 @@
 #endif
 
 #include "vulkan/vulkan.h"
+#include <algorithm>
 #include <atomic>
+#include <iterator>
 #include <string.h>
+#include <map>
+#include <set>
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
 #include <functional>
+#include <mutex>
 
 // Fwd declarations
 namespace cvdescriptorset {
@@ -162,6 +167,149 @@ struct MEMORY_RANGE {
     VkDeviceSize end;
 };
 
+// Ranges bound within a single memory object, kept as an interval tree: a treap ordered by (start, handle) in which
+// every node also records the largest end offset in its subtree. An overlap query descends only into subtrees that
+// can reach the query start and stops at ranges starting past the query end, so insert, erase and overlap queries
+// are logarithmic in the number of bindings plus the ranges reported, however the bound ranges overlap each other.
+// Ranges are inclusive; an empty range (end < start) is never stored.
+class MemoryRangeIndex {
+  public:
+    MemoryRangeIndex() : root_(NIL), free_(NIL) {}
+
+    // Add a range; a handle that is already present has its previous range replaced
+    void insert(const MEMORY_RANGE &range) {
+        erase(range.handle);
+        if (range.end < range.start)
+            return;
+        uint32_t n;
+        if (free_ != NIL) {
+            n = free_;
+            free_ = nodes_[n].left;
+        } else {
+            n = static_cast<uint32_t>(nodes_.size());
+            nodes_.push_back(node());
+        }
+        node &nd = nodes_[n];
+        nd.range = range;
+        nd.max_end = range.end;
+        nd.priority = mix(range.handle);
+        nd.left = nd.right = NIL;
+        uint32_t lo, hi;
+        split(root_, range.start, range.handle, lo, hi);
+        root_ = merge(merge(lo, n), hi);
+        handles_[range.handle] = n;
+    }
+    void erase(uint64_t handle) {
+        auto handle_it = handles_.find(handle);
+        if (handle_it == handles_.end())
+            return;
+        uint32_t n = handle_it->second;
+        handles_.erase(handle_it);
+        root_ = remove(root_, nodes_[n].range.start, handle);
+        nodes_[n].left = free_;
+        free_ = n;
+    }
+    // Invoke fn on every range sharing at least one byte with the inclusive range [start, end]
+    template <typename Fn> void for_each_overlap(VkDeviceSize start, VkDeviceSize end, Fn fn) const {
+        if (end < start)
+            return;
+        visit_overlaps(root_, start, end, fn);
+    }
+    size_t size() const { return handles_.size(); }
+    bool empty() const { return handles_.empty(); }
+
+  private:
+    static const uint32_t NIL = UINT32_MAX;
+    struct node {
+        MEMORY_RANGE range;
+        VkDeviceSize max_end; // largest range.end in this subtree
+        uint32_t priority;
+        uint32_t left, right; // children, or the next free node (left) once released
+    };
+
+    static uint32_t mix(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        return static_cast<uint32_t>(x);
+    }
+    static bool less(VkDeviceSize start_a, uint64_t handle_a, VkDeviceSize start_b, uint64_t handle_b) {
+        return start_a < start_b || (start_a == start_b && handle_a < handle_b);
+    }
+    void update(uint32_t n) {
+        node &nd = nodes_[n];
+        nd.max_end = nd.range.end;
+        if (nd.left != NIL)
+            nd.max_end = std::max(nd.max_end, nodes_[nd.left].max_end);
+        if (nd.right != NIL)
+            nd.max_end = std::max(nd.max_end, nodes_[nd.right].max_end);
+    }
+    // Split t into the nodes ordered before (start, handle) and the rest
+    void split(uint32_t t, VkDeviceSize start, uint64_t handle, uint32_t &lo, uint32_t &hi) {
+        if (t == NIL) {
+            lo = hi = NIL;
+        } else if (less(nodes_[t].range.start, nodes_[t].range.handle, start, handle)) {
+            split(nodes_[t].right, start, handle, nodes_[t].right, hi);
+            lo = t;
+            update(t);
+        } else {
+            split(nodes_[t].left, start, handle, lo, nodes_[t].left);
+            hi = t;
+            update(t);
+        }
+    }
+    // Join two treaps where every node of a is ordered before every node of b
+    uint32_t merge(uint32_t a, uint32_t b) {
+        if (a == NIL)
+            return b;
+        if (b == NIL)
+            return a;
+        if (nodes_[a].priority > nodes_[b].priority) {
+            nodes_[a].right = merge(nodes_[a].right, b);
+            update(a);
+            return a;
+        }
+        nodes_[b].left = merge(a, nodes_[b].left);
+        update(b);
+        return b;
+    }
+    uint32_t remove(uint32_t t, VkDeviceSize start, uint64_t handle) {
+        if (t == NIL)
+            return NIL;
+        node &nd = nodes_[t];
+        if (nd.range.start == start && nd.range.handle == handle)
+            return merge(nd.left, nd.right);
+        if (less(start, handle, nd.range.start, nd.range.handle))
+            nd.left = remove(nd.left, start, handle);
+        else
+            nd.right = remove(nd.right, start, handle);
+        update(t);
+        return t;
+    }
+    template <typename Fn> void visit_overlaps(uint32_t t, VkDeviceSize start, VkDeviceSize end, Fn &fn) const {
+        // Nothing in this subtree reaches start
+        if (t == NIL || nodes_[t].max_end < start)
+            return;
+        const node &nd = nodes_[t];
+        visit_overlaps(nd.left, start, end, fn);
+        // This node and everything to its right start past end
+        if (nd.range.start > end)
+            return;
+        if (nd.range.end >= start)
+            fn(nd.range);
+        visit_overlaps(nd.right, start, end, fn);
+    }
+
+    std::vector<node> nodes_;
+    uint32_t root_;
+    uint32_t free_;
+    std::unordered_map<uint64_t, uint32_t> handles_;
+};
+
+namespace core_validation {
+class guarded_shadow;
+}
+
 // Data struct for tracking memory object
 struct DEVICE_MEM_INFO {
     void *object; // Dispatchable object used to create this memory (device of swapchain)
@@ -170,14 +318,15 @@ struct DEVICE_MEM_INFO {
     VkMemoryAllocateInfo allocInfo;
     std::unordered_set<MT_OBJ_HANDLE_TYPE> objBindings;        // objects bound to this memory
     std::unordered_set<VkCommandBuffer> commandBufferBindings; // cmd buffers referencing this memory
-    std::vector<MEMORY_RANGE> bufferRanges;
-    std::vector<MEMORY_RANGE> imageRanges;
+    MemoryRangeIndex bufferRanges;
+    MemoryRangeIndex imageRanges;
     VkImage image; // If memory is bound to image, this will have VkImage handle, else VK_NULL_HANDLE
     MemRange memRange;
     void *pData, *pDriverData;
+    core_validation::guarded_shadow *pGuardedShadow; // Page protected shadow of a mapped range, used instead of pData when enabled
     DEVICE_MEM_INFO(void *disp_object, const VkDeviceMemory in_mem, const VkMemoryAllocateInfo *p_alloc_info)
         : object(disp_object), valid(false), mem(in_mem), allocInfo(*p_alloc_info), image(VK_NULL_HANDLE), memRange{}, pData(0),
-          pDriverData(0){};
+          pDriverData(0), pGuardedShadow(nullptr){};
 };
 
 class SWAPCHAIN_NODE {
@@ -215,6 +364,159 @@ class IMAGE_CMD_BUF_LAYOUT_NODE {
     VkImageLayout layout;
 };
 
+inline bool operator==(const IMAGE_CMD_BUF_LAYOUT_NODE &a, const IMAGE_CMD_BUF_LAYOUT_NODE &b) {
+    return a.initialLayout == b.initialLayout && a.layout == b.layout;
+}
+
+// Layout state for every subresource of one image. Subresources are flattened to the index
+// ((aspect * mipLevels) + mipLevel) * arrayLayers + arrayLayer, where aspect is the bit position of a single
+// VkImageAspectFlagBits, and stored as runs of equal state. Transitioning a whole image, or a subresource range that
+// spans all array layers, touches one run per aspect regardless of how many subresources it covers.
+template <typename NODE> class ImageLayoutMap {
+  public:
+    static const uint32_t ASPECT_COUNT = 4; // COLOR, DEPTH, STENCIL, METADATA
+
+    ImageLayoutMap() : mip_levels_(0), array_layers_(0), has_image_layout_(false) {}
+    ImageLayoutMap(uint32_t mip_levels, uint32_t array_layers)
+        : mip_levels_(mip_levels), array_layers_(array_layers), has_image_layout_(false) {}
+
+    uint32_t MipLevels() const { return mip_levels_; }
+    uint32_t ArrayLayers() const { return array_layers_; }
+    bool Empty() const { return runs_.empty(); }
+
+    // Layout of the image as a whole, which applies to subresources that have no state of their own
+    void SetImageLayout(const NODE &node) {
+        image_layout_ = node;
+        has_image_layout_ = true;
+    }
+    const NODE *GetImageLayout() const { return has_image_layout_ ? &image_layout_ : nullptr; }
+
+    uint64_t Index(uint32_t aspect, uint32_t mip_level, uint32_t array_layer) const {
+        return (uint64_t(aspect) * mip_levels_ + mip_level) * array_layers_ + array_layer;
+    }
+    VkImageSubresource Subresource(uint64_t index) const {
+        VkImageSubresource sub;
+        sub.arrayLayer = static_cast<uint32_t>(index % array_layers_);
+        index /= array_layers_;
+        sub.mipLevel = static_cast<uint32_t>(index % mip_levels_);
+        sub.aspectMask = VkImageAspectFlags(1) << (index / mip_levels_);
+        return sub;
+    }
+
+    // Invoke fn(begin, end) for each contiguous index interval covered by range, clipped to the image's dimensions.
+    // VK_REMAINING_MIP_LEVELS and VK_REMAINING_ARRAY_LAYERS are handled by the clipping.
+    template <typename Fn> void ForEachInterval(const VkImageSubresourceRange &range, Fn fn) const {
+        if (range.baseMipLevel >= mip_levels_ || range.baseArrayLayer >= array_layers_)
+            return;
+        uint32_t mip_end = range.baseMipLevel + std::min(range.levelCount, mip_levels_ - range.baseMipLevel);
+        uint32_t layer_end = range.baseArrayLayer + std::min(range.layerCount, array_layers_ - range.baseArrayLayer);
+        for (uint32_t aspect = 0; aspect < ASPECT_COUNT; ++aspect) {
+            if (!(range.aspectMask & (1u << aspect)))
+                continue;
+            if (range.baseArrayLayer == 0 && layer_end == array_layers_) {
+                if (range.baseMipLevel < mip_end)
+                    fn(Index(aspect, range.baseMipLevel, 0), Index(aspect, mip_end, 0));
+            } else {
+                for (uint32_t mip = range.baseMipLevel; mip < mip_end; ++mip) {
+                    fn(Index(aspect, mip, range.baseArrayLayer), Index(aspect, mip, layer_end));
+                }
+            }
+        }
+    }
+
+    // Invoke fn(begin, end, node) for each piece of [begin, end) with uniform state; node is nullptr for subresources
+    // with no state of their own
+    template <typename Fn> void ForEach(uint64_t begin, uint64_t end, Fn fn) const {
+        auto it = runs_.upper_bound(begin);
+        if (it != runs_.begin() && std::prev(it)->second.end > begin) {
+            --it;
+        }
+        uint64_t pos = begin;
+        for (; it != runs_.end() && it->first < end; ++it) {
+            if (it->first > pos) {
+                fn(pos, it->first, static_cast<const NODE *>(nullptr));
+                pos = it->first;
+            }
+            uint64_t run_end = std::min(it->second.end, end);
+            fn(pos, run_end, &it->second.node);
+            pos = run_end;
+        }
+        if (pos < end) {
+            fn(pos, end, static_cast<const NODE *>(nullptr));
+        }
+    }
+
+    // Invoke fn(begin, end, node) for every run of subresources that has state
+    template <typename Fn> void ForEachRun(Fn fn) const {
+        for (auto const &run : runs_) {
+            fn(run.first, run.second.end, run.second.node);
+        }
+    }
+
+    // Replace the state of each uniform piece of [begin, end) with fn(begin, end, node), node as for ForEach
+    template <typename Fn> void Update(uint64_t begin, uint64_t end, Fn fn) {
+        std::vector<std::pair<std::pair<uint64_t, uint64_t>, NODE>> pieces;
+        ForEach(begin, end, [&](uint64_t piece_begin, uint64_t piece_end, const NODE *node) {
+            pieces.push_back(std::make_pair(std::make_pair(piece_begin, piece_end), fn(piece_begin, piece_end, node)));
+        });
+        for (auto const &piece : pieces) {
+            Set(piece.first.first, piece.first.second, piece.second);
+        }
+    }
+
+    void Set(uint64_t begin, uint64_t end, const NODE &node) {
+        if (begin >= end)
+            return;
+        auto it = runs_.lower_bound(begin);
+        // Trim a run that starts before begin, keeping any part of it that extends past end
+        if (it != runs_.begin()) {
+            auto prev = std::prev(it);
+            if (prev->second.end > begin) {
+                if (prev->second.end > end) {
+                    it = runs_.emplace_hint(it, end, Run{prev->second.end, prev->second.node});
+                }
+                prev->second.end = begin;
+            }
+        }
+        // Drop runs starting inside [begin, end), keeping any part of the last one that extends past end
+        while (it != runs_.end() && it->first < end) {
+            if (it->second.end > end) {
+                Run tail = {it->second.end, it->second.node};
+                it = runs_.erase(it);
+                it = runs_.emplace_hint(it, end, tail);
+                break;
+            }
+            it = runs_.erase(it);
+        }
+        // Insert, merging with neighbouring runs of equal state
+        it = runs_.emplace_hint(it, begin, Run{end, node});
+        if (it != runs_.begin()) {
+            auto prev = std::prev(it);
+            if (prev->second.end == begin && prev->second.node == node) {
+                prev->second.end = end;
+                runs_.erase(it);
+                it = prev;
+            }
+        }
+        auto next = std::next(it);
+        if (next != runs_.end() && next->first == it->second.end && next->second.node == node) {
+            it->second.end = next->second.end;
+            runs_.erase(next);
+        }
+    }
+
+  private:
+    struct Run {
+        uint64_t end;
+        NODE node;
+    };
+    uint32_t mip_levels_;
+    uint32_t array_layers_;
+    bool has_image_layout_;
+    NODE image_layout_;
+    std::map<uint64_t, Run> runs_; // keyed by first index, runs never overlap
+};
+
 struct MT_PASS_ATTACHMENT_INFO {
     uint32_t attachment;
     VkAttachmentLoadOp load_op;
@@ -366,37 +668,166 @@ template <> struct hash<QueryObject> {
     }
 };
 }
-struct DRAW_DATA { std::vector<VkBuffer> buffers; };
+// One bit per query of a query pool, stored densely so that ranges of queries are updated a word at a time. Grows on
+// demand to cover the highest index set, but never past the limit given, which is the query count of the pool.
+class QueryBitset {
+  public:
+    void Reserve(uint64_t count, uint32_t limit) {
+        count = std::min<uint64_t>(count, limit);
+        if (words_.size() < WordCount(count))
+            words_.resize(WordCount(count), 0);
+    }
+    bool Test(uint32_t index) const {
+        size_t word = index / 64;
+        return word < words_.size() && (words_[word] & (uint64_t(1) << (index % 64)));
+    }
+    // Bits at or past limit are left alone
+    void Set(uint32_t first, uint32_t count, bool value, uint32_t limit) {
+        uint64_t end = std::min<uint64_t>(uint64_t(first) + count, limit);
+        if (first >= end)
+            return;
+        if (value)
+            Reserve(end, limit);
+        size_t last_word = std::min<size_t>(static_cast<size_t>((end - 1) / 64) + 1, words_.size());
+        for (size_t word = first / 64; word < last_word; ++word) {
+            uint64_t word_begin = uint64_t(word) * 64;
+            uint64_t lo = std::max<uint64_t>(first, word_begin) - word_begin;
+            uint64_t hi = std::min<uint64_t>(end, word_begin + 64) - word_begin;
+            uint64_t mask = (hi == 64 ? ~uint64_t(0) : (uint64_t(1) << hi) - 1) & ~((uint64_t(1) << lo) - 1);
+            if (value)
+                words_[word] |= mask;
+            else
+                words_[word] &= ~mask;
+        }
+    }
+    // Take the bits selected by mask from src, keep the others
+    void Merge(const QueryBitset &mask, const QueryBitset &src) {
+        if (words_.size() < mask.words_.size())
+            words_.resize(mask.words_.size(), 0);
+        for (size_t word = 0; word < mask.words_.size(); ++word) {
+            uint64_t src_word = word < src.words_.size() ? src.words_[word] : 0;
+            words_[word] = (words_[word] & ~mask.words_[word]) | (src_word & mask.words_[word]);
+        }
+    }
+    bool Any() const {
+        for (auto word : words_) {
+            if (word)
+                return true;
+        }
+        return false;
+    }
+    // Invoke fn(index) for every set bit, in increasing order
+    template <typename Fn> void ForEach(Fn fn) const {
+        for (size_t word = 0; word < words_.size(); ++word) {
+            for (uint64_t bits = words_[word]; bits; bits &= bits - 1) {
+                uint32_t bit = 0;
+                while (!(bits & (uint64_t(1) << bit)))
+                    ++bit;
+                fn(static_cast<uint32_t>(word * 64 + bit));
+            }
+        }
+    }
 
-struct ImageSubresourcePair {
-    VkImage image;
-    bool hasSubresource;
-    VkImageSubresource subresource;
+  private:
+    static size_t WordCount(uint64_t count) { return static_cast<size_t>((count + 63) / 64); }
+    std::vector<uint64_t> words_;
 };
 
-inline bool operator==(const ImageSubresourcePair &img1, const ImageSubresourcePair &img2) {
-    if (img1.image != img2.image || img1.hasSubresource != img2.hasSubresource)
-        return false;
-    return !img1.hasSubresource ||
-           (img1.subresource.aspectMask == img2.subresource.aspectMask && img1.subresource.mipLevel == img2.subresource.mipLevel &&
-            img1.subresource.arrayLayer == img2.subresource.arrayLayer);
-}
+// Availability of the queries of one pool. A query has no known state until it is reset or ended.
+struct QUERY_POOL_STATE {
+    QueryBitset known;
+    QueryBitset available;
 
-namespace std {
-template <> struct hash<ImageSubresourcePair> {
-    size_t operator()(ImageSubresourcePair img) const throw() {
-        size_t hashVal = hash<uint64_t>()(reinterpret_cast<uint64_t &>(img.image));
-        hashVal ^= hash<bool>()(img.hasSubresource);
-        if (img.hasSubresource) {
-            hashVal ^= hash<uint32_t>()(reinterpret_cast<uint32_t &>(img.subresource.aspectMask));
-            hashVal ^= hash<uint32_t>()(img.subresource.mipLevel);
-            hashVal ^= hash<uint32_t>()(img.subresource.arrayLayer);
-        }
-        return hashVal;
+    void Set(uint32_t first, uint32_t count, bool value, uint32_t limit) {
+        known.Set(first, count, true, limit);
+        available.Set(first, count, value, limit);
+    }
+    // Returns false if the query has no known state
+    bool Find(uint32_t index, bool *value) const {
+        if (!known.Test(index))
+            return false;
+        *value = available.Test(index);
+        return true;
+    }
+    // Overwrite the state of every query that other knows about
+    void Merge(const QUERY_POOL_STATE &other) {
+        available.Merge(other.known, other.available);
+        known.Merge(other.known, other.known);
     }
 };
+
+// Query availability per pool, for queries whose state has been set by a cmd buffer or on a queue
+typedef std::unordered_map<VkQueryPool, QUERY_POOL_STATE> QueryStateMap;
+// Set of queries, per pool
+typedef std::unordered_map<VkQueryPool, QueryBitset> QuerySet;
+
+inline void MergeQueryStates(QueryStateMap &dst, const QueryStateMap &src) {
+    for (auto const &pool_state : src) {
+        dst[pool_state.first].Merge(pool_state.second);
+    }
+}
+
+inline bool AnyQueries(const QuerySet &queries) {
+    for (auto const &pool_queries : queries) {
+        if (pool_queries.second.Any())
+            return true;
+    }
+    return false;
 }
 
+// Events a cmd buffer had waited on when it reset a range of queries
+struct QUERY_RESET_EVENTS {
+    VkQueryPool pool;
+    uint32_t firstQuery;
+    uint32_t queryCount;
+    std::unordered_set<VkEvent> waitedEvents;
+};
+
+struct DRAW_DATA { std::vector<VkBuffer> buffers; };
+
+// Resources a recorded cmd buffer holds in use while it is in flight, each listed once. Built by vkEndCommandBuffer so
+// that the work done per submit scales with the number of distinct resources rather than the number of draws; the
+// semaphores are filled in at each vkQueueSubmit.
+struct CB_SUBMIT_RESOURCES {
+    std::vector<VkBuffer> buffers;
+    std::vector<VkDescriptorSet> descriptorSets;
+    std::vector<VkSemaphore> semaphores;
+    std::vector<VkEvent> events;
+
+    void clear() {
+        buffers.clear();
+        descriptorSets.clear();
+        semaphores.clear();
+        events.clear();
+    }
+};
+
+// Check or update of whether a memory object (or swapchain image) holds defined contents, recorded into a cmd buffer
+// and replayed in order when the cmd buffer is submitted
+struct DEFERRED_MEMORY_OP {
+    enum Type : uint8_t { VALIDATE, SET_VALID, SET_INVALID } type;
+    VkDeviceMemory mem;
+    VkImage image;            // Identifies the swapchain image when mem is MEMTRACKER_SWAP_CHAIN_IMAGE_KEY
+    const char *functionName; // Command reported when VALIDATE fails
+};
+
+// vkCmdSetEvent/vkCmdResetEvent stage mask update, or vkCmdWaitEvents stage mask check, replayed at submit
+struct DEFERRED_EVENT_OP {
+    enum Type : uint8_t { SET, WAIT } type;
+    VkEvent event;                  // SET only
+    VkPipelineStageFlags stageMask; // Mask the event is set with, or srcStageMask of the wait
+    uint32_t eventCount;            // WAIT only: events waited on are eventCount entries of
+    size_t firstEventIndex;         // GLOBAL_CB_NODE::events starting at firstEventIndex
+};
+
+// Query availability update, or check that queries copied to a buffer are available, replayed at submit
+struct DEFERRED_QUERY_OP {
+    enum Type : uint8_t { SET_AVAILABLE, SET_UNAVAILABLE, VALIDATE } type;
+    VkQueryPool queryPool;
+    uint32_t firstQuery;
+    uint32_t queryCount;
+};
+
 // Track last states that are bound per pipeline bind point (Gfx & Compute)
 struct LAST_BOUND_STATE {
     VkPipeline pipeline;
@@ -408,13 +839,23 @@ struct LAST_BOUND_STATE {
     std::vector<cvdescriptorset::DescriptorSet *> boundDescriptorSets;
     // one dynamic offset per dynamic descriptor bound to this CB
     std::vector<std::vector<uint32_t>> dynamicOffsets;
+    // Bumped whenever the pipeline, layout, bound sets or dynamic offsets change
+    uint64_t version = 1;
+    // Draw-time descriptor validation last passed at this version, with these bound sets at the given versions and
+    // the device's descriptorResourceVersion at the time. A draw that finds all three unchanged skips validation.
+    uint64_t validatedVersion = 0;
+    uint64_t validatedResourceVersion = 0;
+    std::vector<std::pair<cvdescriptorset::DescriptorSet *, uint64_t>> validatedSets;
 
     void reset() {
         pipeline = VK_NULL_HANDLE;
         pipelineLayout = VK_NULL_HANDLE;
-        uniqueBoundSets.clear();
+        if (!uniqueBoundSets.empty())
+            uniqueBoundSets.clear();
         boundDescriptorSets.clear();
         dynamicOffsets.clear();
+        version++;
+        validatedSets.clear();
     }
 };
 // Cmd Buffer Wrapper Struct - TODO : This desperately needs its own class
@@ -431,6 +872,7 @@ struct GLOBAL_CB_NODE : public BASE_NODE {
     uint64_t submitCount;               // Number of times CB has been submitted
     CBStatusFlags status;               // Track status of various bindings on cmd buffer
     std::vector<CMD_NODE> cmds;              // vector of commands bound to this command buffer
+    std::mutex record_lock;             // Guards recording state while the device-wide lock is held shared
     // Currently storing "lastBound" objects on per-CB basis
     //  long-term may want to create caches of "lastBound" states and could have
     //  each individual CMD_NODE referencing its own "lastBound" state
@@ -459,15 +901,15 @@ struct GLOBAL_CB_NODE : public BASE_NODE {
     std::vector<VkEvent> writeEventsBeforeWait;
     std::vector<VkSemaphore> semaphores;
     std::vector<VkEvent> events;
-    std::unordered_map<QueryObject, std::unordered_set<VkEvent>> waitedEventsBeforeQueryReset;
-    std::unordered_map<QueryObject, bool> queryToStateMap; // 0 is unavailable, 1 is available
-    std::unordered_set<QueryObject> activeQueries;
-    std::unordered_set<QueryObject> startedQueries;
-    std::unordered_map<ImageSubresourcePair, IMAGE_CMD_BUF_LAYOUT_NODE> imageLayoutMap;
-    std::unordered_map<VkImage, std::vector<ImageSubresourcePair>> imageSubresourceMap;
+    std::vector<QUERY_RESET_EVENTS> waitedEventsBeforeQueryReset; // in recording order, later resets take precedence
+    QueryStateMap queryToStateMap;
+    QuerySet activeQueries;
+    QuerySet startedQueries;
+    std::unordered_map<VkImage, ImageLayoutMap<IMAGE_CMD_BUF_LAYOUT_NODE>> imageLayoutMap;
     std::unordered_map<VkEvent, VkPipelineStageFlags> eventToStageMap;
-    std::vector<DRAW_DATA> drawData;
+    std::unordered_set<VkBuffer> drawBuffers; // Vertex buffers bound at any draw
     DRAW_DATA currentDrawData;
+    CB_SUBMIT_RESOURCES submitResources;
     VkCommandBuffer primaryCommandBuffer;
     // Track images and buffers that are updated by this CB at the point of a draw
     std::unordered_set<VkImageView> updateImages;
@@ -476,10 +918,13 @@ struct GLOBAL_CB_NODE : public BASE_NODE {
     // execution
     std::unordered_set<VkCommandBuffer> secondaryCommandBuffers;
     // MTMTODO : Scrub these data fields and merge active sets w/ lastBound as appropriate
-    std::vector<std::function<bool()>> validate_functions;
+    std::vector<DEFERRED_MEMORY_OP> memoryOps;
+    // Index in memoryOps of the last op queued per memory object and per swapchain image
+    std::unordered_map<VkDeviceMemory, size_t> lastMemoryOp;
+    std::unordered_map<VkImage, size_t> lastSwapchainImageOp;
     std::unordered_set<VkDeviceMemory> memObjs;
-    std::vector<std::function<bool(VkQueue)>> eventUpdates;
-    std::vector<std::function<bool(VkQueue)>> queryUpdates;
+    std::vector<DEFERRED_EVENT_OP> eventUpdates;
+    std::vector<DEFERRED_QUERY_OP> queryUpdates;
 
     ~GLOBAL_CB_NODE();
 };
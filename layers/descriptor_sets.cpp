@@ -263,55 +263,77 @@ bool cvdescriptorset::DescriptorSetLayout::VerifyUpdateConsistency(uint32_t curr
 cvdescriptorset::AllocateDescriptorSetsData::AllocateDescriptorSetsData(uint32_t count)
     : required_descriptors_by_type{}, layout_nodes(count, nullptr) {}
 
+std::atomic<uint64_t> cvdescriptorset::DescriptorSet::next_version_(0);
+
+static cvdescriptorset::DescriptorClass GetDescriptorClassFromType(VkDescriptorType type) {
+    switch (type) {
+    case VK_DESCRIPTOR_TYPE_SAMPLER:
+        return cvdescriptorset::PlainSampler;
+    case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+        return cvdescriptorset::ImageSampler;
+    case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+    case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+    case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+        return cvdescriptorset::Image;
+    case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+    case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+        return cvdescriptorset::TexelBuffer;
+    case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+    case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+        return cvdescriptorset::GeneralBuffer;
+    default:
+        assert(0); // Bad descriptor type specified
+        return cvdescriptorset::GeneralBuffer;
+    }
+}
+
 cvdescriptorset::DescriptorSet::DescriptorSet(const VkDescriptorSet set, const DescriptorSetLayout *layout,
                                               const core_validation::layer_data *dev_data)
-    : some_update_(false), set_(set), p_layout_(layout), device_data_(dev_data) {
+    : some_update_(false), version_(++next_version_), set_(set), p_layout_(layout), device_data_(dev_data) {
+    // Size the per-class arrays up front so allocating the set is a fixed number of allocations
+    uint32_t class_counts[GeneralBuffer + 1] = {};
+    for (uint32_t i = 0; i < p_layout_->GetBindingCount(); ++i) {
+        class_counts[GetDescriptorClassFromType(p_layout_->GetTypeFromIndex(i))] += p_layout_->GetDescriptorCountFromIndex(i);
+    }
+    descriptor_refs_.reserve(p_layout_->GetTotalDescriptorCount());
+    samplers_.reserve(class_counts[PlainSampler]);
+    image_samplers_.reserve(class_counts[ImageSampler]);
+    images_.reserve(class_counts[Image]);
+    texels_.reserve(class_counts[TexelBuffer]);
+    buffers_.reserve(class_counts[GeneralBuffer]);
     // Foreach binding, create default descriptors of given type
     for (uint32_t i = 0; i < p_layout_->GetBindingCount(); ++i) {
         auto type = p_layout_->GetTypeFromIndex(i);
-        switch (type) {
-        case VK_DESCRIPTOR_TYPE_SAMPLER: {
-            auto immut_sampler = p_layout_->GetImmutableSamplerPtrFromIndex(i);
-            for (uint32_t di = 0; di < p_layout_->GetDescriptorCountFromIndex(i); ++di) {
-                if (immut_sampler)
-                    descriptors_.emplace_back(new SamplerDescriptor(immut_sampler + di));
-                else
-                    descriptors_.emplace_back(new SamplerDescriptor());
+        auto descriptor_class = GetDescriptorClassFromType(type);
+        for (uint32_t di = 0; di < p_layout_->GetDescriptorCountFromIndex(i); ++di) {
+            switch (descriptor_class) {
+            case PlainSampler: {
+                auto immut_sampler = p_layout_->GetImmutableSamplerPtrFromIndex(i);
+                descriptor_refs_.push_back({descriptor_class, static_cast<uint32_t>(samplers_.size())});
+                samplers_.emplace_back(immut_sampler ? immut_sampler + di : nullptr);
+                break;
             }
-            break;
-        }
-        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER: {
-            auto immut = p_layout_->GetImmutableSamplerPtrFromIndex(i);
-            for (uint32_t di = 0; di < p_layout_->GetDescriptorCountFromIndex(i); ++di) {
-                if (immut)
-                    descriptors_.emplace_back(new ImageSamplerDescriptor(immut + di));
-                else
-                    descriptors_.emplace_back(new ImageSamplerDescriptor());
+            case ImageSampler: {
+                auto immut = p_layout_->GetImmutableSamplerPtrFromIndex(i);
+                descriptor_refs_.push_back({descriptor_class, static_cast<uint32_t>(image_samplers_.size())});
+                image_samplers_.emplace_back(immut ? immut + di : nullptr);
+                break;
+            }
+            case Image:
+                descriptor_refs_.push_back({descriptor_class, static_cast<uint32_t>(images_.size())});
+                images_.emplace_back(type);
+                break;
+            case TexelBuffer:
+                descriptor_refs_.push_back({descriptor_class, static_cast<uint32_t>(texels_.size())});
+                texels_.emplace_back(type);
+                break;
+            case GeneralBuffer:
+                descriptor_refs_.push_back({descriptor_class, static_cast<uint32_t>(buffers_.size())});
+                buffers_.emplace_back(type);
+                break;
             }
-            break;
-        }
-        // ImageDescriptors
-        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
-        case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
-        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
-            for (uint32_t di = 0; di < p_layout_->GetDescriptorCountFromIndex(i); ++di)
-                descriptors_.emplace_back(new ImageDescriptor(type));
-            break;
-        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
-        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
-            for (uint32_t di = 0; di < p_layout_->GetDescriptorCountFromIndex(i); ++di)
-                descriptors_.emplace_back(new TexelDescriptor(type));
-            break;
-        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
-        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
-        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
-        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
-            for (uint32_t di = 0; di < p_layout_->GetDescriptorCountFromIndex(i); ++di)
-                descriptors_.emplace_back(new BufferDescriptor(type));
-            break;
-        default:
-            assert(0); // Bad descriptor type specified
-            break;
         }
     }
 }
@@ -325,6 +347,93 @@ cvdescriptorset::DescriptorSet::~DescriptorSet() {
         }
     }
 }
+
+const cvdescriptorset::Descriptor *cvdescriptorset::DescriptorSet::GetDescriptor(const uint32_t index) const {
+    auto const &ref = descriptor_refs_[index];
+    switch (ref.descriptor_class) {
+    case PlainSampler:
+        return &samplers_[ref.index];
+    case ImageSampler:
+        return &image_samplers_[ref.index];
+    case Image:
+        return &images_[ref.index];
+    case TexelBuffer:
+        return &texels_[ref.index];
+    case GeneralBuffer:
+        return &buffers_[ref.index];
+    }
+    return nullptr;
+}
+
+bool cvdescriptorset::DescriptorSet::IsImmutableSampler(const uint32_t index) const {
+    auto const &ref = descriptor_refs_[index];
+    switch (ref.descriptor_class) {
+    case PlainSampler:
+        return samplers_[ref.index].IsImmutableSampler();
+    case ImageSampler:
+        return image_samplers_[ref.index].IsImmutableSampler();
+    default:
+        return false;
+    }
+}
+
+bool cvdescriptorset::DescriptorSet::IsStorage(const uint32_t index) const {
+    auto const &ref = descriptor_refs_[index];
+    switch (ref.descriptor_class) {
+    case Image:
+        return images_[ref.index].IsStorage();
+    case TexelBuffer:
+        return texels_[ref.index].IsStorage();
+    case GeneralBuffer:
+        return buffers_[ref.index].IsStorage();
+    default:
+        return false;
+    }
+}
+
+void cvdescriptorset::DescriptorSet::WriteDescriptor(const uint32_t index, const VkWriteDescriptorSet *update,
+                                                     const uint32_t di) {
+    auto const &ref = descriptor_refs_[index];
+    switch (ref.descriptor_class) {
+    case PlainSampler:
+        samplers_[ref.index].WriteUpdate(update, di);
+        break;
+    case ImageSampler:
+        image_samplers_[ref.index].WriteUpdate(update, di);
+        break;
+    case Image:
+        images_[ref.index].WriteUpdate(update, di);
+        break;
+    case TexelBuffer:
+        texels_[ref.index].WriteUpdate(update, di);
+        break;
+    case GeneralBuffer:
+        buffers_[ref.index].WriteUpdate(update, di);
+        break;
+    }
+}
+
+void cvdescriptorset::DescriptorSet::CopyDescriptor(const uint32_t index, const DescriptorSet *src_set, const uint32_t src_index) {
+    auto const &ref = descriptor_refs_[index];
+    assert(ref.descriptor_class == src_set->GetDescriptorClass(src_index));
+    switch (ref.descriptor_class) {
+    case PlainSampler:
+        samplers_[ref.index].CopyUpdate(&src_set->GetSamplerDescriptor(src_index));
+        break;
+    case ImageSampler:
+        image_samplers_[ref.index].CopyUpdate(&src_set->GetImageSamplerDescriptor(src_index));
+        break;
+    case Image:
+        images_[ref.index].CopyUpdate(&src_set->GetImageDescriptor(src_index));
+        break;
+    case TexelBuffer:
+        texels_[ref.index].CopyUpdate(&src_set->GetTexelDescriptor(src_index));
+        break;
+    case GeneralBuffer:
+        buffers_[ref.index].CopyUpdate(&src_set->GetBufferDescriptor(src_index));
+        break;
+    }
+}
 // Is this sets underlying layout compatible with passed in layout according to "Pipeline Layout Compatibility" in spec?
 bool cvdescriptorset::DescriptorSet::IsCompatible(const DescriptorSetLayout *layout, std::string *error) const {
     return layout->IsCompatible(p_layout_, error);
@@ -338,21 +447,22 @@ bool cvdescriptorset::DescriptorSet::ValidateDrawState(const std::unordered_set<
     auto dyn_offset_index = 0;
     for (auto binding : bindings) {
         auto start_idx = p_layout_->GetGlobalStartIndexFromBinding(binding);
-        if (descriptors_[start_idx]->IsImmutableSampler()) {
+        if (IsImmutableSampler(start_idx)) {
             // Nothing to do for strictly immutable sampler
         } else {
             auto end_idx = p_layout_->GetGlobalEndIndexFromBinding(binding);
             for (uint32_t i = start_idx; i <= end_idx; ++i) {
-                if (!descriptors_[i]->updated) {
+                if (!GetDescriptor(i)->updated) {
                     std::stringstream error_str;
                     error_str << "Descriptor in binding #" << binding << " at global descriptor index " << i
                               << " is being used in draw but has not been updated.";
                     *error = error_str.str();
                     return false;
                 } else {
-                    if (GeneralBuffer == descriptors_[i]->GetClass()) {
+                    if (GeneralBuffer == GetDescriptorClass(i)) {
                         // Verify that buffers are valid
-                        auto buffer = static_cast<BufferDescriptor *>(descriptors_[i].get())->GetBuffer();
+                        auto const &buffer_desc = GetBufferDescriptor(i);
+                        auto buffer = buffer_desc.GetBuffer();
                         auto buffer_node = getBufferNode(device_data_, buffer);
                         if (!buffer_node) {
                             std::stringstream error_str;
@@ -371,11 +481,11 @@ bool cvdescriptorset::DescriptorSet::ValidateDrawState(const std::unordered_set<
                                 return false;
                             }
                         }
-                        if (descriptors_[i]->IsDynamic()) {
+                        if (buffer_desc.IsDynamic()) {
                             // Validate that dynamic offsets are within the buffer
                             auto buffer_size = buffer_node->createInfo.size;
-                            auto range = static_cast<BufferDescriptor *>(descriptors_[i].get())->GetRange();
-                            auto desc_offset = static_cast<BufferDescriptor *>(descriptors_[i].get())->GetOffset();
+                            auto range = buffer_desc.GetRange();
+                            auto desc_offset = buffer_desc.GetOffset();
                             auto dyn_offset = dynamic_offsets[dyn_offset_index++];
                             if (VK_WHOLE_SIZE == range) {
                                 if ((dyn_offset + desc_offset) > buffer_size) {
@@ -414,18 +524,20 @@ uint32_t cvdescriptorset::DescriptorSet::GetStorageUpdates(const std::unordered_
     auto num_updates = 0;
     for (auto binding : bindings) {
         auto start_idx = p_layout_->GetGlobalStartIndexFromBinding(binding);
-        if (descriptors_[start_idx]->IsStorage()) {
-            if (Image == descriptors_[start_idx]->descriptor_class) {
+        if (IsStorage(start_idx)) {
+            if (Image == GetDescriptorClass(start_idx)) {
                 for (uint32_t i = 0; i < p_layout_->GetDescriptorCountFromBinding(binding); ++i) {
-                    if (descriptors_[start_idx + i]->updated) {
-                        image_set->insert(static_cast<ImageDescriptor *>(descriptors_[start_idx + i].get())->GetImageView());
+                    auto const &image_desc = GetImageDescriptor(start_idx + i);
+                    if (image_desc.updated) {
+                        image_set->insert(image_desc.GetImageView());
                         num_updates++;
                     }
                 }
-            } else if (TexelBuffer == descriptors_[start_idx]->descriptor_class) {
+            } else if (TexelBuffer == GetDescriptorClass(start_idx)) {
                 for (uint32_t i = 0; i < p_layout_->GetDescriptorCountFromBinding(binding); ++i) {
-                    if (descriptors_[start_idx + i]->updated) {
-                        auto bufferview = static_cast<TexelDescriptor *>(descriptors_[start_idx + i].get())->GetBufferView();
+                    auto const &texel_desc = GetTexelDescriptor(start_idx + i);
+                    if (texel_desc.updated) {
+                        auto bufferview = texel_desc.GetBufferView();
                         auto bv_info = getBufferViewInfo(device_data_, bufferview);
                         if (bv_info) {
                             buffer_set->insert(bv_info->buffer);
@@ -433,10 +545,11 @@ uint32_t cvdescriptorset::DescriptorSet::GetStorageUpdates(const std::unordered_
                         }
                     }
                 }
-            } else if (GeneralBuffer == descriptors_[start_idx]->descriptor_class) {
+            } else if (GeneralBuffer == GetDescriptorClass(start_idx)) {
                 for (uint32_t i = 0; i < p_layout_->GetDescriptorCountFromBinding(binding); ++i) {
-                    if (descriptors_[start_idx + i]->updated) {
-                        buffer_set->insert(static_cast<BufferDescriptor *>(descriptors_[start_idx + i].get())->GetBuffer());
+                    auto const &buffer_desc = GetBufferDescriptor(start_idx + i);
+                    if (buffer_desc.updated) {
+                        buffer_set->insert(buffer_desc.GetBuffer());
                         num_updates++;
                     }
                 }
@@ -451,15 +564,20 @@ void cvdescriptorset::DescriptorSet::InvalidateBoundCmdBuffers() {
         cb_node->state = CB_INVALID;
     }
 }
-// Perform write update in given update struct
-void cvdescriptorset::DescriptorSet::PerformWriteUpdate(const VkWriteDescriptorSet *update) {
-    auto start_idx = p_layout_->GetGlobalStartIndexFromBinding(update->dstBinding) + update->dstArrayElement;
-    // perform update
-    for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-        descriptors_[start_idx + di]->WriteUpdate(update, di);
+// Perform the write updates at the given indices, in order, then invalidate bound cmd buffers once for all of them
+void cvdescriptorset::DescriptorSet::PerformWriteUpdates(const VkWriteDescriptorSet *p_wds,
+                                                         const std::vector<uint32_t> &write_indices) {
+    for (auto write_index : write_indices) {
+        const VkWriteDescriptorSet *update = &p_wds[write_index];
+        auto start_idx = p_layout_->GetGlobalStartIndexFromBinding(update->dstBinding) + update->dstArrayElement;
+        // perform update
+        for (uint32_t di = 0; di < update->descriptorCount; ++di) {
+            WriteDescriptor(start_idx + di, update, di);
+        }
+        if (update->descriptorCount)
+            some_update_ = true;
     }
-    if (update->descriptorCount)
-        some_update_ = true;
+    version_ = ++next_version_;
 
     InvalidateBoundCmdBuffers();
 }
@@ -530,7 +648,7 @@ bool cvdescriptorset::DescriptorSet::ValidateCopyUpdate(const debug_report_data
     }
     // First make sure source descriptors are updated
     for (uint32_t i = 0; i < update->descriptorCount; ++i) {
-        if (!src_set->descriptors_[src_start_idx + i]) {
+        if (!src_set->GetDescriptor(src_start_idx + i)) {
             std::stringstream error_str;
             error_str << "Attempting copy update from descriptorSet " << src_set << " binding #" << update->srcBinding << " but descriptor at array offset "
                       << update->srcArrayElement + i << " has not been updated.";
@@ -551,22 +669,16 @@ void cvdescriptorset::DescriptorSet::PerformCopyUpdate(const VkCopyDescriptorSet
     auto dst_start_idx = p_layout_->GetGlobalStartIndexFromBinding(update->dstBinding) + update->dstArrayElement;
     // Update parameters all look good so perform update
     for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-        descriptors_[dst_start_idx + di]->CopyUpdate(src_set->descriptors_[src_start_idx + di].get());
+        CopyDescriptor(dst_start_idx + di, src_set, src_start_idx + di);
     }
     if (update->descriptorCount)
         some_update_ = true;
+    version_ = ++next_version_;
 
     InvalidateBoundCmdBuffers();
 }
 
-cvdescriptorset::SamplerDescriptor::SamplerDescriptor() : sampler_(VK_NULL_HANDLE), immutable_(false) {
-    updated = false;
-    descriptor_class = PlainSampler;
-};
-
 cvdescriptorset::SamplerDescriptor::SamplerDescriptor(const VkSampler *immut) : sampler_(VK_NULL_HANDLE), immutable_(false) {
-    updated = false;
-    descriptor_class = PlainSampler;
     if (immut) {
         sampler_ = *immut;
         immutable_ = true;
@@ -709,24 +821,16 @@ void cvdescriptorset::SamplerDescriptor::WriteUpdate(const VkWriteDescriptorSet
     updated = true;
 }
 
-void cvdescriptorset::SamplerDescriptor::CopyUpdate(const Descriptor *src) {
+void cvdescriptorset::SamplerDescriptor::CopyUpdate(const SamplerDescriptor *src) {
     if (!immutable_) {
-        auto update_sampler = static_cast<const SamplerDescriptor *>(src)->sampler_;
+        auto update_sampler = src->sampler_;
         sampler_ = update_sampler;
     }
     updated = true;
 }
 
-cvdescriptorset::ImageSamplerDescriptor::ImageSamplerDescriptor()
-    : sampler_(VK_NULL_HANDLE), immutable_(false), image_view_(VK_NULL_HANDLE), image_layout_(VK_IMAGE_LAYOUT_UNDEFINED) {
-    updated = false;
-    descriptor_class = ImageSampler;
-}
-
 cvdescriptorset::ImageSamplerDescriptor::ImageSamplerDescriptor(const VkSampler *immut)
-    : sampler_(VK_NULL_HANDLE), immutable_(true), image_view_(VK_NULL_HANDLE), image_layout_(VK_IMAGE_LAYOUT_UNDEFINED) {
-    updated = false;
-    descriptor_class = ImageSampler;
+    : sampler_(VK_NULL_HANDLE), immutable_(false), image_view_(VK_NULL_HANDLE), image_layout_(VK_IMAGE_LAYOUT_UNDEFINED) {
     if (immut) {
         sampler_ = *immut;
         immutable_ = true;
@@ -742,13 +846,13 @@ void cvdescriptorset::ImageSamplerDescriptor::WriteUpdate(const VkWriteDescripto
     image_layout_ = image_info.imageLayout;
 }
 
-void cvdescriptorset::ImageSamplerDescriptor::CopyUpdate(const Descriptor *src) {
+void cvdescriptorset::ImageSamplerDescriptor::CopyUpdate(const ImageSamplerDescriptor *src) {
     if (!immutable_) {
-        auto update_sampler = static_cast<const ImageSamplerDescriptor *>(src)->sampler_;
+        auto update_sampler = src->sampler_;
         sampler_ = update_sampler;
     }
-    auto image_view = static_cast<const ImageSamplerDescriptor *>(src)->image_view_;
-    auto image_layout = static_cast<const ImageSamplerDescriptor *>(src)->image_layout_;
+    auto image_view = src->image_view_;
+    auto image_layout = src->image_layout_;
     updated = true;
     image_view_ = image_view;
     image_layout_ = image_layout;
@@ -756,8 +860,6 @@ void cvdescriptorset::ImageSamplerDescriptor::CopyUpdate(const Descriptor *src)
 
 cvdescriptorset::ImageDescriptor::ImageDescriptor(const VkDescriptorType type)
     : storage_(false), image_view_(VK_NULL_HANDLE), image_layout_(VK_IMAGE_LAYOUT_UNDEFINED) {
-    updated = false;
-    descriptor_class = Image;
     if (VK_DESCRIPTOR_TYPE_STORAGE_IMAGE == type)
         storage_ = true;
 };
@@ -769,9 +871,9 @@ void cvdescriptorset::ImageDescriptor::WriteUpdate(const VkWriteDescriptorSet *u
     image_layout_ = image_info.imageLayout;
 }
 
-void cvdescriptorset::ImageDescriptor::CopyUpdate(const Descriptor *src) {
-    auto image_view = static_cast<const ImageDescriptor *>(src)->image_view_;
-    auto image_layout = static_cast<const ImageDescriptor *>(src)->image_layout_;
+void cvdescriptorset::ImageDescriptor::CopyUpdate(const ImageDescriptor *src) {
+    auto image_view = src->image_view_;
+    auto image_layout = src->image_layout_;
     updated = true;
     image_view_ = image_view;
     image_layout_ = image_layout;
@@ -779,8 +881,6 @@ void cvdescriptorset::ImageDescriptor::CopyUpdate(const Descriptor *src) {
 
 cvdescriptorset::BufferDescriptor::BufferDescriptor(const VkDescriptorType type)
     : storage_(false), dynamic_(false), buffer_(VK_NULL_HANDLE), offset_(0), range_(0) {
-    updated = false;
-    descriptor_class = GeneralBuffer;
     if (VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC == type) {
         dynamic_ = true;
     } else if (VK_DESCRIPTOR_TYPE_STORAGE_BUFFER == type) {
@@ -798,8 +898,8 @@ void cvdescriptorset::BufferDescriptor::WriteUpdate(const VkWriteDescriptorSet *
     range_ = buffer_info.range;
 }
 
-void cvdescriptorset::BufferDescriptor::CopyUpdate(const Descriptor *src) {
-    auto buff_desc = static_cast<const BufferDescriptor *>(src);
+void cvdescriptorset::BufferDescriptor::CopyUpdate(const BufferDescriptor *src) {
+    auto buff_desc = src;
     updated = true;
     buffer_ = buff_desc->buffer_;
     offset_ = buff_desc->offset_;
@@ -807,8 +907,6 @@ void cvdescriptorset::BufferDescriptor::CopyUpdate(const Descriptor *src) {
 }
 
 cvdescriptorset::TexelDescriptor::TexelDescriptor(const VkDescriptorType type) : buffer_view_(VK_NULL_HANDLE), storage_(false) {
-    updated = false;
-    descriptor_class = TexelBuffer;
     if (VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER == type)
         storage_ = true;
 };
@@ -818,42 +916,61 @@ void cvdescriptorset::TexelDescriptor::WriteUpdate(const VkWriteDescriptorSet *u
     buffer_view_ = update->pTexelBufferView[index];
 }
 
-void cvdescriptorset::TexelDescriptor::CopyUpdate(const Descriptor *src) {
+void cvdescriptorset::TexelDescriptor::CopyUpdate(const TexelDescriptor *src) {
     updated = true;
-    buffer_view_ = static_cast<const TexelDescriptor *>(src)->buffer_view_;
+    buffer_view_ = src->buffer_view_;
 }
-// This is a helper function that iterates over a set of Write and Copy updates, pulls the DescriptorSet* for updated
-//  sets, and then calls their respective Validate[Write|Copy]Update functions.
-// If the update hits an issue for which the callback returns "true", meaning that the call down the chain should
-//  be skipped, then true is returned.
-// If there is no issue with the update, then false is returned.
-bool cvdescriptorset::ValidateUpdateDescriptorSets(const debug_report_data *report_data,
-                                                   const core_validation::layer_data *dev_data, uint32_t write_count,
-                                                   const VkWriteDescriptorSet *p_wds, uint32_t copy_count,
-                                                   const VkCopyDescriptorSet *p_cds) {
-    bool skip_call = false;
-    // Validate Write updates
+// Split write updates into groups by destination set. Writes to a set are usually passed back to back, so the last group
+//  is checked before falling back to a lookup.
+void cvdescriptorset::GroupWriteUpdates(uint32_t write_count, const VkWriteDescriptorSet *p_wds,
+                                        std::vector<WriteUpdateGroup> *groups) {
+    std::unordered_map<VkDescriptorSet, size_t> group_index;
     for (uint32_t i = 0; i < write_count; i++) {
         auto dest_set = p_wds[i].dstSet;
-        auto set_node = core_validation::getSetNode(dev_data, dest_set);
+        if (groups->empty() || groups->back().dst_set != dest_set) {
+            auto inserted = group_index.emplace(dest_set, groups->size());
+            if (inserted.second) {
+                groups->push_back({dest_set, {}});
+            } else {
+                (*groups)[inserted.first->second].write_indices.push_back(i);
+                continue;
+            }
+        }
+        groups->back().write_indices.push_back(i);
+    }
+}
+// Validate the write updates of one group, pulling the DescriptorSet* once and calling its ValidateWriteUpdate function
+//  for each write
+bool cvdescriptorset::ValidateWriteUpdateGroup(const debug_report_data *report_data, const core_validation::layer_data *dev_data,
+                                               const VkWriteDescriptorSet *p_wds, const WriteUpdateGroup &group) {
+    bool skip_call = false;
+    auto dest_set = group.dst_set;
+    auto set_node = core_validation::getSetNode(dev_data, dest_set);
+    for (auto write_index : group.write_indices) {
         if (!set_node) {
             skip_call |=
                 log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_SET_EXT,
                         reinterpret_cast<uint64_t &>(dest_set), __LINE__, DRAWSTATE_INVALID_DESCRIPTOR_SET, "DS",
-                        "Cannot call vkUpdateDescriptorSets() on descriptor set 0x%" PRIxLEAST64 " that has not been allocated.",
-                        reinterpret_cast<uint64_t &>(dest_set));
+                        "Cannot call vkUpdateDescriptorSets() with pDescriptorWrites[%u] on descriptor set 0x%" PRIxLEAST64
+                        " that has not been allocated.",
+                        write_index, reinterpret_cast<uint64_t &>(dest_set));
         } else {
             std::string error_str;
-            if (!set_node->ValidateWriteUpdate(report_data, &p_wds[i], &error_str)) {
+            if (!set_node->ValidateWriteUpdate(report_data, &p_wds[write_index], &error_str)) {
                 skip_call |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_SET_EXT,
                                      reinterpret_cast<uint64_t &>(dest_set), __LINE__, DRAWSTATE_INVALID_UPDATE_INDEX, "DS",
-                                     "vkUpdateDescriptorsSets() failed write update validation for Descriptor Set 0x%" PRIx64
-                                     " with error: %s",
-                                     reinterpret_cast<uint64_t &>(dest_set), error_str.c_str());
+                                     "vkUpdateDescriptorsSets() failed write update validation of pDescriptorWrites[%u] for "
+                                     "Descriptor Set 0x%" PRIx64 " with error: %s",
+                                     write_index, reinterpret_cast<uint64_t &>(dest_set), error_str.c_str());
             }
         }
     }
-    // Now validate copy updates
+    return skip_call;
+}
+// Validate copy updates, pulling the DescriptorSet* for the src & dst sets and calling ValidateCopyUpdate on the dst set
+bool cvdescriptorset::ValidateCopyUpdates(const debug_report_data *report_data, const core_validation::layer_data *dev_data,
+                                          uint32_t copy_count, const VkCopyDescriptorSet *p_cds) {
+    bool skip_call = false;
     for (uint32_t i = 0; i < copy_count; ++i) {
         auto dst_set = p_cds[i].dstSet;
         auto src_set = p_cds[i].srcSet;
@@ -885,26 +1002,25 @@ bool cvdescriptorset::ValidateUpdateDescriptorSets(const debug_report_data *repo
     }
     return skip_call;
 }
-// This is a helper function that iterates over a set of Write and Copy updates, pulls the DescriptorSet* for updated
-//  sets, and then calls their respective Perform[Write|Copy]Update functions.
-// Prerequisite : ValidateUpdateDescriptorSets() should be called and return "false" prior to calling PerformUpdateDescriptorSets()
-//  with the same set of updates.
+// This is a helper function that iterates over the grouped Write updates and the Copy updates, pulls the DescriptorSet*
+//  for updated sets, and then calls their respective Perform[Write|Copy]Update functions.
+// Prerequisite : ValidateWriteUpdateGroup() and ValidateCopyUpdates() should be called and return "false" prior to calling
+//  PerformUpdateDescriptorSets() with the same set of updates.
 // This is split from the validate code to allow validation prior to calling down the chain, and then update after
 //  calling down the chain.
-void cvdescriptorset::PerformUpdateDescriptorSets(const core_validation::layer_data *dev_data, uint32_t write_count,
+void cvdescriptorset::PerformUpdateDescriptorSets(const core_validation::layer_data *dev_data,
+                                                  const std::vector<WriteUpdateGroup> &write_groups,
                                                   const VkWriteDescriptorSet *p_wds, uint32_t copy_count,
                                                   const VkCopyDescriptorSet *p_cds) {
-    // Write updates first
-    uint32_t i = 0;
-    for (i = 0; i < write_count; ++i) {
-        auto dest_set = p_wds[i].dstSet;
-        auto set_node = core_validation::getSetNode(dev_data, dest_set);
+    // Write updates first, each set looked up and its bound cmd buffers invalidated once
+    for (auto const &group : write_groups) {
+        auto set_node = core_validation::getSetNode(dev_data, group.dst_set);
         if (set_node) {
-            set_node->PerformWriteUpdate(&p_wds[i]);
+            set_node->PerformWriteUpdates(p_wds, group.write_indices);
         }
     }
     // Now copy updates
-    for (i = 0; i < copy_count; ++i) {
+    for (uint32_t i = 0; i < copy_count; ++i) {
         auto dst_set = p_cds[i].dstSet;
         auto src_set = p_cds[i].srcSet;
         auto src_node = core_validation::getSetNode(dev_data, src_set);
@@ -1037,7 +1153,7 @@ bool cvdescriptorset::DescriptorSet::VerifyWriteUpdateContents(const VkWriteDesc
     }
     case VK_DESCRIPTOR_TYPE_SAMPLER: {
         for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-            if (!descriptors_[index + di].get()->IsImmutableSampler()) {
+            if (!IsImmutableSampler(index + di)) {
                 if (!ValidateSampler(update->pImageInfo[di].sampler, device_data_)) {
                     std::stringstream error_str;
                     error_str << "Attempted write update to sampler descriptor with invalid sampler: "
@@ -1112,11 +1228,12 @@ bool cvdescriptorset::DescriptorSet::VerifyWriteUpdateContents(const VkWriteDesc
 // Verify that the contents of the update are ok, but don't perform actual update
 bool cvdescriptorset::DescriptorSet::VerifyCopyUpdateContents(const VkCopyDescriptorSet *update, const DescriptorSet *src_set,
                                                               VkDescriptorType type, uint32_t index, std::string *error) const {
-    switch (src_set->descriptors_[index]->descriptor_class) {
+    switch (src_set->GetDescriptorClass(index)) {
     case PlainSampler: {
         for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-            if (!src_set->descriptors_[index + di]->IsImmutableSampler()) {
-                auto update_sampler = static_cast<SamplerDescriptor *>(src_set->descriptors_[index + di].get())->GetSampler();
+            auto const &sampler_desc = src_set->GetSamplerDescriptor(index + di);
+            if (!sampler_desc.IsImmutableSampler()) {
+                auto update_sampler = sampler_desc.GetSampler();
                 if (!ValidateSampler(update_sampler, device_data_)) {
                     std::stringstream error_str;
                     error_str << "Attempted copy update to sampler descriptor with invalid sampler: " << update_sampler << ".";
@@ -1131,7 +1248,7 @@ bool cvdescriptorset::DescriptorSet::VerifyCopyUpdateContents(const VkCopyDescri
     }
     case ImageSampler: {
         for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-            auto img_samp_desc = static_cast<const ImageSamplerDescriptor *>(src_set->descriptors_[index + di].get());
+            auto img_samp_desc = &src_set->GetImageSamplerDescriptor(index + di);
             // First validate sampler
             if (!img_samp_desc->IsImmutableSampler()) {
                 auto update_sampler = img_samp_desc->GetSampler();
@@ -1154,10 +1271,11 @@ bool cvdescriptorset::DescriptorSet::VerifyCopyUpdateContents(const VkCopyDescri
                 return false;
             }
         }
+        break;
     }
     case Image: {
         for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-            auto img_desc = static_cast<const ImageDescriptor *>(src_set->descriptors_[index + di].get());
+            auto img_desc = &src_set->GetImageDescriptor(index + di);
             auto image_view = img_desc->GetImageView();
             auto image_layout = img_desc->GetImageLayout();
             if (!ValidateImageUpdate(image_view, image_layout, type, device_data_, error)) {
@@ -1171,7 +1289,7 @@ bool cvdescriptorset::DescriptorSet::VerifyCopyUpdateContents(const VkCopyDescri
     }
     case TexelBuffer: {
         for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-            auto buffer_view = static_cast<TexelDescriptor *>(src_set->descriptors_[index + di].get())->GetBufferView();
+            auto buffer_view = src_set->GetTexelDescriptor(index + di).GetBufferView();
             auto bv_info = getBufferViewInfo(device_data_, buffer_view);
             if (!bv_info) {
                 std::stringstream error_str;
@@ -1191,7 +1309,7 @@ bool cvdescriptorset::DescriptorSet::VerifyCopyUpdateContents(const VkCopyDescri
     }
     case GeneralBuffer: {
         for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-            auto buffer = static_cast<BufferDescriptor *>(src_set->descriptors_[index + di].get())->GetBuffer();
+            auto buffer = src_set->GetBufferDescriptor(index + di).GetBuffer();
             if (!ValidateBufferUpdate(buffer, type, error)) {
                 std::stringstream error_str;
                 error_str << "Attempted copy update to buffer descriptor failed due to: " << error->c_str();
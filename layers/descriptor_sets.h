@@ -47,6 +47,7 @@
 #include "vk_layer_utils.h"
 #include "vk_safe_struct.h"
 #include "vulkan/vk_layer.h"
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
@@ -135,9 +136,11 @@ class DescriptorSetLayout {
 
 /*
  * Descriptor classes
- *  Descriptor is an abstract base class from which 5 separate descriptor types are derived.
- *   This allows the WriteUpdate() and CopyUpdate() operations to be specialized per
- *   descriptor type, but all descriptors in a set can be accessed via the common Descriptor*.
+ *  There are 5 separate descriptor classes, one per group of descriptor types that share their contents.
+ *   Descriptors are plain values: a DescriptorSet stores them in one contiguous array per class and records
+ *   the class of every global index, so operations on an arbitrary descriptor switch on its DescriptorClass
+ *   instead of going through a vtable, and allocating a set costs one allocation per class in use rather
+ *   than one per descriptor.
  */
 
 // Slightly broader than type, each c++ "class" will has a corresponding "DescriptorClass"
@@ -145,18 +148,8 @@ enum DescriptorClass { PlainSampler, ImageSampler, Image, TexelBuffer, GeneralBu
 
 class Descriptor {
   public:
-    virtual ~Descriptor(){};
-    virtual void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t) = 0;
-    virtual void CopyUpdate(const Descriptor *) = 0;
-    virtual DescriptorClass GetClass() const { return descriptor_class; };
-    // Special fast-path check for SamplerDescriptors that are immutable
-    virtual bool IsImmutableSampler() const { return false; };
-    // Check for dynamic descriptor type
-    virtual bool IsDynamic() const { return false; };
-    // Check for storage descriptor type
-    virtual bool IsStorage() const { return false; };
+    Descriptor() : updated(false){};
     bool updated; // Has descriptor been updated?
-    DescriptorClass descriptor_class;
 };
 // Shared helper functions - These are useful because the shared sampler image descriptor type
 //  performs common functions with both sampler and image descriptors so they can share their common functions
@@ -165,11 +158,10 @@ bool ValidateImageUpdate(VkImageView, VkImageLayout, VkDescriptorType, const cor
 
 class SamplerDescriptor : public Descriptor {
   public:
-    SamplerDescriptor();
     SamplerDescriptor(const VkSampler *);
-    void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t) override;
-    void CopyUpdate(const Descriptor *) override;
-    virtual bool IsImmutableSampler() const override { return immutable_; };
+    void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t);
+    void CopyUpdate(const SamplerDescriptor *);
+    bool IsImmutableSampler() const { return immutable_; };
     VkSampler GetSampler() const { return sampler_; }
 
   private:
@@ -180,11 +172,10 @@ class SamplerDescriptor : public Descriptor {
 
 class ImageSamplerDescriptor : public Descriptor {
   public:
-    ImageSamplerDescriptor();
     ImageSamplerDescriptor(const VkSampler *);
-    void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t) override;
-    void CopyUpdate(const Descriptor *) override;
-    virtual bool IsImmutableSampler() const override { return immutable_; };
+    void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t);
+    void CopyUpdate(const ImageSamplerDescriptor *);
+    bool IsImmutableSampler() const { return immutable_; };
     VkSampler GetSampler() const { return sampler_; }
     VkImageView GetImageView() const { return image_view_; }
     VkImageLayout GetImageLayout() const { return image_layout_; }
@@ -199,9 +190,9 @@ class ImageSamplerDescriptor : public Descriptor {
 class ImageDescriptor : public Descriptor {
   public:
     ImageDescriptor(const VkDescriptorType);
-    void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t) override;
-    void CopyUpdate(const Descriptor *) override;
-    virtual bool IsStorage() const override { return storage_; }
+    void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t);
+    void CopyUpdate(const ImageDescriptor *);
+    bool IsStorage() const { return storage_; }
     VkImageView GetImageView() const { return image_view_; }
     VkImageLayout GetImageLayout() const { return image_layout_; }
 
@@ -214,9 +205,9 @@ class ImageDescriptor : public Descriptor {
 class TexelDescriptor : public Descriptor {
   public:
     TexelDescriptor(const VkDescriptorType);
-    void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t) override;
-    void CopyUpdate(const Descriptor *) override;
-    virtual bool IsStorage() const override { return storage_; }
+    void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t);
+    void CopyUpdate(const TexelDescriptor *);
+    bool IsStorage() const { return storage_; }
     VkBufferView GetBufferView() const { return buffer_view_; }
 
   private:
@@ -227,10 +218,10 @@ class TexelDescriptor : public Descriptor {
 class BufferDescriptor : public Descriptor {
   public:
     BufferDescriptor(const VkDescriptorType);
-    void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t) override;
-    void CopyUpdate(const Descriptor *) override;
-    virtual bool IsDynamic() const override { return dynamic_; }
-    virtual bool IsStorage() const override { return storage_; }
+    void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t);
+    void CopyUpdate(const BufferDescriptor *);
+    bool IsDynamic() const { return dynamic_; }
+    bool IsStorage() const { return storage_; }
     VkBuffer GetBuffer() const { return buffer_; }
     VkDeviceSize GetOffset() const { return offset_; }
     VkDeviceSize GetRange() const { return range_; }
@@ -248,13 +239,22 @@ struct AllocateDescriptorSetsData {
     std::vector<cvdescriptorset::DescriptorSetLayout const *> layout_nodes;
     AllocateDescriptorSetsData(uint32_t);
 };
+// The write updates of one vkUpdateDescriptorSets() call that target the same set, in the order they were passed
+struct WriteUpdateGroup {
+    VkDescriptorSet dst_set;
+    std::vector<uint32_t> write_indices;
+};
 // Helper functions for descriptor set functions that cross multiple sets
-// "Validate" will make sure an update is ok without actually performing it
-bool ValidateUpdateDescriptorSets(const debug_report_data *, const core_validation::layer_data *, uint32_t,
-                                  const VkWriteDescriptorSet *, uint32_t, const VkCopyDescriptorSet *);
-// "Perform" does the update with the assumption that ValidateUpdateDescriptorSets() has passed for the given update
-void PerformUpdateDescriptorSets(const core_validation::layer_data *, uint32_t, const VkWriteDescriptorSet *, uint32_t,
-                                 const VkCopyDescriptorSet *);
+// Group write updates by destination set, so that each set is looked up and invalidated once per call
+void GroupWriteUpdates(uint32_t, const VkWriteDescriptorSet *, std::vector<WriteUpdateGroup> *);
+// "Validate" will make sure an update is ok without actually performing it. Groups touch disjoint sets and only read
+//  device state, so separate groups may be validated concurrently.
+bool ValidateWriteUpdateGroup(const debug_report_data *, const core_validation::layer_data *, const VkWriteDescriptorSet *,
+                              const WriteUpdateGroup &);
+bool ValidateCopyUpdates(const debug_report_data *, const core_validation::layer_data *, uint32_t, const VkCopyDescriptorSet *);
+// "Perform" does the update with the assumption that the Validate functions above have passed for the given updates
+void PerformUpdateDescriptorSets(const core_validation::layer_data *, const std::vector<WriteUpdateGroup> &,
+                                 const VkWriteDescriptorSet *, uint32_t, const VkCopyDescriptorSet *);
 // Validate that Allocation state is ok
 bool ValidateAllocateDescriptorSets(const debug_report_data *, const VkDescriptorSetAllocateInfo *,
                                     const core_validation::layer_data *, AllocateDescriptorSetsData *);
@@ -274,8 +274,8 @@ void PerformAllocateDescriptorSets(const VkDescriptorSetAllocateInfo *, const Vk
  *   Please refer to the DescriptorSetLayout comment above for a description of
  *   index, binding, and global index.
  *
- * At construction a vector of Descriptor* is created with types corresponding to the
- *   layout. The primary operation performed on the descriptors is to update them
+ * At construction the descriptors are created with types corresponding to the layout,
+ *   stored contiguously per DescriptorClass. The primary operation performed on the descriptors is to update them
  *   via write or copy updates, and validate that the update contents are correct.
  *   In order to validate update contents, the DescriptorSet stores a bunch of ptrs
  *   to data maps where various Vulkan objects can be looked up. The management of
@@ -320,8 +320,8 @@ class DescriptorSet : public BASE_NODE {
     // Descriptor Update functions. These functions validate state and perform update separately
     // Validate contents of a WriteUpdate
     bool ValidateWriteUpdate(const debug_report_data *, const VkWriteDescriptorSet *, std::string *);
-    // Perform a WriteUpdate whose contents were just validated using ValidateWriteUpdate
-    void PerformWriteUpdate(const VkWriteDescriptorSet *);
+    // Perform the WriteUpdates at the given indices of p_wds, whose contents were just validated using ValidateWriteUpdate
+    void PerformWriteUpdates(const VkWriteDescriptorSet *, const std::vector<uint32_t> &);
     // Validate contents of a CopyUpdate
     bool ValidateCopyUpdate(const debug_report_data *, const VkCopyDescriptorSet *, const DescriptorSet *, std::string *);
     // Perform a CopyUpdate whose contents were just validated using ValidateCopyUpdate
@@ -345,8 +345,23 @@ class DescriptorSet : public BASE_NODE {
     uint32_t GetGlobalEndIndexFromBinding(const uint32_t binding) const {
         return p_layout_->GetGlobalEndIndexFromBinding(binding);
     };
+    // Descriptor at the given global index, as its class or as the common base
+    const Descriptor *GetDescriptor(const uint32_t) const;
+    DescriptorClass GetDescriptorClass(const uint32_t index) const { return descriptor_refs_[index].descriptor_class; };
+    const SamplerDescriptor &GetSamplerDescriptor(const uint32_t index) const { return samplers_[descriptor_refs_[index].index]; };
+    const ImageSamplerDescriptor &GetImageSamplerDescriptor(const uint32_t index) const {
+        return image_samplers_[descriptor_refs_[index].index];
+    };
+    const ImageDescriptor &GetImageDescriptor(const uint32_t index) const { return images_[descriptor_refs_[index].index]; };
+    const TexelDescriptor &GetTexelDescriptor(const uint32_t index) const { return texels_[descriptor_refs_[index].index]; };
+    const BufferDescriptor &GetBufferDescriptor(const uint32_t index) const { return buffers_[descriptor_refs_[index].index]; };
+    bool IsImmutableSampler(const uint32_t) const;
+    bool IsStorage(const uint32_t) const;
     // Return true if any part of set has ever been updated
     bool IsUpdated() const { return some_update_; };
+    // Changes on every update of the set and is never shared by two sets, so draw-time validation results can be
+    // cached against it
+    uint64_t GetVersion() const { return version_; };
 
   private:
     bool VerifyWriteUpdateContents(const VkWriteDescriptorSet *, const uint32_t, std::string *) const;
@@ -355,11 +370,26 @@ class DescriptorSet : public BASE_NODE {
     bool ValidateBufferUpdate(VkBuffer, VkDescriptorType, std::string *) const;
     // Private helper to set all bound cmd buffers to INVALID state
     void InvalidateBoundCmdBuffers();
+    // Update the descriptor at a global index from update element di, or from a descriptor of the same class in src_set
+    void WriteDescriptor(const uint32_t, const VkWriteDescriptorSet *, const uint32_t);
+    void CopyDescriptor(const uint32_t, const DescriptorSet *, const uint32_t);
     bool some_update_; // has any part of the set ever been updated?
+    uint64_t version_;
+    static std::atomic<uint64_t> next_version_;
     VkDescriptorSet set_;
     const DescriptorSetLayout *p_layout_;
     std::unordered_set<GLOBAL_CB_NODE *> bound_cmd_buffers_;
-    std::vector<std::unique_ptr<Descriptor>> descriptors_;
+    // Class of each descriptor by global index, and its position in the array for that class
+    struct DescriptorRef {
+        DescriptorClass descriptor_class;
+        uint32_t index;
+    };
+    std::vector<DescriptorRef> descriptor_refs_;
+    std::vector<SamplerDescriptor> samplers_;
+    std::vector<ImageSamplerDescriptor> image_samplers_;
+    std::vector<ImageDescriptor> images_;
+    std::vector<TexelDescriptor> texels_;
+    std::vector<BufferDescriptor> buffers_;
     // Ptr to device data used for various data look-ups
     const core_validation::layer_data *device_data_;
 };
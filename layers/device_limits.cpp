@@ -72,7 +72,7 @@ struct layer_data {
           physicalDeviceState(nullptr), actualPhysicalDeviceFeatures(), requestedPhysicalDeviceFeatures(), physicalDevice(){};
 };
 
-static unordered_map<void *, layer_data *> layer_data_map;
+static dispatch_key_map<layer_data> layer_data_map;
 
 // TODO : This can be much smarter, using separate locks for separate global data
 static int globalLockInitialized = 0;
@@ -47,6 +47,7 @@
 #include "vk_layer_extension_utils.h"
 #include "vk_layer_utils.h"
 #include "vk_layer_logging.h"
+#include "vk_layer_profile.h"
 
 using namespace std;
 
@@ -69,11 +70,13 @@ struct layer_data {
           physicalDeviceProperties(){};
 };
 
-static unordered_map<void *, layer_data *> layer_data_map;
+static dispatch_key_map<layer_data> layer_data_map;
 static std::mutex global_lock;
+static layer_profiler profiler;
 
 static void init_image(layer_data *my_data, const VkAllocationCallbacks *pAllocator) {
     layer_debug_actions(my_data->report_data, my_data->logging_callback, pAllocator, "lunarg_image");
+    layer_profile_start(&profiler, "lunarg_image");
 }
 
 static IMAGE_STATE const *getImageState(layer_data const *dev_data, VkImage image) {
@@ -87,8 +90,10 @@ static IMAGE_STATE const *getImageState(layer_data const *dev_data, VkImage imag
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateDebugReportCallbackEXT(VkInstance instance, const VkDebugReportCallbackCreateInfoEXT *pCreateInfo,
                              const VkAllocationCallbacks *pAllocator, VkDebugReportCallbackEXT *pMsgCallback) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDebugReportCallbackEXT");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
-    VkResult res = my_data->instance_dispatch_table->CreateDebugReportCallbackEXT(instance, pCreateInfo, pAllocator, pMsgCallback);
+    VkResult res = LAYER_PROFILE_DISPATCH(
+        profiler, my_data->instance_dispatch_table->CreateDebugReportCallbackEXT(instance, pCreateInfo, pAllocator, pMsgCallback));
     if (res == VK_SUCCESS) {
         res = layer_create_msg_callback(my_data->report_data, false, pCreateInfo, pAllocator, pMsgCallback);
     }
@@ -98,21 +103,25 @@ CreateDebugReportCallbackEXT(VkInstance instance, const VkDebugReportCallbackCre
 VKAPI_ATTR void VKAPI_CALL DestroyDebugReportCallbackEXT(VkInstance instance,
                                                          VkDebugReportCallbackEXT msgCallback,
                                                          const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDebugReportCallbackEXT");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
-    my_data->instance_dispatch_table->DestroyDebugReportCallbackEXT(instance, msgCallback, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->DestroyDebugReportCallbackEXT(instance, msgCallback,
+                                                                                                     pAllocator));
     layer_destroy_msg_callback(my_data->report_data, msgCallback, pAllocator);
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DebugReportMessageEXT(VkInstance instance, VkDebugReportFlagsEXT flags, VkDebugReportObjectTypeEXT objType, uint64_t object,
                       size_t location, int32_t msgCode, const char *pLayerPrefix, const char *pMsg) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDebugReportMessageEXT");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
-    my_data->instance_dispatch_table->DebugReportMessageEXT(instance, flags, objType, object, location, msgCode, pLayerPrefix,
-                                                            pMsg);
+    LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->DebugReportMessageEXT(
+        instance, flags, objType, object, location, msgCode, pLayerPrefix, pMsg));
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkInstance *pInstance) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateInstance");
     VkLayerInstanceCreateInfo *chain_info = get_chain_info(pCreateInfo, VK_LAYER_LINK_INFO);
 
     assert(chain_info->u.pLayerInfo);
@@ -125,7 +134,7 @@ CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallba
     // Advance the link info for the next element on the chain
     chain_info->u.pLayerInfo = chain_info->u.pLayerInfo->pNext;
 
-    VkResult result = fpCreateInstance(pCreateInfo, pAllocator, pInstance);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, fpCreateInstance(pCreateInfo, pAllocator, pInstance));
     if (result != VK_SUCCESS)
         return result;
 
@@ -143,11 +152,12 @@ CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallba
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyInstance");
     // Grab the key before the instance is destroyed.
     dispatch_key key = get_dispatch_key(instance);
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
     VkLayerInstanceDispatchTable *pTable = my_data->instance_dispatch_table;
-    pTable->DestroyInstance(instance, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, pTable->DestroyInstance(instance, pAllocator));
 
     // Clean up logging callback, if any
     while (my_data->logging_callback.size() > 0) {
@@ -157,6 +167,7 @@ VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocati
     }
 
     layer_debug_report_destroy_instance(my_data->report_data);
+    layer_profile_stop(&profiler);
     delete my_data->instance_dispatch_table;
     layer_data_map.erase(key);
 }
@@ -164,6 +175,7 @@ VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocati
 VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice physicalDevice,
                                             const VkDeviceCreateInfo *pCreateInfo,
                                             const VkAllocationCallbacks *pAllocator, VkDevice *pDevice) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDevice");
     layer_data *my_instance_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
     VkLayerDeviceCreateInfo *chain_info = get_chain_info(pCreateInfo, VK_LAYER_LINK_INFO);
 
@@ -178,7 +190,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice physicalDevice,
     // Advance the link info for the next element on the chain
     chain_info->u.pLayerInfo = chain_info->u.pLayerInfo->pNext;
 
-    VkResult result = fpCreateDevice(physicalDevice, pCreateInfo, pAllocator, pDevice);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, fpCreateDevice(physicalDevice, pCreateInfo, pAllocator, pDevice));
     if (result != VK_SUCCESS) {
         return result;
     }
@@ -192,16 +204,17 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice physicalDevice,
     my_device_data->report_data = layer_debug_report_create_device(my_instance_data->report_data, *pDevice);
     my_device_data->physicalDevice = physicalDevice;
 
-    my_instance_data->instance_dispatch_table->GetPhysicalDeviceProperties(physicalDevice,
-                                                                           &(my_device_data->physicalDeviceProperties));
+    LAYER_PROFILE_DISPATCH(profiler, my_instance_data->instance_dispatch_table->GetPhysicalDeviceProperties(
+        physicalDevice, &(my_device_data->physicalDeviceProperties)));
 
     return result;
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyDevice(VkDevice device, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDevice");
     dispatch_key key = get_dispatch_key(device);
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
-    my_data->device_dispatch_table->DestroyDevice(device, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->DestroyDevice(device, pAllocator));
     delete my_data->device_dispatch_table;
     layer_data_map.erase(key);
 }
@@ -220,6 +233,7 @@ static inline uint32_t validate_VkImageLayoutKHR(VkImageLayout input_value) {
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateImage(VkDevice device, const VkImageCreateInfo *pCreateInfo,
                                            const VkAllocationCallbacks *pAllocator, VkImage *pImage) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateImage");
     bool skip_call = false;
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     VkImageFormatProperties ImageFormatProperties;
@@ -230,8 +244,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateImage(VkDevice device, const VkImageCreateI
 
     if (pCreateInfo->format != VK_FORMAT_UNDEFINED) {
         VkFormatProperties properties;
-        phy_dev_data->instance_dispatch_table->GetPhysicalDeviceFormatProperties(device_data->physicalDevice, pCreateInfo->format,
-                                                                                 &properties);
+        LAYER_PROFILE_DISPATCH(profiler, phy_dev_data->instance_dispatch_table->GetPhysicalDeviceFormatProperties(
+            device_data->physicalDevice, pCreateInfo->format, &properties));
         if ((properties.linearTilingFeatures) == 0 && (properties.optimalTilingFeatures == 0)) {
             std::stringstream ss;
             ss << "vkCreateImage format parameter (" << string_VkFormat(pCreateInfo->format) << ") is an unsupported format";
@@ -289,9 +303,9 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateImage(VkDevice device, const VkImageCreateI
     }
 
     // Internal call to get format info.  Still goes through layers, could potentially go directly to ICD.
-    phy_dev_data->instance_dispatch_table->GetPhysicalDeviceImageFormatProperties(
+    LAYER_PROFILE_DISPATCH(profiler, phy_dev_data->instance_dispatch_table->GetPhysicalDeviceImageFormatProperties(
         physicalDevice, pCreateInfo->format, pCreateInfo->imageType, pCreateInfo->tiling, pCreateInfo->usage, pCreateInfo->flags,
-        &ImageFormatProperties);
+        &ImageFormatProperties));
 
     VkDeviceSize imageGranularity = device_data->physicalDeviceProperties.limits.bufferImageGranularity;
     imageGranularity = imageGranularity == 1 ? 0 : imageGranularity;
@@ -381,7 +395,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateImage(VkDevice device, const VkImageCreateI
     }
 
     if (!skip_call) {
-        result = device_data->device_dispatch_table->CreateImage(device, pCreateInfo, pAllocator, pImage);
+        result = LAYER_PROFILE_DISPATCH(profiler, device_data->device_dispatch_table->CreateImage(device, pCreateInfo, pAllocator,
+                                                                                                  pImage));
     }
     if (result == VK_SUCCESS) {
         std::lock_guard<std::mutex> lock(global_lock);
@@ -391,16 +406,18 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateImage(VkDevice device, const VkImageCreateI
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyImage");
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     std::unique_lock<std::mutex> lock(global_lock);
     device_data->imageMap.erase(image);
     lock.unlock();
-    device_data->device_dispatch_table->DestroyImage(device, image, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, device_data->device_dispatch_table->DestroyImage(device, image, pAllocator));
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass(VkDevice device, const VkRenderPassCreateInfo *pCreateInfo,
                                                 const VkAllocationCallbacks *pAllocator,
                                                 VkRenderPass *pRenderPass) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateRenderPass");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     bool skipCall = false;
 
@@ -457,13 +474,15 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass(VkDevice device, const VkRenderP
     if (skipCall)
         return VK_ERROR_VALIDATION_FAILED_EXT;
 
-    VkResult result = my_data->device_dispatch_table->CreateRenderPass(device, pCreateInfo, pAllocator, pRenderPass);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->CreateRenderPass(device, pCreateInfo,
+                                                                                                        pAllocator, pRenderPass));
 
     return result;
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateImageView(VkDevice device, const VkImageViewCreateInfo *pCreateInfo,
                                                const VkAllocationCallbacks *pAllocator, VkImageView *pView) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateImageView");
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     auto imageEntry = getImageState(device_data, pCreateInfo->image);
@@ -605,13 +624,15 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateImageView(VkDevice device, const VkImageVie
         return VK_ERROR_VALIDATION_FAILED_EXT;
     }
 
-    VkResult result = device_data->device_dispatch_table->CreateImageView(device, pCreateInfo, pAllocator, pView);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, device_data->device_dispatch_table->CreateImageView(device, pCreateInfo,
+                                                                                                           pAllocator, pView));
     return result;
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdClearColorImage(VkCommandBuffer commandBuffer, VkImage image,
                                               VkImageLayout imageLayout, const VkClearColorValue *pColor,
                                               uint32_t rangeCount, const VkImageSubresourceRange *pRanges) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdClearColorImage");
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
 
@@ -647,7 +668,8 @@ VKAPI_ATTR void VKAPI_CALL CmdClearColorImage(VkCommandBuffer commandBuffer, VkI
     }
 
     if (!skipCall) {
-        device_data->device_dispatch_table->CmdClearColorImage(commandBuffer, image, imageLayout, pColor, rangeCount, pRanges);
+        LAYER_PROFILE_DISPATCH(profiler, device_data->device_dispatch_table->CmdClearColorImage(commandBuffer, image, imageLayout,
+                                                                                                pColor, rangeCount, pRanges));
     }
 }
 
@@ -655,6 +677,7 @@ VKAPI_ATTR void VKAPI_CALL
 CmdClearDepthStencilImage(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout imageLayout,
                           const VkClearDepthStencilValue *pDepthStencil, uint32_t rangeCount,
                           const VkImageSubresourceRange *pRanges) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdClearDepthStencilImage");
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     // For each range, Image aspect must be depth or stencil or both
@@ -677,8 +700,8 @@ CmdClearDepthStencilImage(VkCommandBuffer commandBuffer, VkImage image, VkImageL
     }
 
     if (!skipCall) {
-        device_data->device_dispatch_table->CmdClearDepthStencilImage(commandBuffer, image, imageLayout, pDepthStencil, rangeCount,
-                                                                      pRanges);
+        LAYER_PROFILE_DISPATCH(profiler, device_data->device_dispatch_table->CmdClearDepthStencilImage(
+            commandBuffer, image, imageLayout, pDepthStencil, rangeCount, pRanges));
     }
 }
 
@@ -909,6 +932,7 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyImage(VkCommandBuffer commandBuffer, VkImage s
                                         VkImageLayout srcImageLayout, VkImage dstImage,
                                         VkImageLayout dstImageLayout, uint32_t regionCount,
                                         const VkImageCopy *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdCopyImage");
 
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
@@ -916,14 +940,15 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyImage(VkCommandBuffer commandBuffer, VkImage s
     skipCall = cmd_copy_image_valid_usage(commandBuffer, srcImage, dstImage, regionCount, pRegions);
 
     if (!skipCall) {
-        device_data->device_dispatch_table->CmdCopyImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout,
-                                                         regionCount, pRegions);
+        LAYER_PROFILE_DISPATCH(profiler, device_data->device_dispatch_table->CmdCopyImage(
+            commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdClearAttachments(VkCommandBuffer commandBuffer, uint32_t attachmentCount,
                                                const VkClearAttachment *pAttachments, uint32_t rectCount,
                                                const VkClearRect *pRects) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdClearAttachments");
     bool skipCall = false;
     VkImageAspectFlags aspectMask;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
@@ -952,13 +977,15 @@ VKAPI_ATTR void VKAPI_CALL CmdClearAttachments(VkCommandBuffer commandBuffer, ui
     }
 
     if (!skipCall) {
-        device_data->device_dispatch_table->CmdClearAttachments(commandBuffer, attachmentCount, pAttachments, rectCount, pRects);
+        LAYER_PROFILE_DISPATCH(profiler, device_data->device_dispatch_table->CmdClearAttachments(commandBuffer, attachmentCount,
+                                                                                                 pAttachments, rectCount, pRects));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdCopyImageToBuffer(VkCommandBuffer commandBuffer, VkImage srcImage,
                                                 VkImageLayout srcImageLayout, VkBuffer dstBuffer,
                                                 uint32_t regionCount, const VkBufferImageCopy *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdCopyImageToBuffer");
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     // For each region, the number of layers in the image subresource should not be zero
@@ -983,14 +1010,15 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyImageToBuffer(VkCommandBuffer commandBuffer, V
     }
 
     if (!skipCall) {
-        device_data->device_dispatch_table->CmdCopyImageToBuffer(commandBuffer, srcImage, srcImageLayout, dstBuffer, regionCount,
-                                                                 pRegions);
+        LAYER_PROFILE_DISPATCH(profiler, device_data->device_dispatch_table->CmdCopyImageToBuffer(
+            commandBuffer, srcImage, srcImageLayout, dstBuffer, regionCount, pRegions));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer srcBuffer,
                                                 VkImage dstImage, VkImageLayout dstImageLayout,
                                                 uint32_t regionCount, const VkBufferImageCopy *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdCopyBufferToImage");
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     // For each region, the number of layers in the image subresource should not be zero
@@ -1015,14 +1043,15 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImage(VkCommandBuffer commandBuffer, V
     }
 
     if (!skipCall) {
-        device_data->device_dispatch_table->CmdCopyBufferToImage(commandBuffer, srcBuffer, dstImage, dstImageLayout, regionCount,
-                                                                 pRegions);
+        LAYER_PROFILE_DISPATCH(profiler, device_data->device_dispatch_table->CmdCopyBufferToImage(
+            commandBuffer, srcBuffer, dstImage, dstImageLayout, regionCount, pRegions));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdBlitImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage,
              VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageBlit *pRegions, VkFilter filter) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBlitImage");
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
 
@@ -1139,8 +1168,8 @@ CmdBlitImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcI
     }
 
     if (!skipCall) {
-        device_data->device_dispatch_table->CmdBlitImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount,
-                                                         pRegions, filter);
+        LAYER_PROFILE_DISPATCH(profiler, device_data->device_dispatch_table->CmdBlitImage(
+            commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions, filter));
     }
 }
 
@@ -1149,6 +1178,7 @@ CmdPipelineBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStageM
                    VkDependencyFlags dependencyFlags, uint32_t memoryBarrierCount, const VkMemoryBarrier *pMemoryBarriers,
                    uint32_t bufferMemoryBarrierCount, const VkBufferMemoryBarrier *pBufferMemoryBarriers,
                    uint32_t imageMemoryBarrierCount, const VkImageMemoryBarrier *pImageMemoryBarriers) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdPipelineBarrier");
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
 
@@ -1168,14 +1198,15 @@ CmdPipelineBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStageM
         return;
     }
 
-    device_data->device_dispatch_table->CmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, dependencyFlags,
-                                                           memoryBarrierCount, pMemoryBarriers, bufferMemoryBarrierCount,
-                                                           pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers);
+    LAYER_PROFILE_DISPATCH(profiler, device_data->device_dispatch_table->CmdPipelineBarrier(
+        commandBuffer, srcStageMask, dstStageMask, dependencyFlags, memoryBarrierCount, pMemoryBarriers, bufferMemoryBarrierCount,
+        pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdResolveImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage,
                 VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageResolve *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdResolveImage");
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     auto srcImageEntry = getImageState(device_data, srcImage);
@@ -1239,13 +1270,14 @@ CmdResolveImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout s
     }
 
     if (!skipCall) {
-        device_data->device_dispatch_table->CmdResolveImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout,
-                                                            regionCount, pRegions);
+        LAYER_PROFILE_DISPATCH(profiler, device_data->device_dispatch_table->CmdResolveImage(
+            commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 GetImageSubresourceLayout(VkDevice device, VkImage image, const VkImageSubresource *pSubresource, VkSubresourceLayout *pLayout) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetImageSubresourceLayout");
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     VkFormat format;
@@ -1276,28 +1308,34 @@ GetImageSubresourceLayout(VkDevice device, VkImage image, const VkImageSubresour
     }
 
     if (!skipCall) {
-        device_data->device_dispatch_table->GetImageSubresourceLayout(device, image, pSubresource, pLayout);
+        LAYER_PROFILE_DISPATCH(profiler, device_data->device_dispatch_table->GetImageSubresourceLayout(device, image, pSubresource,
+                                                                                                       pLayout));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 GetPhysicalDeviceProperties(VkPhysicalDevice physicalDevice, VkPhysicalDeviceProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceProperties");
     layer_data *phy_dev_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
-    phy_dev_data->instance_dispatch_table->GetPhysicalDeviceProperties(physicalDevice, pProperties);
+    LAYER_PROFILE_DISPATCH(profiler, phy_dev_data->instance_dispatch_table->GetPhysicalDeviceProperties(physicalDevice,
+                                                                                                        pProperties));
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateInstanceLayerProperties(uint32_t *pCount, VkLayerProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateInstanceLayerProperties");
     return util_GetLayerProperties(1, &global_layer, pCount, pProperties);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateDeviceLayerProperties(VkPhysicalDevice physicalDevice, uint32_t *pCount, VkLayerProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateDeviceLayerProperties");
     return util_GetLayerProperties(1, &global_layer, pCount, pProperties);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateInstanceExtensionProperties(const char *pLayerName, uint32_t *pCount, VkExtensionProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateInstanceExtensionProperties");
     if (pLayerName && !strcmp(pLayerName, global_layer.layerName))
         return util_GetExtensionProperties(1, instance_extensions, pCount, pProperties);
 
@@ -1307,6 +1345,7 @@ EnumerateInstanceExtensionProperties(const char *pLayerName, uint32_t *pCount, V
 VKAPI_ATTR VkResult VKAPI_CALL EnumerateDeviceExtensionProperties(VkPhysicalDevice physicalDevice,
                                                                   const char *pLayerName, uint32_t *pCount,
                                                                   VkExtensionProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateDeviceExtensionProperties");
     // Image does not have any physical device extensions
     if (pLayerName && !strcmp(pLayerName, global_layer.layerName))
         return util_GetExtensionProperties(0, NULL, pCount, pProperties);
@@ -1316,7 +1355,7 @@ VKAPI_ATTR VkResult VKAPI_CALL EnumerateDeviceExtensionProperties(VkPhysicalDevi
     dispatch_key key = get_dispatch_key(physicalDevice);
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
     VkLayerInstanceDispatchTable *pTable = my_data->instance_dispatch_table;
-    return pTable->EnumerateDeviceExtensionProperties(physicalDevice, NULL, pCount, pProperties);
+    return LAYER_PROFILE_DISPATCH(profiler, pTable->EnumerateDeviceExtensionProperties(physicalDevice, NULL, pCount, pProperties));
 }
 
 static PFN_vkVoidFunction
@@ -1325,6 +1364,7 @@ static PFN_vkVoidFunction
 intercept_core_device_command(const char *name);
 
 VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice device, const char *funcName) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetDeviceProcAddr");
     PFN_vkVoidFunction proc = intercept_core_device_command(funcName);
     if (proc)
         return proc;
@@ -1337,11 +1377,12 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice device, cons
     {
         if (pTable->GetDeviceProcAddr == NULL)
             return NULL;
-        return pTable->GetDeviceProcAddr(device, funcName);
+        return LAYER_PROFILE_DISPATCH(profiler, pTable->GetDeviceProcAddr(device, funcName));
     }
 }
 
 VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance, const char *funcName) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetInstanceProcAddr");
     PFN_vkVoidFunction proc = intercept_core_instance_command(funcName);
     if (!proc)
         proc = intercept_core_device_command(funcName);
@@ -1358,7 +1399,7 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance
     VkLayerInstanceDispatchTable *pTable = my_data->instance_dispatch_table;
     if (pTable->GetInstanceProcAddr == NULL)
         return NULL;
-    return pTable->GetInstanceProcAddr(instance, funcName);
+    return LAYER_PROFILE_DISPATCH(profiler, pTable->GetInstanceProcAddr(instance, funcName));
 }
 
 static PFN_vkVoidFunction
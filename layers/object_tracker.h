@@ -20,13 +20,16 @@
  * Author: Tobin Ehlis <tobin@lunarg.com>
  */
 
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include "vulkan/vk_layer.h"
 #include "vk_layer_extension_utils.h"
 #include "vk_enum_string_helper.h"
 #include "vk_layer_table.h"
 #include "vk_layer_utils.h"
+#include "vk_layer_profile.h"
 
 namespace object_tracker {
 
@@ -60,6 +63,201 @@ struct OBJTRACK_NODE {
     ObjectStatusFlags status;           // Object state
     uint64_t parentObj;                 // Parent object
     uint64_t belongsTo;                 // Object Scope -- owning device/instance
+    OBJTRACK_NODE *firstChild;          // Pools -- objects allocated from the pool
+    OBJTRACK_NODE *prevSibling;         // Pool allocated objects -- neighbours in the pool's list of children
+    OBJTRACK_NODE *nextSibling;
+};
+
+// Table of the nodes of one object type, keyed by handle. Nodes are allocated from blocks owned by the table and
+// recycled when their entry is erased, so that creating and destroying objects does not go to the heap each time.
+// The table is open addressed with linear probing; erased entries leave a marker so that erasing never moves other
+// entries, which keeps iterators to them valid as with std::unordered_map.
+//
+// Every call except iteration takes the table's own lock, so that checking handles only contends with changes to the
+// same object type. Code that inserts or erases entries must also hold global_lock, which allows code holding
+// global_lock to iterate the table and use the nodes it finds without taking the table's lock.
+class object_node_map {
+  public:
+    struct value_type {
+        uint64_t first;
+        OBJTRACK_NODE *second;
+    };
+
+    class iterator {
+      public:
+        iterator() : map_(nullptr), index_(0) {}
+        iterator(object_node_map *map, size_t index) : map_(map), index_(index) { skip_unused(); }
+        value_type &operator*() const { return map_->slots_[index_]; }
+        value_type *operator->() const { return &map_->slots_[index_]; }
+        iterator &operator++() {
+            ++index_;
+            skip_unused();
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator prev = *this;
+            ++*this;
+            return prev;
+        }
+        bool operator==(const iterator &other) const { return index_ == other.index_; }
+        bool operator!=(const iterator &other) const { return index_ != other.index_; }
+
+      private:
+        friend class object_node_map;
+        void skip_unused() {
+            while (index_ < map_->slots_.size() && !live(map_->slots_[index_]))
+                ++index_;
+        }
+        object_node_map *map_;
+        size_t index_;
+    };
+
+    object_node_map() : slots_(initial_capacity), used_(0), size_(0) {}
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, slots_.size()); }
+
+    iterator find(uint64_t handle) {
+        std::lock_guard<std::mutex> lock(lock_);
+        size_t index = find_index(handle);
+        return index == npos ? end() : iterator(this, index);
+    }
+
+    bool contains(uint64_t handle) const {
+        std::lock_guard<std::mutex> lock(lock_);
+        return find_index(handle) != npos;
+    }
+
+    // Return the node for handle, or nullptr if there is none
+    OBJTRACK_NODE *get(uint64_t handle) const {
+        std::lock_guard<std::mutex> lock(lock_);
+        size_t index = find_index(handle);
+        return index == npos ? nullptr : slots_[index].second;
+    }
+
+    // Return a zero initialized node for handle, reusing the existing node if handle is already present
+    OBJTRACK_NODE *insert(uint64_t handle) {
+        std::lock_guard<std::mutex> lock(lock_);
+        size_t index = find_index(handle);
+        if (index != npos) {
+            *slots_[index].second = OBJTRACK_NODE();
+            return slots_[index].second;
+        }
+        // Keep the load factor (including erased entries) at or below one half
+        if (2 * (used_ + 1) > slots_.size()) {
+            // Erased entries are dropped by the rebuild, so only grow if live entries take up more than a quarter
+            size_t capacity = slots_.size();
+            if (4 * (size_ + 1) > capacity)
+                capacity *= 2;
+            rebuild(capacity);
+        }
+        OBJTRACK_NODE *node = allocate_node();
+        claim_slot(handle, node);
+        ++used_;
+        ++size_;
+        return node;
+    }
+
+    // Remove the entry at it and recycle its node. Returns an iterator to the next entry.
+    iterator erase(iterator it) {
+        std::lock_guard<std::mutex> lock(lock_);
+        value_type &slot = slots_[it.index_];
+        free_nodes_.push_back(slot.second);
+        slot.second = erased();
+        --size_;
+        return ++it;
+    }
+
+    size_t erase(uint64_t handle) {
+        iterator it = find(handle);
+        if (it == end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+  private:
+    object_node_map(const object_node_map &) = delete;
+    object_node_map &operator=(const object_node_map &) = delete;
+
+    static const size_t initial_capacity = 64;
+    static const size_t node_block_size = 256;
+    static const size_t npos = ~size_t(0);
+
+    // Marks an erased entry. Empty entries have a null node.
+    static OBJTRACK_NODE *erased() {
+        static OBJTRACK_NODE erased_node;
+        return &erased_node;
+    }
+    static bool live(const value_type &slot) { return slot.second && slot.second != erased(); }
+
+    static size_t hash(uint64_t handle) {
+        // Handles are pointers or driver chosen values, either of which may leave the low bits unused
+        handle ^= handle >> 33;
+        handle *= 0xff51afd7ed558ccdULL;
+        handle ^= handle >> 33;
+        return static_cast<size_t>(handle);
+    }
+
+    // Caller must hold lock_
+    size_t find_index(uint64_t handle) const {
+        size_t mask = slots_.size() - 1;
+        for (size_t i = hash(handle) & mask, probes = 0; probes <= mask; i = (i + 1) & mask, ++probes) {
+            const value_type &slot = slots_[i];
+            if (!slot.second)
+                break;
+            if (slot.first == handle && slot.second != erased())
+                return i;
+        }
+        return npos;
+    }
+
+    // Caller must hold lock_
+    void claim_slot(uint64_t handle, OBJTRACK_NODE *node) {
+        size_t mask = slots_.size() - 1;
+        size_t i = hash(handle) & mask;
+        while (slots_[i].second)
+            i = (i + 1) & mask;
+        slots_[i].first = handle;
+        slots_[i].second = node;
+    }
+
+    // Caller must hold lock_
+    void rebuild(size_t capacity) {
+        std::vector<value_type> old_slots(capacity);
+        old_slots.swap(slots_);
+        used_ = 0;
+        for (auto const &slot : old_slots) {
+            if (live(slot)) {
+                claim_slot(slot.first, slot.second);
+                ++used_;
+            }
+        }
+    }
+
+    // Caller must hold lock_
+    OBJTRACK_NODE *allocate_node() {
+        if (free_nodes_.empty()) {
+            node_blocks_.emplace_back(new OBJTRACK_NODE[node_block_size]);
+            OBJTRACK_NODE *block = node_blocks_.back().get();
+            for (size_t i = node_block_size; i > 0; --i)
+                free_nodes_.push_back(&block[i - 1]);
+        }
+        OBJTRACK_NODE *node = free_nodes_.back();
+        free_nodes_.pop_back();
+        *node = OBJTRACK_NODE();
+        return node;
+    }
+
+    mutable std::mutex lock_;
+    std::vector<value_type> slots_;
+    size_t used_; // Live and erased entries
+    size_t size_;
+    std::vector<std::unique_ptr<OBJTRACK_NODE[]>> node_blocks_;
+    std::vector<OBJTRACK_NODE *> free_nodes_;
 };
 
 // prototype for extension functions
@@ -94,16 +292,17 @@ struct instExts {
 };
 
 static std::unordered_map<void *, struct instExts> instanceExtMap;
-static std::unordered_map<void *, layer_data *> layer_data_map;
+static dispatch_key_map<layer_data> layer_data_map;
 static device_table_map object_tracker_device_table_map;
 static instance_table_map object_tracker_instance_table_map;
 
 // We need additionally validate image usage using a separate map
 // of swapchain-created images
-static std::unordered_map<uint64_t, OBJTRACK_NODE *> swapchainImageMap;
+static object_node_map swapchainImageMap;
 
 static long long unsigned int object_track_index = 0;
 static std::mutex global_lock;
+static layer_profiler profiler;
 
 #define NUM_OBJECT_TYPES (VK_DEBUG_REPORT_OBJECT_TYPE_DEBUG_REPORT_EXT + 1)
 
@@ -226,6 +425,7 @@ std::unordered_map<VkQueue, OT_QUEUE_INFO *> queue_info_map;
 static void init_object_tracker(layer_data *my_data, const VkAllocationCallbacks *pAllocator) {
 
     layer_debug_actions(my_data->report_data, my_data->logging_callback, pAllocator, "lunarg_object_tracker");
+    layer_profile_start(&profiler, "lunarg_object_tracker");
 }
 
 //
@@ -263,7 +463,6 @@ static bool validate_pipeline(VkDevice dispatchable_object, VkPipeline object, V
                                   bool null_allowed);
 static void destroy_command_pool(VkDevice dispatchable_object, VkCommandPool object);
 static void destroy_descriptor_pool(VkDevice dispatchable_object, VkDescriptorPool object);
-static void destroy_descriptor_set(VkDevice dispatchable_object, VkDescriptorSet object);
 static void destroy_device_memory(VkDevice dispatchable_object, VkDeviceMemory object);
 static void destroy_swapchain_khr(VkDevice dispatchable_object, VkSwapchainKHR object);
 static bool set_device_memory_status(VkDevice dispatchable_object, VkDeviceMemory object, VkDebugReportObjectTypeEXT objType,
@@ -272,19 +471,20 @@ static bool reset_device_memory_status(VkDevice dispatchable_object, VkDeviceMem
                                            ObjectStatusFlags status_flag);
 static void destroy_queue(VkQueue dispatchable_object, VkQueue object);
 
-extern std::unordered_map<uint64_t, OBJTRACK_NODE *> VkPhysicalDeviceMap;
-extern std::unordered_map<uint64_t, OBJTRACK_NODE *> VkDeviceMap;
-extern std::unordered_map<uint64_t, OBJTRACK_NODE *> VkImageMap;
-extern std::unordered_map<uint64_t, OBJTRACK_NODE *> VkQueueMap;
-extern std::unordered_map<uint64_t, OBJTRACK_NODE *> VkDescriptorSetMap;
-extern std::unordered_map<uint64_t, OBJTRACK_NODE *> VkBufferMap;
-extern std::unordered_map<uint64_t, OBJTRACK_NODE *> VkFenceMap;
-extern std::unordered_map<uint64_t, OBJTRACK_NODE *> VkSemaphoreMap;
-extern std::unordered_map<uint64_t, OBJTRACK_NODE *> VkCommandPoolMap;
-extern std::unordered_map<uint64_t, OBJTRACK_NODE *> VkCommandBufferMap;
-extern std::unordered_map<uint64_t, OBJTRACK_NODE *> VkSwapchainKHRMap;
-extern std::unordered_map<uint64_t, OBJTRACK_NODE *> VkSurfaceKHRMap;
-extern std::unordered_map<uint64_t, OBJTRACK_NODE *> VkQueueMap;
+extern object_node_map VkPhysicalDeviceMap;
+extern object_node_map VkDeviceMap;
+extern object_node_map VkImageMap;
+extern object_node_map VkQueueMap;
+extern object_node_map VkDescriptorSetMap;
+extern object_node_map VkBufferMap;
+extern object_node_map VkFenceMap;
+extern object_node_map VkSemaphoreMap;
+extern object_node_map VkCommandPoolMap;
+extern object_node_map VkDescriptorPoolMap;
+extern object_node_map VkCommandBufferMap;
+extern object_node_map VkSwapchainKHRMap;
+extern object_node_map VkSurfaceKHRMap;
+extern object_node_map VkQueueMap;
 
 // Convert an object type enum to an object type array index
 static uint32_t objTypeToIndex(uint32_t objType) {
@@ -336,7 +536,6 @@ static void destroyQueueMemRefLists() {
                 "OBJ_STAT Destroy %s obj 0x%" PRIxLEAST64 " (%" PRIu64 " total objs remain & %" PRIu64 " %s objs).",
                 string_VkDebugReportObjectTypeEXT(queue->second->objType), queue->second->vkObj, numTotalObjs, numObjs[obj_index],
                 string_VkDebugReportObjectTypeEXT(queue->second->objType));
-        delete queue->second;
         queue = VkQueueMap.erase(queue);
     }
 }
@@ -365,12 +564,11 @@ static void create_physical_device(VkInstance instance, VkPhysicalDevice vkObj,
     uint64_t physical_device_handle = reinterpret_cast<uint64_t>(vkObj);
     auto pd_item = VkPhysicalDeviceMap.find(physical_device_handle);
     if (pd_item == VkPhysicalDeviceMap.end()) {
-        OBJTRACK_NODE *p_new_obj_node = new OBJTRACK_NODE;
+        OBJTRACK_NODE *p_new_obj_node = VkPhysicalDeviceMap.insert(physical_device_handle);
         p_new_obj_node->objType = objType;
         p_new_obj_node->belongsTo = reinterpret_cast<uint64_t>(instance);
         p_new_obj_node->status = OBJSTATUS_NONE;
         p_new_obj_node->vkObj = physical_device_handle;
-        VkPhysicalDeviceMap[physical_device_handle] = p_new_obj_node;
         uint32_t objIndex = objTypeToIndex(objType);
         numObjs[objIndex]++;
         numTotalObjs++;
@@ -383,12 +581,11 @@ static void create_surface_khr(VkInstance dispatchable_object, VkSurfaceKHR vkOb
             "OBJTRACK", "OBJ[%llu] : CREATE %s object 0x%" PRIxLEAST64, object_track_index++,
             string_VkDebugReportObjectTypeEXT(objType), (uint64_t)(vkObj));
 
-    OBJTRACK_NODE *pNewObjNode = new OBJTRACK_NODE;
+    OBJTRACK_NODE *pNewObjNode = VkSurfaceKHRMap.insert((uint64_t)vkObj);
     pNewObjNode->objType = objType;
     pNewObjNode->belongsTo = (uint64_t)dispatchable_object;
     pNewObjNode->status = OBJSTATUS_NONE;
     pNewObjNode->vkObj = (uint64_t)(vkObj);
-    VkSurfaceKHRMap[(uint64_t)vkObj] = pNewObjNode;
     uint32_t objIndex = objTypeToIndex(objType);
     numObjs[objIndex]++;
     numTotalObjs++;
@@ -396,8 +593,9 @@ static void create_surface_khr(VkInstance dispatchable_object, VkSurfaceKHR vkOb
 
 static void destroy_surface_khr(VkInstance dispatchable_object, VkSurfaceKHR object) {
     uint64_t object_handle = (uint64_t)(object);
-    if (VkSurfaceKHRMap.find(object_handle) != VkSurfaceKHRMap.end()) {
-        OBJTRACK_NODE *pNode = VkSurfaceKHRMap[(uint64_t)object];
+    auto surface_item = VkSurfaceKHRMap.find(object_handle);
+    if (surface_item != VkSurfaceKHRMap.end()) {
+        OBJTRACK_NODE *pNode = surface_item->second;
         uint32_t objIndex = objTypeToIndex(pNode->objType);
         assert(numTotalObjs > 0);
         numTotalObjs--;
@@ -408,8 +606,7 @@ static void destroy_surface_khr(VkInstance dispatchable_object, VkSurfaceKHR obj
                 "OBJ_STAT Destroy %s obj 0x%" PRIxLEAST64 " (0x%" PRIx64 " total objs remain & 0x%" PRIx64 " %s objs).",
                 string_VkDebugReportObjectTypeEXT(pNode->objType), (uint64_t)(object), numTotalObjs, numObjs[objIndex],
                 string_VkDebugReportObjectTypeEXT(pNode->objType));
-        delete pNode;
-        VkSurfaceKHRMap.erase(object_handle);
+        VkSurfaceKHRMap.erase(surface_item);
     } else {
         log_msg(mdd(dispatchable_object), VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT)0, object_handle, __LINE__,
                 OBJTRACK_NONE, "OBJTRACK",
@@ -417,13 +614,39 @@ static void destroy_surface_khr(VkInstance dispatchable_object, VkSurfaceKHR obj
     }
 }
 
+// Add child to the front of parent's list of children
+static void link_child(OBJTRACK_NODE *parent, OBJTRACK_NODE *child) {
+    child->prevSibling = nullptr;
+    child->nextSibling = parent->firstChild;
+    if (parent->firstChild)
+        parent->firstChild->prevSibling = child;
+    parent->firstChild = child;
+}
+
+// Remove child from its parent's list of children. parent is null if the parent is no longer tracked, in which case
+// child may still be linked to the other children it had.
+static void unlink_child(OBJTRACK_NODE *parent, OBJTRACK_NODE *child) {
+    if (child->prevSibling)
+        child->prevSibling->nextSibling = child->nextSibling;
+    else if (parent && parent->firstChild == child)
+        parent->firstChild = child->nextSibling;
+    if (child->nextSibling)
+        child->nextSibling->prevSibling = child->prevSibling;
+    child->prevSibling = nullptr;
+    child->nextSibling = nullptr;
+}
+
 static void alloc_command_buffer(VkDevice device, VkCommandPool commandPool, VkCommandBuffer vkObj,
                                  VkDebugReportObjectTypeEXT objType, VkCommandBufferLevel level) {
     log_msg(mdd(device), VK_DEBUG_REPORT_INFORMATION_BIT_EXT, objType, reinterpret_cast<uint64_t>(vkObj), __LINE__, OBJTRACK_NONE,
             "OBJTRACK", "OBJ[%llu] : CREATE %s object 0x%" PRIxLEAST64, object_track_index++,
             string_VkDebugReportObjectTypeEXT(objType), reinterpret_cast<uint64_t>(vkObj));
 
-    OBJTRACK_NODE *pNewObjNode = new OBJTRACK_NODE;
+    // A node already tracked for this handle was left behind by a pool that was never destroyed
+    OBJTRACK_NODE *pStaleNode = VkCommandBufferMap.get(reinterpret_cast<uint64_t>(vkObj));
+    if (pStaleNode)
+        unlink_child(VkCommandPoolMap.get(pStaleNode->parentObj), pStaleNode);
+    OBJTRACK_NODE *pNewObjNode = VkCommandBufferMap.insert(reinterpret_cast<uint64_t>(vkObj));
     pNewObjNode->objType = objType;
     pNewObjNode->belongsTo = (uint64_t)device;
     pNewObjNode->vkObj = reinterpret_cast<uint64_t>(vkObj);
@@ -433,7 +656,9 @@ static void alloc_command_buffer(VkDevice device, VkCommandPool commandPool, VkC
     } else {
         pNewObjNode->status = OBJSTATUS_NONE;
     }
-    VkCommandBufferMap[reinterpret_cast<uint64_t>(vkObj)] = pNewObjNode;
+    OBJTRACK_NODE *pPoolNode = VkCommandPoolMap.get((uint64_t)commandPool);
+    if (pPoolNode)
+        link_child(pPoolNode, pNewObjNode);
     uint32_t objIndex = objTypeToIndex(objType);
     numObjs[objIndex]++;
     numTotalObjs++;
@@ -442,8 +667,9 @@ static void alloc_command_buffer(VkDevice device, VkCommandPool commandPool, VkC
 static bool validate_command_buffer(VkDevice device, VkCommandPool commandPool, VkCommandBuffer commandBuffer) {
     bool skipCall = false;
     uint64_t object_handle = reinterpret_cast<uint64_t>(commandBuffer);
-    if (VkCommandBufferMap.find(object_handle) != VkCommandBufferMap.end()) {
-        OBJTRACK_NODE *pNode = VkCommandBufferMap[(uint64_t)commandBuffer];
+    auto cbItem = VkCommandBufferMap.find(object_handle);
+    if (cbItem != VkCommandBufferMap.end()) {
+        OBJTRACK_NODE *pNode = cbItem->second;
 
         if (pNode->parentObj != (uint64_t)(commandPool)) {
             skipCall |= log_msg(
@@ -475,7 +701,7 @@ static bool free_command_buffer(VkDevice device, VkCommandBuffer commandBuffer)
                             "OBJ_STAT Destroy %s obj 0x%" PRIxLEAST64 " (%" PRIu64 " total objs remain & %" PRIu64 " %s objs).",
                             string_VkDebugReportObjectTypeEXT(pNode->objType), reinterpret_cast<uint64_t>(commandBuffer),
                             numTotalObjs, numObjs[objIndex], string_VkDebugReportObjectTypeEXT(pNode->objType));
-        delete pNode;
+        unlink_child(VkCommandPoolMap.get(pNode->parentObj), pNode);
         VkCommandBufferMap.erase(cbItem);
     }
     return skipCall;
@@ -487,13 +713,19 @@ static void alloc_descriptor_set(VkDevice device, VkDescriptorPool descriptorPoo
             "OBJ[%llu] : CREATE %s object 0x%" PRIxLEAST64, object_track_index++, string_VkDebugReportObjectTypeEXT(objType),
             (uint64_t)(vkObj));
 
-    OBJTRACK_NODE *pNewObjNode = new OBJTRACK_NODE;
+    // A node already tracked for this handle was left behind by a pool that was never destroyed
+    OBJTRACK_NODE *pStaleNode = VkDescriptorSetMap.get((uint64_t)vkObj);
+    if (pStaleNode)
+        unlink_child(VkDescriptorPoolMap.get(pStaleNode->parentObj), pStaleNode);
+    OBJTRACK_NODE *pNewObjNode = VkDescriptorSetMap.insert((uint64_t)vkObj);
     pNewObjNode->objType = objType;
     pNewObjNode->belongsTo = (uint64_t)device;
     pNewObjNode->status = OBJSTATUS_NONE;
     pNewObjNode->vkObj = (uint64_t)(vkObj);
     pNewObjNode->parentObj = (uint64_t)descriptorPool;
-    VkDescriptorSetMap[(uint64_t)vkObj] = pNewObjNode;
+    OBJTRACK_NODE *pPoolNode = VkDescriptorPoolMap.get((uint64_t)descriptorPool);
+    if (pPoolNode)
+        link_child(pPoolNode, pNewObjNode);
     uint32_t objIndex = objTypeToIndex(objType);
     numObjs[objIndex]++;
     numTotalObjs++;
@@ -537,12 +769,23 @@ static bool free_descriptor_set(VkDevice device, VkDescriptorSet descriptorSet)
                             "OBJ_STAT Destroy %s obj 0x%" PRIxLEAST64 " (%" PRIu64 " total objs remain & %" PRIu64 " %s objs).",
                             string_VkDebugReportObjectTypeEXT(pNode->objType), reinterpret_cast<uint64_t &>(descriptorSet),
                             numTotalObjs, numObjs[objIndex], string_VkDebugReportObjectTypeEXT(pNode->objType));
-        delete pNode;
+        unlink_child(VkDescriptorPoolMap.get(pNode->parentObj), pNode);
         VkDescriptorSetMap.erase(dsItem);
     }
     return skipCall;
 }
 
+// Stop tracking the descriptor sets allocated from descriptorPool, which is being reset or destroyed
+static void free_pool_descriptor_sets(VkDevice device, VkDescriptorPool descriptorPool) {
+    OBJTRACK_NODE *pPoolNode = VkDescriptorPoolMap.get((uint64_t)descriptorPool);
+    OBJTRACK_NODE *pChild = pPoolNode ? pPoolNode->firstChild : nullptr;
+    while (pChild) {
+        OBJTRACK_NODE *pNext = pChild->nextSibling;
+        free_descriptor_set(device, (VkDescriptorSet)pChild->vkObj);
+        pChild = pNext;
+    }
+}
+
 static void create_queue(VkDevice device, VkQueue vkObj, VkDebugReportObjectTypeEXT objType) {
 
     log_msg(mdd(device), VK_DEBUG_REPORT_INFORMATION_BIT_EXT, objType, reinterpret_cast<uint64_t>(vkObj), __LINE__,
@@ -552,8 +795,7 @@ static void create_queue(VkDevice device, VkQueue vkObj, VkDebugReportObjectType
     OBJTRACK_NODE *p_obj_node = NULL;
     auto queue_item = VkQueueMap.find(reinterpret_cast<uint64_t>(vkObj));
     if (queue_item == VkQueueMap.end()) {
-        p_obj_node = new OBJTRACK_NODE;
-        VkQueueMap[reinterpret_cast<uint64_t>(vkObj)] = p_obj_node;
+        p_obj_node = VkQueueMap.insert(reinterpret_cast<uint64_t>(vkObj));
         uint32_t objIndex = objTypeToIndex(objType);
         numObjs[objIndex]++;
         numTotalObjs++;
@@ -571,13 +813,12 @@ static void create_swapchain_image_obj(VkDevice dispatchable_object, VkImage vkO
             __LINE__, OBJTRACK_NONE, "OBJTRACK", "OBJ[%llu] : CREATE %s object 0x%" PRIxLEAST64, object_track_index++,
             "SwapchainImage", (uint64_t)(vkObj));
 
-    OBJTRACK_NODE *pNewObjNode = new OBJTRACK_NODE;
+    OBJTRACK_NODE *pNewObjNode = swapchainImageMap.insert((uint64_t)(vkObj));
     pNewObjNode->belongsTo = (uint64_t)dispatchable_object;
     pNewObjNode->objType = VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT;
     pNewObjNode->status = OBJSTATUS_NONE;
     pNewObjNode->vkObj = (uint64_t)vkObj;
     pNewObjNode->parentObj = (uint64_t)swapchain;
-    swapchainImageMap[(uint64_t)(vkObj)] = pNewObjNode;
 }
 
 static void create_device(VkInstance dispatchable_object, VkDevice vkObj, VkDebugReportObjectTypeEXT objType) {
@@ -585,12 +826,11 @@ static void create_device(VkInstance dispatchable_object, VkDevice vkObj, VkDebu
             "OBJTRACK", "OBJ[%llu] : CREATE %s object 0x%" PRIxLEAST64, object_track_index++,
             string_VkDebugReportObjectTypeEXT(objType), (uint64_t)(vkObj));
 
-    OBJTRACK_NODE *pNewObjNode = new OBJTRACK_NODE;
+    OBJTRACK_NODE *pNewObjNode = VkDeviceMap.insert((uint64_t)vkObj);
     pNewObjNode->belongsTo = (uint64_t)dispatchable_object;
     pNewObjNode->objType = objType;
     pNewObjNode->status = OBJSTATUS_NONE;
     pNewObjNode->vkObj = (uint64_t)(vkObj);
-    VkDeviceMap[(uint64_t)vkObj] = pNewObjNode;
     uint32_t objIndex = objTypeToIndex(objType);
     numObjs[objIndex]++;
     numTotalObjs++;
@@ -613,7 +853,7 @@ VkResult explicit_CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const
     // Advance the link info for the next element on the chain
     chain_info->u.pLayerInfo = chain_info->u.pLayerInfo->pNext;
 
-    VkResult result = fpCreateInstance(pCreateInfo, pAllocator, pInstance);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, fpCreateInstance(pCreateInfo, pAllocator, pInstance));
     if (result != VK_SUCCESS) {
         return result;
     }
@@ -634,13 +874,15 @@ VkResult explicit_CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const
     init_object_tracker(my_data, pAllocator);
     createInstanceRegisterExtensions(pCreateInfo, *pInstance);
 
+    std::lock_guard<std::mutex> lock(global_lock);
     create_instance(*pInstance, *pInstance, VK_DEBUG_REPORT_OBJECT_TYPE_INSTANCE_EXT);
 
     return result;
 }
 
 void explicit_GetPhysicalDeviceQueueFamilyProperties(VkPhysicalDevice gpu, uint32_t *pCount, VkQueueFamilyProperties *pProperties) {
-    get_dispatch_table(object_tracker_instance_table_map, gpu)->GetPhysicalDeviceQueueFamilyProperties(gpu, pCount, pProperties);
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_instance_table_map,
+                                                        gpu)->GetPhysicalDeviceQueueFamilyProperties(gpu, pCount, pProperties));
 
     std::lock_guard<std::mutex> lock(global_lock);
     if (pProperties != NULL) {
@@ -667,7 +909,7 @@ VkResult explicit_CreateDevice(VkPhysicalDevice gpu, const VkDeviceCreateInfo *p
     // Advance the link info for the next element on the chain
     chain_info->u.pLayerInfo = chain_info->u.pLayerInfo->pNext;
 
-    VkResult result = fpCreateDevice(gpu, pCreateInfo, pAllocator, pDevice);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, fpCreateDevice(gpu, pCreateInfo, pAllocator, pDevice));
     if (result != VK_SUCCESS) {
         return result;
     }
@@ -679,8 +921,9 @@ VkResult explicit_CreateDevice(VkPhysicalDevice gpu, const VkDeviceCreateInfo *p
 
     createDeviceRegisterExtensions(pCreateInfo, *pDevice);
 
-    if (VkPhysicalDeviceMap.find((uint64_t)gpu) != VkPhysicalDeviceMap.end()) {
-        OBJTRACK_NODE *pNewObjNode = VkPhysicalDeviceMap[(uint64_t)gpu];
+    auto pd_item = VkPhysicalDeviceMap.find((uint64_t)gpu);
+    if (pd_item != VkPhysicalDeviceMap.end()) {
+        OBJTRACK_NODE *pNewObjNode = pd_item->second;
         create_device((VkInstance)pNewObjNode->belongsTo, *pDevice, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT);
     }
 
@@ -690,14 +933,12 @@ VkResult explicit_CreateDevice(VkPhysicalDevice gpu, const VkDeviceCreateInfo *p
 VkResult explicit_EnumeratePhysicalDevices(VkInstance instance, uint32_t *pPhysicalDeviceCount,
                                            VkPhysicalDevice *pPhysicalDevices) {
     bool skipCall = VK_FALSE;
-    std::unique_lock<std::mutex> lock(global_lock);
     skipCall |= validate_instance(instance, instance, VK_DEBUG_REPORT_OBJECT_TYPE_INSTANCE_EXT, false);
-    lock.unlock();
     if (skipCall)
         return VK_ERROR_VALIDATION_FAILED_EXT;
-    VkResult result = get_dispatch_table(object_tracker_instance_table_map, instance)
-                          ->EnumeratePhysicalDevices(instance, pPhysicalDeviceCount, pPhysicalDevices);
-    lock.lock();
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+        object_tracker_instance_table_map, instance)->EnumeratePhysicalDevices(instance, pPhysicalDeviceCount, pPhysicalDevices));
+    std::unique_lock<std::mutex> lock(global_lock);
     if (result == VK_SUCCESS) {
         if (pPhysicalDevices) {
             for (uint32_t i = 0; i < *pPhysicalDeviceCount; i++) {
@@ -714,7 +955,8 @@ void explicit_GetDeviceQueue(VkDevice device, uint32_t queueNodeIndex, uint32_t
     validate_device(device, device, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, false);
     lock.unlock();
 
-    get_dispatch_table(object_tracker_device_table_map, device)->GetDeviceQueue(device, queueNodeIndex, queueIndex, pQueue);
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_device_table_map, device)->GetDeviceQueue(device,
+                                                        queueNodeIndex, queueIndex, pQueue));
 
     lock.lock();
 
@@ -725,27 +967,24 @@ void explicit_GetDeviceQueue(VkDevice device, uint32_t queueNodeIndex, uint32_t
 VkResult explicit_MapMemory(VkDevice device, VkDeviceMemory mem, VkDeviceSize offset, VkDeviceSize size, VkFlags flags,
                             void **ppData) {
     bool skipCall = VK_FALSE;
-    std::unique_lock<std::mutex> lock(global_lock);
     skipCall |= validate_device(device, device, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, false);
-    lock.unlock();
     if (skipCall == VK_TRUE)
         return VK_ERROR_VALIDATION_FAILED_EXT;
 
     VkResult result =
-        get_dispatch_table(object_tracker_device_table_map, device)->MapMemory(device, mem, offset, size, flags, ppData);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_device_table_map, device)->MapMemory(device, mem, offset,
+                                                            size, flags, ppData));
 
     return result;
 }
 
 void explicit_UnmapMemory(VkDevice device, VkDeviceMemory mem) {
     bool skipCall = VK_FALSE;
-    std::unique_lock<std::mutex> lock(global_lock);
     skipCall |= validate_device(device, device, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, false);
-    lock.unlock();
     if (skipCall == VK_TRUE)
         return;
 
-    get_dispatch_table(object_tracker_device_table_map, device)->UnmapMemory(device, mem);
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_device_table_map, device)->UnmapMemory(device, mem));
 }
 
 VkResult explicit_QueueBindSparse(VkQueue queue, uint32_t bindInfoCount, const VkBindSparseInfo *pBindInfo, VkFence fence) {
@@ -763,26 +1002,26 @@ VkResult explicit_QueueBindSparse(VkQueue queue, uint32_t bindInfoCount, const V
     lock.unlock();
 
     VkResult result =
-        get_dispatch_table(object_tracker_device_table_map, queue)->QueueBindSparse(queue, bindInfoCount, pBindInfo, fence);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_device_table_map, queue)->QueueBindSparse(queue,
+                                                            bindInfoCount, pBindInfo, fence));
     return result;
 }
 
 VkResult explicit_AllocateCommandBuffers(VkDevice device, const VkCommandBufferAllocateInfo *pAllocateInfo,
                                          VkCommandBuffer *pCommandBuffers) {
     bool skipCall = VK_FALSE;
-    std::unique_lock<std::mutex> lock(global_lock);
     skipCall |= validate_device(device, device, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, false);
     skipCall |= validate_command_pool(device, pAllocateInfo->commandPool, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_POOL_EXT, false);
-    lock.unlock();
 
     if (skipCall) {
         return VK_ERROR_VALIDATION_FAILED_EXT;
     }
 
     VkResult result =
-        get_dispatch_table(object_tracker_device_table_map, device)->AllocateCommandBuffers(device, pAllocateInfo, pCommandBuffers);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_device_table_map, device)->AllocateCommandBuffers(device,
+                                                            pAllocateInfo, pCommandBuffers));
 
-    lock.lock();
+    std::unique_lock<std::mutex> lock(global_lock);
     for (uint32_t i = 0; i < pAllocateInfo->commandBufferCount; i++) {
         alloc_command_buffer(device, pAllocateInfo->commandPool, pCommandBuffers[i], VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT,
                              pAllocateInfo->level);
@@ -795,7 +1034,6 @@ VkResult explicit_AllocateCommandBuffers(VkDevice device, const VkCommandBufferA
 VkResult explicit_AllocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo *pAllocateInfo,
                                          VkDescriptorSet *pDescriptorSets) {
     bool skipCall = VK_FALSE;
-    std::unique_lock<std::mutex> lock(global_lock);
     skipCall |= validate_device(device, device, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, false);
     skipCall |=
         validate_descriptor_pool(device, pAllocateInfo->descriptorPool, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_POOL_EXT, false);
@@ -803,16 +1041,16 @@ VkResult explicit_AllocateDescriptorSets(VkDevice device, const VkDescriptorSetA
         skipCall |= validate_descriptor_set_layout(device, pAllocateInfo->pSetLayouts[i],
                                                    VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT_EXT, false);
     }
-    lock.unlock();
     if (skipCall) {
         return VK_ERROR_VALIDATION_FAILED_EXT;
     }
 
     VkResult result =
-        get_dispatch_table(object_tracker_device_table_map, device)->AllocateDescriptorSets(device, pAllocateInfo, pDescriptorSets);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_device_table_map, device)->AllocateDescriptorSets(device,
+                                                            pAllocateInfo, pDescriptorSets));
 
     if (VK_SUCCESS == result) {
-        lock.lock();
+        std::unique_lock<std::mutex> lock(global_lock);
         for (uint32_t i = 0; i < pAllocateInfo->descriptorSetCount; i++) {
             alloc_descriptor_set(device, pAllocateInfo->descriptorPool, pDescriptorSets[i],
                                  VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_SET_EXT);
@@ -835,8 +1073,8 @@ void explicit_FreeCommandBuffers(VkDevice device, VkCommandPool commandPool, uin
 
     lock.unlock();
     if (!skipCall) {
-        get_dispatch_table(object_tracker_device_table_map, device)
-            ->FreeCommandBuffers(device, commandPool, commandBufferCount, pCommandBuffers);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_device_table_map, device)->FreeCommandBuffers(device,
+                                                            commandPool, commandBufferCount, pCommandBuffers));
     }
 
     lock.lock();
@@ -849,11 +1087,10 @@ void explicit_DestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, con
     std::unique_lock<std::mutex> lock(global_lock);
     // A swapchain's images are implicitly deleted when the swapchain is deleted.
     // Remove this swapchain's images from our map of such images.
-    std::unordered_map<uint64_t, OBJTRACK_NODE *>::iterator itr = swapchainImageMap.begin();
+    auto itr = swapchainImageMap.begin();
     while (itr != swapchainImageMap.end()) {
         OBJTRACK_NODE *pNode = (*itr).second;
         if (pNode->parentObj == reinterpret_cast<uint64_t &>(swapchain)) {
-            delete pNode;
             swapchainImageMap.erase(itr++);
         } else {
             ++itr;
@@ -862,7 +1099,8 @@ void explicit_DestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, con
     destroy_swapchain_khr(device, swapchain);
     lock.unlock();
 
-    get_dispatch_table(object_tracker_device_table_map, device)->DestroySwapchainKHR(device, swapchain, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_device_table_map, device)->DestroySwapchainKHR(device,
+                                                        swapchain, pAllocator));
 }
 
 void explicit_FreeMemory(VkDevice device, VkDeviceMemory mem, const VkAllocationCallbacks *pAllocator) {
@@ -870,7 +1108,8 @@ void explicit_FreeMemory(VkDevice device, VkDeviceMemory mem, const VkAllocation
     validate_device(device, device, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, false);
     lock.unlock();
 
-    get_dispatch_table(object_tracker_device_table_map, device)->FreeMemory(device, mem, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_device_table_map, device)->FreeMemory(device, mem,
+                                                        pAllocator));
 
     lock.lock();
     destroy_device_memory(device, mem);
@@ -889,8 +1128,8 @@ VkResult explicit_FreeDescriptorSets(VkDevice device, VkDescriptorPool descripto
 
     lock.unlock();
     if (!skipCall) {
-        result = get_dispatch_table(object_tracker_device_table_map, device)
-                     ->FreeDescriptorSets(device, descriptorPool, count, pDescriptorSets);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+            object_tracker_device_table_map, device)->FreeDescriptorSets(device, descriptorPool, count, pDescriptorSets));
     }
 
     lock.lock();
@@ -912,17 +1151,28 @@ void explicit_DestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptor
     // A DescriptorPool's descriptor sets are implicitly deleted when the pool is deleted.
     // Remove this pool's descriptor sets from our descriptorSet map.
     lock.lock();
-    std::unordered_map<uint64_t, OBJTRACK_NODE *>::iterator itr = VkDescriptorSetMap.begin();
-    while (itr != VkDescriptorSetMap.end()) {
-        OBJTRACK_NODE *pNode = (*itr).second;
-        auto del_itr = itr++;
-        if (pNode->parentObj == (uint64_t)(descriptorPool)) {
-            destroy_descriptor_set(device, (VkDescriptorSet)((*del_itr).first));
-        }
-    }
+    free_pool_descriptor_sets(device, descriptorPool);
     destroy_descriptor_pool(device, descriptorPool);
     lock.unlock();
-    get_dispatch_table(object_tracker_device_table_map, device)->DestroyDescriptorPool(device, descriptorPool, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_device_table_map, device)->DestroyDescriptorPool(device,
+                                                        descriptorPool, pAllocator));
+}
+
+VkResult explicit_ResetDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool, VkDescriptorPoolResetFlags flags) {
+    bool skipCall = false;
+    skipCall |= validate_descriptor_pool(device, descriptorPool, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_POOL_EXT, false);
+    skipCall |= validate_device(device, device, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, false);
+    if (skipCall)
+        return VK_ERROR_VALIDATION_FAILED_EXT;
+
+    VkResult result = LAYER_PROFILE_DISPATCH(
+        profiler, get_dispatch_table(object_tracker_device_table_map, device)->ResetDescriptorPool(device, descriptorPool, flags));
+    if (result == VK_SUCCESS) {
+        // Resetting a DescriptorPool implicitly frees all of its descriptor sets
+        std::lock_guard<std::mutex> lock(global_lock);
+        free_pool_descriptor_sets(device, descriptorPool);
+    }
+    return result;
 }
 
 void explicit_DestroyCommandPool(VkDevice device, VkCommandPool commandPool, const VkAllocationCallbacks *pAllocator) {
@@ -937,34 +1187,30 @@ void explicit_DestroyCommandPool(VkDevice device, VkCommandPool commandPool, con
     lock.lock();
     // A CommandPool's command buffers are implicitly deleted when the pool is deleted.
     // Remove this pool's cmdBuffers from our cmd buffer map.
-    std::unordered_map<uint64_t, OBJTRACK_NODE *>::iterator itr = VkCommandBufferMap.begin();
-    std::unordered_map<uint64_t, OBJTRACK_NODE *>::iterator del_itr;
-    while (itr != VkCommandBufferMap.end()) {
-        OBJTRACK_NODE *pNode = (*itr).second;
-        del_itr = itr++;
-        if (pNode->parentObj == (uint64_t)(commandPool)) {
-            skipCall |= validate_command_buffer(device, commandPool, reinterpret_cast<VkCommandBuffer>((*del_itr).first));
-            free_command_buffer(device, reinterpret_cast<VkCommandBuffer>((*del_itr).first));
-        }
+    OBJTRACK_NODE *pPoolNode = VkCommandPoolMap.get((uint64_t)commandPool);
+    OBJTRACK_NODE *pChild = pPoolNode ? pPoolNode->firstChild : nullptr;
+    while (pChild) {
+        OBJTRACK_NODE *pNext = pChild->nextSibling;
+        free_command_buffer(device, reinterpret_cast<VkCommandBuffer>(pChild->vkObj));
+        pChild = pNext;
     }
     destroy_command_pool(device, commandPool);
     lock.unlock();
-    get_dispatch_table(object_tracker_device_table_map, device)->DestroyCommandPool(device, commandPool, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_device_table_map, device)->DestroyCommandPool(device,
+                                                        commandPool, pAllocator));
 }
 
 VkResult explicit_GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t *pCount, VkImage *pSwapchainImages) {
     bool skipCall = VK_FALSE;
-    std::unique_lock<std::mutex> lock(global_lock);
     skipCall |= validate_device(device, device, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, false);
-    lock.unlock();
     if (skipCall)
         return VK_ERROR_VALIDATION_FAILED_EXT;
 
-    VkResult result = get_dispatch_table(object_tracker_device_table_map, device)
-                          ->GetSwapchainImagesKHR(device, swapchain, pCount, pSwapchainImages);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+        object_tracker_device_table_map, device)->GetSwapchainImagesKHR(device, swapchain, pCount, pSwapchainImages));
 
     if (pSwapchainImages != NULL) {
-        lock.lock();
+        std::unique_lock<std::mutex> lock(global_lock);
         for (uint32_t i = 0; i < *pCount; i++) {
             create_swapchain_image_obj(device, pSwapchainImages[i], swapchain);
         }
@@ -978,7 +1224,6 @@ VkResult explicit_CreateGraphicsPipelines(VkDevice device, VkPipelineCache pipel
                                           const VkGraphicsPipelineCreateInfo *pCreateInfos, const VkAllocationCallbacks *pAllocator,
                                           VkPipeline *pPipelines) {
     bool skipCall = VK_FALSE;
-    std::unique_lock<std::mutex> lock(global_lock);
     skipCall |= validate_device(device, device, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, false);
     if (pCreateInfos) {
         for (uint32_t idx0 = 0; idx0 < createInfoCount; ++idx0) {
@@ -1007,12 +1252,12 @@ VkResult explicit_CreateGraphicsPipelines(VkDevice device, VkPipelineCache pipel
     if (pipelineCache) {
         skipCall |= validate_pipeline_cache(device, pipelineCache, VK_DEBUG_REPORT_OBJECT_TYPE_PIPELINE_CACHE_EXT, false);
     }
-    lock.unlock();
     if (skipCall)
         return VK_ERROR_VALIDATION_FAILED_EXT;
-    VkResult result = get_dispatch_table(object_tracker_device_table_map, device)
-                          ->CreateGraphicsPipelines(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines);
-    lock.lock();
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_device_table_map,
+                                                                          device)->CreateGraphicsPipelines(device, pipelineCache,
+                                                                          createInfoCount, pCreateInfos, pAllocator, pPipelines));
+    std::unique_lock<std::mutex> lock(global_lock);
     if (result == VK_SUCCESS) {
         for (uint32_t idx2 = 0; idx2 < createInfoCount; ++idx2) {
             create_pipeline(device, pPipelines[idx2], VK_DEBUG_REPORT_OBJECT_TYPE_PIPELINE_EXT);
@@ -1027,7 +1272,6 @@ VkResult explicit_CreateComputePipelines(VkDevice device, VkPipelineCache pipeli
                                          const VkComputePipelineCreateInfo *pCreateInfos, const VkAllocationCallbacks *pAllocator,
                                          VkPipeline *pPipelines) {
     bool skipCall = VK_FALSE;
-    std::unique_lock<std::mutex> lock(global_lock);
     skipCall |= validate_device(device, device, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, false);
     if (pCreateInfos) {
         for (uint32_t idx0 = 0; idx0 < createInfoCount; ++idx0) {
@@ -1048,12 +1292,12 @@ VkResult explicit_CreateComputePipelines(VkDevice device, VkPipelineCache pipeli
     if (pipelineCache) {
         skipCall |= validate_pipeline_cache(device, pipelineCache, VK_DEBUG_REPORT_OBJECT_TYPE_PIPELINE_CACHE_EXT, false);
     }
-    lock.unlock();
     if (skipCall)
         return VK_ERROR_VALIDATION_FAILED_EXT;
-    VkResult result = get_dispatch_table(object_tracker_device_table_map, device)
-                          ->CreateComputePipelines(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines);
-    lock.lock();
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_device_table_map,
+                                                                          device)->CreateComputePipelines(device, pipelineCache,
+                                                                          createInfoCount, pCreateInfos, pAllocator, pPipelines));
+    std::unique_lock<std::mutex> lock(global_lock);
     if (result == VK_SUCCESS) {
         for (uint32_t idx1 = 0; idx1 < createInfoCount; ++idx1) {
             create_pipeline(device, pPipelines[idx1], VK_DEBUG_REPORT_OBJECT_TYPE_PIPELINE_EXT);
@@ -44,6 +44,7 @@
 #include "vk_layer_table.h"
 #include "vk_layer_data.h"
 #include "vk_layer_logging.h"
+#include "vk_layer_profile.h"
 #include "vk_layer_extension_utils.h"
 #include "vk_layer_utils.h"
 
@@ -71,7 +72,8 @@ struct layer_data {
     layer_data() : report_data(nullptr), num_tmp_callbacks(0), tmp_dbg_create_infos(nullptr), tmp_callbacks(nullptr){};
 };
 
-static std::unordered_map<void *, layer_data *> layer_data_map;
+static dispatch_key_map<layer_data> layer_data_map;
+static layer_profiler profiler;
 static device_table_map pc_device_table_map;
 static instance_table_map pc_instance_table_map;
 
@@ -101,13 +103,16 @@ debug_report_data *mdd(void *object) {
 static void init_parameter_validation(layer_data *my_data, const VkAllocationCallbacks *pAllocator) {
 
     layer_debug_actions(my_data->report_data, my_data->logging_callback, pAllocator, "lunarg_parameter_validation");
+    layer_profile_start(&profiler, "lunarg_parameter_validation");
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateDebugReportCallbackEXT(VkInstance instance, const VkDebugReportCallbackCreateInfoEXT *pCreateInfo,
                              const VkAllocationCallbacks *pAllocator, VkDebugReportCallbackEXT *pMsgCallback) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDebugReportCallbackEXT");
     VkLayerInstanceDispatchTable *pTable = get_dispatch_table(pc_instance_table_map, instance);
-    VkResult result = pTable->CreateDebugReportCallbackEXT(instance, pCreateInfo, pAllocator, pMsgCallback);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, pTable->CreateDebugReportCallbackEXT(instance, pCreateInfo, pAllocator,
+                                                                                            pMsgCallback));
 
     if (result == VK_SUCCESS) {
         layer_data *data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
@@ -120,8 +125,9 @@ CreateDebugReportCallbackEXT(VkInstance instance, const VkDebugReportCallbackCre
 VKAPI_ATTR void VKAPI_CALL DestroyDebugReportCallbackEXT(VkInstance instance,
                                                          VkDebugReportCallbackEXT msgCallback,
                                                          const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDebugReportCallbackEXT");
     VkLayerInstanceDispatchTable *pTable = get_dispatch_table(pc_instance_table_map, instance);
-    pTable->DestroyDebugReportCallbackEXT(instance, msgCallback, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, pTable->DestroyDebugReportCallbackEXT(instance, msgCallback, pAllocator));
 
     layer_data *data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
     layer_destroy_msg_callback(data->report_data, msgCallback, pAllocator);
@@ -130,8 +136,10 @@ VKAPI_ATTR void VKAPI_CALL DestroyDebugReportCallbackEXT(VkInstance instance,
 VKAPI_ATTR void VKAPI_CALL
 DebugReportMessageEXT(VkInstance instance, VkDebugReportFlagsEXT flags, VkDebugReportObjectTypeEXT objType, uint64_t object,
                       size_t location, int32_t msgCode, const char *pLayerPrefix, const char *pMsg) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDebugReportMessageEXT");
     VkLayerInstanceDispatchTable *pTable = get_dispatch_table(pc_instance_table_map, instance);
-    pTable->DebugReportMessageEXT(instance, flags, objType, object, location, msgCode, pLayerPrefix, pMsg);
+    LAYER_PROFILE_DISPATCH(profiler, pTable->DebugReportMessageEXT(instance, flags, objType, object, location, msgCode,
+                                                                   pLayerPrefix, pMsg));
 }
 
 static const VkExtensionProperties instance_extensions[] = {{VK_EXT_DEBUG_REPORT_EXTENSION_NAME, VK_EXT_DEBUG_REPORT_SPEC_VERSION}};
@@ -1293,6 +1301,7 @@ static bool validate_queue_family_indices(layer_data *device_data, const char *f
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkInstance *pInstance) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateInstance");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
 
     VkLayerInstanceCreateInfo *chain_info = get_chain_info(pCreateInfo, VK_LAYER_LINK_INFO);
@@ -1308,7 +1317,7 @@ CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallba
     // Advance the link info for the next element on the chain
     chain_info->u.pLayerInfo = chain_info->u.pLayerInfo->pNext;
 
-    result = fpCreateInstance(pCreateInfo, pAllocator, pInstance);
+    result = LAYER_PROFILE_DISPATCH(profiler, fpCreateInstance(pCreateInfo, pAllocator, pInstance));
 
     if (result == VK_SUCCESS) {
         layer_data *my_instance_data = get_my_data_ptr(get_dispatch_key(*pInstance), layer_data_map);
@@ -1366,6 +1375,7 @@ CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallba
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyInstance");
     // Grab the key before the instance is destroyed.
     dispatch_key key = get_dispatch_key(instance);
     bool skipCall = false;
@@ -1394,7 +1404,7 @@ VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocati
 
     if (!skipCall) {
         VkLayerInstanceDispatchTable *pTable = get_dispatch_table(pc_instance_table_map, instance);
-        pTable->DestroyInstance(instance, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, pTable->DestroyInstance(instance, pAllocator));
 
         // Clean up logging callback, if any
         while (my_data->logging_callback.size() > 0) {
@@ -1404,6 +1414,7 @@ VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocati
         }
 
         layer_debug_report_destroy_instance(mid(instance));
+        layer_profile_stop(&profiler);
         layer_data_map.erase(pTable);
 
         pc_instance_table_map.erase(key);
@@ -1413,6 +1424,7 @@ VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocati
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumeratePhysicalDevices(VkInstance instance, uint32_t *pPhysicalDeviceCount, VkPhysicalDevice *pPhysicalDevices) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumeratePhysicalDevices");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
@@ -1421,8 +1433,8 @@ EnumeratePhysicalDevices(VkInstance instance, uint32_t *pPhysicalDeviceCount, Vk
     skipCall |= parameter_validation_vkEnumeratePhysicalDevices(my_data->report_data, pPhysicalDeviceCount, pPhysicalDevices);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_instance_table_map, instance)
-                     ->EnumeratePhysicalDevices(instance, pPhysicalDeviceCount, pPhysicalDevices);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+            pc_instance_table_map, instance)->EnumeratePhysicalDevices(instance, pPhysicalDeviceCount, pPhysicalDevices));
 
         validate_result(my_data->report_data, "vkEnumeratePhysicalDevices", result);
     }
@@ -1432,6 +1444,7 @@ EnumeratePhysicalDevices(VkInstance instance, uint32_t *pPhysicalDeviceCount, Vk
 
 VKAPI_ATTR void VKAPI_CALL
 GetPhysicalDeviceFeatures(VkPhysicalDevice physicalDevice, VkPhysicalDeviceFeatures *pFeatures) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceFeatures");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
     assert(my_data != NULL);
@@ -1439,12 +1452,14 @@ GetPhysicalDeviceFeatures(VkPhysicalDevice physicalDevice, VkPhysicalDeviceFeatu
     skipCall |= parameter_validation_vkGetPhysicalDeviceFeatures(my_data->report_data, pFeatures);
 
     if (!skipCall) {
-        get_dispatch_table(pc_instance_table_map, physicalDevice)->GetPhysicalDeviceFeatures(physicalDevice, pFeatures);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_instance_table_map,
+                                                            physicalDevice)->GetPhysicalDeviceFeatures(physicalDevice, pFeatures));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 GetPhysicalDeviceFormatProperties(VkPhysicalDevice physicalDevice, VkFormat format, VkFormatProperties *pFormatProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceFormatProperties");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
     assert(my_data != NULL);
@@ -1452,8 +1467,8 @@ GetPhysicalDeviceFormatProperties(VkPhysicalDevice physicalDevice, VkFormat form
     skipCall |= parameter_validation_vkGetPhysicalDeviceFormatProperties(my_data->report_data, format, pFormatProperties);
 
     if (!skipCall) {
-        get_dispatch_table(pc_instance_table_map, physicalDevice)
-            ->GetPhysicalDeviceFormatProperties(physicalDevice, format, pFormatProperties);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+            pc_instance_table_map, physicalDevice)->GetPhysicalDeviceFormatProperties(physicalDevice, format, pFormatProperties));
     }
 }
 
@@ -1461,6 +1476,7 @@ VKAPI_ATTR VkResult VKAPI_CALL
 GetPhysicalDeviceImageFormatProperties(VkPhysicalDevice physicalDevice, VkFormat format, VkImageType type, VkImageTiling tiling,
                                        VkImageUsageFlags usage, VkImageCreateFlags flags,
                                        VkImageFormatProperties *pImageFormatProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceImageFormatProperties");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
@@ -1470,9 +1486,9 @@ GetPhysicalDeviceImageFormatProperties(VkPhysicalDevice physicalDevice, VkFormat
                                                                      pImageFormatProperties);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_instance_table_map, physicalDevice)
-                     ->GetPhysicalDeviceImageFormatProperties(physicalDevice, format, type, tiling, usage, flags,
-                                                              pImageFormatProperties);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+            pc_instance_table_map, physicalDevice)->GetPhysicalDeviceImageFormatProperties(physicalDevice, format, type, tiling,
+            usage, flags, pImageFormatProperties));
 
         validate_result(my_data->report_data, "vkGetPhysicalDeviceImageFormatProperties", result);
     }
@@ -1482,6 +1498,7 @@ GetPhysicalDeviceImageFormatProperties(VkPhysicalDevice physicalDevice, VkFormat
 
 VKAPI_ATTR void VKAPI_CALL
 GetPhysicalDeviceProperties(VkPhysicalDevice physicalDevice, VkPhysicalDeviceProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceProperties");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
     assert(my_data != NULL);
@@ -1489,13 +1506,15 @@ GetPhysicalDeviceProperties(VkPhysicalDevice physicalDevice, VkPhysicalDevicePro
     skipCall |= parameter_validation_vkGetPhysicalDeviceProperties(my_data->report_data, pProperties);
 
     if (!skipCall) {
-        get_dispatch_table(pc_instance_table_map, physicalDevice)->GetPhysicalDeviceProperties(physicalDevice, pProperties);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+            pc_instance_table_map, physicalDevice)->GetPhysicalDeviceProperties(physicalDevice, pProperties));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 GetPhysicalDeviceQueueFamilyProperties(VkPhysicalDevice physicalDevice, uint32_t *pQueueFamilyPropertyCount,
                                        VkQueueFamilyProperties *pQueueFamilyProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceQueueFamilyProperties");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
     assert(my_data != NULL);
@@ -1504,13 +1523,15 @@ GetPhysicalDeviceQueueFamilyProperties(VkPhysicalDevice physicalDevice, uint32_t
                                                                      pQueueFamilyProperties);
 
     if (!skipCall) {
-        get_dispatch_table(pc_instance_table_map, physicalDevice)
-            ->GetPhysicalDeviceQueueFamilyProperties(physicalDevice, pQueueFamilyPropertyCount, pQueueFamilyProperties);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_instance_table_map,
+                                                            physicalDevice)->GetPhysicalDeviceQueueFamilyProperties(physicalDevice,
+                                                            pQueueFamilyPropertyCount, pQueueFamilyProperties));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 GetPhysicalDeviceMemoryProperties(VkPhysicalDevice physicalDevice, VkPhysicalDeviceMemoryProperties *pMemoryProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceMemoryProperties");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
     assert(my_data != NULL);
@@ -1518,8 +1539,8 @@ GetPhysicalDeviceMemoryProperties(VkPhysicalDevice physicalDevice, VkPhysicalDev
     skipCall |= parameter_validation_vkGetPhysicalDeviceMemoryProperties(my_data->report_data, pMemoryProperties);
 
     if (!skipCall) {
-        get_dispatch_table(pc_instance_table_map, physicalDevice)
-            ->GetPhysicalDeviceMemoryProperties(physicalDevice, pMemoryProperties);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+            pc_instance_table_map, physicalDevice)->GetPhysicalDeviceMemoryProperties(physicalDevice, pMemoryProperties));
     }
 }
 
@@ -1586,6 +1607,7 @@ void storeCreateDeviceData(VkDevice device, const VkDeviceCreateInfo *pCreateInf
 VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice physicalDevice,
                                             const VkDeviceCreateInfo *pCreateInfo,
                                             const VkAllocationCallbacks *pAllocator, VkDevice *pDevice) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDevice");
     /*
      * NOTE: We do not validate physicalDevice or any dispatchable
      * object as the first parameter. We couldn't get here if it was wrong!
@@ -1629,7 +1651,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice physicalDevice,
         // Advance the link info for the next element on the chain
         chain_info->u.pLayerInfo = chain_info->u.pLayerInfo->pNext;
 
-        result = fpCreateDevice(physicalDevice, pCreateInfo, pAllocator, pDevice);
+        result = LAYER_PROFILE_DISPATCH(profiler, fpCreateDevice(physicalDevice, pCreateInfo, pAllocator, pDevice));
 
         validate_result(my_instance_data->report_data, "vkCreateDevice", result);
 
@@ -1641,11 +1663,12 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice physicalDevice,
             initDeviceTable(*pDevice, fpGetDeviceProcAddr, pc_device_table_map);
 
             uint32_t count;
-            get_dispatch_table(pc_instance_table_map, physicalDevice)
-                ->GetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count, nullptr);
+            LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+                pc_instance_table_map, physicalDevice)->GetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count, nullptr));
             std::vector<VkQueueFamilyProperties> properties(count);
-            get_dispatch_table(pc_instance_table_map, physicalDevice)
-                ->GetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count, &properties[0]);
+            LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+                pc_instance_table_map, physicalDevice)->GetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count,
+                &properties[0]));
 
             validateDeviceCreateInfo(physicalDevice, pCreateInfo, properties);
             storeCreateDeviceData(*pDevice, pCreateInfo);
@@ -1656,6 +1679,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice physicalDevice,
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyDevice(VkDevice device, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDevice");
     dispatch_key key = get_dispatch_key(device);
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
@@ -1670,7 +1694,7 @@ VKAPI_ATTR void VKAPI_CALL DestroyDevice(VkDevice device, const VkAllocationCall
         fprintf(stderr, "Device:  0x%p, key:  0x%p\n", device, key);
 #endif
 
-        get_dispatch_table(pc_device_table_map, device)->DestroyDevice(device, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyDevice(device, pAllocator));
         pc_device_table_map.erase(key);
         layer_data_map.erase(key);
     }
@@ -1697,6 +1721,7 @@ bool PreGetDeviceQueue(VkDevice device, uint32_t queueFamilyIndex, uint32_t queu
 
 VKAPI_ATTR void VKAPI_CALL
 GetDeviceQueue(VkDevice device, uint32_t queueFamilyIndex, uint32_t queueIndex, VkQueue *pQueue) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetDeviceQueue");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -1706,12 +1731,14 @@ GetDeviceQueue(VkDevice device, uint32_t queueFamilyIndex, uint32_t queueIndex,
     if (!skipCall) {
         PreGetDeviceQueue(device, queueFamilyIndex, queueIndex);
 
-        get_dispatch_table(pc_device_table_map, device)->GetDeviceQueue(device, queueFamilyIndex, queueIndex, pQueue);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->GetDeviceQueue(device, queueFamilyIndex,
+                                                            queueIndex, pQueue));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 QueueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo *pSubmits, VkFence fence) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkQueueSubmit");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(queue), layer_data_map);
@@ -1720,7 +1747,8 @@ QueueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo *pSubmits, V
     skipCall |= parameter_validation_vkQueueSubmit(my_data->report_data, submitCount, pSubmits, fence);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, queue)->QueueSubmit(queue, submitCount, pSubmits, fence);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, queue)->QueueSubmit(queue, submitCount,
+                                                                     pSubmits, fence));
 
         validate_result(my_data->report_data, "vkQueueSubmit", result);
     }
@@ -1729,10 +1757,11 @@ QueueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo *pSubmits, V
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL QueueWaitIdle(VkQueue queue) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkQueueWaitIdle");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(queue), layer_data_map);
     assert(my_data != NULL);
 
-    VkResult result = get_dispatch_table(pc_device_table_map, queue)->QueueWaitIdle(queue);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, queue)->QueueWaitIdle(queue));
 
     validate_result(my_data->report_data, "vkQueueWaitIdle", result);
 
@@ -1740,10 +1769,11 @@ VKAPI_ATTR VkResult VKAPI_CALL QueueWaitIdle(VkQueue queue) {
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL DeviceWaitIdle(VkDevice device) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDeviceWaitIdle");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
 
-    VkResult result = get_dispatch_table(pc_device_table_map, device)->DeviceWaitIdle(device);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DeviceWaitIdle(device));
 
     validate_result(my_data->report_data, "vkDeviceWaitIdle", result);
 
@@ -1752,6 +1782,7 @@ VKAPI_ATTR VkResult VKAPI_CALL DeviceWaitIdle(VkDevice device) {
 
 VKAPI_ATTR VkResult VKAPI_CALL AllocateMemory(VkDevice device, const VkMemoryAllocateInfo *pAllocateInfo,
                                                                 const VkAllocationCallbacks *pAllocator, VkDeviceMemory *pMemory) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkAllocateMemory");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -1760,7 +1791,8 @@ VKAPI_ATTR VkResult VKAPI_CALL AllocateMemory(VkDevice device, const VkMemoryAll
     skipCall |= parameter_validation_vkAllocateMemory(my_data->report_data, pAllocateInfo, pAllocator, pMemory);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->AllocateMemory(device, pAllocateInfo, pAllocator, pMemory);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->AllocateMemory(device,
+                                                                     pAllocateInfo, pAllocator, pMemory));
 
         validate_result(my_data->report_data, "vkAllocateMemory", result);
     }
@@ -1770,6 +1802,7 @@ VKAPI_ATTR VkResult VKAPI_CALL AllocateMemory(VkDevice device, const VkMemoryAll
 
 VKAPI_ATTR void VKAPI_CALL
 FreeMemory(VkDevice device, VkDeviceMemory memory, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkFreeMemory");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -1777,12 +1810,13 @@ FreeMemory(VkDevice device, VkDeviceMemory memory, const VkAllocationCallbacks *
     skipCall |= parameter_validation_vkFreeMemory(my_data->report_data, memory, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->FreeMemory(device, memory, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->FreeMemory(device, memory, pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 MapMemory(VkDevice device, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize size, VkMemoryMapFlags flags, void **ppData) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkMapMemory");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -1791,7 +1825,8 @@ MapMemory(VkDevice device, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceS
     skipCall |= parameter_validation_vkMapMemory(my_data->report_data, memory, offset, size, flags, ppData);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->MapMemory(device, memory, offset, size, flags, ppData);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->MapMemory(device, memory, offset,
+                                                                     size, flags, ppData));
 
         validate_result(my_data->report_data, "vkMapMemory", result);
     }
@@ -1800,6 +1835,7 @@ MapMemory(VkDevice device, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceS
 }
 
 VKAPI_ATTR void VKAPI_CALL UnmapMemory(VkDevice device, VkDeviceMemory memory) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkUnmapMemory");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -1807,12 +1843,13 @@ VKAPI_ATTR void VKAPI_CALL UnmapMemory(VkDevice device, VkDeviceMemory memory) {
     skipCall |= parameter_validation_vkUnmapMemory(my_data->report_data, memory);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->UnmapMemory(device, memory);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->UnmapMemory(device, memory));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 FlushMappedMemoryRanges(VkDevice device, uint32_t memoryRangeCount, const VkMappedMemoryRange *pMemoryRanges) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkFlushMappedMemoryRanges");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -1821,7 +1858,8 @@ FlushMappedMemoryRanges(VkDevice device, uint32_t memoryRangeCount, const VkMapp
     skipCall |= parameter_validation_vkFlushMappedMemoryRanges(my_data->report_data, memoryRangeCount, pMemoryRanges);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->FlushMappedMemoryRanges(device, memoryRangeCount, pMemoryRanges);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->FlushMappedMemoryRanges(device,
+                                                                     memoryRangeCount, pMemoryRanges));
 
         validate_result(my_data->report_data, "vkFlushMappedMemoryRanges", result);
     }
@@ -1831,6 +1869,7 @@ FlushMappedMemoryRanges(VkDevice device, uint32_t memoryRangeCount, const VkMapp
 
 VKAPI_ATTR VkResult VKAPI_CALL
 InvalidateMappedMemoryRanges(VkDevice device, uint32_t memoryRangeCount, const VkMappedMemoryRange *pMemoryRanges) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkInvalidateMappedMemoryRanges");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -1840,7 +1879,8 @@ InvalidateMappedMemoryRanges(VkDevice device, uint32_t memoryRangeCount, const V
 
     if (!skipCall) {
         result =
-            get_dispatch_table(pc_device_table_map, device)->InvalidateMappedMemoryRanges(device, memoryRangeCount, pMemoryRanges);
+            LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->InvalidateMappedMemoryRanges(device,
+                                                                memoryRangeCount, pMemoryRanges));
 
         validate_result(my_data->report_data, "vkInvalidateMappedMemoryRanges", result);
     }
@@ -1850,6 +1890,7 @@ InvalidateMappedMemoryRanges(VkDevice device, uint32_t memoryRangeCount, const V
 
 VKAPI_ATTR void VKAPI_CALL
 GetDeviceMemoryCommitment(VkDevice device, VkDeviceMemory memory, VkDeviceSize *pCommittedMemoryInBytes) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetDeviceMemoryCommitment");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -1857,12 +1898,14 @@ GetDeviceMemoryCommitment(VkDevice device, VkDeviceMemory memory, VkDeviceSize *
     skipCall |= parameter_validation_vkGetDeviceMemoryCommitment(my_data->report_data, memory, pCommittedMemoryInBytes);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->GetDeviceMemoryCommitment(device, memory, pCommittedMemoryInBytes);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->GetDeviceMemoryCommitment(device, memory,
+                                                            pCommittedMemoryInBytes));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL BindBufferMemory(VkDevice device, VkBuffer buffer, VkDeviceMemory memory,
                                                 VkDeviceSize memoryOffset) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkBindBufferMemory");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -1871,7 +1914,8 @@ VKAPI_ATTR VkResult VKAPI_CALL BindBufferMemory(VkDevice device, VkBuffer buffer
     skipCall |= parameter_validation_vkBindBufferMemory(my_data->report_data, buffer, memory, memoryOffset);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->BindBufferMemory(device, buffer, memory, memoryOffset);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->BindBufferMemory(device, buffer,
+                                                                     memory, memoryOffset));
 
         validate_result(my_data->report_data, "vkBindBufferMemory", result);
     }
@@ -1881,6 +1925,7 @@ VKAPI_ATTR VkResult VKAPI_CALL BindBufferMemory(VkDevice device, VkBuffer buffer
 
 VKAPI_ATTR VkResult VKAPI_CALL BindImageMemory(VkDevice device, VkImage image, VkDeviceMemory memory,
                                                VkDeviceSize memoryOffset) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkBindImageMemory");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -1889,7 +1934,8 @@ VKAPI_ATTR VkResult VKAPI_CALL BindImageMemory(VkDevice device, VkImage image, V
     skipCall |= parameter_validation_vkBindImageMemory(my_data->report_data, image, memory, memoryOffset);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->BindImageMemory(device, image, memory, memoryOffset);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->BindImageMemory(device, image,
+                                                                     memory, memoryOffset));
 
         validate_result(my_data->report_data, "vkBindImageMemory", result);
     }
@@ -1899,6 +1945,7 @@ VKAPI_ATTR VkResult VKAPI_CALL BindImageMemory(VkDevice device, VkImage image, V
 
 VKAPI_ATTR void VKAPI_CALL
 GetBufferMemoryRequirements(VkDevice device, VkBuffer buffer, VkMemoryRequirements *pMemoryRequirements) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetBufferMemoryRequirements");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -1906,12 +1953,14 @@ GetBufferMemoryRequirements(VkDevice device, VkBuffer buffer, VkMemoryRequiremen
     skipCall |= parameter_validation_vkGetBufferMemoryRequirements(my_data->report_data, buffer, pMemoryRequirements);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->GetBufferMemoryRequirements(device, buffer, pMemoryRequirements);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->GetBufferMemoryRequirements(device,
+                                                            buffer, pMemoryRequirements));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 GetImageMemoryRequirements(VkDevice device, VkImage image, VkMemoryRequirements *pMemoryRequirements) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetImageMemoryRequirements");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -1919,7 +1968,8 @@ GetImageMemoryRequirements(VkDevice device, VkImage image, VkMemoryRequirements
     skipCall |= parameter_validation_vkGetImageMemoryRequirements(my_data->report_data, image, pMemoryRequirements);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->GetImageMemoryRequirements(device, image, pMemoryRequirements);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->GetImageMemoryRequirements(device, image,
+                                                            pMemoryRequirements));
     }
 }
 
@@ -1943,6 +1993,7 @@ bool PostGetImageSparseMemoryRequirements(VkDevice device, VkImage image, uint32
 VKAPI_ATTR void VKAPI_CALL
 GetImageSparseMemoryRequirements(VkDevice device, VkImage image, uint32_t *pSparseMemoryRequirementCount,
                                  VkSparseImageMemoryRequirements *pSparseMemoryRequirements) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetImageSparseMemoryRequirements");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -1951,8 +2002,8 @@ GetImageSparseMemoryRequirements(VkDevice device, VkImage image, uint32_t *pSpar
                                                                pSparseMemoryRequirements);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)
-            ->GetImageSparseMemoryRequirements(device, image, pSparseMemoryRequirementCount, pSparseMemoryRequirements);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->GetImageSparseMemoryRequirements(device,
+                                                            image, pSparseMemoryRequirementCount, pSparseMemoryRequirements));
 
         PostGetImageSparseMemoryRequirements(device, image, pSparseMemoryRequirementCount, pSparseMemoryRequirements);
     }
@@ -1979,6 +2030,7 @@ VKAPI_ATTR void VKAPI_CALL
 GetPhysicalDeviceSparseImageFormatProperties(VkPhysicalDevice physicalDevice, VkFormat format, VkImageType type,
                                              VkSampleCountFlagBits samples, VkImageUsageFlags usage, VkImageTiling tiling,
                                              uint32_t *pPropertyCount, VkSparseImageFormatProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceSparseImageFormatProperties");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
     assert(my_data != NULL);
@@ -1987,9 +2039,9 @@ GetPhysicalDeviceSparseImageFormatProperties(VkPhysicalDevice physicalDevice, Vk
                                                                            tiling, pPropertyCount, pProperties);
 
     if (!skipCall) {
-        get_dispatch_table(pc_instance_table_map, physicalDevice)
-            ->GetPhysicalDeviceSparseImageFormatProperties(physicalDevice, format, type, samples, usage, tiling, pPropertyCount,
-                                                           pProperties);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+            pc_instance_table_map, physicalDevice)->GetPhysicalDeviceSparseImageFormatProperties(physicalDevice, format, type,
+            samples, usage, tiling, pPropertyCount, pProperties));
 
         PostGetPhysicalDeviceSparseImageFormatProperties(physicalDevice, format, type, samples, usage, tiling, pPropertyCount,
                                                          pProperties);
@@ -1998,6 +2050,7 @@ GetPhysicalDeviceSparseImageFormatProperties(VkPhysicalDevice physicalDevice, Vk
 
 VKAPI_ATTR VkResult VKAPI_CALL
 QueueBindSparse(VkQueue queue, uint32_t bindInfoCount, const VkBindSparseInfo *pBindInfo, VkFence fence) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkQueueBindSparse");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(queue), layer_data_map);
@@ -2006,7 +2059,8 @@ QueueBindSparse(VkQueue queue, uint32_t bindInfoCount, const VkBindSparseInfo *p
     skipCall |= parameter_validation_vkQueueBindSparse(my_data->report_data, bindInfoCount, pBindInfo, fence);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, queue)->QueueBindSparse(queue, bindInfoCount, pBindInfo, fence);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, queue)->QueueBindSparse(queue,
+                                                                     bindInfoCount, pBindInfo, fence));
 
         validate_result(my_data->report_data, "vkQueueBindSparse", result);
     }
@@ -2016,6 +2070,7 @@ QueueBindSparse(VkQueue queue, uint32_t bindInfoCount, const VkBindSparseInfo *p
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateFence(VkDevice device, const VkFenceCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkFence *pFence) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateFence");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2024,7 +2079,8 @@ CreateFence(VkDevice device, const VkFenceCreateInfo *pCreateInfo, const VkAlloc
     skipCall |= parameter_validation_vkCreateFence(my_data->report_data, pCreateInfo, pAllocator, pFence);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->CreateFence(device, pCreateInfo, pAllocator, pFence);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateFence(device, pCreateInfo,
+                                                                     pAllocator, pFence));
 
         validate_result(my_data->report_data, "vkCreateFence", result);
     }
@@ -2033,6 +2089,7 @@ CreateFence(VkDevice device, const VkFenceCreateInfo *pCreateInfo, const VkAlloc
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyFence(VkDevice device, VkFence fence, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyFence");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -2040,11 +2097,12 @@ VKAPI_ATTR void VKAPI_CALL DestroyFence(VkDevice device, VkFence fence, const Vk
     skipCall |= parameter_validation_vkDestroyFence(my_data->report_data, fence, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyFence(device, fence, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyFence(device, fence, pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL ResetFences(VkDevice device, uint32_t fenceCount, const VkFence *pFences) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkResetFences");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2053,7 +2111,8 @@ VKAPI_ATTR VkResult VKAPI_CALL ResetFences(VkDevice device, uint32_t fenceCount,
     skipCall |= parameter_validation_vkResetFences(my_data->report_data, fenceCount, pFences);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->ResetFences(device, fenceCount, pFences);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->ResetFences(device, fenceCount,
+                                                                     pFences));
 
         validate_result(my_data->report_data, "vkResetFences", result);
     }
@@ -2062,6 +2121,7 @@ VKAPI_ATTR VkResult VKAPI_CALL ResetFences(VkDevice device, uint32_t fenceCount,
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL GetFenceStatus(VkDevice device, VkFence fence) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetFenceStatus");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2070,7 +2130,7 @@ VKAPI_ATTR VkResult VKAPI_CALL GetFenceStatus(VkDevice device, VkFence fence) {
     skipCall |= parameter_validation_vkGetFenceStatus(my_data->report_data, fence);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->GetFenceStatus(device, fence);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->GetFenceStatus(device, fence));
 
         validate_result(my_data->report_data, "vkGetFenceStatus", result);
     }
@@ -2080,6 +2140,7 @@ VKAPI_ATTR VkResult VKAPI_CALL GetFenceStatus(VkDevice device, VkFence fence) {
 
 VKAPI_ATTR VkResult VKAPI_CALL
 WaitForFences(VkDevice device, uint32_t fenceCount, const VkFence *pFences, VkBool32 waitAll, uint64_t timeout) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkWaitForFences");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2088,7 +2149,8 @@ WaitForFences(VkDevice device, uint32_t fenceCount, const VkFence *pFences, VkBo
     skipCall |= parameter_validation_vkWaitForFences(my_data->report_data, fenceCount, pFences, waitAll, timeout);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->WaitForFences(device, fenceCount, pFences, waitAll, timeout);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->WaitForFences(device, fenceCount,
+                                                                     pFences, waitAll, timeout));
 
         validate_result(my_data->report_data, "vkWaitForFences", result);
     }
@@ -2098,6 +2160,7 @@ WaitForFences(VkDevice device, uint32_t fenceCount, const VkFence *pFences, VkBo
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateSemaphore(VkDevice device, const VkSemaphoreCreateInfo *pCreateInfo,
                                                                  const VkAllocationCallbacks *pAllocator, VkSemaphore *pSemaphore) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateSemaphore");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2106,7 +2169,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateSemaphore(VkDevice device, const VkSemaphor
     skipCall |= parameter_validation_vkCreateSemaphore(my_data->report_data, pCreateInfo, pAllocator, pSemaphore);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->CreateSemaphore(device, pCreateInfo, pAllocator, pSemaphore);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateSemaphore(device,
+                                                                     pCreateInfo, pAllocator, pSemaphore));
 
         validate_result(my_data->report_data, "vkCreateSemaphore", result);
     }
@@ -2116,6 +2180,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateSemaphore(VkDevice device, const VkSemaphor
 
 VKAPI_ATTR void VKAPI_CALL
 DestroySemaphore(VkDevice device, VkSemaphore semaphore, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroySemaphore");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -2123,12 +2188,14 @@ DestroySemaphore(VkDevice device, VkSemaphore semaphore, const VkAllocationCallb
     skipCall |= parameter_validation_vkDestroySemaphore(my_data->report_data, semaphore, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroySemaphore(device, semaphore, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroySemaphore(device, semaphore,
+                                                            pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateEvent(VkDevice device, const VkEventCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkEvent *pEvent) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateEvent");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2137,7 +2204,8 @@ CreateEvent(VkDevice device, const VkEventCreateInfo *pCreateInfo, const VkAlloc
     skipCall |= parameter_validation_vkCreateEvent(my_data->report_data, pCreateInfo, pAllocator, pEvent);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->CreateEvent(device, pCreateInfo, pAllocator, pEvent);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateEvent(device, pCreateInfo,
+                                                                     pAllocator, pEvent));
 
         validate_result(my_data->report_data, "vkCreateEvent", result);
     }
@@ -2146,6 +2214,7 @@ CreateEvent(VkDevice device, const VkEventCreateInfo *pCreateInfo, const VkAlloc
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyEvent(VkDevice device, VkEvent event, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyEvent");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -2153,11 +2222,12 @@ VKAPI_ATTR void VKAPI_CALL DestroyEvent(VkDevice device, VkEvent event, const Vk
     skipCall |= parameter_validation_vkDestroyEvent(my_data->report_data, event, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyEvent(device, event, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyEvent(device, event, pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL GetEventStatus(VkDevice device, VkEvent event) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetEventStatus");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2166,7 +2236,7 @@ VKAPI_ATTR VkResult VKAPI_CALL GetEventStatus(VkDevice device, VkEvent event) {
     skipCall |= parameter_validation_vkGetEventStatus(my_data->report_data, event);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->GetEventStatus(device, event);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->GetEventStatus(device, event));
 
         validate_result(my_data->report_data, "vkGetEventStatus", result);
     }
@@ -2175,6 +2245,7 @@ VKAPI_ATTR VkResult VKAPI_CALL GetEventStatus(VkDevice device, VkEvent event) {
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL SetEvent(VkDevice device, VkEvent event) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkSetEvent");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2183,7 +2254,7 @@ VKAPI_ATTR VkResult VKAPI_CALL SetEvent(VkDevice device, VkEvent event) {
     skipCall |= parameter_validation_vkSetEvent(my_data->report_data, event);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->SetEvent(device, event);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->SetEvent(device, event));
 
         validate_result(my_data->report_data, "vkSetEvent", result);
     }
@@ -2192,6 +2263,7 @@ VKAPI_ATTR VkResult VKAPI_CALL SetEvent(VkDevice device, VkEvent event) {
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL ResetEvent(VkDevice device, VkEvent event) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkResetEvent");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2200,7 +2272,7 @@ VKAPI_ATTR VkResult VKAPI_CALL ResetEvent(VkDevice device, VkEvent event) {
     skipCall |= parameter_validation_vkResetEvent(my_data->report_data, event);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->ResetEvent(device, event);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->ResetEvent(device, event));
 
         validate_result(my_data->report_data, "vkResetEvent", result);
     }
@@ -2210,6 +2282,7 @@ VKAPI_ATTR VkResult VKAPI_CALL ResetEvent(VkDevice device, VkEvent event) {
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateQueryPool(VkDevice device, const VkQueryPoolCreateInfo *pCreateInfo,
                                                 const VkAllocationCallbacks *pAllocator, VkQueryPool *pQueryPool) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateQueryPool");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skip_call = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2233,7 +2306,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateQueryPool(VkDevice device, const VkQueryPoo
     }
 
     if (!skip_call) {
-        result = get_dispatch_table(pc_device_table_map, device)->CreateQueryPool(device, pCreateInfo, pAllocator, pQueryPool);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateQueryPool(device,
+                                                                     pCreateInfo, pAllocator, pQueryPool));
 
         validate_result(report_data, "vkCreateQueryPool", result);
     }
@@ -2243,6 +2317,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateQueryPool(VkDevice device, const VkQueryPoo
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyQueryPool(VkDevice device, VkQueryPool queryPool, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyQueryPool");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -2250,13 +2325,15 @@ DestroyQueryPool(VkDevice device, VkQueryPool queryPool, const VkAllocationCallb
     skipCall |= parameter_validation_vkDestroyQueryPool(my_data->report_data, queryPool, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyQueryPool(device, queryPool, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyQueryPool(device, queryPool,
+                                                            pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL GetQueryPoolResults(VkDevice device, VkQueryPool queryPool, uint32_t firstQuery,
                                                    uint32_t queryCount, size_t dataSize, void *pData,
                                                    VkDeviceSize stride, VkQueryResultFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetQueryPoolResults");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2266,8 +2343,9 @@ VKAPI_ATTR VkResult VKAPI_CALL GetQueryPoolResults(VkDevice device, VkQueryPool
         parameter_validation_vkGetQueryPoolResults(my_data->report_data, queryPool, firstQuery, queryCount, dataSize, pData, stride, flags);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)
-                     ->GetQueryPoolResults(device, queryPool, firstQuery, queryCount, dataSize, pData, stride, flags);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->GetQueryPoolResults(device,
+                                                                     queryPool, firstQuery, queryCount, dataSize, pData, stride,
+                                                                     flags));
 
         validate_result(my_data->report_data, "vkGetQueryPoolResults", result);
     }
@@ -2277,6 +2355,7 @@ VKAPI_ATTR VkResult VKAPI_CALL GetQueryPoolResults(VkDevice device, VkQueryPool
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateBuffer(VkDevice device, const VkBufferCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkBuffer *pBuffer) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateBuffer");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skip_call = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2313,7 +2392,8 @@ CreateBuffer(VkDevice device, const VkBufferCreateInfo *pCreateInfo, const VkAll
     }
 
     if (!skip_call) {
-        result = get_dispatch_table(pc_device_table_map, device)->CreateBuffer(device, pCreateInfo, pAllocator, pBuffer);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateBuffer(device, pCreateInfo,
+                                                                     pAllocator, pBuffer));
 
         validate_result(report_data, "vkCreateBuffer", result);
     }
@@ -2323,6 +2403,7 @@ CreateBuffer(VkDevice device, const VkBufferCreateInfo *pCreateInfo, const VkAll
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyBuffer(VkDevice device, VkBuffer buffer, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyBuffer");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -2330,12 +2411,14 @@ DestroyBuffer(VkDevice device, VkBuffer buffer, const VkAllocationCallbacks *pAl
     skipCall |= parameter_validation_vkDestroyBuffer(my_data->report_data, buffer, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyBuffer(device, buffer, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyBuffer(device, buffer,
+                                                            pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateBufferView(VkDevice device, const VkBufferViewCreateInfo *pCreateInfo,
                                                 const VkAllocationCallbacks *pAllocator, VkBufferView *pView) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateBufferView");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2344,7 +2427,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateBufferView(VkDevice device, const VkBufferV
     skipCall |= parameter_validation_vkCreateBufferView(my_data->report_data, pCreateInfo, pAllocator, pView);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->CreateBufferView(device, pCreateInfo, pAllocator, pView);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateBufferView(device,
+                                                                     pCreateInfo, pAllocator, pView));
 
         validate_result(my_data->report_data, "vkCreateBufferView", result);
     }
@@ -2354,6 +2438,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateBufferView(VkDevice device, const VkBufferV
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyBufferView(VkDevice device, VkBufferView bufferView, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyBufferView");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -2361,12 +2446,14 @@ DestroyBufferView(VkDevice device, VkBufferView bufferView, const VkAllocationCa
     skipCall |= parameter_validation_vkDestroyBufferView(my_data->report_data, bufferView, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyBufferView(device, bufferView, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyBufferView(device, bufferView,
+                                                            pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateImage(VkDevice device, const VkImageCreateInfo *pCreateInfo,
                                            const VkAllocationCallbacks *pAllocator, VkImage *pImage) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateImage");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skip_call = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2464,7 +2551,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateImage(VkDevice device, const VkImageCreateI
     }
 
     if (!skip_call) {
-        result = get_dispatch_table(pc_device_table_map, device)->CreateImage(device, pCreateInfo, pAllocator, pImage);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateImage(device, pCreateInfo,
+                                                                     pAllocator, pImage));
 
         validate_result(report_data, "vkCreateImage", result);
     }
@@ -2473,6 +2561,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateImage(VkDevice device, const VkImageCreateI
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyImage");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -2480,7 +2569,7 @@ VKAPI_ATTR void VKAPI_CALL DestroyImage(VkDevice device, VkImage image, const Vk
     skipCall |= parameter_validation_vkDestroyImage(my_data->report_data, image, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyImage(device, image, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyImage(device, image, pAllocator));
     }
 }
 
@@ -2500,6 +2589,7 @@ bool PreGetImageSubresourceLayout(VkDevice device, const VkImageSubresource *pSu
 
 VKAPI_ATTR void VKAPI_CALL
 GetImageSubresourceLayout(VkDevice device, VkImage image, const VkImageSubresource *pSubresource, VkSubresourceLayout *pLayout) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetImageSubresourceLayout");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -2509,12 +2599,14 @@ GetImageSubresourceLayout(VkDevice device, VkImage image, const VkImageSubresour
     if (!skipCall) {
         PreGetImageSubresourceLayout(device, pSubresource);
 
-        get_dispatch_table(pc_device_table_map, device)->GetImageSubresourceLayout(device, image, pSubresource, pLayout);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->GetImageSubresourceLayout(device, image,
+                                                            pSubresource, pLayout));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateImageView(VkDevice device, const VkImageViewCreateInfo *pCreateInfo,
                                                const VkAllocationCallbacks *pAllocator, VkImageView *pView) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateImageView");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skip_call = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2567,7 +2659,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateImageView(VkDevice device, const VkImageVie
     }
 
     if (!skip_call) {
-        result = get_dispatch_table(pc_device_table_map, device)->CreateImageView(device, pCreateInfo, pAllocator, pView);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateImageView(device,
+                                                                     pCreateInfo, pAllocator, pView));
 
         validate_result(my_data->report_data, "vkCreateImageView", result);
     }
@@ -2577,6 +2670,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateImageView(VkDevice device, const VkImageVie
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyImageView(VkDevice device, VkImageView imageView, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyImageView");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -2584,13 +2678,15 @@ DestroyImageView(VkDevice device, VkImageView imageView, const VkAllocationCallb
     skipCall |= parameter_validation_vkDestroyImageView(my_data->report_data, imageView, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyImageView(device, imageView, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyImageView(device, imageView,
+                                                            pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateShaderModule(VkDevice device, const VkShaderModuleCreateInfo *pCreateInfo,
                                                   const VkAllocationCallbacks *pAllocator,
                                                   VkShaderModule *pShaderModule) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateShaderModule");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2600,7 +2696,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateShaderModule(VkDevice device, const VkShade
 
     if (!skipCall) {
         result =
-            get_dispatch_table(pc_device_table_map, device)->CreateShaderModule(device, pCreateInfo, pAllocator, pShaderModule);
+            LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateShaderModule(device,
+                                                                pCreateInfo, pAllocator, pShaderModule));
 
         validate_result(my_data->report_data, "vkCreateShaderModule", result);
     }
@@ -2610,6 +2707,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateShaderModule(VkDevice device, const VkShade
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyShaderModule(VkDevice device, VkShaderModule shaderModule, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyShaderModule");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -2617,13 +2715,15 @@ DestroyShaderModule(VkDevice device, VkShaderModule shaderModule, const VkAlloca
     skipCall |= parameter_validation_vkDestroyShaderModule(my_data->report_data, shaderModule, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyShaderModule(device, shaderModule, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyShaderModule(device, shaderModule,
+                                                            pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineCache(VkDevice device, const VkPipelineCacheCreateInfo *pCreateInfo,
                                                    const VkAllocationCallbacks *pAllocator,
                                                    VkPipelineCache *pPipelineCache) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreatePipelineCache");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2633,7 +2733,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineCache(VkDevice device, const VkPipe
 
     if (!skipCall) {
         result =
-            get_dispatch_table(pc_device_table_map, device)->CreatePipelineCache(device, pCreateInfo, pAllocator, pPipelineCache);
+            LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreatePipelineCache(device,
+                                                                pCreateInfo, pAllocator, pPipelineCache));
 
         validate_result(my_data->report_data, "vkCreatePipelineCache", result);
     }
@@ -2643,6 +2744,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineCache(VkDevice device, const VkPipe
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyPipelineCache(VkDevice device, VkPipelineCache pipelineCache, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyPipelineCache");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -2650,12 +2752,14 @@ DestroyPipelineCache(VkDevice device, VkPipelineCache pipelineCache, const VkAll
     skipCall |= parameter_validation_vkDestroyPipelineCache(my_data->report_data, pipelineCache, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyPipelineCache(device, pipelineCache, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyPipelineCache(device,
+                                                            pipelineCache, pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 GetPipelineCacheData(VkDevice device, VkPipelineCache pipelineCache, size_t *pDataSize, void *pData) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPipelineCacheData");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2664,7 +2768,8 @@ GetPipelineCacheData(VkDevice device, VkPipelineCache pipelineCache, size_t *pDa
     skipCall |= parameter_validation_vkGetPipelineCacheData(my_data->report_data, pipelineCache, pDataSize, pData);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->GetPipelineCacheData(device, pipelineCache, pDataSize, pData);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->GetPipelineCacheData(device,
+                                                                     pipelineCache, pDataSize, pData));
 
         validate_result(my_data->report_data, "vkGetPipelineCacheData", result);
     }
@@ -2674,6 +2779,7 @@ GetPipelineCacheData(VkDevice device, VkPipelineCache pipelineCache, size_t *pDa
 
 VKAPI_ATTR VkResult VKAPI_CALL
 MergePipelineCaches(VkDevice device, VkPipelineCache dstCache, uint32_t srcCacheCount, const VkPipelineCache *pSrcCaches) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkMergePipelineCaches");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -2682,7 +2788,8 @@ MergePipelineCaches(VkDevice device, VkPipelineCache dstCache, uint32_t srcCache
     skipCall |= parameter_validation_vkMergePipelineCaches(my_data->report_data, dstCache, srcCacheCount, pSrcCaches);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->MergePipelineCaches(device, dstCache, srcCacheCount, pSrcCaches);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->MergePipelineCaches(device,
+                                                                     dstCache, srcCacheCount, pSrcCaches));
 
         validate_result(my_data->report_data, "vkMergePipelineCaches", result);
     }
@@ -2744,6 +2851,7 @@ VKAPI_ATTR VkResult VKAPI_CALL
 CreateGraphicsPipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t createInfoCount,
                         const VkGraphicsPipelineCreateInfo *pCreateInfos, const VkAllocationCallbacks *pAllocator,
                         VkPipeline *pPipelines) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateGraphicsPipelines");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skip_call = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3093,8 +3201,9 @@ CreateGraphicsPipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t
     if (!skip_call) {
         PreCreateGraphicsPipelines(device, pCreateInfos);
 
-        result = get_dispatch_table(pc_device_table_map, device)
-                     ->CreateGraphicsPipelines(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateGraphicsPipelines(device,
+                                                                     pipelineCache, createInfoCount, pCreateInfos, pAllocator,
+                                                                     pPipelines));
 
         validate_result(report_data, "vkCreateGraphicsPipelines", result);
     }
@@ -3118,6 +3227,7 @@ VKAPI_ATTR VkResult VKAPI_CALL
 CreateComputePipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t createInfoCount,
                        const VkComputePipelineCreateInfo *pCreateInfos, const VkAllocationCallbacks *pAllocator,
                        VkPipeline *pPipelines) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateComputePipelines");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3129,8 +3239,9 @@ CreateComputePipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t
     if (!skipCall) {
         PreCreateComputePipelines(device, pCreateInfos);
 
-        result = get_dispatch_table(pc_device_table_map, device)
-                     ->CreateComputePipelines(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateComputePipelines(device,
+                                                                     pipelineCache, createInfoCount, pCreateInfos, pAllocator,
+                                                                     pPipelines));
 
         validate_result(my_data->report_data, "vkCreateComputePipelines", result);
     }
@@ -3140,6 +3251,7 @@ CreateComputePipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyPipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyPipeline");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -3147,13 +3259,15 @@ DestroyPipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallback
     skipCall |= parameter_validation_vkDestroyPipeline(my_data->report_data, pipeline, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyPipeline(device, pipeline, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyPipeline(device, pipeline,
+                                                            pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreatePipelineLayout(VkDevice device, const VkPipelineLayoutCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator,
                      VkPipelineLayout *pPipelineLayout) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreatePipelineLayout");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3163,7 +3277,8 @@ CreatePipelineLayout(VkDevice device, const VkPipelineLayoutCreateInfo *pCreateI
 
     if (!skipCall) {
         result =
-            get_dispatch_table(pc_device_table_map, device)->CreatePipelineLayout(device, pCreateInfo, pAllocator, pPipelineLayout);
+            LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreatePipelineLayout(device,
+                                                                pCreateInfo, pAllocator, pPipelineLayout));
 
         validate_result(my_data->report_data, "vkCreatePipelineLayout", result);
     }
@@ -3173,6 +3288,7 @@ CreatePipelineLayout(VkDevice device, const VkPipelineLayoutCreateInfo *pCreateI
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyPipelineLayout(VkDevice device, VkPipelineLayout pipelineLayout, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyPipelineLayout");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -3180,12 +3296,14 @@ DestroyPipelineLayout(VkDevice device, VkPipelineLayout pipelineLayout, const Vk
     skipCall |= parameter_validation_vkDestroyPipelineLayout(my_data->report_data, pipelineLayout, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyPipelineLayout(device, pipelineLayout, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyPipelineLayout(device,
+                                                            pipelineLayout, pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateSampler(VkDevice device, const VkSamplerCreateInfo *pCreateInfo,
                                              const VkAllocationCallbacks *pAllocator, VkSampler *pSampler) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateSampler");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skip_call = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3213,7 +3331,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateSampler(VkDevice device, const VkSamplerCre
     }
 
     if (!skip_call) {
-        result = get_dispatch_table(pc_device_table_map, device)->CreateSampler(device, pCreateInfo, pAllocator, pSampler);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateSampler(device,
+                                                                     pCreateInfo, pAllocator, pSampler));
 
         validate_result(report_data, "vkCreateSampler", result);
     }
@@ -3223,6 +3342,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateSampler(VkDevice device, const VkSamplerCre
 
 VKAPI_ATTR void VKAPI_CALL
 DestroySampler(VkDevice device, VkSampler sampler, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroySampler");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -3230,13 +3350,15 @@ DestroySampler(VkDevice device, VkSampler sampler, const VkAllocationCallbacks *
     skipCall |= parameter_validation_vkDestroySampler(my_data->report_data, sampler, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroySampler(device, sampler, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroySampler(device, sampler,
+                                                            pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateDescriptorSetLayout(VkDevice device, const VkDescriptorSetLayoutCreateInfo *pCreateInfo,
                           const VkAllocationCallbacks *pAllocator, VkDescriptorSetLayout *pSetLayout) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDescriptorSetLayout");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skip_call = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3284,7 +3406,8 @@ CreateDescriptorSetLayout(VkDevice device, const VkDescriptorSetLayoutCreateInfo
 
     if (!skip_call) {
         result =
-            get_dispatch_table(pc_device_table_map, device)->CreateDescriptorSetLayout(device, pCreateInfo, pAllocator, pSetLayout);
+            LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateDescriptorSetLayout(device,
+                                                                pCreateInfo, pAllocator, pSetLayout));
 
         validate_result(report_data, "vkCreateDescriptorSetLayout", result);
     }
@@ -3294,6 +3417,7 @@ CreateDescriptorSetLayout(VkDevice device, const VkDescriptorSetLayoutCreateInfo
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyDescriptorSetLayout(VkDevice device, VkDescriptorSetLayout descriptorSetLayout, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDescriptorSetLayout");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -3301,13 +3425,15 @@ DestroyDescriptorSetLayout(VkDevice device, VkDescriptorSetLayout descriptorSetL
     skipCall |= parameter_validation_vkDestroyDescriptorSetLayout(my_data->report_data, descriptorSetLayout, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyDescriptorSetLayout(device, descriptorSetLayout, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyDescriptorSetLayout(device,
+                                                            descriptorSetLayout, pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateDescriptorPool(VkDevice device, const VkDescriptorPoolCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator,
                      VkDescriptorPool *pDescriptorPool) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDescriptorPool");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3319,7 +3445,8 @@ CreateDescriptorPool(VkDevice device, const VkDescriptorPoolCreateInfo *pCreateI
 
     if (!skipCall) {
         result =
-            get_dispatch_table(pc_device_table_map, device)->CreateDescriptorPool(device, pCreateInfo, pAllocator, pDescriptorPool);
+            LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateDescriptorPool(device,
+                                                                pCreateInfo, pAllocator, pDescriptorPool));
 
         validate_result(my_data->report_data, "vkCreateDescriptorPool", result);
     }
@@ -3329,6 +3456,7 @@ CreateDescriptorPool(VkDevice device, const VkDescriptorPoolCreateInfo *pCreateI
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDescriptorPool");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -3336,12 +3464,14 @@ DestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool, const Vk
     skipCall |= parameter_validation_vkDestroyDescriptorPool(my_data->report_data, descriptorPool, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyDescriptorPool(device, descriptorPool, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyDescriptorPool(device,
+                                                            descriptorPool, pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 ResetDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool, VkDescriptorPoolResetFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkResetDescriptorPool");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3350,7 +3480,8 @@ ResetDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool, VkDescript
     skipCall |= parameter_validation_vkResetDescriptorPool(my_data->report_data, descriptorPool, flags);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->ResetDescriptorPool(device, descriptorPool, flags);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->ResetDescriptorPool(device,
+                                                                     descriptorPool, flags));
 
         validate_result(my_data->report_data, "vkResetDescriptorPool", result);
     }
@@ -3360,6 +3491,7 @@ ResetDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool, VkDescript
 
 VKAPI_ATTR VkResult VKAPI_CALL
 AllocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo *pAllocateInfo, VkDescriptorSet *pDescriptorSets) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkAllocateDescriptorSets");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3368,7 +3500,8 @@ AllocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo *pAllo
     skipCall |= parameter_validation_vkAllocateDescriptorSets(my_data->report_data, pAllocateInfo, pDescriptorSets);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->AllocateDescriptorSets(device, pAllocateInfo, pDescriptorSets);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->AllocateDescriptorSets(device,
+                                                                     pAllocateInfo, pDescriptorSets));
 
         validate_result(my_data->report_data, "vkAllocateDescriptorSets", result);
     }
@@ -3379,6 +3512,7 @@ AllocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo *pAllo
 VKAPI_ATTR VkResult VKAPI_CALL FreeDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool,
                                                   uint32_t descriptorSetCount,
                                                   const VkDescriptorSet *pDescriptorSets) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkFreeDescriptorSets");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skip_call = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3394,8 +3528,8 @@ VKAPI_ATTR VkResult VKAPI_CALL FreeDescriptorSets(VkDevice device, VkDescriptorP
                                 pDescriptorSets, true, true);
 
     if (!skip_call) {
-        result = get_dispatch_table(pc_device_table_map, device)
-                     ->FreeDescriptorSets(device, descriptorPool, descriptorSetCount, pDescriptorSets);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->FreeDescriptorSets(device,
+                                                                     descriptorPool, descriptorSetCount, pDescriptorSets));
 
         validate_result(report_data, "vkFreeDescriptorSets", result);
     }
@@ -3406,6 +3540,7 @@ VKAPI_ATTR VkResult VKAPI_CALL FreeDescriptorSets(VkDevice device, VkDescriptorP
 VKAPI_ATTR void VKAPI_CALL
 UpdateDescriptorSets(VkDevice device, uint32_t descriptorWriteCount, const VkWriteDescriptorSet *pDescriptorWrites,
                      uint32_t descriptorCopyCount, const VkCopyDescriptorSet *pDescriptorCopies) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkUpdateDescriptorSets");
     bool skip_call = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(device_data != NULL);
@@ -3502,14 +3637,16 @@ UpdateDescriptorSets(VkDevice device, uint32_t descriptorWriteCount, const VkWri
     }
 
     if (!skip_call) {
-        get_dispatch_table(pc_device_table_map, device)
-            ->UpdateDescriptorSets(device, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount, pDescriptorCopies);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->UpdateDescriptorSets(device,
+                                                            descriptorWriteCount, pDescriptorWrites, descriptorCopyCount,
+                                                            pDescriptorCopies));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateFramebuffer(VkDevice device, const VkFramebufferCreateInfo *pCreateInfo,
                                                  const VkAllocationCallbacks *pAllocator,
                                                                    VkFramebuffer *pFramebuffer) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateFramebuffer");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3518,7 +3655,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateFramebuffer(VkDevice device, const VkFrameb
     skipCall |= parameter_validation_vkCreateFramebuffer(my_data->report_data, pCreateInfo, pAllocator, pFramebuffer);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->CreateFramebuffer(device, pCreateInfo, pAllocator, pFramebuffer);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateFramebuffer(device,
+                                                                     pCreateInfo, pAllocator, pFramebuffer));
 
         validate_result(my_data->report_data, "vkCreateFramebuffer", result);
     }
@@ -3528,6 +3666,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateFramebuffer(VkDevice device, const VkFrameb
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyFramebuffer(VkDevice device, VkFramebuffer framebuffer, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyFramebuffer");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -3535,13 +3674,15 @@ DestroyFramebuffer(VkDevice device, VkFramebuffer framebuffer, const VkAllocatio
     skipCall |= parameter_validation_vkDestroyFramebuffer(my_data->report_data, framebuffer, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyFramebuffer(device, framebuffer, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyFramebuffer(device, framebuffer,
+                                                            pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass(VkDevice device, const VkRenderPassCreateInfo *pCreateInfo,
                                                 const VkAllocationCallbacks *pAllocator,
                                                 VkRenderPass *pRenderPass) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateRenderPass");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3550,7 +3691,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass(VkDevice device, const VkRenderP
     skipCall |= parameter_validation_vkCreateRenderPass(my_data->report_data, pCreateInfo, pAllocator, pRenderPass);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->CreateRenderPass(device, pCreateInfo, pAllocator, pRenderPass);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateRenderPass(device,
+                                                                     pCreateInfo, pAllocator, pRenderPass));
 
         validate_result(my_data->report_data, "vkCreateRenderPass", result);
     }
@@ -3560,6 +3702,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass(VkDevice device, const VkRenderP
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyRenderPass(VkDevice device, VkRenderPass renderPass, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyRenderPass");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -3567,12 +3710,14 @@ DestroyRenderPass(VkDevice device, VkRenderPass renderPass, const VkAllocationCa
     skipCall |= parameter_validation_vkDestroyRenderPass(my_data->report_data, renderPass, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyRenderPass(device, renderPass, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyRenderPass(device, renderPass,
+                                                            pAllocator));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 GetRenderAreaGranularity(VkDevice device, VkRenderPass renderPass, VkExtent2D *pGranularity) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetRenderAreaGranularity");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -3580,13 +3725,15 @@ GetRenderAreaGranularity(VkDevice device, VkRenderPass renderPass, VkExtent2D *p
     skipCall |= parameter_validation_vkGetRenderAreaGranularity(my_data->report_data, renderPass, pGranularity);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->GetRenderAreaGranularity(device, renderPass, pGranularity);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->GetRenderAreaGranularity(device,
+                                                            renderPass, pGranularity));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateCommandPool(VkDevice device, const VkCommandPoolCreateInfo *pCreateInfo,
                                                  const VkAllocationCallbacks *pAllocator,
                                                  VkCommandPool *pCommandPool) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateCommandPool");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3598,7 +3745,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateCommandPool(VkDevice device, const VkComman
     skipCall |= parameter_validation_vkCreateCommandPool(my_data->report_data, pCreateInfo, pAllocator, pCommandPool);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->CreateCommandPool(device, pCreateInfo, pAllocator, pCommandPool);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->CreateCommandPool(device,
+                                                                     pCreateInfo, pAllocator, pCommandPool));
 
         validate_result(my_data->report_data, "vkCreateCommandPool", result);
     }
@@ -3608,6 +3756,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateCommandPool(VkDevice device, const VkComman
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyCommandPool(VkDevice device, VkCommandPool commandPool, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyCommandPool");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(my_data != NULL);
@@ -3615,12 +3764,14 @@ DestroyCommandPool(VkDevice device, VkCommandPool commandPool, const VkAllocatio
     skipCall |= parameter_validation_vkDestroyCommandPool(my_data->report_data, commandPool, pAllocator);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, device)->DestroyCommandPool(device, commandPool, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->DestroyCommandPool(device, commandPool,
+                                                            pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 ResetCommandPool(VkDevice device, VkCommandPool commandPool, VkCommandPoolResetFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkResetCommandPool");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3629,7 +3780,8 @@ ResetCommandPool(VkDevice device, VkCommandPool commandPool, VkCommandPoolResetF
     skipCall |= parameter_validation_vkResetCommandPool(my_data->report_data, commandPool, flags);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->ResetCommandPool(device, commandPool, flags);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->ResetCommandPool(device,
+                                                                     commandPool, flags));
 
         validate_result(my_data->report_data, "vkResetCommandPool", result);
     }
@@ -3639,6 +3791,7 @@ ResetCommandPool(VkDevice device, VkCommandPool commandPool, VkCommandPoolResetF
 
 VKAPI_ATTR VkResult VKAPI_CALL
 AllocateCommandBuffers(VkDevice device, const VkCommandBufferAllocateInfo *pAllocateInfo, VkCommandBuffer *pCommandBuffers) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkAllocateCommandBuffers");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -3647,7 +3800,8 @@ AllocateCommandBuffers(VkDevice device, const VkCommandBufferAllocateInfo *pAllo
     skipCall |= parameter_validation_vkAllocateCommandBuffers(my_data->report_data, pAllocateInfo, pCommandBuffers);
 
     if (!skipCall) {
-        result = get_dispatch_table(pc_device_table_map, device)->AllocateCommandBuffers(device, pAllocateInfo, pCommandBuffers);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->AllocateCommandBuffers(device,
+                                                                     pAllocateInfo, pCommandBuffers));
 
         validate_result(my_data->report_data, "vkAllocateCommandBuffers", result);
     }
@@ -3658,6 +3812,7 @@ AllocateCommandBuffers(VkDevice device, const VkCommandBufferAllocateInfo *pAllo
 VKAPI_ATTR void VKAPI_CALL FreeCommandBuffers(VkDevice device, VkCommandPool commandPool,
                                               uint32_t commandBufferCount,
                                               const VkCommandBuffer *pCommandBuffers) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkFreeCommandBuffers");
     bool skip_call = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     assert(device_data != nullptr);
@@ -3672,13 +3827,14 @@ VKAPI_ATTR void VKAPI_CALL FreeCommandBuffers(VkDevice device, VkCommandPool com
                                 pCommandBuffers, true, true);
 
     if (!skip_call) {
-        get_dispatch_table(pc_device_table_map, device)
-            ->FreeCommandBuffers(device, commandPool, commandBufferCount, pCommandBuffers);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->FreeCommandBuffers(device, commandPool,
+                                                            commandBufferCount, pCommandBuffers));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 BeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo *pBeginInfo) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkBeginCommandBuffer");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     bool skip_call = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
@@ -3711,7 +3867,8 @@ BeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo
     }
 
     if (!skip_call) {
-        result = get_dispatch_table(pc_device_table_map, commandBuffer)->BeginCommandBuffer(commandBuffer, pBeginInfo);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map,
+                                                                     commandBuffer)->BeginCommandBuffer(commandBuffer, pBeginInfo));
 
         validate_result(report_data, "vkBeginCommandBuffer", result);
     }
@@ -3720,10 +3877,12 @@ BeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL EndCommandBuffer(VkCommandBuffer commandBuffer) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEndCommandBuffer");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
 
-    VkResult result = get_dispatch_table(pc_device_table_map, commandBuffer)->EndCommandBuffer(commandBuffer);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map,
+                                                                          commandBuffer)->EndCommandBuffer(commandBuffer));
 
     validate_result(my_data->report_data, "vkEndCommandBuffer", result);
 
@@ -3732,6 +3891,7 @@ VKAPI_ATTR VkResult VKAPI_CALL EndCommandBuffer(VkCommandBuffer commandBuffer) {
 
 VKAPI_ATTR VkResult VKAPI_CALL
 ResetCommandBuffer(VkCommandBuffer commandBuffer, VkCommandBufferResetFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkResetCommandBuffer");
     VkResult result = VK_ERROR_VALIDATION_FAILED_EXT;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3739,7 +3899,8 @@ ResetCommandBuffer(VkCommandBuffer commandBuffer, VkCommandBufferResetFlags flag
     bool skip_call = parameter_validation_vkResetCommandBuffer(my_data->report_data, flags);
 
     if (!skip_call) {
-        result = get_dispatch_table(pc_device_table_map, commandBuffer)->ResetCommandBuffer(commandBuffer, flags);
+        result = LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map,
+                                                                     commandBuffer)->ResetCommandBuffer(commandBuffer, flags));
 
         validate_result(my_data->report_data, "vkResetCommandBuffer", result);
     }
@@ -3749,6 +3910,7 @@ ResetCommandBuffer(VkCommandBuffer commandBuffer, VkCommandBufferResetFlags flag
 
 VKAPI_ATTR void VKAPI_CALL
 CmdBindPipeline(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipeline pipeline) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBindPipeline");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3756,12 +3918,14 @@ CmdBindPipeline(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindP
     skipCall |= parameter_validation_vkCmdBindPipeline(my_data->report_data, pipelineBindPoint, pipeline);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdBindPipeline(commandBuffer, pipelineBindPoint, pipeline);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdBindPipeline(commandBuffer,
+                                                            pipelineBindPoint, pipeline));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetViewport(VkCommandBuffer commandBuffer, uint32_t firstViewport, uint32_t viewportCount, const VkViewport *pViewports) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetViewport");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3769,13 +3933,14 @@ CmdSetViewport(VkCommandBuffer commandBuffer, uint32_t firstViewport, uint32_t v
     skipCall |= parameter_validation_vkCmdSetViewport(my_data->report_data, firstViewport, viewportCount, pViewports);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdSetViewport(commandBuffer, firstViewport, viewportCount, pViewports);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetViewport(commandBuffer,
+                                                            firstViewport, viewportCount, pViewports));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetScissor(VkCommandBuffer commandBuffer, uint32_t firstScissor, uint32_t scissorCount, const VkRect2D *pScissors) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetScissor");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3783,21 +3948,26 @@ CmdSetScissor(VkCommandBuffer commandBuffer, uint32_t firstScissor, uint32_t sci
     skipCall |= parameter_validation_vkCmdSetScissor(my_data->report_data, firstScissor, scissorCount, pScissors);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetScissor(commandBuffer, firstScissor, scissorCount, pScissors);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetScissor(commandBuffer,
+                                                            firstScissor, scissorCount, pScissors));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdSetLineWidth(VkCommandBuffer commandBuffer, float lineWidth) {
-    get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetLineWidth(commandBuffer, lineWidth);
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetLineWidth");
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetLineWidth(commandBuffer,
+                                                        lineWidth));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetDepthBias(VkCommandBuffer commandBuffer, float depthBiasConstantFactor, float depthBiasClamp, float depthBiasSlopeFactor) {
-    get_dispatch_table(pc_device_table_map, commandBuffer)
-        ->CmdSetDepthBias(commandBuffer, depthBiasConstantFactor, depthBiasClamp, depthBiasSlopeFactor);
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetDepthBias");
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetDepthBias(commandBuffer,
+                                                        depthBiasConstantFactor, depthBiasClamp, depthBiasSlopeFactor));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdSetBlendConstants(VkCommandBuffer commandBuffer, const float blendConstants[4]) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetBlendConstants");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3805,17 +3975,21 @@ VKAPI_ATTR void VKAPI_CALL CmdSetBlendConstants(VkCommandBuffer commandBuffer, c
     skipCall |= parameter_validation_vkCmdSetBlendConstants(my_data->report_data, blendConstants);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetBlendConstants(commandBuffer, blendConstants);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetBlendConstants(commandBuffer,
+                                                            blendConstants));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetDepthBounds(VkCommandBuffer commandBuffer, float minDepthBounds, float maxDepthBounds) {
-    get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetDepthBounds(commandBuffer, minDepthBounds, maxDepthBounds);
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetDepthBounds");
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetDepthBounds(commandBuffer,
+                                                        minDepthBounds, maxDepthBounds));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetStencilCompareMask(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceMask, uint32_t compareMask) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetStencilCompareMask");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3823,12 +3997,14 @@ CmdSetStencilCompareMask(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceM
     skipCall |= parameter_validation_vkCmdSetStencilCompareMask(my_data->report_data, faceMask, compareMask);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetStencilCompareMask(commandBuffer, faceMask, compareMask);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+            pc_device_table_map, commandBuffer)->CmdSetStencilCompareMask(commandBuffer, faceMask, compareMask));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetStencilWriteMask(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceMask, uint32_t writeMask) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetStencilWriteMask");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3836,12 +4012,14 @@ CmdSetStencilWriteMask(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceMas
     skipCall |= parameter_validation_vkCmdSetStencilWriteMask(my_data->report_data, faceMask, writeMask);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetStencilWriteMask(commandBuffer, faceMask, writeMask);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+            pc_device_table_map, commandBuffer)->CmdSetStencilWriteMask(commandBuffer, faceMask, writeMask));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetStencilReference(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceMask, uint32_t reference) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetStencilReference");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3849,7 +4027,8 @@ CmdSetStencilReference(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceMas
     skipCall |= parameter_validation_vkCmdSetStencilReference(my_data->report_data, faceMask, reference);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetStencilReference(commandBuffer, faceMask, reference);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+            pc_device_table_map, commandBuffer)->CmdSetStencilReference(commandBuffer, faceMask, reference));
     }
 }
 
@@ -3857,6 +4036,7 @@ VKAPI_ATTR void VKAPI_CALL
 CmdBindDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout layout,
                       uint32_t firstSet, uint32_t descriptorSetCount, const VkDescriptorSet *pDescriptorSets,
                       uint32_t dynamicOffsetCount, const uint32_t *pDynamicOffsets) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBindDescriptorSets");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3865,14 +4045,15 @@ CmdBindDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelin
                                                     pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdBindDescriptorSets(commandBuffer, pipelineBindPoint, layout, firstSet, descriptorSetCount, pDescriptorSets,
-                                    dynamicOffsetCount, pDynamicOffsets);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+            pc_device_table_map, commandBuffer)->CmdBindDescriptorSets(commandBuffer, pipelineBindPoint, layout, firstSet,
+            descriptorSetCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdBindIndexBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBindIndexBuffer");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3880,13 +4061,15 @@ CmdBindIndexBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize
     skipCall |= parameter_validation_vkCmdBindIndexBuffer(my_data->report_data, buffer, offset, indexType);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdBindIndexBuffer(commandBuffer, buffer, offset, indexType);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdBindIndexBuffer(commandBuffer,
+                                                            buffer, offset, indexType));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdBindVertexBuffers(VkCommandBuffer commandBuffer, uint32_t firstBinding,
                                                 uint32_t bindingCount, const VkBuffer *pBuffers,
                                                 const VkDeviceSize *pOffsets) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBindVertexBuffers");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3894,8 +4077,8 @@ VKAPI_ATTR void VKAPI_CALL CmdBindVertexBuffers(VkCommandBuffer commandBuffer, u
     skipCall |= parameter_validation_vkCmdBindVertexBuffers(my_data->report_data, firstBinding, bindingCount, pBuffers, pOffsets);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdBindVertexBuffers(commandBuffer, firstBinding, bindingCount, pBuffers, pOffsets);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdBindVertexBuffers(commandBuffer,
+                                                            firstBinding, bindingCount, pBuffers, pOffsets));
     }
 }
 
@@ -3922,21 +4105,24 @@ bool PreCmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t in
 
 VKAPI_ATTR void VKAPI_CALL CmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t instanceCount,
                                    uint32_t firstVertex, uint32_t firstInstance) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdDraw");
     PreCmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
 
-    get_dispatch_table(pc_device_table_map, commandBuffer)
-        ->CmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdDraw(commandBuffer, vertexCount,
+                                                        instanceCount, firstVertex, firstInstance));
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdDrawIndexed(VkCommandBuffer commandBuffer, uint32_t indexCount,
                                           uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset,
                                           uint32_t firstInstance) {
-    get_dispatch_table(pc_device_table_map, commandBuffer)
-        ->CmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdDrawIndexed");
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdDrawIndexed(commandBuffer,
+                                                        indexCount, instanceCount, firstIndex, vertexOffset, firstInstance));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdDrawIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, uint32_t count, uint32_t stride) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdDrawIndirect");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3944,12 +4130,14 @@ CmdDrawIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize off
     skipCall |= parameter_validation_vkCmdDrawIndirect(my_data->report_data, buffer, offset, count, stride);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdDrawIndirect(commandBuffer, buffer, offset, count, stride);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdDrawIndirect(commandBuffer,
+                                                            buffer, offset, count, stride));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdDrawIndexedIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, uint32_t count, uint32_t stride) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdDrawIndexedIndirect");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3957,17 +4145,19 @@ CmdDrawIndexedIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceS
     skipCall |= parameter_validation_vkCmdDrawIndexedIndirect(my_data->report_data, buffer, offset, count, stride);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdDrawIndexedIndirect(commandBuffer, buffer, offset, count, stride);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+            pc_device_table_map, commandBuffer)->CmdDrawIndexedIndirect(commandBuffer, buffer, offset, count, stride));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdDispatch(VkCommandBuffer commandBuffer, uint32_t x, uint32_t y, uint32_t z) {
-    get_dispatch_table(pc_device_table_map, commandBuffer)->CmdDispatch(commandBuffer, x, y, z);
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdDispatch");
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdDispatch(commandBuffer, x, y, z));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdDispatchIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdDispatchIndirect");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3975,12 +4165,14 @@ CmdDispatchIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize
     skipCall |= parameter_validation_vkCmdDispatchIndirect(my_data->report_data, buffer, offset);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdDispatchIndirect(commandBuffer, buffer, offset);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdDispatchIndirect(commandBuffer,
+                                                            buffer, offset));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdCopyBuffer(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkBuffer dstBuffer,
                                          uint32_t regionCount, const VkBufferCopy *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdCopyBuffer");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -3988,8 +4180,8 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyBuffer(VkCommandBuffer commandBuffer, VkBuffer
     skipCall |= parameter_validation_vkCmdCopyBuffer(my_data->report_data, srcBuffer, dstBuffer, regionCount, pRegions);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, regionCount, pRegions);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdCopyBuffer(commandBuffer,
+                                                            srcBuffer, dstBuffer, regionCount, pRegions));
     }
 }
 
@@ -4017,6 +4209,7 @@ bool PreCmdCopyImage(VkCommandBuffer commandBuffer, const VkImageCopy *pRegions)
 VKAPI_ATTR void VKAPI_CALL
 CmdCopyImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage,
              VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageCopy *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdCopyImage");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4027,8 +4220,9 @@ CmdCopyImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcI
     if (!skipCall) {
         PreCmdCopyImage(commandBuffer, pRegions);
 
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdCopyImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdCopyImage(commandBuffer,
+                                                            srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount,
+                                                            pRegions));
     }
 }
 
@@ -4056,6 +4250,7 @@ bool PreCmdBlitImage(VkCommandBuffer commandBuffer, const VkImageBlit *pRegions)
 VKAPI_ATTR void VKAPI_CALL
 CmdBlitImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage,
              VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageBlit *pRegions, VkFilter filter) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBlitImage");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4066,8 +4261,9 @@ CmdBlitImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcI
     if (!skipCall) {
         PreCmdBlitImage(commandBuffer, pRegions);
 
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdBlitImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions, filter);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdBlitImage(commandBuffer,
+                                                            srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount,
+                                                            pRegions, filter));
     }
 }
 
@@ -4089,6 +4285,7 @@ bool PreCmdCopyBufferToImage(VkCommandBuffer commandBuffer, const VkBufferImageC
 VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer srcBuffer,
                                                 VkImage dstImage, VkImageLayout dstImageLayout,
                                                 uint32_t regionCount, const VkBufferImageCopy *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdCopyBufferToImage");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4099,8 +4296,8 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImage(VkCommandBuffer commandBuffer, V
     if (!skipCall) {
         PreCmdCopyBufferToImage(commandBuffer, pRegions);
 
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdCopyBufferToImage(commandBuffer, srcBuffer, dstImage, dstImageLayout, regionCount, pRegions);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdCopyBufferToImage(commandBuffer,
+                                                            srcBuffer, dstImage, dstImageLayout, regionCount, pRegions));
     }
 }
 
@@ -4122,6 +4319,7 @@ bool PreCmdCopyImageToBuffer(VkCommandBuffer commandBuffer, const VkBufferImageC
 VKAPI_ATTR void VKAPI_CALL CmdCopyImageToBuffer(VkCommandBuffer commandBuffer, VkImage srcImage,
                                                 VkImageLayout srcImageLayout, VkBuffer dstBuffer,
                                                 uint32_t regionCount, const VkBufferImageCopy *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdCopyImageToBuffer");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4132,13 +4330,14 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyImageToBuffer(VkCommandBuffer commandBuffer, V
     if (!skipCall) {
         PreCmdCopyImageToBuffer(commandBuffer, pRegions);
 
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdCopyImageToBuffer(commandBuffer, srcImage, srcImageLayout, dstBuffer, regionCount, pRegions);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdCopyImageToBuffer(commandBuffer,
+                                                            srcImage, srcImageLayout, dstBuffer, regionCount, pRegions));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdUpdateBuffer(VkCommandBuffer commandBuffer, VkBuffer dstBuffer,
                                            VkDeviceSize dstOffset, VkDeviceSize dataSize, const uint32_t *pData) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdUpdateBuffer");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4146,13 +4345,14 @@ VKAPI_ATTR void VKAPI_CALL CmdUpdateBuffer(VkCommandBuffer commandBuffer, VkBuff
     skipCall |= parameter_validation_vkCmdUpdateBuffer(my_data->report_data, dstBuffer, dstOffset, dataSize, pData);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdUpdateBuffer(commandBuffer, dstBuffer, dstOffset, dataSize, pData);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdUpdateBuffer(commandBuffer,
+                                                            dstBuffer, dstOffset, dataSize, pData));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdFillBuffer(VkCommandBuffer commandBuffer, VkBuffer dstBuffer, VkDeviceSize dstOffset, VkDeviceSize size, uint32_t data) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdFillBuffer");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4160,13 +4360,15 @@ CmdFillBuffer(VkCommandBuffer commandBuffer, VkBuffer dstBuffer, VkDeviceSize ds
     skipCall |= parameter_validation_vkCmdFillBuffer(my_data->report_data, dstBuffer, dstOffset, size, data);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdFillBuffer(commandBuffer, dstBuffer, dstOffset, size, data);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdFillBuffer(commandBuffer,
+                                                            dstBuffer, dstOffset, size, data));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdClearColorImage(VkCommandBuffer commandBuffer, VkImage image,
                                               VkImageLayout imageLayout, const VkClearColorValue *pColor,
                                               uint32_t rangeCount, const VkImageSubresourceRange *pRanges) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdClearColorImage");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4174,8 +4376,8 @@ VKAPI_ATTR void VKAPI_CALL CmdClearColorImage(VkCommandBuffer commandBuffer, VkI
     skipCall |= parameter_validation_vkCmdClearColorImage(my_data->report_data, image, imageLayout, pColor, rangeCount, pRanges);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdClearColorImage(commandBuffer, image, imageLayout, pColor, rangeCount, pRanges);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdClearColorImage(commandBuffer,
+                                                            image, imageLayout, pColor, rangeCount, pRanges));
     }
 }
 
@@ -4183,6 +4385,7 @@ VKAPI_ATTR void VKAPI_CALL
 CmdClearDepthStencilImage(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout imageLayout,
                           const VkClearDepthStencilValue *pDepthStencil, uint32_t rangeCount,
                           const VkImageSubresourceRange *pRanges) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdClearDepthStencilImage");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4191,14 +4394,16 @@ CmdClearDepthStencilImage(VkCommandBuffer commandBuffer, VkImage image, VkImageL
         parameter_validation_vkCmdClearDepthStencilImage(my_data->report_data, image, imageLayout, pDepthStencil, rangeCount, pRanges);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdClearDepthStencilImage(commandBuffer, image, imageLayout, pDepthStencil, rangeCount, pRanges);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map,
+                                                            commandBuffer)->CmdClearDepthStencilImage(commandBuffer, image,
+                                                            imageLayout, pDepthStencil, rangeCount, pRanges));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdClearAttachments(VkCommandBuffer commandBuffer, uint32_t attachmentCount,
                                                const VkClearAttachment *pAttachments, uint32_t rectCount,
                                                const VkClearRect *pRects) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdClearAttachments");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4206,8 +4411,8 @@ VKAPI_ATTR void VKAPI_CALL CmdClearAttachments(VkCommandBuffer commandBuffer, ui
     skipCall |= parameter_validation_vkCmdClearAttachments(my_data->report_data, attachmentCount, pAttachments, rectCount, pRects);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdClearAttachments(commandBuffer, attachmentCount, pAttachments, rectCount, pRects);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdClearAttachments(commandBuffer,
+                                                            attachmentCount, pAttachments, rectCount, pRects));
     }
 }
 
@@ -4237,6 +4442,7 @@ bool PreCmdResolveImage(VkCommandBuffer commandBuffer, const VkImageResolve *pRe
 VKAPI_ATTR void VKAPI_CALL
 CmdResolveImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage,
                 VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageResolve *pRegions) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdResolveImage");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4247,13 +4453,15 @@ CmdResolveImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout s
     if (!skipCall) {
         PreCmdResolveImage(commandBuffer, pRegions);
 
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdResolveImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdResolveImage(commandBuffer,
+                                                            srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount,
+                                                            pRegions));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdSetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags stageMask) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdSetEvent");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4261,12 +4469,14 @@ CmdSetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags s
     skipCall |= parameter_validation_vkCmdSetEvent(my_data->report_data, event, stageMask);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetEvent(commandBuffer, event, stageMask);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdSetEvent(commandBuffer, event,
+                                                            stageMask));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdResetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags stageMask) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdResetEvent");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4274,7 +4484,8 @@ CmdResetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags
     skipCall |= parameter_validation_vkCmdResetEvent(my_data->report_data, event, stageMask);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdResetEvent(commandBuffer, event, stageMask);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdResetEvent(commandBuffer, event,
+                                                            stageMask));
     }
 }
 
@@ -4283,6 +4494,7 @@ CmdWaitEvents(VkCommandBuffer commandBuffer, uint32_t eventCount, const VkEvent
               VkPipelineStageFlags dstStageMask, uint32_t memoryBarrierCount, const VkMemoryBarrier *pMemoryBarriers,
               uint32_t bufferMemoryBarrierCount, const VkBufferMemoryBarrier *pBufferMemoryBarriers,
               uint32_t imageMemoryBarrierCount, const VkImageMemoryBarrier *pImageMemoryBarriers) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdWaitEvents");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4292,9 +4504,10 @@ CmdWaitEvents(VkCommandBuffer commandBuffer, uint32_t eventCount, const VkEvent
                                             imageMemoryBarrierCount, pImageMemoryBarriers);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdWaitEvents(commandBuffer, eventCount, pEvents, srcStageMask, dstStageMask, memoryBarrierCount, pMemoryBarriers,
-                            bufferMemoryBarrierCount, pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdWaitEvents(commandBuffer,
+                                                            eventCount, pEvents, srcStageMask, dstStageMask, memoryBarrierCount,
+                                                            pMemoryBarriers, bufferMemoryBarrierCount, pBufferMemoryBarriers,
+                                                            imageMemoryBarrierCount, pImageMemoryBarriers));
     }
 }
 
@@ -4303,6 +4516,7 @@ CmdPipelineBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStageM
                    VkDependencyFlags dependencyFlags, uint32_t memoryBarrierCount, const VkMemoryBarrier *pMemoryBarriers,
                    uint32_t bufferMemoryBarrierCount, const VkBufferMemoryBarrier *pBufferMemoryBarriers,
                    uint32_t imageMemoryBarrierCount, const VkImageMemoryBarrier *pImageMemoryBarriers) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdPipelineBarrier");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4312,14 +4526,16 @@ CmdPipelineBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStageM
                                                  pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, dependencyFlags, memoryBarrierCount, pMemoryBarriers,
-                                 bufferMemoryBarrierCount, pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdPipelineBarrier(commandBuffer,
+                                                            srcStageMask, dstStageMask, dependencyFlags, memoryBarrierCount,
+                                                            pMemoryBarriers, bufferMemoryBarrierCount, pBufferMemoryBarriers,
+                                                            imageMemoryBarrierCount, pImageMemoryBarriers));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdBeginQuery(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t slot, VkQueryControlFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBeginQuery");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4327,11 +4543,13 @@ CmdBeginQuery(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t slo
     skipCall |= parameter_validation_vkCmdBeginQuery(my_data->report_data, queryPool, slot, flags);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdBeginQuery(commandBuffer, queryPool, slot, flags);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdBeginQuery(commandBuffer,
+                                                            queryPool, slot, flags));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdEndQuery(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t slot) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdEndQuery");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4339,12 +4557,14 @@ VKAPI_ATTR void VKAPI_CALL CmdEndQuery(VkCommandBuffer commandBuffer, VkQueryPoo
     skipCall |= parameter_validation_vkCmdEndQuery(my_data->report_data, queryPool, slot);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdEndQuery(commandBuffer, queryPool, slot);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdEndQuery(commandBuffer,
+                                                            queryPool, slot));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdResetQueryPool(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t firstQuery, uint32_t queryCount) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdResetQueryPool");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4352,7 +4572,8 @@ CmdResetQueryPool(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t
     skipCall |= parameter_validation_vkCmdResetQueryPool(my_data->report_data, queryPool, firstQuery, queryCount);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdResetQueryPool(commandBuffer, queryPool, firstQuery, queryCount);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdResetQueryPool(commandBuffer,
+                                                            queryPool, firstQuery, queryCount));
     }
 }
 
@@ -4366,6 +4587,7 @@ bool PostCmdWriteTimestamp(VkCommandBuffer commandBuffer, VkPipelineStageFlagBit
 
 VKAPI_ATTR void VKAPI_CALL CmdWriteTimestamp(VkCommandBuffer commandBuffer, VkPipelineStageFlagBits pipelineStage,
                                              VkQueryPool queryPool, uint32_t query) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdWriteTimestamp");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4373,7 +4595,8 @@ VKAPI_ATTR void VKAPI_CALL CmdWriteTimestamp(VkCommandBuffer commandBuffer, VkPi
     skipCall |= parameter_validation_vkCmdWriteTimestamp(my_data->report_data, pipelineStage, queryPool, query);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdWriteTimestamp(commandBuffer, pipelineStage, queryPool, query);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdWriteTimestamp(commandBuffer,
+                                                            pipelineStage, queryPool, query));
 
         PostCmdWriteTimestamp(commandBuffer, pipelineStage, queryPool, query);
     }
@@ -4382,6 +4605,7 @@ VKAPI_ATTR void VKAPI_CALL CmdWriteTimestamp(VkCommandBuffer commandBuffer, VkPi
 VKAPI_ATTR void VKAPI_CALL
 CmdCopyQueryPoolResults(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t firstQuery, uint32_t queryCount,
                         VkBuffer dstBuffer, VkDeviceSize dstOffset, VkDeviceSize stride, VkQueryResultFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdCopyQueryPoolResults");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4390,14 +4614,16 @@ CmdCopyQueryPoolResults(VkCommandBuffer commandBuffer, VkQueryPool queryPool, ui
                                                                dstOffset, stride, flags);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdCopyQueryPoolResults(commandBuffer, queryPool, firstQuery, queryCount, dstBuffer, dstOffset, stride, flags);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map,
+                                                            commandBuffer)->CmdCopyQueryPoolResults(commandBuffer, queryPool,
+                                                            firstQuery, queryCount, dstBuffer, dstOffset, stride, flags));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdPushConstants(VkCommandBuffer commandBuffer, VkPipelineLayout layout,
                                             VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size,
                                             const void *pValues) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdPushConstants");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4405,13 +4631,14 @@ VKAPI_ATTR void VKAPI_CALL CmdPushConstants(VkCommandBuffer commandBuffer, VkPip
     skipCall |= parameter_validation_vkCmdPushConstants(my_data->report_data, layout, stageFlags, offset, size, pValues);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdPushConstants(commandBuffer, layout, stageFlags, offset, size, pValues);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdPushConstants(commandBuffer,
+                                                            layout, stageFlags, offset, size, pValues));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdBeginRenderPass(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo *pRenderPassBegin, VkSubpassContents contents) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdBeginRenderPass");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4419,11 +4646,13 @@ CmdBeginRenderPass(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo *p
     skipCall |= parameter_validation_vkCmdBeginRenderPass(my_data->report_data, pRenderPassBegin, contents);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdBeginRenderPass(commandBuffer, pRenderPassBegin, contents);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdBeginRenderPass(commandBuffer,
+                                                            pRenderPassBegin, contents));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdNextSubpass(VkCommandBuffer commandBuffer, VkSubpassContents contents) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdNextSubpass");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4431,16 +4660,19 @@ VKAPI_ATTR void VKAPI_CALL CmdNextSubpass(VkCommandBuffer commandBuffer, VkSubpa
     skipCall |= parameter_validation_vkCmdNextSubpass(my_data->report_data, contents);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)->CmdNextSubpass(commandBuffer, contents);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdNextSubpass(commandBuffer,
+                                                            contents));
     }
 }
 
 VKAPI_ATTR void VKAPI_CALL CmdEndRenderPass(VkCommandBuffer commandBuffer) {
-    get_dispatch_table(pc_device_table_map, commandBuffer)->CmdEndRenderPass(commandBuffer);
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdEndRenderPass");
+    LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdEndRenderPass(commandBuffer));
 }
 
 VKAPI_ATTR void VKAPI_CALL
 CmdExecuteCommands(VkCommandBuffer commandBuffer, uint32_t commandBufferCount, const VkCommandBuffer *pCommandBuffers) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCmdExecuteCommands");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
     assert(my_data != NULL);
@@ -4448,23 +4680,26 @@ CmdExecuteCommands(VkCommandBuffer commandBuffer, uint32_t commandBufferCount, c
     skipCall |= parameter_validation_vkCmdExecuteCommands(my_data->report_data, commandBufferCount, pCommandBuffers);
 
     if (!skipCall) {
-        get_dispatch_table(pc_device_table_map, commandBuffer)
-            ->CmdExecuteCommands(commandBuffer, commandBufferCount, pCommandBuffers);
+        LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, commandBuffer)->CmdExecuteCommands(commandBuffer,
+                                                            commandBufferCount, pCommandBuffers));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateInstanceLayerProperties(uint32_t *pCount, VkLayerProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateInstanceLayerProperties");
     return util_GetLayerProperties(1, &global_layer, pCount, pProperties);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateDeviceLayerProperties(VkPhysicalDevice physicalDevice, uint32_t *pCount, VkLayerProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateDeviceLayerProperties");
     return util_GetLayerProperties(1, &global_layer, pCount, pProperties);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateInstanceExtensionProperties(const char *pLayerName, uint32_t *pCount, VkExtensionProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateInstanceExtensionProperties");
     if (pLayerName && !strcmp(pLayerName, global_layer.layerName))
         return util_GetExtensionProperties(1, instance_extensions, pCount, pProperties);
 
@@ -4474,14 +4709,15 @@ EnumerateInstanceExtensionProperties(const char *pLayerName, uint32_t *pCount, V
 VKAPI_ATTR VkResult VKAPI_CALL EnumerateDeviceExtensionProperties(VkPhysicalDevice physicalDevice,
                                                                   const char *pLayerName, uint32_t *pCount,
                                                                   VkExtensionProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateDeviceExtensionProperties");
     /* parameter_validation does not have any physical device extensions */
     if (pLayerName && !strcmp(pLayerName, global_layer.layerName))
         return util_GetExtensionProperties(0, NULL, pCount, pProperties);
 
     assert(physicalDevice);
 
-    return get_dispatch_table(pc_instance_table_map, physicalDevice)
-        ->EnumerateDeviceExtensionProperties(physicalDevice, NULL, pCount, pProperties);
+    return LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(
+        pc_instance_table_map, physicalDevice)->EnumerateDeviceExtensionProperties(physicalDevice, NULL, pCount, pProperties));
 }
 
 static PFN_vkVoidFunction
@@ -4491,6 +4727,7 @@ static PFN_vkVoidFunction
 intercept_core_device_command(const char *name);
 
 VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice device, const char *funcName) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetDeviceProcAddr");
     assert(device);
 
     layer_data *data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -4505,10 +4742,11 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice device, cons
 
     if (get_dispatch_table(pc_device_table_map, device)->GetDeviceProcAddr == NULL)
         return NULL;
-    return get_dispatch_table(pc_device_table_map, device)->GetDeviceProcAddr(device, funcName);
+    return LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_device_table_map, device)->GetDeviceProcAddr(device, funcName));
 }
 
 VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance, const char *funcName) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetInstanceProcAddr");
     PFN_vkVoidFunction proc = intercept_core_instance_command(funcName);
     if (!proc)
         proc = intercept_core_device_command(funcName);
@@ -4525,7 +4763,8 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance
 
     if (get_dispatch_table(pc_instance_table_map, instance)->GetInstanceProcAddr == NULL)
         return NULL;
-    return get_dispatch_table(pc_instance_table_map, instance)->GetInstanceProcAddr(instance, funcName);
+    return LAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(pc_instance_table_map, instance)->GetInstanceProcAddr(instance,
+                                                               funcName));
 }
 
 static PFN_vkVoidFunction
@@ -28,13 +28,15 @@
 #include "vk_layer_extension_utils.h"
 #include "vk_enum_string_helper.h"
 #include "vk_layer_utils.h"
+#include "vk_layer_profile.h"
 
 namespace swapchain {
 
 static std::mutex global_lock;
+static layer_profiler profiler;
 
 // The following is for logging error messages:
-static std::unordered_map<void *, layer_data *> layer_data_map;
+static dispatch_key_map<layer_data> layer_data_map;
 
 static const VkExtensionProperties instance_extensions[] = {{VK_EXT_DEBUG_REPORT_EXTENSION_NAME, VK_EXT_DEBUG_REPORT_SPEC_VERSION}};
 
@@ -209,6 +211,7 @@ static void createInstanceRegisterExtensions(const VkInstanceCreateInfo *pCreate
 static void init_swapchain(layer_data *my_data, const VkAllocationCallbacks *pAllocator) {
 
     layer_debug_actions(my_data->report_data, my_data->logging_callback, pAllocator, "lunarg_swapchain");
+    layer_profile_start(&profiler, "lunarg_swapchain");
 }
 
 static const char *surfaceTransformStr(VkSurfaceTransformFlagBitsKHR value) {
@@ -233,6 +236,7 @@ static const char *sharingModeStr(VkSharingMode value) {
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkInstance *pInstance) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateInstance");
     VkLayerInstanceCreateInfo *chain_info = get_chain_info(pCreateInfo, VK_LAYER_LINK_INFO);
 
     assert(chain_info->u.pLayerInfo);
@@ -245,7 +249,7 @@ CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallba
     // Advance the link info for the next element on the chain
     chain_info->u.pLayerInfo = chain_info->u.pLayerInfo->pNext;
 
-    VkResult result = fpCreateInstance(pCreateInfo, pAllocator, pInstance);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, fpCreateInstance(pCreateInfo, pAllocator, pInstance));
     if (result != VK_SUCCESS) {
         return result;
     }
@@ -266,6 +270,7 @@ CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallba
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyInstance");
     dispatch_key key = get_dispatch_key(instance);
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
     SwpInstance *pInstance = NULL;
@@ -275,7 +280,7 @@ VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocati
     }
 
     // Call down the call chain:
-    my_data->instance_dispatch_table->DestroyInstance(instance, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->DestroyInstance(instance, pAllocator));
 
     std::lock_guard<std::mutex> lock(global_lock);
 
@@ -341,6 +346,7 @@ VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocati
         my_data->logging_callback.pop_back();
     }
     layer_debug_report_destroy_instance(my_data->report_data);
+    layer_profile_stop(&profiler);
 
     delete my_data->instance_dispatch_table;
     layer_data_map.erase(key);
@@ -349,11 +355,12 @@ VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocati
 VKAPI_ATTR void VKAPI_CALL
 GetPhysicalDeviceQueueFamilyProperties(VkPhysicalDevice physicalDevice, uint32_t *pQueueFamilyPropertyCount,
                                        VkQueueFamilyProperties *pQueueFamilyProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceQueueFamilyProperties");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
 
     // Call down the call chain:
-    my_data->instance_dispatch_table->GetPhysicalDeviceQueueFamilyProperties(physicalDevice, pQueueFamilyPropertyCount,
-                                                                             pQueueFamilyProperties);
+    LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->GetPhysicalDeviceQueueFamilyProperties(
+        physicalDevice, pQueueFamilyPropertyCount, pQueueFamilyProperties));
 
     // Record the result of this query:
     std::lock_guard<std::mutex> lock(global_lock);
@@ -372,6 +379,7 @@ GetPhysicalDeviceQueueFamilyProperties(VkPhysicalDevice physicalDevice, uint32_t
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateAndroidSurfaceKHR(VkInstance instance, const VkAndroidSurfaceCreateInfoKHR *pCreateInfo,
                         const VkAllocationCallbacks *pAllocator, VkSurfaceKHR *pSurface) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateAndroidSurfaceKHR");
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
@@ -404,7 +412,8 @@ CreateAndroidSurfaceKHR(VkInstance instance, const VkAndroidSurfaceCreateInfoKHR
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->instance_dispatch_table->CreateAndroidSurfaceKHR(instance, pCreateInfo, pAllocator, pSurface);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->CreateAndroidSurfaceKHR(instance, pCreateInfo,
+                                                                                                            pAllocator, pSurface));
         lock.lock();
 
         // Obtain this pointer again after locking:
@@ -432,6 +441,7 @@ CreateAndroidSurfaceKHR(VkInstance instance, const VkAndroidSurfaceCreateInfoKHR
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateMirSurfaceKHR(VkInstance instance, const VkMirSurfaceCreateInfoKHR *pCreateInfo, const VkAllocationCallbacks *pAllocator,
                     VkSurfaceKHR *pSurface) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateMirSurfaceKHR");
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
@@ -464,7 +474,8 @@ CreateMirSurfaceKHR(VkInstance instance, const VkMirSurfaceCreateInfoKHR *pCreat
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->instance_dispatch_table->CreateMirSurfaceKHR(instance, pCreateInfo, pAllocator, pSurface);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->CreateMirSurfaceKHR(instance, pCreateInfo,
+                                                                                                        pAllocator, pSurface));
         lock.lock();
 
         // Obtain this pointer again after locking:
@@ -490,6 +501,7 @@ CreateMirSurfaceKHR(VkInstance instance, const VkMirSurfaceCreateInfoKHR *pCreat
 VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceMirPresentationSupportKHR(VkPhysicalDevice physicalDevice,
                                                                           uint32_t queueFamilyIndex,
                                                                           MirConnection *connection) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceMirPresentationSupportKHR");
     VkBool32 result = VK_FALSE;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
@@ -516,8 +528,8 @@ VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceMirPresentationSupportKHR(VkPhys
 
     if (!skipCall) {
         // Call down the call chain:
-        result = my_data->instance_dispatch_table->GetPhysicalDeviceMirPresentationSupportKHR(physicalDevice, queueFamilyIndex,
-                                                                                              connection);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->GetPhysicalDeviceMirPresentationSupportKHR(
+            physicalDevice, queueFamilyIndex, connection));
     }
     return result;
 }
@@ -527,6 +539,7 @@ VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceMirPresentationSupportKHR(VkPhys
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateWaylandSurfaceKHR(VkInstance instance, const VkWaylandSurfaceCreateInfoKHR *pCreateInfo,
                         const VkAllocationCallbacks *pAllocator, VkSurfaceKHR *pSurface) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateWaylandSurfaceKHR");
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
@@ -559,7 +572,8 @@ CreateWaylandSurfaceKHR(VkInstance instance, const VkWaylandSurfaceCreateInfoKHR
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->instance_dispatch_table->CreateWaylandSurfaceKHR(instance, pCreateInfo, pAllocator, pSurface);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->CreateWaylandSurfaceKHR(instance, pCreateInfo,
+                                                                                                            pAllocator, pSurface));
         lock.lock();
 
         // Obtain this pointer again after locking:
@@ -585,6 +599,7 @@ CreateWaylandSurfaceKHR(VkInstance instance, const VkWaylandSurfaceCreateInfoKHR
 VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceWaylandPresentationSupportKHR(VkPhysicalDevice physicalDevice,
                                                                               uint32_t queueFamilyIndex,
                                                                               struct wl_display *display) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceWaylandPresentationSupportKHR");
     VkBool32 result = VK_FALSE;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
@@ -611,8 +626,8 @@ VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceWaylandPresentationSupportKHR(Vk
 
     if (!skipCall) {
         // Call down the call chain:
-        result = my_data->instance_dispatch_table->GetPhysicalDeviceWaylandPresentationSupportKHR(physicalDevice, queueFamilyIndex,
-                                                                                                  display);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->GetPhysicalDeviceWaylandPresentationSupportKHR(
+            physicalDevice, queueFamilyIndex, display));
     }
     return result;
 }
@@ -622,6 +637,7 @@ VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceWaylandPresentationSupportKHR(Vk
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateWin32SurfaceKHR(VkInstance instance, const VkWin32SurfaceCreateInfoKHR *pCreateInfo,
                       const VkAllocationCallbacks *pAllocator, VkSurfaceKHR *pSurface) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateWin32SurfaceKHR");
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
@@ -654,7 +670,8 @@ CreateWin32SurfaceKHR(VkInstance instance, const VkWin32SurfaceCreateInfoKHR *pC
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->instance_dispatch_table->CreateWin32SurfaceKHR(instance, pCreateInfo, pAllocator, pSurface);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->CreateWin32SurfaceKHR(instance, pCreateInfo,
+                                                                                                          pAllocator, pSurface));
         lock.lock();
 
         // Obtain this pointer again after locking:
@@ -679,6 +696,7 @@ CreateWin32SurfaceKHR(VkInstance instance, const VkWin32SurfaceCreateInfoKHR *pC
 
 VKAPI_ATTR VkBool32 VKAPI_CALL
 GetPhysicalDeviceWin32PresentationSupportKHR(VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceWin32PresentationSupportKHR");
     VkBool32 result = VK_FALSE;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
@@ -705,7 +723,8 @@ GetPhysicalDeviceWin32PresentationSupportKHR(VkPhysicalDevice physicalDevice, ui
 
     if (!skipCall) {
         // Call down the call chain:
-        result = my_data->instance_dispatch_table->GetPhysicalDeviceWin32PresentationSupportKHR(physicalDevice, queueFamilyIndex);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->GetPhysicalDeviceWin32PresentationSupportKHR(
+            physicalDevice, queueFamilyIndex));
     }
     return result;
 }
@@ -715,6 +734,7 @@ GetPhysicalDeviceWin32PresentationSupportKHR(VkPhysicalDevice physicalDevice, ui
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateXcbSurfaceKHR(VkInstance instance, const VkXcbSurfaceCreateInfoKHR *pCreateInfo, const VkAllocationCallbacks *pAllocator,
                       VkSurfaceKHR *pSurface) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateXcbSurfaceKHR");
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
@@ -747,7 +767,8 @@ CreateXcbSurfaceKHR(VkInstance instance, const VkXcbSurfaceCreateInfoKHR *pCreat
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->instance_dispatch_table->CreateXcbSurfaceKHR(instance, pCreateInfo, pAllocator, pSurface);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->CreateXcbSurfaceKHR(instance, pCreateInfo,
+                                                                                                        pAllocator, pSurface));
         lock.lock();
 
         // Obtain this pointer again after locking:
@@ -773,6 +794,7 @@ CreateXcbSurfaceKHR(VkInstance instance, const VkXcbSurfaceCreateInfoKHR *pCreat
 VKAPI_ATTR VkBool32 VKAPI_CALL
 GetPhysicalDeviceXcbPresentationSupportKHR(VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex,
                                            xcb_connection_t *connection, xcb_visualid_t visual_id) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceXcbPresentationSupportKHR");
     VkBool32 result = VK_FALSE;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
@@ -799,8 +821,8 @@ GetPhysicalDeviceXcbPresentationSupportKHR(VkPhysicalDevice physicalDevice, uint
 
     if (!skipCall) {
         // Call down the call chain:
-        result = my_data->instance_dispatch_table->GetPhysicalDeviceXcbPresentationSupportKHR(physicalDevice, queueFamilyIndex,
-                                                                                              connection, visual_id);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->GetPhysicalDeviceXcbPresentationSupportKHR(
+            physicalDevice, queueFamilyIndex, connection, visual_id));
     }
     return result;
 }
@@ -810,6 +832,7 @@ GetPhysicalDeviceXcbPresentationSupportKHR(VkPhysicalDevice physicalDevice, uint
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateXlibSurfaceKHR(VkInstance instance, const VkXlibSurfaceCreateInfoKHR *pCreateInfo, const VkAllocationCallbacks *pAllocator,
                      VkSurfaceKHR *pSurface) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateXlibSurfaceKHR");
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
@@ -842,7 +865,8 @@ CreateXlibSurfaceKHR(VkInstance instance, const VkXlibSurfaceCreateInfoKHR *pCre
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->instance_dispatch_table->CreateXlibSurfaceKHR(instance, pCreateInfo, pAllocator, pSurface);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->CreateXlibSurfaceKHR(instance, pCreateInfo,
+                                                                                                         pAllocator, pSurface));
         lock.lock();
 
         // Obtain this pointer again after locking:
@@ -868,6 +892,7 @@ CreateXlibSurfaceKHR(VkInstance instance, const VkXlibSurfaceCreateInfoKHR *pCre
 VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceXlibPresentationSupportKHR(VkPhysicalDevice physicalDevice,
                                                                            uint32_t queueFamilyIndex,
                                                                            Display *dpy, VisualID visualID) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceXlibPresentationSupportKHR");
     VkBool32 result = VK_FALSE;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
@@ -894,8 +919,8 @@ VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceXlibPresentationSupportKHR(VkPhy
 
     if (!skipCall) {
         // Call down the call chain:
-        result = my_data->instance_dispatch_table->GetPhysicalDeviceXlibPresentationSupportKHR(physicalDevice, queueFamilyIndex,
-                                                                                               dpy, visualID);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->GetPhysicalDeviceXlibPresentationSupportKHR(
+            physicalDevice, queueFamilyIndex, dpy, visualID));
     }
     return result;
 }
@@ -903,6 +928,7 @@ VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceXlibPresentationSupportKHR(VkPhy
 
 VKAPI_ATTR void VKAPI_CALL
 DestroySurfaceKHR(VkInstance instance, VkSurfaceKHR surface, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroySurfaceKHR");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
     std::unique_lock<std::mutex> lock(global_lock);
@@ -961,17 +987,19 @@ DestroySurfaceKHR(VkInstance instance, VkSurfaceKHR surface, const VkAllocationC
 
     if (!skipCall) {
         // Call down the call chain:
-        my_data->instance_dispatch_table->DestroySurfaceKHR(instance, surface, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->DestroySurfaceKHR(instance, surface, pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumeratePhysicalDevices(VkInstance instance, uint32_t *pPhysicalDeviceCount, VkPhysicalDevice *pPhysicalDevices) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumeratePhysicalDevices");
     VkResult result = VK_SUCCESS;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
 
     // Call down the call chain:
-    result = my_data->instance_dispatch_table->EnumeratePhysicalDevices(instance, pPhysicalDeviceCount, pPhysicalDevices);
+    result = LAYER_PROFILE_DISPATCH(
+        profiler, my_data->instance_dispatch_table->EnumeratePhysicalDevices(instance, pPhysicalDeviceCount, pPhysicalDevices));
 
     std::lock_guard<std::mutex> lock(global_lock);
     SwpInstance *pInstance = NULL;
@@ -1003,6 +1031,7 @@ EnumeratePhysicalDevices(VkInstance instance, uint32_t *pPhysicalDeviceCount, Vk
 VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice physicalDevice,
                                             const VkDeviceCreateInfo *pCreateInfo,
                                             const VkAllocationCallbacks *pAllocator, VkDevice *pDevice) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDevice");
     layer_data *my_instance_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
     VkLayerDeviceCreateInfo *chain_info = get_chain_info(pCreateInfo, VK_LAYER_LINK_INFO);
 
@@ -1017,7 +1046,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice physicalDevice,
     // Advance the link info for the next element on the chain
     chain_info->u.pLayerInfo = chain_info->u.pLayerInfo->pNext;
 
-    VkResult result = fpCreateDevice(physicalDevice, pCreateInfo, pAllocator, pDevice);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, fpCreateDevice(physicalDevice, pCreateInfo, pAllocator, pDevice));
     if (result != VK_SUCCESS) {
         return result;
     }
@@ -1036,11 +1065,12 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice physicalDevice,
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyDevice(VkDevice device, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDevice");
     dispatch_key key = get_dispatch_key(device);
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
 
     // Call down the call chain:
-    my_data->device_dispatch_table->DestroyDevice(device, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->DestroyDevice(device, pAllocator));
 
     // Do some internal cleanup:
     std::lock_guard<std::mutex> lock(global_lock);
@@ -1082,6 +1112,7 @@ VKAPI_ATTR void VKAPI_CALL DestroyDevice(VkDevice device, const VkAllocationCall
 VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceSupportKHR(VkPhysicalDevice physicalDevice,
                                                                   uint32_t queueFamilyIndex, VkSurfaceKHR surface,
                                                                   VkBool32 *pSupported) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceSurfaceSupportKHR");
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
@@ -1117,8 +1148,8 @@ VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceSupportKHR(VkPhysicalDevi
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->instance_dispatch_table->GetPhysicalDeviceSurfaceSupportKHR(physicalDevice, queueFamilyIndex, surface,
-                                                                                      pSupported);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->GetPhysicalDeviceSurfaceSupportKHR(
+            physicalDevice, queueFamilyIndex, surface, pSupported));
         lock.lock();
 
         // Obtain this pointer again after locking:
@@ -1154,6 +1185,7 @@ VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceSupportKHR(VkPhysicalDevi
 VKAPI_ATTR VkResult VKAPI_CALL
 GetPhysicalDeviceSurfaceCapabilitiesKHR(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface,
                                         VkSurfaceCapabilitiesKHR *pSurfaceCapabilities) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceSurfaceCapabilitiesKHR");
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
@@ -1178,8 +1210,8 @@ GetPhysicalDeviceSurfaceCapabilitiesKHR(VkPhysicalDevice physicalDevice, VkSurfa
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->instance_dispatch_table->GetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, surface,
-                                                                                           pSurfaceCapabilities);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->GetPhysicalDeviceSurfaceCapabilitiesKHR(
+            physicalDevice, surface, pSurfaceCapabilities));
         lock.lock();
 
         // Obtain this pointer again after locking:
@@ -1201,6 +1233,7 @@ GetPhysicalDeviceSurfaceCapabilitiesKHR(VkPhysicalDevice physicalDevice, VkSurfa
 VKAPI_ATTR VkResult VKAPI_CALL
 GetPhysicalDeviceSurfaceFormatsKHR(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface, uint32_t *pSurfaceFormatCount,
                                    VkSurfaceFormatKHR *pSurfaceFormats) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceSurfaceFormatsKHR");
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
@@ -1242,8 +1275,8 @@ GetPhysicalDeviceSurfaceFormatsKHR(VkPhysicalDevice physicalDevice, VkSurfaceKHR
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->instance_dispatch_table->GetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, pSurfaceFormatCount,
-                                                                                      pSurfaceFormats);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->GetPhysicalDeviceSurfaceFormatsKHR(
+            physicalDevice, surface, pSurfaceFormatCount, pSurfaceFormats));
         lock.lock();
 
         // Obtain this pointer again after locking:
@@ -1276,6 +1309,7 @@ GetPhysicalDeviceSurfaceFormatsKHR(VkPhysicalDevice physicalDevice, VkSurfaceKHR
 VKAPI_ATTR VkResult VKAPI_CALL
 GetPhysicalDeviceSurfacePresentModesKHR(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface, uint32_t *pPresentModeCount,
                                         VkPresentModeKHR *pPresentModes) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetPhysicalDeviceSurfacePresentModesKHR");
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
@@ -1317,8 +1351,8 @@ GetPhysicalDeviceSurfacePresentModesKHR(VkPhysicalDevice physicalDevice, VkSurfa
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->instance_dispatch_table->GetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface,
-                                                                                           pPresentModeCount, pPresentModes);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->GetPhysicalDeviceSurfacePresentModesKHR(
+            physicalDevice, surface, pPresentModeCount, pPresentModes));
         lock.lock();
 
         // Obtain this pointer again after locking:
@@ -1680,6 +1714,7 @@ static bool validateCreateSwapchainKHR(VkDevice device, const VkSwapchainCreateI
 VKAPI_ATTR VkResult VKAPI_CALL CreateSwapchainKHR(VkDevice device, const VkSwapchainCreateInfoKHR *pCreateInfo,
                                                   const VkAllocationCallbacks *pAllocator,
                                                   VkSwapchainKHR *pSwapchain) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateSwapchainKHR");
     VkResult result = VK_SUCCESS;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
     std::unique_lock<std::mutex> lock(global_lock);
@@ -1688,7 +1723,8 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateSwapchainKHR(VkDevice device, const VkSwapc
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->device_dispatch_table->CreateSwapchainKHR(device, pCreateInfo, pAllocator, pSwapchain);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->CreateSwapchainKHR(device, pCreateInfo,
+                                                                                                     pAllocator, pSwapchain));
         lock.lock();
 
         if (result == VK_SUCCESS) {
@@ -1724,6 +1760,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateSwapchainKHR(VkDevice device, const VkSwapc
 
 VKAPI_ATTR void VKAPI_CALL
 DestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroySwapchainKHR");
     // TODOs:
     //
     // - Implement a check for validity language that reads: All uses of
@@ -1780,12 +1817,13 @@ DestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocatio
 
     if (!skipCall) {
         // Call down the call chain:
-        my_data->device_dispatch_table->DestroySwapchainKHR(device, swapchain, pAllocator);
+        LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->DestroySwapchainKHR(device, swapchain, pAllocator));
     }
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t *pSwapchainImageCount, VkImage *pSwapchainImages) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetSwapchainImagesKHR");
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
@@ -1831,7 +1869,8 @@ GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t *pSwap
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->device_dispatch_table->GetSwapchainImagesKHR(device, swapchain, pSwapchainImageCount, pSwapchainImages);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->GetSwapchainImagesKHR(
+            device, swapchain, pSwapchainImageCount, pSwapchainImages));
         lock.lock();
 
         // Obtain this pointer again after locking:
@@ -1859,6 +1898,7 @@ GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t *pSwap
 
 VKAPI_ATTR VkResult VKAPI_CALL AcquireNextImageKHR(VkDevice device, VkSwapchainKHR swapchain, uint64_t timeout,
                                                    VkSemaphore semaphore, VkFence fence, uint32_t *pImageIndex) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkAcquireNextImageKHR");
     // TODOs:
     //
     // - Address the timeout.  Possibilities include looking at the state of the
@@ -1933,7 +1973,8 @@ VKAPI_ATTR VkResult VKAPI_CALL AcquireNextImageKHR(VkDevice device, VkSwapchainK
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->device_dispatch_table->AcquireNextImageKHR(device, swapchain, timeout, semaphore, fence, pImageIndex);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->AcquireNextImageKHR(
+            device, swapchain, timeout, semaphore, fence, pImageIndex));
         lock.lock();
 
         // Obtain this pointer again after locking:
@@ -1951,6 +1992,7 @@ VKAPI_ATTR VkResult VKAPI_CALL AcquireNextImageKHR(VkDevice device, VkSwapchainK
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL QueuePresentKHR(VkQueue queue, const VkPresentInfoKHR *pPresentInfo) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkQueuePresentKHR");
     // TODOs:
     //
     // - Implement a check for validity language that reads: Any given element of
@@ -2043,7 +2085,7 @@ VKAPI_ATTR VkResult VKAPI_CALL QueuePresentKHR(VkQueue queue, const VkPresentInf
     if (!skipCall) {
         // Call down the call chain:
         lock.unlock();
-        result = my_data->device_dispatch_table->QueuePresentKHR(queue, pPresentInfo);
+        result = LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->QueuePresentKHR(queue, pPresentInfo));
         lock.lock();
 
         if (pPresentInfo && ((result == VK_SUCCESS) || (result == VK_SUBOPTIMAL_KHR))) {
@@ -2068,12 +2110,14 @@ VKAPI_ATTR VkResult VKAPI_CALL QueuePresentKHR(VkQueue queue, const VkPresentInf
 
 VKAPI_ATTR void VKAPI_CALL
 GetDeviceQueue(VkDevice device, uint32_t queueFamilyIndex, uint32_t queueIndex, VkQueue *pQueue) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetDeviceQueue");
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
     if (!skipCall) {
         // Call down the call chain:
-        my_data->device_dispatch_table->GetDeviceQueue(device, queueFamilyIndex, queueIndex, pQueue);
+        LAYER_PROFILE_DISPATCH(profiler, my_data->device_dispatch_table->GetDeviceQueue(device, queueFamilyIndex, queueIndex,
+                                                                                        pQueue));
 
         // Remember the queue's handle, and link it to the device:
         std::lock_guard<std::mutex> lock(global_lock);
@@ -2094,9 +2138,11 @@ GetDeviceQueue(VkDevice device, uint32_t queueFamilyIndex, uint32_t queueIndex,
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateDebugReportCallbackEXT(VkInstance instance, const VkDebugReportCallbackCreateInfoEXT *pCreateInfo,
                              const VkAllocationCallbacks *pAllocator, VkDebugReportCallbackEXT *pMsgCallback) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDebugReportCallbackEXT");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
     VkResult result =
-        my_data->instance_dispatch_table->CreateDebugReportCallbackEXT(instance, pCreateInfo, pAllocator, pMsgCallback);
+        LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->CreateDebugReportCallbackEXT(instance, pCreateInfo,
+                                                                                                        pAllocator, pMsgCallback));
     if (VK_SUCCESS == result) {
         std::lock_guard<std::mutex> lock(global_lock);
         result = layer_create_msg_callback(my_data->report_data, false, pCreateInfo, pAllocator, pMsgCallback);
@@ -2107,8 +2153,10 @@ CreateDebugReportCallbackEXT(VkInstance instance, const VkDebugReportCallbackCre
 VKAPI_ATTR void VKAPI_CALL DestroyDebugReportCallbackEXT(VkInstance instance,
                                                          VkDebugReportCallbackEXT msgCallback,
                                                          const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDebugReportCallbackEXT");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
-    my_data->instance_dispatch_table->DestroyDebugReportCallbackEXT(instance, msgCallback, pAllocator);
+    LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->DestroyDebugReportCallbackEXT(instance, msgCallback,
+                                                                                                     pAllocator));
     std::lock_guard<std::mutex> lock(global_lock);
     layer_destroy_msg_callback(my_data->report_data, msgCallback, pAllocator);
 }
@@ -2116,23 +2164,27 @@ VKAPI_ATTR void VKAPI_CALL DestroyDebugReportCallbackEXT(VkInstance instance,
 VKAPI_ATTR void VKAPI_CALL
 DebugReportMessageEXT(VkInstance instance, VkDebugReportFlagsEXT flags, VkDebugReportObjectTypeEXT objType, uint64_t object,
                       size_t location, int32_t msgCode, const char *pLayerPrefix, const char *pMsg) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDebugReportMessageEXT");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
-    my_data->instance_dispatch_table->DebugReportMessageEXT(instance, flags, objType, object, location, msgCode, pLayerPrefix,
-                                                            pMsg);
+    LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->DebugReportMessageEXT(
+        instance, flags, objType, object, location, msgCode, pLayerPrefix, pMsg));
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateInstanceLayerProperties(uint32_t *pCount, VkLayerProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateInstanceLayerProperties");
     return util_GetLayerProperties(1, &swapchain_layer, pCount, pProperties);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateDeviceLayerProperties(VkPhysicalDevice physicalDevice, uint32_t *pCount, VkLayerProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateDeviceLayerProperties");
     return util_GetLayerProperties(1, &swapchain_layer, pCount, pProperties);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateInstanceExtensionProperties(const char *pLayerName, uint32_t *pCount, VkExtensionProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateInstanceExtensionProperties");
     if (pLayerName && !strcmp(pLayerName, swapchain_layer.layerName))
         return util_GetExtensionProperties(1, instance_extensions, pCount, pProperties);
 
@@ -2142,6 +2194,7 @@ EnumerateInstanceExtensionProperties(const char *pLayerName, uint32_t *pCount, V
 VKAPI_ATTR VkResult VKAPI_CALL EnumerateDeviceExtensionProperties(VkPhysicalDevice physicalDevice,
                                                                   const char *pLayerName, uint32_t *pCount,
                                                                   VkExtensionProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateDeviceExtensionProperties");
     if (pLayerName && !strcmp(pLayerName, swapchain_layer.layerName))
         return util_GetExtensionProperties(0, nullptr, pCount, pProperties);
 
@@ -2149,7 +2202,8 @@ VKAPI_ATTR VkResult VKAPI_CALL EnumerateDeviceExtensionProperties(VkPhysicalDevi
 
     dispatch_key key = get_dispatch_key(physicalDevice);
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
-    return my_data->instance_dispatch_table->EnumerateDeviceExtensionProperties(physicalDevice, NULL, pCount, pProperties);
+    return LAYER_PROFILE_DISPATCH(
+        profiler, my_data->instance_dispatch_table->EnumerateDeviceExtensionProperties(physicalDevice, NULL, pCount, pProperties));
 }
 
 static PFN_vkVoidFunction
@@ -2165,6 +2219,7 @@ static PFN_vkVoidFunction
 intercept_khr_swapchain_command(const char *name, VkDevice dev);
 
 VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice device, const char *funcName) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetDeviceProcAddr");
     PFN_vkVoidFunction proc = intercept_core_device_command(funcName);
     if (proc)
         return proc;
@@ -2182,10 +2237,11 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice device, cons
 
     if (pDisp->GetDeviceProcAddr == NULL)
         return NULL;
-    return pDisp->GetDeviceProcAddr(device, funcName);
+    return LAYER_PROFILE_DISPATCH(profiler, pDisp->GetDeviceProcAddr(device, funcName));
 }
 
 VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance, const char *funcName) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetInstanceProcAddr");
     PFN_vkVoidFunction proc = intercept_core_instance_command(funcName);
     if (!proc)
         proc = intercept_core_device_command(funcName);
@@ -2208,7 +2264,7 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance
 
     if (pTable->GetInstanceProcAddr == NULL)
         return NULL;
-    return pTable->GetInstanceProcAddr(instance, funcName);
+    return LAYER_PROFILE_DISPATCH(profiler, pTable->GetInstanceProcAddr(instance, funcName));
 }
 
 static PFN_vkVoidFunction
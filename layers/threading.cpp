@@ -41,13 +41,35 @@
 
 namespace threading {
 
+// Instances created and not yet destroyed, guarded by global_lock
+static uint32_t instance_count = 0;
+
+// Read the sampling and command pool settings. They apply to the whole process, so they are only read by an instance
+// created while no other instance exists, when no thread can be using the layer, and hold until the last one is destroyed.
+static void initSettings() {
+    std::lock_guard<std::mutex> lock(global_lock);
+    if (instance_count++)
+        return;
+    pool_span_tracking = !strcmp(getLayerOption("google_threading.command_pool_tracking"), "recording");
+    sample_rate = (uint32_t)strtoul(getLayerOption("google_threading.sample_rate"), nullptr, 10);
+    sample_window_ms = (uint32_t)strtoul(getLayerOption("google_threading.sample_window_ms"), nullptr, 10);
+    sample_period_ms = 1000 * (uint32_t)strtoul(getLayerOption("google_threading.sample_period_s"), nullptr, 10);
+    if (sample_window_ms && !sample_period_ms)
+        sample_period_ms = 1000;
+    sample_epoch = std::chrono::steady_clock::now();
+    sample_generation++;
+}
+
 static void initThreading(layer_data *my_data, const VkAllocationCallbacks *pAllocator) {
 
     layer_debug_actions(my_data->report_data, my_data->logging_callback, pAllocator, "google_threading");
+    layer_profile_start(&profiler, "google_threading");
+    initSettings();
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkInstance *pInstance) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateInstance");
     VkLayerInstanceCreateInfo *chain_info = get_chain_info(pCreateInfo, VK_LAYER_LINK_INFO);
 
     assert(chain_info->u.pLayerInfo);
@@ -60,7 +82,7 @@ CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallba
     // Advance the link info for the next element on the chain
     chain_info->u.pLayerInfo = chain_info->u.pLayerInfo->pNext;
 
-    VkResult result = fpCreateInstance(pCreateInfo, pAllocator, pInstance);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, fpCreateInstance(pCreateInfo, pAllocator, pInstance));
     if (result != VK_SUCCESS)
         return result;
 
@@ -81,6 +103,7 @@ CreateInstance(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallba
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyInstance");
     dispatch_key key = get_dispatch_key(instance);
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
     VkLayerInstanceDispatchTable *pTable = my_data->instance_dispatch_table;
@@ -94,9 +117,12 @@ VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocati
         }
     }
 
-    startWriteObject(my_data, instance);
-    pTable->DestroyInstance(instance, pAllocator);
-    finishWriteObject(my_data, instance);
+    const bool sampled = sampleCall();
+    if (sampled)
+        startWriteObject(my_data, instance);
+    LAYER_PROFILE_DISPATCH(profiler, pTable->DestroyInstance(instance, pAllocator));
+    if (sampled)
+        finishWriteObject(my_data, instance);
 
     // Disable and cleanup the temporary callback(s):
     if (callback_setup) {
@@ -115,12 +141,16 @@ VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocati
     }
 
     layer_debug_report_destroy_instance(my_data->report_data);
+    layer_profile_stop(&profiler);
     delete my_data->instance_dispatch_table;
     layer_data_map.erase(key);
+    std::lock_guard<std::mutex> lock(global_lock);
+    instance_count--;
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice gpu, const VkDeviceCreateInfo *pCreateInfo,
                                             const VkAllocationCallbacks *pAllocator, VkDevice *pDevice) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDevice");
     layer_data *my_instance_data = get_my_data_ptr(get_dispatch_key(gpu), layer_data_map);
     VkLayerDeviceCreateInfo *chain_info = get_chain_info(pCreateInfo, VK_LAYER_LINK_INFO);
 
@@ -135,7 +165,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice gpu, const VkDevice
     // Advance the link info for the next element on the chain
     chain_info->u.pLayerInfo = chain_info->u.pLayerInfo->pNext;
 
-    VkResult result = fpCreateDevice(gpu, pCreateInfo, pAllocator, pDevice);
+    VkResult result = LAYER_PROFILE_DISPATCH(profiler, fpCreateDevice(gpu, pCreateInfo, pAllocator, pDevice));
     if (result != VK_SUCCESS) {
         return result;
     }
@@ -151,11 +181,23 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice gpu, const VkDevice
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyDevice(VkDevice device, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDevice");
     dispatch_key key = get_dispatch_key(device);
     layer_data *dev_data = get_my_data_ptr(key, layer_data_map);
-    startWriteObject(dev_data, device);
-    dev_data->device_dispatch_table->DestroyDevice(device, pAllocator);
-    finishWriteObject(dev_data, device);
+    const bool sampled = sampleCall();
+    if (sampled)
+        startWriteObject(dev_data, device);
+    LAYER_PROFILE_DISPATCH(profiler, dev_data->device_dispatch_table->DestroyDevice(device, pAllocator));
+    if (sampled)
+        finishWriteObject(dev_data, device);
+    {
+        // No call on the device's command buffers can be in progress any more
+        std::lock_guard<std::mutex> lock(global_lock);
+        for (auto cb_data : dev_data->free_command_buffers) {
+            delete cb_data;
+        }
+        dev_data->free_command_buffers.clear();
+    }
     layer_data_map.erase(key);
 }
 
@@ -178,16 +220,19 @@ static inline PFN_vkVoidFunction layer_intercept_proc(const char *name) {
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateInstanceLayerProperties(uint32_t *pCount, VkLayerProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateInstanceLayerProperties");
     return util_GetLayerProperties(1, &layerProps, pCount, pProperties);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateDeviceLayerProperties(VkPhysicalDevice physicalDevice, uint32_t *pCount, VkLayerProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateDeviceLayerProperties");
     return util_GetLayerProperties(1, &layerProps, pCount, pProperties);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 EnumerateInstanceExtensionProperties(const char *pLayerName, uint32_t *pCount, VkExtensionProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateInstanceExtensionProperties");
     if (pLayerName && !strcmp(pLayerName, layerProps.layerName))
         return util_GetExtensionProperties(1, threading_extensions, pCount, pProperties);
 
@@ -197,6 +242,7 @@ EnumerateInstanceExtensionProperties(const char *pLayerName, uint32_t *pCount, V
 VKAPI_ATTR VkResult VKAPI_CALL EnumerateDeviceExtensionProperties(VkPhysicalDevice physicalDevice,
                                                                   const char *pLayerName, uint32_t *pCount,
                                                                   VkExtensionProperties *pProperties) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEnumerateDeviceExtensionProperties");
     // Threading layer does not have any device extensions
     if (pLayerName && !strcmp(pLayerName, layerProps.layerName))
         return util_GetExtensionProperties(0, nullptr, pCount, pProperties);
@@ -205,7 +251,8 @@ VKAPI_ATTR VkResult VKAPI_CALL EnumerateDeviceExtensionProperties(VkPhysicalDevi
 
     dispatch_key key = get_dispatch_key(physicalDevice);
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
-    return my_data->instance_dispatch_table->EnumerateDeviceExtensionProperties(physicalDevice, NULL, pCount, pProperties);
+    return LAYER_PROFILE_DISPATCH(
+        profiler, my_data->instance_dispatch_table->EnumerateDeviceExtensionProperties(physicalDevice, NULL, pCount, pProperties));
 }
 
 static inline PFN_vkVoidFunction layer_intercept_instance_proc(const char *name) {
@@ -234,6 +281,7 @@ static inline PFN_vkVoidFunction layer_intercept_instance_proc(const char *name)
 }
 
 VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice device, const char *funcName) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetDeviceProcAddr");
     PFN_vkVoidFunction addr;
     layer_data *dev_data;
 
@@ -248,10 +296,11 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice device, cons
 
     if (pTable->GetDeviceProcAddr == NULL)
         return NULL;
-    return pTable->GetDeviceProcAddr(device, funcName);
+    return LAYER_PROFILE_DISPATCH(profiler, pTable->GetDeviceProcAddr(device, funcName));
 }
 
 VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance, const char *funcName) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkGetInstanceProcAddr");
     PFN_vkVoidFunction addr;
     layer_data *my_data;
 
@@ -274,52 +323,92 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance
     if (pTable->GetInstanceProcAddr == NULL) {
         return NULL;
     }
-    return pTable->GetInstanceProcAddr(instance, funcName);
+    return LAYER_PROFILE_DISPATCH(profiler, pTable->GetInstanceProcAddr(instance, funcName));
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 CreateDebugReportCallbackEXT(VkInstance instance, const VkDebugReportCallbackCreateInfoEXT *pCreateInfo,
                              const VkAllocationCallbacks *pAllocator, VkDebugReportCallbackEXT *pMsgCallback) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkCreateDebugReportCallbackEXT");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
-    startReadObject(my_data, instance);
+    const bool sampled = sampleCall();
+    if (sampled)
+        startReadObject(my_data, instance);
     VkResult result =
-        my_data->instance_dispatch_table->CreateDebugReportCallbackEXT(instance, pCreateInfo, pAllocator, pMsgCallback);
+        LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->CreateDebugReportCallbackEXT(instance, pCreateInfo,
+                                                                                                        pAllocator, pMsgCallback));
     if (VK_SUCCESS == result) {
         result = layer_create_msg_callback(my_data->report_data, false, pCreateInfo, pAllocator, pMsgCallback);
     }
-    finishReadObject(my_data, instance);
+    if (sampled)
+        finishReadObject(my_data, instance);
     return result;
 }
 
 VKAPI_ATTR void VKAPI_CALL
 DestroyDebugReportCallbackEXT(VkInstance instance, VkDebugReportCallbackEXT callback, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDebugReportCallbackEXT");
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(instance), layer_data_map);
-    startReadObject(my_data, instance);
-    startWriteObject(my_data, callback);
-    my_data->instance_dispatch_table->DestroyDebugReportCallbackEXT(instance, callback, pAllocator);
+    const bool sampled = sampleCall();
+    if (sampled) {
+        startReadObject(my_data, instance);
+        startWriteObject(my_data, callback);
+    }
+    LAYER_PROFILE_DISPATCH(profiler, my_data->instance_dispatch_table->DestroyDebugReportCallbackEXT(instance, callback,
+                                                                                                     pAllocator));
     layer_destroy_msg_callback(my_data->report_data, callback, pAllocator);
-    finishReadObject(my_data, instance);
-    finishWriteObject(my_data, callback);
+    if (sampled) {
+        finishReadObject(my_data, instance);
+        finishWriteObject(my_data, callback);
+    }
+}
+
+// Command buffer records are read without a lock, so a thread that keeps using a command buffer while another frees it
+// may still hold its record. Freed records are therefore never deleted while the device lives: they go on the device's
+// free list and are reused by later allocations. Caller holds global_lock.
+static command_buffer_data *newCommandBufferData(layer_data *my_data, VkCommandPool pool) {
+    if (my_data->free_command_buffers.empty())
+        return new command_buffer_data(pool);
+    command_buffer_data *cb_data = my_data->free_command_buffers.back();
+    my_data->free_command_buffers.pop_back();
+    cb_data->reset(pool);
+    return cb_data;
+}
+static void retireCommandBufferData(layer_data *my_data, VkCommandBuffer command_buffer) {
+    command_buffer_data *cb_data = command_buffer_map.find(command_buffer);
+    if (!cb_data)
+        return;
+    // Unpublish the record before it can be reused
+    command_buffer_map.erase(command_buffer);
+    my_data->free_command_buffers.push_back(cb_data);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
 AllocateCommandBuffers(VkDevice device, const VkCommandBufferAllocateInfo *pAllocateInfo, VkCommandBuffer *pCommandBuffers) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkAllocateCommandBuffers");
     dispatch_key key = get_dispatch_key(device);
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
     VkLayerDispatchTable *pTable = my_data->device_dispatch_table;
     VkResult result;
-    startReadObject(my_data, device);
-    startWriteObject(my_data, pAllocateInfo->commandPool);
+    const bool sampled = sampleCall();
+    if (sampled) {
+        startReadObject(my_data, device);
+        startWriteObject(my_data, pAllocateInfo->commandPool);
+    }
 
-    result = pTable->AllocateCommandBuffers(device, pAllocateInfo, pCommandBuffers);
-    finishReadObject(my_data, device);
-    finishWriteObject(my_data, pAllocateInfo->commandPool);
+    result = LAYER_PROFILE_DISPATCH(profiler, pTable->AllocateCommandBuffers(device, pAllocateInfo, pCommandBuffers));
+    if (sampled) {
+        finishReadObject(my_data, device);
+        finishWriteObject(my_data, pAllocateInfo->commandPool);
+    }
 
     // Record mapping from command buffer to command pool
     if (VK_SUCCESS == result) {
+        std::lock_guard<std::mutex> lock(global_lock);
+        auto &pool_buffers = command_pool_buffers[pAllocateInfo->commandPool];
         for (uint32_t index = 0; index < pAllocateInfo->commandBufferCount; index++) {
-            std::lock_guard<std::mutex> lock(global_lock);
-            command_pool_map[pCommandBuffers[index]] = pAllocateInfo->commandPool;
+            command_buffer_map.insert(pCommandBuffers[index], newCommandBufferData(my_data, pAllocateInfo->commandPool));
+            pool_buffers.insert(pCommandBuffers[index]);
         }
     }
 
@@ -328,26 +417,165 @@ AllocateCommandBuffers(VkDevice device, const VkCommandBufferAllocateInfo *pAllo
 
 VKAPI_ATTR void VKAPI_CALL FreeCommandBuffers(VkDevice device, VkCommandPool commandPool, uint32_t commandBufferCount,
                                               const VkCommandBuffer *pCommandBuffers) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkFreeCommandBuffers");
     dispatch_key key = get_dispatch_key(device);
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
     VkLayerDispatchTable *pTable = my_data->device_dispatch_table;
     const bool lockCommandPool = false; // pool is already directly locked
-    startReadObject(my_data, device);
-    startWriteObject(my_data, commandPool);
     for (uint32_t index = 0; index < commandBufferCount; index++) {
-        startWriteObject(my_data, pCommandBuffers[index], lockCommandPool);
+        releaseCommandPool(my_data, pCommandBuffers[index]);
+    }
+    const bool sampled = sampleCall();
+    if (sampled) {
+        startReadObject(my_data, device);
+        startWriteObject(my_data, commandPool);
+        for (uint32_t index = 0; index < commandBufferCount; index++) {
+            startWriteObject(my_data, pCommandBuffers[index], lockCommandPool);
+        }
     }
 
-    pTable->FreeCommandBuffers(device, commandPool, commandBufferCount, pCommandBuffers);
-    finishReadObject(my_data, device);
-    finishWriteObject(my_data, commandPool);
+    LAYER_PROFILE_DISPATCH(profiler, pTable->FreeCommandBuffers(device, commandPool, commandBufferCount, pCommandBuffers));
+    if (sampled) {
+        finishReadObject(my_data, device);
+        finishWriteObject(my_data, commandPool);
+        for (uint32_t index = 0; index < commandBufferCount; index++) {
+            finishWriteObject(my_data, pCommandBuffers[index], lockCommandPool);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(global_lock);
+    auto &pool_buffers = command_pool_buffers[commandPool];
     for (uint32_t index = 0; index < commandBufferCount; index++) {
-        finishWriteObject(my_data, pCommandBuffers[index], lockCommandPool);
+        if (pCommandBuffers[index] == VK_NULL_HANDLE)
+            continue;
+        retireCommandBufferData(my_data, pCommandBuffers[index]);
+        pool_buffers.erase(pCommandBuffers[index]);
+    }
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyCommandPool(VkDevice device, VkCommandPool commandPool, const VkAllocationCallbacks *pAllocator) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyCommandPool");
+    dispatch_key key = get_dispatch_key(device);
+    layer_data *my_data = get_my_data_ptr(key, layer_data_map);
+    VkLayerDispatchTable *pTable = my_data->device_dispatch_table;
+    std::unordered_set<VkCommandBuffer> pool_buffers;
+    {
         std::lock_guard<std::mutex> lock(global_lock);
-        command_pool_map.erase(pCommandBuffers[index]);
+        auto it = command_pool_buffers.find(commandPool);
+        if (it != command_pool_buffers.end()) {
+            pool_buffers.swap(it->second);
+            command_pool_buffers.erase(it);
+        }
+    }
+    // Destroying the pool frees its command buffers, including any still recording
+    for (auto command_buffer : pool_buffers) {
+        releaseCommandPool(my_data, command_buffer);
+    }
+    const bool sampled = sampleCall();
+    if (sampled) {
+        startReadObject(my_data, device);
+        startWriteObject(my_data, commandPool);
+    }
+
+    LAYER_PROFILE_DISPATCH(profiler, pTable->DestroyCommandPool(device, commandPool, pAllocator));
+    if (sampled) {
+        finishReadObject(my_data, device);
+        finishWriteObject(my_data, commandPool);
+    }
+
+    std::lock_guard<std::mutex> lock(global_lock);
+    for (auto command_buffer : pool_buffers) {
+        retireCommandBufferData(my_data, command_buffer);
     }
 }
 
+VKAPI_ATTR VkResult VKAPI_CALL ResetCommandPool(VkDevice device, VkCommandPool commandPool, VkCommandPoolResetFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkResetCommandPool");
+    dispatch_key key = get_dispatch_key(device);
+    layer_data *my_data = get_my_data_ptr(key, layer_data_map);
+    VkLayerDispatchTable *pTable = my_data->device_dispatch_table;
+    VkResult result;
+    // Resetting the pool ends recording of all its command buffers
+    if (pool_span_tracking) {
+        std::vector<VkCommandBuffer> pool_buffers;
+        {
+            std::lock_guard<std::mutex> lock(global_lock);
+            auto &buffers = command_pool_buffers[commandPool];
+            pool_buffers.assign(buffers.begin(), buffers.end());
+        }
+        for (auto command_buffer : pool_buffers) {
+            releaseCommandPool(my_data, command_buffer);
+        }
+    }
+    const bool sampled = sampleCall();
+    if (sampled) {
+        startReadObject(my_data, device);
+        startWriteObject(my_data, commandPool);
+    }
+
+    result = LAYER_PROFILE_DISPATCH(profiler, pTable->ResetCommandPool(device, commandPool, flags));
+    if (sampled) {
+        finishReadObject(my_data, device);
+        finishWriteObject(my_data, commandPool);
+    }
+    return result;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL BeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo *pBeginInfo) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkBeginCommandBuffer");
+    dispatch_key key = get_dispatch_key(commandBuffer);
+    layer_data *my_data = get_my_data_ptr(key, layer_data_map);
+    VkLayerDispatchTable *pTable = my_data->device_dispatch_table;
+    VkResult result;
+    const bool sampled = sampleCall();
+    if (sampled)
+        startWriteObject(my_data, commandBuffer);
+
+    result = LAYER_PROFILE_DISPATCH(profiler, pTable->BeginCommandBuffer(commandBuffer, pBeginInfo));
+    if (sampled)
+        finishWriteObject(my_data, commandBuffer);
+    // In recording span mode, hold the pool until recording ends instead of tracking it for every recorded command
+    if (sampled && VK_SUCCESS == result) {
+        holdCommandPool(my_data, commandBuffer);
+    }
+    return result;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL EndCommandBuffer(VkCommandBuffer commandBuffer) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkEndCommandBuffer");
+    dispatch_key key = get_dispatch_key(commandBuffer);
+    layer_data *my_data = get_my_data_ptr(key, layer_data_map);
+    VkLayerDispatchTable *pTable = my_data->device_dispatch_table;
+    VkResult result;
+    const bool sampled = sampleCall();
+    if (sampled)
+        startWriteObject(my_data, commandBuffer);
+
+    result = LAYER_PROFILE_DISPATCH(profiler, pTable->EndCommandBuffer(commandBuffer));
+    if (sampled)
+        finishWriteObject(my_data, commandBuffer);
+    // Recording has ended even if it failed, and whether or not its start was sampled
+    releaseCommandPool(my_data, commandBuffer);
+    return result;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ResetCommandBuffer(VkCommandBuffer commandBuffer, VkCommandBufferResetFlags flags) {
+    LAYER_PROFILE_ENTRY_POINT(profiler, "vkResetCommandBuffer");
+    dispatch_key key = get_dispatch_key(commandBuffer);
+    layer_data *my_data = get_my_data_ptr(key, layer_data_map);
+    VkLayerDispatchTable *pTable = my_data->device_dispatch_table;
+    VkResult result;
+    releaseCommandPool(my_data, commandBuffer);
+    const bool sampled = sampleCall();
+    if (sampled)
+        startWriteObject(my_data, commandBuffer);
+
+    result = LAYER_PROFILE_DISPATCH(profiler, pTable->ResetCommandBuffer(commandBuffer, flags));
+    if (sampled)
+        finishWriteObject(my_data, commandBuffer);
+    return result;
+}
+
 } // namespace threading
 
 // vk_layer_logging.h expects these to be defined
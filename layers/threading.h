@@ -20,11 +20,16 @@
 
 #ifndef THREADING_H
 #define THREADING_H
+#include <atomic>
+#include <cassert>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
+#include <unordered_set>
 #include <vector>
 #include "vk_layer_config.h"
 #include "vk_layer_logging.h"
+#include "vk_layer_profile.h"
 
 #if defined(__LP64__) || defined(_WIN64) || defined(__x86_64__) || defined(_M_X64) || defined(__ia64) || defined(_M_IA64) ||       \
     defined(__aarch64__) || defined(__powerpc64__)
@@ -40,154 +45,243 @@ enum THREADING_CHECKER_ERROR {
     THREADING_CHECKER_SINGLE_THREAD_REUSE, // Object used simultaneously by recursion in single thread
 };
 
+// Use state of one object. state packs the reader and writer counts with a small id of the thread that claimed the object,
+// so a use is recorded with a single compare-and-swap and no lock. Nodes are never freed while the counter exists: an
+// idle node is reused for another object, and its generation is bumped when that happens so that a thread still
+// holding the node for the old object fails its compare-and-swap and looks the object up again.
 struct object_use_data {
-    loader_platform_thread_id thread;
-    int reader_count;
-    int writer_count;
+    std::atomic<uint64_t> object;
+    std::atomic<uint64_t> state;
+    std::atomic<loader_platform_thread_id> thread; // Only used to report which thread holds the object
+    std::atomic<uint32_t> waiters;
+    std::mutex wait_lock;
+    std::condition_variable wait_condition;
+    object_use_data *next; // Set before the node is published and never changed
+    object_use_data(uint64_t object_key, object_use_data *next_node)
+        : object(object_key), state(0), thread(loader_platform_thread_id()), waiters(0), next(next_node) {}
 };
 
+static const uint64_t OBJECT_USE_READER = 1;
+static const uint64_t OBJECT_USE_READER_MASK = 0xFFFFFull;
+static const uint64_t OBJECT_USE_WRITER = 1ull << 20;
+static const uint64_t OBJECT_USE_WRITER_MASK = 0xFFFull << 20;
+static const uint64_t OBJECT_USE_COUNT_MASK = OBJECT_USE_READER_MASK | OBJECT_USE_WRITER_MASK;
+static const uint32_t OBJECT_USE_OWNER_SHIFT = 32;
+static const uint64_t OBJECT_USE_OWNER_MASK = 0xFFFFull << OBJECT_USE_OWNER_SHIFT;
+static const uint32_t OBJECT_USE_GENERATION_SHIFT = 48;
+static const uint64_t OBJECT_USE_GENERATION_MASK = 0x7FFFull << OBJECT_USE_GENERATION_SHIFT;
+static const uint64_t OBJECT_USE_RECYCLING = 1ull << 63;
+
+// Small per-thread id stored in object_use_data::state. Ids wrap after 65536 threads, so two threads only share one if
+// tens of thousands of threads have been created in between.
+static std::atomic<uint32_t> thread_slot_count;
+static THREAD_LOCAL_DECL uint32_t thread_slot;
+static inline uint64_t get_thread_slot() {
+    if (!thread_slot)
+        thread_slot = ++thread_slot_count;
+    return static_cast<uint64_t>(thread_slot & 0xFFFF) << OBJECT_USE_OWNER_SHIFT;
+}
+
+// Sampling of the calls that are tracked, configured by a vkCreateInstance made while no other instance exists. Between
+// decisions a thread only counts down sample_countdown; sample_current says whether the calls it counts down are tracked.
+static uint32_t sample_rate = 1;
+static uint32_t sample_window_ms = 0;
+static uint32_t sample_period_ms = 0;
+static std::chrono::steady_clock::time_point sample_epoch;
+// Bumped each time the settings are read, so that a thread drops a countdown started under the previous settings
+static uint32_t sample_generation = 0;
+static THREAD_LOCAL_DECL uint32_t sample_countdown;
+static THREAD_LOCAL_DECL bool sample_current;
+static THREAD_LOCAL_DECL uint32_t sample_thread_generation;
+
+// Calls between two reads of the clock when sampling time windows
+static const uint32_t SAMPLE_WINDOW_CHECK_CALLS = 64;
+
+static bool sampleNextCalls() {
+    sample_thread_generation = sample_generation;
+    if (sample_window_ms) {
+        uint64_t elapsed_ms =
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - sample_epoch).count();
+        sample_current = (elapsed_ms % sample_period_ms) < sample_window_ms;
+        sample_countdown = SAMPLE_WINDOW_CHECK_CALLS - 1;
+        return sample_current;
+    }
+    if (sample_rate <= 1) {
+        sample_current = true;
+        sample_countdown = UINT32_MAX;
+        return true;
+    }
+    // Track this call and skip the next sample_rate - 1
+    sample_current = false;
+    sample_countdown = sample_rate - 1;
+    return true;
+}
+
+// Whether the objects used by the calling thread's current call are tracked. Every wrapper decides this once on entry
+// so that the start and finish of each use agree.
+static inline bool sampleCall() {
+    if (sample_countdown && sample_thread_generation == sample_generation) {
+        --sample_countdown;
+        return sample_current;
+    }
+    return sampleNextCalls();
+}
+
 struct layer_data;
 
 static std::mutex global_lock;
-static std::condition_variable global_condition;
+static layer_profiler profiler;
 
 template <typename T> class counter {
   public:
     const char *typeName;
     VkDebugReportObjectTypeEXT objectType;
-    std::unordered_map<T, object_use_data> uses;
-    void startWrite(debug_report_data *report_data, T object) {
-        bool skipCall = false;
-        loader_platform_thread_id tid = loader_platform_get_thread_id();
-        std::unique_lock<std::mutex> lock(global_lock);
-        if (uses.find(object) == uses.end()) {
-            // There is no current use of the object.  Record writer thread.
-            struct object_use_data *use_data = &uses[object];
-            use_data->reader_count = 0;
-            use_data->writer_count = 1;
-            use_data->thread = tid;
-        } else {
-            struct object_use_data *use_data = &uses[object];
-            if (use_data->reader_count == 0) {
-                // There are no readers.  Two writers just collided.
-                if (use_data->thread != tid) {
-                    skipCall |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, objectType, (uint64_t)(object),
-                                        /*location*/ 0, THREADING_CHECKER_MULTIPLE_THREADS, "THREADING",
-                                        "THREADING ERROR : object of type %s is simultaneously used in thread %ld and thread %ld",
-                                        typeName, use_data->thread, tid);
-                    if (skipCall) {
-                        // Wait for thread-safe access to object instead of skipping call.
-                        while (uses.find(object) != uses.end()) {
-                            global_condition.wait(lock);
-                        }
-                        // There is now no current use of the object.  Record writer thread.
-                        struct object_use_data *use_data = &uses[object];
-                        use_data->thread = tid;
-                        use_data->reader_count = 0;
-                        use_data->writer_count = 1;
-                    } else {
-                        // Continue with an unsafe use of the object.
-                        use_data->thread = tid;
-                        use_data->writer_count += 1;
-                    }
-                } else {
-                    // This is either safe multiple use in one call, or recursive use.
-                    // There is no way to make recursion safe.  Just forge ahead.
-                    use_data->writer_count += 1;
-                }
-            } else {
-                // There are readers.  This writer collided with them.
-                if (use_data->thread != tid) {
-                    skipCall |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, objectType, (uint64_t)(object),
-                                        /*location*/ 0, THREADING_CHECKER_MULTIPLE_THREADS, "THREADING",
-                                        "THREADING ERROR : object of type %s is simultaneously used in thread %ld and thread %ld",
-                                        typeName, use_data->thread, tid);
-                    if (skipCall) {
-                        // Wait for thread-safe access to object instead of skipping call.
-                        while (uses.find(object) != uses.end()) {
-                            global_condition.wait(lock);
-                        }
-                        // There is now no current use of the object.  Record writer thread.
-                        struct object_use_data *use_data = &uses[object];
-                        use_data->thread = tid;
-                        use_data->reader_count = 0;
-                        use_data->writer_count = 1;
-                    } else {
-                        // Continue with an unsafe use of the object.
-                        use_data->thread = tid;
-                        use_data->writer_count += 1;
-                    }
-                } else {
-                    // This is either safe multiple use in one call, or recursive use.
-                    // There is no way to make recursion safe.  Just forge ahead.
-                    use_data->writer_count += 1;
-                }
+
+    void startWrite(debug_report_data *report_data, T object) { startUse(report_data, object, true); }
+    void finishWrite(T object) { finishUse(object, OBJECT_USE_WRITER); }
+    void startRead(debug_report_data *report_data, T object) { startUse(report_data, object, false); }
+    void finishRead(T object) { finishUse(object, OBJECT_USE_READER); }
+
+    counter(const char *name = "", VkDebugReportObjectTypeEXT type = VK_DEBUG_REPORT_OBJECT_TYPE_UNKNOWN_EXT) {
+        typeName = name;
+        objectType = type;
+        for (uint32_t i = 0; i < bucket_count; ++i) {
+            buckets[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+    ~counter() {
+        for (uint32_t i = 0; i < bucket_count; ++i) {
+            object_use_data *use = buckets[i].load();
+            while (use) {
+                object_use_data *next = use->next;
+                delete use;
+                use = next;
             }
         }
     }
 
-    void finishWrite(T object) {
-        // Object is no longer in use
-        std::unique_lock<std::mutex> lock(global_lock);
-        uses[object].writer_count -= 1;
-        if ((uses[object].reader_count == 0) && (uses[object].writer_count == 0)) {
-            uses.erase(object);
+  private:
+    counter(const counter &) = delete;
+    counter &operator=(const counter &) = delete;
+
+    static const uint32_t bucket_count = 256;
+    static const uint32_t shard_count = 16;
+
+    // Each bucket is a list of nodes that only grows at its head. Lookups walk it without a lock; adding a node or
+    // reusing an idle one for another object takes the lock of the bucket's shard.
+    std::atomic<object_use_data *> buckets[bucket_count];
+    std::mutex shard_locks[shard_count];
+
+    // The top 8 bits of a multiplicative hash select one of the bucket_count buckets
+    static uint32_t bucket(uint64_t key) { return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> 56); }
+
+    object_use_data *find(uint32_t b, uint64_t key) const {
+        for (object_use_data *use = buckets[b].load(std::memory_order_acquire); use; use = use->next) {
+            if (use->object.load() == key)
+                return use;
+        }
+        return nullptr;
+    }
+
+    object_use_data *findOrInsert(uint64_t key) {
+        uint32_t b = bucket(key);
+        object_use_data *use = find(b, key);
+        if (use)
+            return use;
+        std::lock_guard<std::mutex> lock(shard_locks[b % shard_count]);
+        use = find(b, key);
+        if (use)
+            return use;
+        object_use_data *head = buckets[b].load();
+        for (use = head; use; use = use->next) {
+            uint64_t state = use->state.load();
+            if ((state & (OBJECT_USE_COUNT_MASK | OBJECT_USE_RECYCLING)) || use->waiters.load())
+                continue;
+            if (use->state.compare_exchange_strong(state, state | OBJECT_USE_RECYCLING)) {
+                use->object.store(key);
+                use->state.store((state + (1ull << OBJECT_USE_GENERATION_SHIFT)) & OBJECT_USE_GENERATION_MASK);
+                return use;
+            }
+        }
+        use = new object_use_data(key, head);
+        buckets[b].store(use, std::memory_order_release);
+        return use;
+    }
+
+    // Block until no thread uses the object that use was found for
+    void waitForIdle(object_use_data *use) {
+        use->waiters.fetch_add(1);
+        std::unique_lock<std::mutex> lock(use->wait_lock);
+        while (use->state.load() & OBJECT_USE_COUNT_MASK) {
+            use->wait_condition.wait(lock);
         }
-        // Notify any waiting threads that this object may be safe to use
         lock.unlock();
-        global_condition.notify_all();
+        use->waiters.fetch_sub(1);
     }
 
-    void startRead(debug_report_data *report_data, T object) {
+    void startUse(debug_report_data *report_data, T object, bool write) {
+        uint64_t key = (uint64_t)(object);
+        uint64_t owner = get_thread_slot();
+        uint64_t increment = write ? OBJECT_USE_WRITER : OBJECT_USE_READER;
+        bool reported = false;
         bool skipCall = false;
-        loader_platform_thread_id tid = loader_platform_get_thread_id();
-        std::unique_lock<std::mutex> lock(global_lock);
-        if (uses.find(object) == uses.end()) {
-            // There is no current use of the object.  Record reader count
-            struct object_use_data *use_data = &uses[object];
-            use_data->reader_count = 1;
-            use_data->writer_count = 0;
-            use_data->thread = tid;
-        } else if (uses[object].writer_count > 0 && uses[object].thread != tid) {
-            // There is a writer of the object.
-            skipCall |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, objectType, (uint64_t)(object),
-                                /*location*/ 0, THREADING_CHECKER_MULTIPLE_THREADS, "THREADING",
-                                "THREADING ERROR : object of type %s is simultaneously used in thread %ld and thread %ld", typeName,
-                                uses[object].thread, tid);
-            if (skipCall) {
-                // Wait for thread-safe access to object instead of skipping call.
-                while (uses.find(object) != uses.end()) {
-                    global_condition.wait(lock);
+        for (;;) {
+            object_use_data *use = findOrInsert(key);
+            uint64_t state = use->state.load();
+            // The node is rechecked after every load of state, a change of generation fails the exchange
+            while (!(state & OBJECT_USE_RECYCLING) && use->object.load() == key) {
+                uint64_t desired;
+                if (!(state & OBJECT_USE_COUNT_MASK)) {
+                    // There is no current use of the object.  Record the using thread.
+                    desired = (state & OBJECT_USE_GENERATION_MASK) | owner | increment;
+                } else if ((state & OBJECT_USE_OWNER_MASK) == owner || (!write && !(state & OBJECT_USE_WRITER_MASK))) {
+                    // This is either safe multiple use in one call, recursive use, or another reader.
+                    // There is no way to make recursion safe.  Just forge ahead.
+                    desired = state + increment;
+                } else {
+                    // A writer collided with another use, or a reader collided with a writer
+                    if (!reported) {
+                        skipCall |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, objectType, key,
+                                            /*location*/ 0, THREADING_CHECKER_MULTIPLE_THREADS, "THREADING",
+                                            "THREADING ERROR : object of type %s is simultaneously used in thread %ld and "
+                                            "thread %ld",
+                                            typeName, use->thread.load(), loader_platform_get_thread_id());
+                        reported = true;
+                    }
+                    if (skipCall) {
+                        // Wait for thread-safe access to object instead of skipping call.
+                        waitForIdle(use);
+                        break;
+                    }
+                    // Continue with an unsafe use of the object.
+                    desired = write ? ((state & ~OBJECT_USE_OWNER_MASK) | owner) + increment : state + increment;
+                }
+                if (use->state.compare_exchange_weak(state, desired)) {
+                    if ((desired & OBJECT_USE_OWNER_MASK) == owner)
+                        use->thread.store(loader_platform_get_thread_id());
+                    return;
                 }
-                // There is no current use of the object.  Record reader count
-                struct object_use_data *use_data = &uses[object];
-                use_data->reader_count = 1;
-                use_data->writer_count = 0;
-                use_data->thread = tid;
-            } else {
-                uses[object].reader_count += 1;
             }
-        } else {
-            // There are other readers of the object.  Increase reader count
-            uses[object].reader_count += 1;
         }
     }
-    void finishRead(T object) {
-        std::unique_lock<std::mutex> lock(global_lock);
-        uses[object].reader_count -= 1;
-        if ((uses[object].reader_count == 0) && (uses[object].writer_count == 0)) {
-            uses.erase(object);
+
+    void finishUse(T object, uint64_t decrement) {
+        // Object is no longer in use
+        object_use_data *use = find(bucket((uint64_t)(object)), (uint64_t)(object));
+        assert(use);
+        if (!use)
+            return;
+        uint64_t state = use->state.fetch_sub(decrement) - decrement;
+        // Notify any threads waiting for this object that it may be safe to use
+        if (!(state & OBJECT_USE_COUNT_MASK) && use->waiters.load()) {
+            std::lock_guard<std::mutex> lock(use->wait_lock);
+            use->wait_condition.notify_all();
         }
-        // Notify and waiting threads that this object may be safe to use
-        lock.unlock();
-        global_condition.notify_all();
-    }
-    counter(const char *name = "", VkDebugReportObjectTypeEXT type = VK_DEBUG_REPORT_OBJECT_TYPE_UNKNOWN_EXT) {
-        typeName = name;
-        objectType = type;
     }
 };
 
+struct command_buffer_data;
+
 struct layer_data {
     VkInstance instance;
 
@@ -200,6 +294,8 @@ struct layer_data {
     uint32_t num_tmp_callbacks;
     VkDebugReportCallbackCreateInfoEXT *tmp_dbg_create_infos;
     VkDebugReportCallbackEXT *tmp_callbacks;
+    // Records of freed command buffers, kept for reuse until the device is destroyed. Guarded by global_lock.
+    std::vector<command_buffer_data *> free_command_buffers;
     counter<VkCommandBuffer> c_VkCommandBuffer;
     counter<VkDevice> c_VkDevice;
     counter<VkInstance> c_VkInstance;
@@ -301,40 +397,90 @@ WRAPPER(VkDebugReportCallbackEXT)
 WRAPPER(uint64_t)
 #endif // DISTINCT_NONDISPATCHABLE_HANDLES
 
-static std::unordered_map<void *, layer_data *> layer_data_map;
-static std::unordered_map<VkCommandBuffer, VkCommandPool> command_pool_map;
+static dispatch_key_map<layer_data> layer_data_map;
+
+// When set, vkBeginCommandBuffer starts a write use of the command buffer's pool that lasts until recording ends, and the
+// commands recorded in between skip the pool. Otherwise the pool is used for the duration of each call, as the spec
+// requires. Set from google_threading.command_pool_tracking.
+static bool pool_span_tracking = false;
+
+// Per command buffer record set up at vkAllocateCommandBuffers, found without a lock on every use of the command buffer.
+// pool only changes when a freed record is reused for another command buffer. pool_held is set while a recording span
+// holds the pool. pool_writes and pool_reads count the uses of the pool started on behalf of individual calls, so that a
+// finish only ever undoes a start that really happened, however pool_held changed in between.
+struct command_buffer_data {
+    std::atomic<VkCommandPool> pool;
+    std::atomic<bool> pool_held;
+    std::atomic<uint32_t> pool_writes;
+    std::atomic<uint32_t> pool_reads;
+    explicit command_buffer_data(VkCommandPool command_pool) { reset(command_pool); }
+    void reset(VkCommandPool command_pool) {
+        pool.store(command_pool);
+        pool_held.store(false);
+        pool_writes.store(0);
+        pool_reads.store(0);
+    }
+};
+static dispatch_key_map<command_buffer_data> command_buffer_map;
+// Command buffers allocated from each pool, guarded by global_lock
+static std::unordered_map<VkCommandPool, std::unordered_set<VkCommandBuffer>> command_pool_buffers;
+
+// Take one from count unless it is zero. Returns false if it was zero.
+static bool takePoolUse(std::atomic<uint32_t> &count) {
+    uint32_t uses = count.load();
+    while (uses && !count.compare_exchange_weak(uses, uses - 1)) {
+    }
+    return uses != 0;
+}
 
 // VkCommandBuffer needs check for implicit use of command pool
 static void startWriteObject(struct layer_data *my_data, VkCommandBuffer object, bool lockPool = true) {
     if (lockPool) {
-        std::unique_lock<std::mutex> lock(global_lock);
-        VkCommandPool pool = command_pool_map[object];
-        lock.unlock();
-        startWriteObject(my_data, pool);
+        command_buffer_data *cb_data = command_buffer_map.find(object);
+        if (cb_data && !cb_data->pool_held.load()) {
+            startWriteObject(my_data, cb_data->pool.load());
+            cb_data->pool_writes.fetch_add(1);
+        }
     }
     my_data->c_VkCommandBuffer.startWrite(my_data->report_data, object);
 }
 static void finishWriteObject(struct layer_data *my_data, VkCommandBuffer object, bool lockPool = true) {
     my_data->c_VkCommandBuffer.finishWrite(object);
     if (lockPool) {
-        std::unique_lock<std::mutex> lock(global_lock);
-        VkCommandPool pool = command_pool_map[object];
-        lock.unlock();
-        finishWriteObject(my_data, pool);
+        command_buffer_data *cb_data = command_buffer_map.find(object);
+        if (cb_data && takePoolUse(cb_data->pool_writes))
+            finishWriteObject(my_data, cb_data->pool.load());
     }
 }
 static void startReadObject(struct layer_data *my_data, VkCommandBuffer object) {
-    std::unique_lock<std::mutex> lock(global_lock);
-    VkCommandPool pool = command_pool_map[object];
-    lock.unlock();
-    startReadObject(my_data, pool);
+    command_buffer_data *cb_data = command_buffer_map.find(object);
+    if (cb_data && !cb_data->pool_held.load()) {
+        startReadObject(my_data, cb_data->pool.load());
+        cb_data->pool_reads.fetch_add(1);
+    }
     my_data->c_VkCommandBuffer.startRead(my_data->report_data, object);
 }
 static void finishReadObject(struct layer_data *my_data, VkCommandBuffer object) {
     my_data->c_VkCommandBuffer.finishRead(object);
-    std::unique_lock<std::mutex> lock(global_lock);
-    VkCommandPool pool = command_pool_map[object];
-    lock.unlock();
-    finishReadObject(my_data, pool);
+    command_buffer_data *cb_data = command_buffer_map.find(object);
+    if (cb_data && takePoolUse(cb_data->pool_reads))
+        finishReadObject(my_data, cb_data->pool.load());
+}
+
+// Start holding the pool of a command buffer that has begun recording, if recording spans are tracked
+static void holdCommandPool(struct layer_data *my_data, VkCommandBuffer object) {
+    if (!pool_span_tracking)
+        return;
+    command_buffer_data *cb_data = command_buffer_map.find(object);
+    if (cb_data && !cb_data->pool_held.exchange(true))
+        startWriteObject(my_data, cb_data->pool.load());
+}
+// Stop holding the pool of a command buffer that is no longer recording
+static void releaseCommandPool(struct layer_data *my_data, VkCommandBuffer object) {
+    if (!pool_span_tracking)
+        return;
+    command_buffer_data *cb_data = command_buffer_map.find(object);
+    if (cb_data && cb_data->pool_held.exchange(false))
+        finishWriteObject(my_data, cb_data->pool.load());
 }
 #endif // THREADING_H
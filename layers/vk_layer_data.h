@@ -40,4 +40,9 @@ template <typename DATA_T> DATA_T *get_my_data_ptr(void *data_key, std::unordere
     return debug_data;
 }
 
+// Lock-free lookup for the common case where the data already exists, see dispatch_key_map
+template <typename DATA_T> DATA_T *get_my_data_ptr(void *data_key, dispatch_key_map<DATA_T> &layer_data_map) {
+    return layer_data_map.find_or_create(data_key);
+}
+
 #endif // LAYER_DATA_H
@@ -28,18 +28,31 @@
 #include "vk_layer_table.h"
 #include "vk_loader_platform.h"
 #include "vulkan/vk_layer.h"
+#include <atomic>
+#include <chrono>
 #include <cinttypes>
+#include <condition_variable>
+#include <mutex>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+struct debug_report_async_log;
+struct debug_report_dedup;
+
 typedef struct _debug_report_data {
     VkLayerDbgFunctionNode *debug_callback_list;
     VkLayerDbgFunctionNode *default_debug_callback_list;
     VkFlags active_flags;
     bool g_DEBUG_REPORT;
+    // Non-null when the layer's log_mode setting is "async"
+    debug_report_async_log *async_log;
+    // Non-null when the layer's duplicate_message_limit setting is non-zero
+    debug_report_dedup *dedup;
 } debug_report_data;
 
 template debug_report_data *get_my_data_ptr<debug_report_data>(void *data_key,
@@ -49,6 +62,7 @@ template debug_report_data *get_my_data_ptr<debug_report_data>(void *data_key,
 static inline bool debug_report_log_msg(const debug_report_data *debug_data, VkFlags msgFlags,
                                         VkDebugReportObjectTypeEXT objectType, uint64_t srcObject, size_t location, int32_t msgCode,
                                         const char *pLayerPrefix, const char *pMsg);
+static inline void layer_debug_report_disable_dedup(debug_report_data *debug_data);
 
 // Add a debug message callback node structure to the specified callback linked list
 static inline void AddDebugMessageCallback(debug_report_data *debug_data, VkLayerDbgFunctionNode **list_head,
@@ -129,6 +143,185 @@ static inline bool debug_report_log_msg(const debug_report_data *debug_data, VkF
     return bail;
 }
 
+// Asynchronous logging
+//
+// When a layer's log_mode setting is "async", log_msg() claims a slot in a bounded multi-producer ring, formats the
+// message directly into that slot on the calling thread and returns without walking the callback list. A drain thread
+// owned by the debug_report_data delivers the records to the callbacks in the order their slots were claimed. If the
+// ring is full the message is dropped before it is formatted; drops are counted and reported as a single summary
+// message on the next drain.
+static const uint32_t DEBUG_REPORT_ASYNC_RING_SIZE = 1024; // Must be a power of two
+static const size_t DEBUG_REPORT_ASYNC_MSG_SIZE = 512;
+static const size_t DEBUG_REPORT_ASYNC_PREFIX_SIZE = 32;
+static const uint32_t DEBUG_REPORT_ASYNC_DRAIN_INTERVAL_MS = 10;
+
+struct debug_report_async_record {
+    // Slot is free for producer N when sequence == N, and holds a published record for consumer N when sequence == N + 1
+    std::atomic<uint32_t> sequence;
+    VkFlags msgFlags;
+    VkDebugReportObjectTypeEXT objectType;
+    uint64_t srcObject;
+    size_t location;
+    int32_t msgCode;
+    // Heap copy for the rare message that does not fit in msg
+    char *long_msg;
+    char layer_prefix[DEBUG_REPORT_ASYNC_PREFIX_SIZE];
+    char msg[DEBUG_REPORT_ASYNC_MSG_SIZE];
+};
+
+struct debug_report_async_log {
+    debug_report_async_record ring[DEBUG_REPORT_ASYNC_RING_SIZE];
+    std::atomic<uint32_t> enqueue_pos;
+    // Only touched with drain_lock held
+    uint32_t dequeue_pos;
+    std::atomic<uint64_t> dropped_count;
+    std::atomic<VkFlags> dropped_flags;
+    std::atomic<bool> stop;
+    // Serializes draining against changes to the callback lists
+    std::mutex drain_lock;
+    std::mutex wait_lock;
+    std::condition_variable wait_cv;
+    std::thread drain_thread;
+
+    debug_report_async_log() : enqueue_pos(0), dequeue_pos(0), dropped_count(0), dropped_flags(0), stop(false) {
+        for (uint32_t i = 0; i < DEBUG_REPORT_ASYNC_RING_SIZE; i++) {
+            ring[i].sequence.store(i, std::memory_order_relaxed);
+            ring[i].long_msg = nullptr;
+        }
+    }
+};
+
+// Deliver every published record to the callback lists. Caller must hold async_log->drain_lock.
+static inline void debug_report_async_drain(const debug_report_data *debug_data) {
+    debug_report_async_log *async_log = debug_data->async_log;
+
+    while (true) {
+        debug_report_async_record &record = async_log->ring[async_log->dequeue_pos & (DEBUG_REPORT_ASYNC_RING_SIZE - 1)];
+        if (record.sequence.load(std::memory_order_acquire) != async_log->dequeue_pos + 1) {
+            break;
+        }
+        debug_report_log_msg(debug_data, record.msgFlags, record.objectType, record.srcObject, record.location, record.msgCode,
+                             record.layer_prefix, record.long_msg ? record.long_msg : record.msg);
+        free(record.long_msg);
+        record.long_msg = nullptr;
+        record.sequence.store(async_log->dequeue_pos + DEBUG_REPORT_ASYNC_RING_SIZE, std::memory_order_release);
+        async_log->dequeue_pos++;
+    }
+
+    // Producers set dropped_flags before bumping dropped_count, so read them in the opposite order
+    uint64_t dropped = async_log->dropped_count.exchange(0);
+    if (dropped) {
+        VkFlags flags = async_log->dropped_flags.exchange(0);
+        char str[128];
+        snprintf(str, sizeof(str), "Asynchronous log queue was full, %" PRIu64 " message(s) dropped", dropped);
+        debug_report_log_msg(debug_data, flags, VK_DEBUG_REPORT_OBJECT_TYPE_DEBUG_REPORT_EXT, 0, 0, VK_DEBUG_REPORT_ERROR_NONE_EXT,
+                             "DebugReport", str);
+    }
+}
+
+static inline void debug_report_async_thread(const debug_report_data *debug_data) {
+    debug_report_async_log *async_log = debug_data->async_log;
+
+    while (!async_log->stop.load(std::memory_order_acquire)) {
+        {
+            std::lock_guard<std::mutex> lock(async_log->drain_lock);
+            debug_report_async_drain(debug_data);
+        }
+        std::unique_lock<std::mutex> lock(async_log->wait_lock);
+        if (!async_log->stop.load(std::memory_order_acquire)) {
+            async_log->wait_cv.wait_for(lock, std::chrono::milliseconds(DEBUG_REPORT_ASYNC_DRAIN_INTERVAL_MS));
+        }
+    }
+}
+
+// Queue a message for the drain thread. Callbacks have not run yet, so their return value can't be reported and the
+// result is always false.
+static inline bool debug_report_async_log_msg(const debug_report_data *debug_data, VkFlags msgFlags,
+                                              VkDebugReportObjectTypeEXT objectType, uint64_t srcObject, size_t location,
+                                              int32_t msgCode, const char *pLayerPrefix, const char *format, va_list argptr) {
+    debug_report_async_log *async_log = debug_data->async_log;
+    debug_report_async_record *record;
+    uint32_t pos = async_log->enqueue_pos.load(std::memory_order_relaxed);
+
+    while (true) {
+        record = &async_log->ring[pos & (DEBUG_REPORT_ASYNC_RING_SIZE - 1)];
+        int32_t diff = (int32_t)(record->sequence.load(std::memory_order_acquire) - pos);
+        if (diff == 0) {
+            if (async_log->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Ring is full, drop the message without formatting it
+            async_log->dropped_flags.fetch_or(msgFlags);
+            async_log->dropped_count.fetch_add(1);
+            async_log->wait_cv.notify_one();
+            return false;
+        } else {
+            pos = async_log->enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->msgFlags = msgFlags;
+    record->objectType = objectType;
+    record->srcObject = srcObject;
+    record->location = location;
+    record->msgCode = msgCode;
+    strncpy(record->layer_prefix, pLayerPrefix, DEBUG_REPORT_ASYNC_PREFIX_SIZE - 1);
+    record->layer_prefix[DEBUG_REPORT_ASYNC_PREFIX_SIZE - 1] = '\0';
+
+    va_list argcopy;
+    va_copy(argcopy, argptr);
+    int size = vsnprintf(record->msg, DEBUG_REPORT_ASYNC_MSG_SIZE, format, argptr);
+    if (size < 0) {
+        snprintf(record->msg, DEBUG_REPORT_ASYNC_MSG_SIZE, "Message formatting failure");
+    } else if ((size_t)size >= DEBUG_REPORT_ASYNC_MSG_SIZE) {
+        // Falls back to the truncated copy in msg if this allocation fails
+        record->long_msg = (char *)malloc(size + 1);
+        if (record->long_msg) {
+            vsnprintf(record->long_msg, size + 1, format, argcopy);
+        }
+    }
+    va_end(argcopy);
+
+    record->sequence.store(pos + 1, std::memory_order_release);
+
+    // The drain thread wakes up on its own every DEBUG_REPORT_ASYNC_DRAIN_INTERVAL_MS; only nudge it when a burst
+    // of messages is filling the ring
+    if ((pos & (DEBUG_REPORT_ASYNC_RING_SIZE / 4 - 1)) == 0) {
+        async_log->wait_cv.notify_one();
+    }
+    return false;
+}
+
+// Switch log_msg() for this debug_report_data to asynchronous delivery
+static inline void layer_debug_report_enable_async(debug_report_data *debug_data) {
+    if (!debug_data || debug_data->async_log) {
+        return;
+    }
+    debug_data->async_log = new debug_report_async_log;
+    debug_data->async_log->drain_thread = std::thread(debug_report_async_thread, debug_data);
+}
+
+// Stop the drain thread and deliver anything still queued
+static inline void layer_debug_report_disable_async(debug_report_data *debug_data) {
+    debug_report_async_log *async_log = debug_data->async_log;
+    if (!async_log) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(async_log->wait_lock);
+        async_log->stop.store(true, std::memory_order_release);
+    }
+    async_log->wait_cv.notify_all();
+    async_log->drain_thread.join();
+    {
+        std::lock_guard<std::mutex> lock(async_log->drain_lock);
+        debug_report_async_drain(debug_data);
+    }
+    debug_data->async_log = nullptr;
+    delete async_log;
+}
+
 static inline debug_report_data *
 debug_report_create_instance(VkLayerInstanceDispatchTable *table, VkInstance inst, uint32_t extension_count,
                              const char *const *ppEnabledExtensions) // layer or extension name to be enabled
@@ -156,6 +349,9 @@ debug_report_create_instance(VkLayerInstanceDispatchTable *table, VkInstance ins
 
 static inline void layer_debug_report_destroy_instance(debug_report_data *debug_data) {
     if (debug_data) {
+        // Report outstanding duplicate counts while the callbacks are still registered
+        layer_debug_report_disable_dedup(debug_data);
+        layer_debug_report_disable_async(debug_data);
         RemoveAllMessageCallbacks(debug_data, &debug_data->default_debug_callback_list);
         RemoveAllMessageCallbacks(debug_data, &debug_data->debug_callback_list);
         free(debug_data);
@@ -174,6 +370,12 @@ static inline void layer_debug_report_destroy_device(VkDevice device) {
 
 static inline void layer_destroy_msg_callback(debug_report_data *debug_data, VkDebugReportCallbackEXT callback,
                                               const VkAllocationCallbacks *pAllocator) {
+    std::unique_lock<std::mutex> lock;
+    if (debug_data->async_log) {
+        lock = std::unique_lock<std::mutex>(debug_data->async_log->drain_lock);
+        // Deliver queued messages before the callback goes away
+        debug_report_async_drain(debug_data);
+    }
     RemoveDebugMessageCallback(debug_data, &debug_data->debug_callback_list, callback);
     RemoveDebugMessageCallback(debug_data, &debug_data->default_debug_callback_list, callback);
 }
@@ -193,6 +395,10 @@ static inline VkResult layer_create_msg_callback(debug_report_data *debug_data,
     pNewDbgFuncNode->msgFlags = pCreateInfo->flags;
     pNewDbgFuncNode->pUserData = pCreateInfo->pUserData;
 
+    std::unique_lock<std::mutex> lock;
+    if (debug_data->async_log) {
+        lock = std::unique_lock<std::mutex>(debug_data->async_log->drain_lock);
+    }
     if (default_callback) {
         AddDebugMessageCallback(debug_data, &debug_data->default_debug_callback_list, pNewDbgFuncNode);
     } else {
@@ -332,6 +538,260 @@ static inline int vasprintf(char **strp, char const *fmt, va_list ap) {
 }
 #endif
 
+// Deferred delivery
+//
+// Validation that runs on a worker thread on behalf of an API call (see the core validation worker pool) diverts its
+// messages into a debug_report_deferred_log. The thread that made the API call then delivers each item's log in item
+// order with debug_report_deliver_deferred(), so callbacks only ever run on application threads and see messages in the
+// same order as serial validation would produce them.
+struct debug_report_deferred_msg {
+    VkFlags msgFlags;
+    VkDebugReportObjectTypeEXT objectType;
+    uint64_t srcObject;
+    size_t location;
+    int32_t msgCode;
+    const char *pLayerPrefix;
+    std::string msg;
+};
+typedef std::vector<debug_report_deferred_msg> debug_report_deferred_log;
+
+// The log this thread's messages are currently diverted into, or null. Deliberately not static, so every translation
+// unit of a layer shares the one thread-local slot.
+inline debug_report_deferred_log *&debug_report_deferred_target() {
+    static THREAD_LOCAL_DECL debug_report_deferred_log *target;
+    return target;
+}
+
+// Divert this thread's messages into a log for the lifetime of the scope
+class debug_report_defer_scope {
+  public:
+    explicit debug_report_defer_scope(debug_report_deferred_log *log) : previous_(debug_report_deferred_target()) {
+        debug_report_deferred_target() = log;
+    }
+    ~debug_report_defer_scope() { debug_report_deferred_target() = previous_; }
+
+  private:
+    debug_report_defer_scope(const debug_report_defer_scope &) = delete;
+    debug_report_defer_scope &operator=(const debug_report_defer_scope &) = delete;
+
+    debug_report_deferred_log *previous_;
+};
+
+// Format a message and hand it to the callbacks, either directly or through the asynchronous queue
+static inline bool debug_report_vlog_msg(const debug_report_data *debug_data, VkFlags msgFlags,
+                                         VkDebugReportObjectTypeEXT objectType, uint64_t srcObject, size_t location,
+                                         int32_t msgCode, const char *pLayerPrefix, const char *format, va_list argptr) {
+    debug_report_deferred_log *deferred = debug_report_deferred_target();
+    if (deferred) {
+        char *str;
+        if (-1 == vasprintf(&str, format, argptr)) {
+            str = nullptr;
+        }
+        debug_report_deferred_msg message = {msgFlags, objectType, srcObject, location, msgCode, pLayerPrefix,
+                                             str ? str : "Allocation failure"};
+        free(str);
+        deferred->push_back(std::move(message));
+        // Whether a callback asks to skip the call is only known once the message is delivered
+        return false;
+    }
+    if (debug_data->async_log) {
+        return debug_report_async_log_msg(debug_data, msgFlags, objectType, srcObject, location, msgCode, pLayerPrefix, format,
+                                          argptr);
+    }
+    char *str;
+    if (-1 == vasprintf(&str, format, argptr)) {
+        // On failure, glibc vasprintf leaves str undefined
+        str = nullptr;
+    }
+    bool result = debug_report_log_msg(debug_data, msgFlags, objectType, srcObject, location, msgCode, pLayerPrefix,
+                                       str ? str : "Allocation failure");
+    free(str);
+    return result;
+}
+
+static inline bool debug_report_format_msg(const debug_report_data *debug_data, VkFlags msgFlags,
+                                           VkDebugReportObjectTypeEXT objectType, uint64_t srcObject, size_t location,
+                                           int32_t msgCode, const char *pLayerPrefix, const char *format, ...) {
+    va_list argptr;
+    va_start(argptr, format);
+    bool result = debug_report_vlog_msg(debug_data, msgFlags, objectType, srcObject, location, msgCode, pLayerPrefix, format,
+                                        argptr);
+    va_end(argptr);
+    return result;
+}
+
+static inline void debug_report_dedup_record(const debug_report_data *debug_data, uint64_t srcObject, int32_t msgCode,
+                                             const char *pLayerPrefix, bool bail);
+
+// Deliver the messages diverted into a deferred log. Returns true if any callback asked for the call to be skipped.
+static inline bool debug_report_deliver_deferred(const debug_report_data *debug_data, const debug_report_deferred_log &log) {
+    bool bail = false;
+    for (auto &message : log) {
+        bool result = debug_report_format_msg(debug_data, message.msgFlags, message.objectType, message.srcObject,
+                                              message.location, message.msgCode, message.pLayerPrefix, "%s", message.msg.c_str());
+        if (debug_data->dedup) {
+            debug_report_dedup_record(debug_data, message.srcObject, message.msgCode, message.pLayerPrefix, result);
+        }
+        bail |= result;
+    }
+    return bail;
+}
+
+// Duplicate message suppression
+//
+// When a layer's duplicate_message_limit setting is non-zero, log_msg() reports each (msgCode, srcObject, layer prefix)
+// combination at most that many times per duplicate_message_window_ms (or for the life of the instance if no window is
+// set). Repeats beyond the budget cost a hash probe and are never formatted, but still return whatever the callbacks
+// answered for the last reported copy so a callback that asks for calls to be skipped keeps blocking them. When a key's
+// window rolls over, or the instance is destroyed, a single "suppressed N duplicate(s)" message is reported in their place.
+static const size_t DEBUG_REPORT_DEDUP_MAX_KEYS = 65536;
+
+struct debug_report_dedup_key {
+    int32_t msgCode;
+    uint64_t srcObject;
+    // log_msg() callers pass string literals or static layer names, so the pointer outlives the entry
+    const char *pLayerPrefix;
+};
+
+struct debug_report_dedup_key_hash {
+    size_t operator()(const debug_report_dedup_key &key) const {
+        size_t hash = std::hash<uint64_t>()(key.srcObject) ^ ((size_t)key.msgCode * 0x9E3779B9u);
+        for (const char *c = key.pLayerPrefix; *c; c++) {
+            hash = hash * 31 + *c;
+        }
+        return hash;
+    }
+};
+
+struct debug_report_dedup_key_equal {
+    bool operator()(const debug_report_dedup_key &a, const debug_report_dedup_key &b) const {
+        return a.msgCode == b.msgCode && a.srcObject == b.srcObject &&
+               (a.pLayerPrefix == b.pLayerPrefix || !strcmp(a.pLayerPrefix, b.pLayerPrefix));
+    }
+};
+
+struct debug_report_dedup_entry {
+    uint32_t reported;
+    uint64_t suppressed;
+    VkFlags msgFlags;
+    VkDebugReportObjectTypeEXT objectType;
+    std::chrono::steady_clock::time_point window_start;
+    // Last callback answer for this key, returned in place of suppressed repeats
+    bool bail;
+};
+
+struct debug_report_dedup {
+    uint32_t limit;
+    std::chrono::milliseconds window;
+    std::mutex lock;
+    std::unordered_map<debug_report_dedup_key, debug_report_dedup_entry, debug_report_dedup_key_hash,
+                       debug_report_dedup_key_equal> entries;
+
+    debug_report_dedup(uint32_t limit, uint32_t window_ms) : limit(limit), window(window_ms) {}
+};
+
+static inline void debug_report_dedup_summary(const debug_report_data *debug_data, const debug_report_dedup_key &key,
+                                              const debug_report_dedup_entry &entry, uint64_t suppressed) {
+    debug_report_format_msg(debug_data, entry.msgFlags, entry.objectType, key.srcObject, 0, key.msgCode, key.pLayerPrefix,
+                            "Suppressed %" PRIu64 " duplicate(s) of message code %d for object 0x%" PRIx64, suppressed,
+                            key.msgCode, key.srcObject);
+}
+
+// Returns false if this message is over its budget and should be dropped, setting *bail to the callbacks' last answer
+// for it. Reports the suppressed count for the previous window first if the window has rolled over.
+static inline bool debug_report_dedup_check(const debug_report_data *debug_data, VkFlags msgFlags,
+                                            VkDebugReportObjectTypeEXT objectType, uint64_t srcObject, int32_t msgCode,
+                                            const char *pLayerPrefix, bool *bail) {
+    debug_report_dedup *dedup = debug_data->dedup;
+    debug_report_dedup_key key = {msgCode, srcObject, pLayerPrefix};
+    debug_report_dedup_entry summary_entry;
+    uint64_t suppressed = 0;
+    {
+        std::lock_guard<std::mutex> lock(dedup->lock);
+        auto it = dedup->entries.find(key);
+        if (it == dedup->entries.end()) {
+            if (dedup->entries.size() >= DEBUG_REPORT_DEDUP_MAX_KEYS) {
+                // Stop tracking new keys rather than grow without bound
+                return true;
+            }
+            debug_report_dedup_entry entry = {1, 0, msgFlags, objectType, std::chrono::steady_clock::now(), false};
+            dedup->entries.emplace(key, entry);
+            return true;
+        }
+        debug_report_dedup_entry &entry = it->second;
+        if (dedup->window.count()) {
+            auto now = std::chrono::steady_clock::now();
+            if (now - entry.window_start >= dedup->window) {
+                suppressed = entry.suppressed;
+                summary_entry = entry;
+                entry.reported = 0;
+                entry.suppressed = 0;
+                entry.window_start = now;
+            }
+        }
+        entry.msgFlags = msgFlags;
+        entry.objectType = objectType;
+        if (entry.reported >= dedup->limit) {
+            entry.suppressed++;
+            *bail = entry.bail;
+            return false;
+        }
+        entry.reported++;
+    }
+    if (suppressed) {
+        debug_report_dedup_summary(debug_data, key, summary_entry, suppressed);
+    }
+    return true;
+}
+
+// Remember what the callbacks answered for a reported message
+static inline void debug_report_dedup_record(const debug_report_data *debug_data, uint64_t srcObject, int32_t msgCode,
+                                             const char *pLayerPrefix, bool bail) {
+    debug_report_dedup *dedup = debug_data->dedup;
+    debug_report_dedup_key key = {msgCode, srcObject, pLayerPrefix};
+    std::lock_guard<std::mutex> lock(dedup->lock);
+    auto it = dedup->entries.find(key);
+    if (it != dedup->entries.end()) {
+        it->second.bail = bail;
+    }
+}
+
+// Report every outstanding suppressed count and reset the counters
+static inline void debug_report_dedup_flush(const debug_report_data *debug_data) {
+    debug_report_dedup *dedup = debug_data->dedup;
+    if (!dedup) {
+        return;
+    }
+    std::vector<std::pair<debug_report_dedup_key, debug_report_dedup_entry>> pending;
+    {
+        std::lock_guard<std::mutex> lock(dedup->lock);
+        for (auto &it : dedup->entries) {
+            if (it.second.suppressed) {
+                pending.push_back(it);
+                it.second.suppressed = 0;
+            }
+        }
+    }
+    for (auto &it : pending) {
+        debug_report_dedup_summary(debug_data, it.first, it.second, it.second.suppressed);
+    }
+}
+
+// Enable duplicate suppression with a budget of limit reports per key per window_ms (0 meaning no window)
+static inline void layer_debug_report_enable_dedup(debug_report_data *debug_data, uint32_t limit, uint32_t window_ms) {
+    if (!debug_data || debug_data->dedup || !limit) {
+        return;
+    }
+    debug_data->dedup = new debug_report_dedup(limit, window_ms);
+}
+
+// Report outstanding suppressed counts and stop suppressing duplicates
+static inline void layer_debug_report_disable_dedup(debug_report_data *debug_data) {
+    debug_report_dedup_flush(debug_data);
+    delete debug_data->dedup;
+    debug_data->dedup = nullptr;
+}
+
 // Output log message via DEBUG_REPORT
 // Takes format and variable arg list so that output string
 // is only computed if a message needs to be logged
@@ -348,17 +808,22 @@ static inline bool log_msg(const debug_report_data *debug_data, VkFlags msgFlags
         return false;
     }
 
+    bool bail = false;
+    if (debug_data->dedup &&
+        !debug_report_dedup_check(debug_data, msgFlags, objectType, srcObject, msgCode, pLayerPrefix, &bail)) {
+        // Duplicate is over its budget, repeat the callbacks' last answer
+        return bail;
+    }
+
     va_list argptr;
     va_start(argptr, format);
-    char *str;
-    if (-1 == vasprintf(&str, format, argptr)) {
-        // On failure, glibc vasprintf leaves str undefined
-        str = nullptr;
-    }
+    bool result = debug_report_vlog_msg(debug_data, msgFlags, objectType, srcObject, location, msgCode, pLayerPrefix, format,
+                                        argptr);
     va_end(argptr);
-    bool result = debug_report_log_msg(debug_data, msgFlags, objectType, srcObject, location, msgCode, pLayerPrefix,
-                                       str ? str : "Allocation failure");
-    free(str);
+    if (debug_data->dedup && !debug_report_deferred_target()) {
+        // Deferred messages are recorded when they are delivered
+        debug_report_dedup_record(debug_data, srcObject, msgCode, pLayerPrefix, result);
+    }
     return result;
 }
 
@@ -0,0 +1,311 @@
+/* Copyright (c) 2015-2016 The Khronos Group Inc.
+ * Copyright (c) 2015-2016 Valve Corporation
+ * Copyright (c) 2015-2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LAYER_PROFILE_H
+#define LAYER_PROFILE_H
+
+#include "vk_layer_config.h"
+#include "vk_loader_platform.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <inttypes.h>
+#include <memory>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// Opt-in timing of a layer's entry points, enabled by the <LayerIdentifier>.profile_filename setting. Every intercepted
+// function records its call count, its self time -- the time spent in the layer, excluding the downstream dispatch and
+// any nested entry point -- and the time spent in the downstream dispatch. Self times are binned in a log-linear
+// histogram so that percentiles can be reported without keeping samples. The totals are rewritten to the profile file
+// as CSV or JSON every <LayerIdentifier>.profile_interval_ms, and when the last instance is destroyed.
+//
+// Each layer owns one static layer_profiler, started and stopped next to its debug report setup, and marks its entry
+// points with LAYER_PROFILE_ENTRY_POINT and its calls down the chain with LAYER_PROFILE_DISPATCH. While profiling is
+// off both cost a single test of layer_profiler::enabled.
+
+// Self times below 8ns get a bucket each, then every power of two is split into 8 linear buckets
+#define LAYER_PROFILE_SUB_BUCKETS 8
+#define LAYER_PROFILE_BUCKET_COUNT (LAYER_PROFILE_SUB_BUCKETS * 40)
+
+struct layer_profile_entry {
+    std::string name;
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> self_ns;
+    std::atomic<uint64_t> dispatch_ns;
+    std::atomic<uint32_t> histogram[LAYER_PROFILE_BUCKET_COUNT];
+
+    explicit layer_profile_entry(const char *entry_name) : name(entry_name), calls(0), self_ns(0), dispatch_ns(0) {
+        for (auto &bucket : histogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+struct layer_profiler {
+    // Read without the lock by every entry point
+    std::atomic<bool> enabled;
+    bool json;
+    bool stop;
+    uint32_t start_count;
+    uint32_t interval_ms;
+    std::string layer_identifier;
+    std::string filename;
+    // Guards everything below, the fields above are only written with it held
+    std::mutex lock;
+    std::vector<std::unique_ptr<layer_profile_entry>> entries;
+    std::thread dump_thread;
+    std::condition_variable dump_cv;
+
+    layer_profiler() : enabled(false), json(false), stop(false), start_count(0), interval_ms(0) {}
+    ~layer_profiler();
+};
+
+static inline uint32_t layer_profile_bucket(uint64_t ns) {
+    if (ns < LAYER_PROFILE_SUB_BUCKETS)
+        return static_cast<uint32_t>(ns);
+    uint32_t shift = 0;
+    while ((ns >> shift) >= 2 * LAYER_PROFILE_SUB_BUCKETS) {
+        shift++;
+    }
+    uint32_t bucket = (shift + 1) * LAYER_PROFILE_SUB_BUCKETS + static_cast<uint32_t>((ns >> shift) - LAYER_PROFILE_SUB_BUCKETS);
+    return bucket < LAYER_PROFILE_BUCKET_COUNT ? bucket : LAYER_PROFILE_BUCKET_COUNT - 1;
+}
+
+// Smallest self time that falls in the bucket after this one
+static inline uint64_t layer_profile_bucket_limit(uint32_t bucket) {
+    if (bucket < LAYER_PROFILE_SUB_BUCKETS)
+        return bucket + 1;
+    uint32_t shift = bucket / LAYER_PROFILE_SUB_BUCKETS - 1;
+    return static_cast<uint64_t>(LAYER_PROFILE_SUB_BUCKETS + bucket % LAYER_PROFILE_SUB_BUCKETS + 1) << shift;
+}
+
+// Upper bound of the self time that fraction of the calls took at most
+static inline uint64_t layer_profile_percentile(const std::vector<uint32_t> &histogram, uint64_t calls, double fraction) {
+    uint64_t target = static_cast<uint64_t>(fraction * calls + 0.5);
+    uint64_t seen = 0;
+    for (uint32_t bucket = 0; bucket < histogram.size(); ++bucket) {
+        seen += histogram[bucket];
+        if (seen >= target && seen > 0)
+            return layer_profile_bucket_limit(bucket);
+    }
+    return 0;
+}
+
+static inline layer_profile_entry *layer_profile_get_entry(layer_profiler *profiler, const char *name) {
+    std::lock_guard<std::mutex> lock(profiler->lock);
+    for (auto const &entry : profiler->entries) {
+        if (entry->name == name)
+            return entry.get();
+    }
+    profiler->entries.emplace_back(new layer_profile_entry(name));
+    return profiler->entries.back().get();
+}
+
+// Rewrite the profile file with the totals so far. Caller must hold profiler->lock.
+static inline void layer_profile_write(layer_profiler *profiler) {
+    FILE *output = fopen(profiler->filename.c_str(), "w");
+    if (!output)
+        return;
+    if (profiler->json) {
+        fprintf(output, "{\n  \"layer\": \"%s\",\n  \"entry_points\": [", profiler->layer_identifier.c_str());
+    } else {
+        fprintf(output, "entry_point,calls,self_total_ns,self_p50_ns,self_p99_ns,dispatch_total_ns\n");
+    }
+    const char *separator = "\n";
+    std::vector<uint32_t> histogram(LAYER_PROFILE_BUCKET_COUNT);
+    for (auto const &entry : profiler->entries) {
+        uint64_t calls = entry->calls.load(std::memory_order_relaxed);
+        if (!calls)
+            continue;
+        for (uint32_t bucket = 0; bucket < LAYER_PROFILE_BUCKET_COUNT; ++bucket) {
+            histogram[bucket] = entry->histogram[bucket].load(std::memory_order_relaxed);
+        }
+        uint64_t self_ns = entry->self_ns.load(std::memory_order_relaxed);
+        uint64_t dispatch_ns = entry->dispatch_ns.load(std::memory_order_relaxed);
+        uint64_t p50 = layer_profile_percentile(histogram, calls, 0.50);
+        uint64_t p99 = layer_profile_percentile(histogram, calls, 0.99);
+        if (profiler->json) {
+            fprintf(output, "%s    {\"entry_point\": \"%s\", \"calls\": %" PRIu64 ", \"self_total_ns\": %" PRIu64
+                            ", \"self_p50_ns\": %" PRIu64 ", \"self_p99_ns\": %" PRIu64 ", \"dispatch_total_ns\": %" PRIu64 "}",
+                    separator, entry->name.c_str(), calls, self_ns, p50, p99, dispatch_ns);
+            separator = ",\n";
+        } else {
+            fprintf(output, "%s,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n", entry->name.c_str(), calls,
+                    self_ns, p50, p99, dispatch_ns);
+        }
+    }
+    if (profiler->json) {
+        fprintf(output, "\n  ]\n}\n");
+    }
+    fclose(output);
+}
+
+static inline void layer_profile_thread(layer_profiler *profiler) {
+    std::unique_lock<std::mutex> lock(profiler->lock);
+    while (!profiler->stop) {
+        profiler->dump_cv.wait_for(lock, std::chrono::milliseconds(profiler->interval_ms));
+        if (!profiler->stop) {
+            layer_profile_write(profiler);
+        }
+    }
+}
+
+// Called once per instance created, next to layer_debug_actions
+static inline void layer_profile_start(layer_profiler *profiler, const char *layer_identifier) {
+    std::string filename_key = layer_identifier;
+    std::string format_key = layer_identifier;
+    std::string interval_key = layer_identifier;
+    filename_key.append(".profile_filename");
+    format_key.append(".profile_format");
+    interval_key.append(".profile_interval_ms");
+
+    const char *filename = getLayerOption(filename_key.c_str());
+    if (!filename || !*filename)
+        return;
+    std::lock_guard<std::mutex> lock(profiler->lock);
+    if (profiler->start_count++ > 0)
+        return;
+    profiler->layer_identifier = layer_identifier;
+    profiler->filename = filename;
+    profiler->json = !strcmp(getLayerOption(format_key.c_str()), "json");
+    profiler->interval_ms = (uint32_t)strtoul(getLayerOption(interval_key.c_str()), nullptr, 10);
+    profiler->stop = false;
+    if (profiler->interval_ms) {
+        profiler->dump_thread = std::thread(layer_profile_thread, profiler);
+    }
+    profiler->enabled.store(true, std::memory_order_relaxed);
+}
+
+// Stop profiling, join the dump thread and write the final totals. Caller must hold lock on profiler->lock.
+static inline void layer_profile_finish(layer_profiler *profiler, std::unique_lock<std::mutex> &lock) {
+    profiler->enabled.store(false, std::memory_order_relaxed);
+    profiler->stop = true;
+    profiler->dump_cv.notify_all();
+    if (profiler->dump_thread.joinable()) {
+        lock.unlock();
+        profiler->dump_thread.join();
+        lock.lock();
+    }
+    layer_profile_write(profiler);
+}
+
+// Called once per instance destroyed; the last call writes the final totals
+static inline void layer_profile_stop(layer_profiler *profiler) {
+    std::unique_lock<std::mutex> lock(profiler->lock);
+    if (!profiler->start_count || --profiler->start_count > 0)
+        return;
+    layer_profile_finish(profiler, lock);
+}
+
+// An application that exits without destroying its instances leaves the profiler started. Finish it when the layer's
+// statics are destroyed, so the dump thread is joined instead of being destroyed while joinable, which would terminate
+// the process, and the totals are still written.
+inline layer_profiler::~layer_profiler() {
+    std::unique_lock<std::mutex> guard(lock);
+    if (start_count) {
+        start_count = 0;
+        layer_profile_finish(this, guard);
+    }
+}
+
+class layer_profile_scope;
+static THREAD_LOCAL_DECL layer_profile_scope *layer_profile_current_scope;
+
+// Times one call of an entry point. Dispatches and nested entry points made while it is the innermost scope on the
+// thread are subtracted from its self time.
+class layer_profile_scope {
+  public:
+    layer_profile_scope(layer_profiler &profiler, std::atomic<layer_profile_entry *> &slot, const char *name)
+        : entry_(nullptr), parent_(nullptr), dispatch_ns_(0), nested_ns_(0) {
+        if (!profiler.enabled.load(std::memory_order_relaxed))
+            return;
+        entry_ = slot.load(std::memory_order_acquire);
+        if (!entry_) {
+            entry_ = layer_profile_get_entry(&profiler, name);
+            slot.store(entry_, std::memory_order_release);
+        }
+        parent_ = layer_profile_current_scope;
+        layer_profile_current_scope = this;
+        start_ = std::chrono::steady_clock::now();
+    }
+    ~layer_profile_scope() {
+        if (!entry_)
+            return;
+        uint64_t total_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+        uint64_t self_ns = total_ns > nested_ns_ ? total_ns - nested_ns_ : 0;
+        entry_->calls.fetch_add(1, std::memory_order_relaxed);
+        entry_->self_ns.fetch_add(self_ns, std::memory_order_relaxed);
+        entry_->dispatch_ns.fetch_add(dispatch_ns_, std::memory_order_relaxed);
+        entry_->histogram[layer_profile_bucket(self_ns)].fetch_add(1, std::memory_order_relaxed);
+        layer_profile_current_scope = parent_;
+        if (parent_) {
+            parent_->nested_ns_ += total_ns;
+        }
+    }
+
+  private:
+    friend class layer_profile_dispatch;
+    layer_profile_entry *entry_;
+    layer_profile_scope *parent_;
+    uint64_t dispatch_ns_;
+    uint64_t nested_ns_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Times one call down the chain, charging it to the innermost entry point scope. Entry points of this layer reached
+// again through the chain are timed as top level calls rather than charged twice.
+class layer_profile_dispatch {
+  public:
+    explicit layer_profile_dispatch(const layer_profiler &profiler)
+        : scope_(profiler.enabled.load(std::memory_order_relaxed) ? layer_profile_current_scope : nullptr) {
+        if (scope_) {
+            layer_profile_current_scope = nullptr;
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    ~layer_profile_dispatch() {
+        if (scope_) {
+            uint64_t ns =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+            scope_->dispatch_ns_ += ns;
+            scope_->nested_ns_ += ns;
+            layer_profile_current_scope = scope_;
+        }
+    }
+
+  private:
+    layer_profile_scope *scope_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Open the profile scope of the entry point name for the rest of the enclosing function
+#define LAYER_PROFILE_ENTRY_POINT(profiler, name)                                                                              \
+    static std::atomic<layer_profile_entry *> layer_profile_slot;                                                              \
+    layer_profile_scope layer_profile_entry_scope(profiler, layer_profile_slot, name)
+
+// Evaluate a call down the chain, timing it as dispatch. The timer lives until the end of the full expression.
+#define LAYER_PROFILE_DISPATCH(profiler, call) (layer_profile_dispatch(profiler), call)
+
+#endif // LAYER_PROFILE_H
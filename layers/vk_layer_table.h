@@ -21,10 +21,252 @@
 
 #include "vulkan/vk_layer.h"
 #include "vulkan/vulkan.h"
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
-typedef std::unordered_map<void *, VkLayerDispatchTable *> device_table_map;
-typedef std::unordered_map<void *, VkLayerInstanceDispatchTable *> instance_table_map;
+#include "vk_loader_platform.h"
+
+// Index of the calling thread's reader counter in a dispatch_key_map
+static inline uint32_t dispatch_key_reader_stripe() {
+    static std::atomic<uint32_t> next_stripe;
+    static THREAD_LOCAL_DECL uint32_t stripe_plus_one; // Zero until the thread's first lookup
+    if (!stripe_plus_one)
+        stripe_plus_one = next_stripe.fetch_add(1) + 1;
+    return stripe_plus_one - 1;
+}
+
+// Read-mostly map from a dispatch key to a per-instance or per-device pointer (dispatch table or layer data).
+//  Instances and devices are created and destroyed rarely but looked up on every call, so find() takes no lock: entries
+//  live in a small open-addressed table of atomic slots. Writers are serialized by a mutex. Erased entries keep their key
+//  with a null value so probe chains stay intact; a key that is inserted again (dispatch tables get reused) takes its old
+//  slot back.
+//  When erased entries fill up the table it is rehashed in place, and readers retry if a rehash overlapped their probe,
+//  which they detect from a sequence number that is odd while a rehash is in progress. When live entries fill up the
+//  table it is replaced by a larger copy. The old table is retired and freed by a later write once no reader is inside
+//  find(), which readers announce on one of a few striped counters, or when the map is destroyed.
+template <typename T> class dispatch_key_map {
+  public:
+    dispatch_key_map() : table_(new table(initial_capacity, nullptr)), used_(0), size_(0), sequence_(0) {
+        for (auto &readers : readers_)
+            readers.count.store(0);
+    }
+    ~dispatch_key_map() {
+        table *t = table_.load();
+        while (t) {
+            table *retired = t->retired;
+            delete t;
+            t = retired;
+        }
+    }
+
+    // Return the value stored for key, or nullptr if there is none
+    T *find(const void *key) const {
+        reader_scope scope(readers_[dispatch_key_reader_stripe() % reader_stripes].count);
+        for (;;) {
+            uint32_t sequence = sequence_.load(std::memory_order_acquire);
+            const table *t = table_.load();
+            T *value = nullptr;
+            for (size_t i = hash(key) & t->mask, probes = 0; probes <= t->mask; i = (i + 1) & t->mask, ++probes) {
+                const void *slot_key = t->slots[i].key.load(std::memory_order_acquire);
+                if (slot_key == key) {
+                    value = t->slots[i].value.load(std::memory_order_acquire);
+                    break;
+                }
+                if (!slot_key)
+                    break;
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (!(sequence & 1) && sequence_.load(std::memory_order_relaxed) == sequence)
+                return value;
+        }
+    }
+
+    // Store value for key, replacing any existing value
+    void insert(const void *key, T *value) {
+        std::lock_guard<std::mutex> lock(write_lock_);
+        insert_locked(key, value);
+        reclaim_retired();
+    }
+
+    // Return the value stored for key, creating a default constructed one if there is none
+    T *find_or_create(const void *key) {
+        T *value = find(key);
+        if (!value) {
+            std::lock_guard<std::mutex> lock(write_lock_);
+            value = find(key);
+            if (!value) {
+                value = new T;
+                insert_locked(key, value);
+                reclaim_retired();
+            }
+        }
+        return value;
+    }
+
+    // Remove key from the map. The value is not deleted.
+    void erase(const void *key) {
+        std::lock_guard<std::mutex> lock(write_lock_);
+        slot *s = find_slot(table_.load(), key);
+        if (s && s->value.load()) {
+            s->value.store(nullptr, std::memory_order_release);
+            --size_;
+        }
+        reclaim_retired();
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+  private:
+    dispatch_key_map(const dispatch_key_map &) = delete;
+    dispatch_key_map &operator=(const dispatch_key_map &) = delete;
+
+    static const size_t initial_capacity = 16;
+    static const size_t reader_stripes = 16;
+
+    struct slot {
+        std::atomic<const void *> key;
+        std::atomic<T *> value;
+        slot() : key(nullptr), value(nullptr) {}
+    };
+    struct table {
+        size_t mask;
+        slot *slots;
+        table *retired;
+        table(size_t capacity, table *retired_table) : mask(capacity - 1), slots(new slot[capacity]), retired(retired_table) {}
+        ~table() { delete[] slots; }
+    };
+    // Number of threads inside find(), padded so that threads on different stripes do not share a cache line
+    struct reader_count {
+        std::atomic<uint32_t> count;
+        char padding[64 - sizeof(std::atomic<uint32_t>)];
+    };
+    struct reader_scope {
+        std::atomic<uint32_t> &count;
+        explicit reader_scope(std::atomic<uint32_t> &readers) : count(readers) { count.fetch_add(1); }
+        ~reader_scope() { count.fetch_sub(1, std::memory_order_release); }
+    };
+
+    static size_t hash(const void *key) {
+        // Keys are pointers to loader dispatch tables, so the low bits carry no information
+        uintptr_t k = reinterpret_cast<uintptr_t>(key) >> 4;
+        return static_cast<size_t>(k ^ (k >> 9) ^ (k >> 17));
+    }
+
+    static slot *find_slot(table *t, const void *key) {
+        for (size_t i = hash(key) & t->mask, probes = 0; probes <= t->mask; i = (i + 1) & t->mask, ++probes) {
+            const void *slot_key = t->slots[i].key.load();
+            if (slot_key == key)
+                return &t->slots[i];
+            if (!slot_key)
+                break;
+        }
+        return nullptr;
+    }
+
+    // Caller must hold write_lock_
+    void insert_locked(const void *key, T *value) {
+        table *t = table_.load();
+        slot *s = find_slot(t, key);
+        if (s) {
+            if (!s->value.load())
+                ++size_;
+            s->value.store(value, std::memory_order_release);
+            return;
+        }
+        // Keep the load factor (including erased slots) at or below one half
+        if (2 * (used_ + 1) > t->mask + 1) {
+            if (4 * (size_ + 1) > t->mask + 1) {
+                grow(t);
+                t = table_.load();
+            } else {
+                rehash_in_place(t);
+            }
+        }
+        claim_slot(t, key, value);
+        ++used_;
+        ++size_;
+    }
+
+    // Replace t with a copy of twice the capacity and retire t. Caller must hold write_lock_.
+    void grow(table *t) {
+        table *grown = new table(2 * (t->mask + 1), t);
+        used_ = 0;
+        for (size_t i = 0; i <= t->mask; ++i) {
+            T *old_value = t->slots[i].value.load();
+            if (old_value) {
+                claim_slot(grown, t->slots[i].key.load(), old_value);
+                ++used_;
+            }
+        }
+        table_.store(grown);
+    }
+
+    // Drop the erased slots of t without moving to a new table. Caller must hold write_lock_.
+    void rehash_in_place(table *t) {
+        std::vector<std::pair<const void *, T *>> live;
+        for (size_t i = 0; i <= t->mask; ++i) {
+            T *old_value = t->slots[i].value.load();
+            if (old_value)
+                live.emplace_back(t->slots[i].key.load(), old_value);
+        }
+        uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i <= t->mask; ++i) {
+            t->slots[i].key.store(nullptr, std::memory_order_relaxed);
+            t->slots[i].value.store(nullptr, std::memory_order_relaxed);
+        }
+        for (auto const &entry : live)
+            claim_slot(t, entry.first, entry.second);
+        sequence_.store(sequence + 2, std::memory_order_release);
+        used_ = live.size();
+    }
+
+    // Free the tables retired by grow() if no reader can still be using them. A reader announces itself before it
+    // loads table_, and grow() publishes the new table before this checks the announcements, so a reader that is not
+    // seen here loads the new table. Caller must hold write_lock_.
+    void reclaim_retired() {
+        table *t = table_.load();
+        if (!t->retired)
+            return;
+        for (auto const &readers : readers_) {
+            if (readers.count.load())
+                return;
+        }
+        table *retired = t->retired;
+        t->retired = nullptr;
+        while (retired) {
+            table *next = retired->retired;
+            delete retired;
+            retired = next;
+        }
+    }
+
+    // Fill the first empty slot on key's probe chain. The value is published before the key so that a reader that
+    // observes the key also observes the value.
+    static void claim_slot(table *t, const void *key, T *value) {
+        size_t i = hash(key) & t->mask;
+        while (t->slots[i].key.load())
+            i = (i + 1) & t->mask;
+        t->slots[i].value.store(value, std::memory_order_relaxed);
+        t->slots[i].key.store(key, std::memory_order_release);
+    }
+
+    std::atomic<table *> table_;
+    std::mutex write_lock_;
+    size_t used_;
+    std::atomic<size_t> size_;
+    std::atomic<uint32_t> sequence_;
+    mutable reader_count readers_[reader_stripes];
+};
+
+typedef dispatch_key_map<VkLayerDispatchTable> device_table_map;
+typedef dispatch_key_map<VkLayerInstanceDispatchTable> instance_table_map;
 VkLayerDispatchTable *initDeviceTable(VkDevice device, const PFN_vkGetDeviceProcAddr gpa, device_table_map &map);
 VkLayerDispatchTable *initDeviceTable(VkDevice device, const PFN_vkGetDeviceProcAddr gpa);
 VkLayerInstanceDispatchTable *initInstanceTable(VkInstance instance, const PFN_vkGetInstanceProcAddr gpa, instance_table_map &map);
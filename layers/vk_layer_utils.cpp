@@ -623,9 +623,15 @@ void layer_debug_actions(debug_report_data *report_data, std::vector<VkDebugRepo
     std::string report_flags_key = layer_identifier;
     std::string debug_action_key = layer_identifier;
     std::string log_filename_key = layer_identifier;
+    std::string log_mode_key = layer_identifier;
+    std::string duplicate_limit_key = layer_identifier;
+    std::string duplicate_window_key = layer_identifier;
     report_flags_key.append(".report_flags");
     debug_action_key.append(".debug_action");
     log_filename_key.append(".log_filename");
+    log_mode_key.append(".log_mode");
+    duplicate_limit_key.append(".duplicate_message_limit");
+    duplicate_window_key.append(".duplicate_message_window_ms");
 
     // Initialize layer options
     VkDebugReportFlagsEXT report_flags = GetLayerOptionFlags(report_flags_key, report_flags_option_definitions, 0);
@@ -633,6 +639,17 @@ void layer_debug_actions(debug_report_data *report_data, std::vector<VkDebugRepo
     // Flag as default if these settings are not from a vk_layer_settings.txt file
     bool default_layer_callback = (debug_action & VK_DBG_LAYER_ACTION_DEFAULT) ? true : false;
 
+    // Messages are delivered on the calling thread unless async delivery is requested
+    const char *log_mode = getLayerOption(log_mode_key.c_str());
+    if (log_mode && !strcmp(log_mode, "async")) {
+        layer_debug_report_enable_async(report_data);
+    }
+
+    // Repeats of the same message code for the same object are budgeted if a limit is set
+    uint32_t duplicate_limit = (uint32_t)strtoul(getLayerOption(duplicate_limit_key.c_str()), nullptr, 10);
+    uint32_t duplicate_window_ms = (uint32_t)strtoul(getLayerOption(duplicate_window_key.c_str()), nullptr, 10);
+    layer_debug_report_enable_dedup(report_data, duplicate_limit, duplicate_window_ms);
+
     if (debug_action & VK_DBG_LAYER_ACTION_LOG_MSG) {
         const char *log_filename = getLayerOption(log_filename_key.c_str());
         FILE *log_output = getLayerLogOutput(log_filename, layer_identifier);
@@ -0,0 +1,597 @@
+/*
+ * Copyright (c) 2015-2016 The Khronos Group Inc.
+ * Copyright (c) 2015-2016 Valve Corporation
+ * Copyright (c) 2015-2016 LunarG, Inc.
+ * Copyright (c) 2015-2016 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+// Timing tests for the validation layers. Each test drives one hot path
+// through the full layer stack and prints the time per call; none of them
+// checks for a particular validation message, so they are built as their
+// own executable and are not part of run_all_tests.sh.
+
+#ifdef ANDROID
+#include "vulkan_wrapper.h"
+#else
+#include <vulkan/vulkan.h>
+#endif
+#include "test_common.h"
+#include "vkrenderframework.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+static const char perfVertShaderText[] =
+    "#version 450\n"
+    "vec2 vertices[3];\n"
+    "out gl_PerVertex {\n"
+    "    vec4 gl_Position;\n"
+    "};\n"
+    "void main() {\n"
+    "      vertices[0] = vec2(-1.0, -1.0);\n"
+    "      vertices[1] = vec2( 1.0, -1.0);\n"
+    "      vertices[2] = vec2( 0.0,  1.0);\n"
+    "   gl_Position = vec4(vertices[gl_VertexIndex % 3], 0.0, 1.0);\n"
+    "}\n";
+
+static const char perfFragShaderText[] =
+    "#version 450\n"
+    "\n"
+    "layout(location = 0) out vec4 uFragColor;\n"
+    "void main(){\n"
+    "   uFragColor = vec4(0,1,0,1);\n"
+    "}\n";
+
+static VKAPI_ATTR VkBool32 VKAPI_CALL
+countErrorsFunc(VkFlags msgFlags, VkDebugReportObjectTypeEXT objType,
+                uint64_t srcObject, size_t location, int32_t msgCode,
+                const char *pLayerPrefix, const char *pMsg, void *pUserData) {
+    if (msgFlags & (VK_DEBUG_REPORT_WARNING_BIT_EXT |
+                    VK_DEBUG_REPORT_PERFORMANCE_WARNING_BIT_EXT |
+                    VK_DEBUG_REPORT_ERROR_BIT_EXT)) {
+        ((std::atomic<uint32_t> *)pUserData)->fetch_add(1);
+        printf("%s\n", pMsg);
+    }
+    return false;
+}
+
+class VkLayerPerfTest : public VkRenderFramework {
+  public:
+    void BeginCommandBuffer() { m_commandBuffer->BeginCommandBuffer(); }
+    void EndCommandBuffer() { m_commandBuffer->EndCommandBuffer(); }
+
+    // The timed work should be valid usage; a message means the test
+    // measured the error path instead
+    void ExpectNoErrors() { EXPECT_EQ(0u, m_errorCount.load()); }
+
+  protected:
+    std::atomic<uint32_t> m_errorCount;
+
+    virtual void SetUp() {
+        std::vector<const char *> layer_names;
+        std::vector<const char *> instance_extension_names;
+        std::vector<const char *> device_extension_names;
+
+        instance_extension_names.push_back(VK_EXT_DEBUG_REPORT_EXTENSION_NAME);
+        layer_names.push_back("VK_LAYER_GOOGLE_threading");
+        layer_names.push_back("VK_LAYER_LUNARG_parameter_validation");
+        layer_names.push_back("VK_LAYER_LUNARG_object_tracker");
+        layer_names.push_back("VK_LAYER_LUNARG_core_validation");
+        layer_names.push_back("VK_LAYER_LUNARG_device_limits");
+        layer_names.push_back("VK_LAYER_LUNARG_image");
+        layer_names.push_back("VK_LAYER_LUNARG_swapchain");
+        layer_names.push_back("VK_LAYER_GOOGLE_unique_objects");
+
+        this->app_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        this->app_info.pNext = NULL;
+        this->app_info.pApplicationName = "layer_perf_tests";
+        this->app_info.applicationVersion = 1;
+        this->app_info.pEngineName = "unittest";
+        this->app_info.engineVersion = 1;
+        this->app_info.apiVersion = VK_API_VERSION_1_0;
+
+        m_errorCount = 0;
+        InitFramework(layer_names, layer_names, instance_extension_names,
+                      device_extension_names, countErrorsFunc, &m_errorCount);
+    }
+
+    virtual void TearDown() { ShutdownFramework(); }
+};
+
+TEST_F(VkLayerPerfTest, BindBufferMemorySuballocationOverhead) {
+    TEST_DESCRIPTION("Suballocate thousands of small buffers out of one memory "
+                     "object, as a suballocating allocator would, and report the "
+                     "time spent per vkBindBufferMemory and vkDestroyBuffer call.");
+    VkResult err;
+    bool pass;
+
+    const uint32_t buffer_count = 4096;
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkBufferCreateInfo buf_info = {};
+    buf_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buf_info.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    buf_info.size = 256;
+    buf_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    std::vector<VkBuffer> buffers(buffer_count);
+    for (auto &buffer : buffers) {
+        err = vkCreateBuffer(m_device->device(), &buf_info, NULL, &buffer);
+        ASSERT_VK_SUCCESS(err);
+    }
+
+    VkMemoryRequirements mem_reqs;
+    vkGetBufferMemoryRequirements(m_device->device(), buffers[0], &mem_reqs);
+    VkDeviceSize stride = mem_reqs.size;
+    if (mem_reqs.alignment > 1) {
+        stride = (stride + mem_reqs.alignment - 1) & ~(mem_reqs.alignment - 1);
+    }
+
+    VkMemoryAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = stride * buffer_count;
+    pass = m_device->phy().set_memory_type(mem_reqs.memoryTypeBits, &alloc_info, 0);
+    if (!pass) {
+        for (auto buffer : buffers) {
+            vkDestroyBuffer(m_device->device(), buffer, NULL);
+        }
+        return;
+    }
+
+    VkDeviceMemory mem;
+    err = vkAllocateMemory(m_device->device(), &alloc_info, NULL, &mem);
+    ASSERT_VK_SUCCESS(err);
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < buffer_count; i++) {
+        err = vkBindBufferMemory(m_device->device(), buffers[i], mem, i * stride);
+        ASSERT_VK_SUCCESS(err);
+    }
+    auto bind_elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (auto buffer : buffers) {
+        vkDestroyBuffer(m_device->device(), buffer, NULL);
+    }
+    auto destroy_elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%u buffers in one allocation: %.2f us/bind, %.2f us/destroy\n", buffer_count, bind_elapsed / buffer_count,
+           destroy_elapsed / buffer_count);
+
+    vkFreeMemory(m_device->device(), mem, NULL);
+    ExpectNoErrors();
+}
+
+TEST_F(VkLayerPerfTest, ImageLayoutTransitionLargeArrayOverhead) {
+    TEST_DESCRIPTION("Transition every subresource of an image with many array "
+                     "layers and a full mip chain back and forth, and report "
+                     "the time per whole image barrier.");
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkImageCreateInfo image_create_info = {};
+    image_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_create_info.imageType = VK_IMAGE_TYPE_2D;
+    image_create_info.format = VK_FORMAT_B8G8R8A8_UNORM;
+    image_create_info.extent.width = 256;
+    image_create_info.extent.height = 256;
+    image_create_info.extent.depth = 1;
+    image_create_info.mipLevels = 9;
+    image_create_info.arrayLayers = std::min<uint32_t>(2048, m_device->props.limits.maxImageArrayLayers);
+    image_create_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    image_create_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    image_create_info.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+    VkImage image;
+    VkResult err = vkCreateImage(m_device->device(), &image_create_info, NULL, &image);
+    ASSERT_VK_SUCCESS(err);
+
+    BeginCommandBuffer();
+    VkImageMemoryBarrier image_barrier = {};
+    image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barrier.image = image;
+    image_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    image_barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+    image_barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+
+    const uint32_t transition_count = 100;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < transition_count; i++) {
+        image_barrier.oldLayout = i ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+        image_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        vkCmdPipelineBarrier(m_commandBuffer->handle(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, NULL, 0, NULL, 1, &image_barrier);
+        image_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        image_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        vkCmdPipelineBarrier(m_commandBuffer->handle(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, NULL, 0, NULL, 1, &image_barrier);
+    }
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    EndCommandBuffer();
+
+    printf("%u layers x %u mips: %.1f us/whole image barrier\n", image_create_info.arrayLayers, image_create_info.mipLevels,
+           elapsed / (2 * transition_count));
+
+    vkDestroyImage(m_device->device(), image, NULL);
+    ExpectNoErrors();
+}
+
+TEST_F(VkLayerPerfTest, CommandPoolResetOverhead) {
+    TEST_DESCRIPTION("Repeatedly record, reset, free and reallocate a pool of "
+                     "command buffers and report the average time per "
+                     "vkResetCommandPool and per vkAllocateCommandBuffers call.");
+
+    const uint32_t command_buffer_count = 256;
+    const uint32_t iteration_count = 50;
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkCommandPool command_pool;
+    VkCommandPoolCreateInfo pool_create_info{};
+    pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_create_info.queueFamilyIndex = m_device->graphics_queue_node_index_;
+    vkCreateCommandPool(m_device->device(), &pool_create_info, nullptr, &command_pool);
+
+    std::vector<VkCommandBuffer> command_buffers(command_buffer_count);
+    VkCommandBufferAllocateInfo command_buffer_allocate_info{};
+    command_buffer_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    command_buffer_allocate_info.commandPool = command_pool;
+    command_buffer_allocate_info.commandBufferCount = command_buffer_count;
+    command_buffer_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+
+    double reset_elapsed = 0;
+    double allocate_elapsed = 0;
+    for (uint32_t i = 0; i < iteration_count; i++) {
+        auto start = std::chrono::steady_clock::now();
+        vkAllocateCommandBuffers(m_device->device(), &command_buffer_allocate_info, command_buffers.data());
+        allocate_elapsed += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        for (auto command_buffer : command_buffers) {
+            vkBeginCommandBuffer(command_buffer, &begin_info);
+            for (uint32_t j = 0; j < 16; j++) {
+                vkCmdSetStencilReference(command_buffer, VK_STENCIL_FRONT_AND_BACK, j);
+            }
+            vkEndCommandBuffer(command_buffer);
+        }
+
+        start = std::chrono::steady_clock::now();
+        vkResetCommandPool(m_device->device(), command_pool, 0);
+        reset_elapsed += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        vkFreeCommandBuffers(m_device->device(), command_pool, command_buffer_count, command_buffers.data());
+    }
+
+    printf("%u command buffers: %.1f us/vkResetCommandPool, %.1f us/vkAllocateCommandBuffers\n", command_buffer_count,
+           reset_elapsed / iteration_count, allocate_elapsed / iteration_count);
+
+    vkDestroyCommandPool(m_device->device(), command_pool, NULL);
+
+    ExpectNoErrors();
+}
+
+TEST_F(VkLayerPerfTest, QueueSubmitDeferredCheckOverhead) {
+    TEST_DESCRIPTION("Record many copies between the same pair of buffers "
+                     "into one command buffer, then resubmit it and report "
+                     "the average time per vkQueueSubmit.");
+
+    const uint32_t copy_count = 10000;
+    const uint32_t submit_count = 100;
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkMemoryPropertyFlags reqs = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    vk_testing::Buffer src_buffer;
+    src_buffer.init_as_src_and_dst(*m_device, (VkDeviceSize)256, reqs);
+    vk_testing::Buffer dst_buffer;
+    dst_buffer.init_as_dst(*m_device, (VkDeviceSize)256, reqs);
+
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    VkCommandBuffer command_buffer = m_commandBuffer->GetBufferHandle();
+    vkBeginCommandBuffer(command_buffer, &begin_info);
+    vkCmdFillBuffer(command_buffer, src_buffer.handle(), 0, 256, 0x11111111);
+    VkBufferCopy region = {0, 0, 256};
+    for (uint32_t i = 0; i < copy_count; i++) {
+        vkCmdCopyBuffer(command_buffer, src_buffer.handle(), dst_buffer.handle(), 1, &region);
+    }
+    vkEndCommandBuffer(command_buffer);
+
+    VkSubmitInfo submit_info{};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer;
+
+    double elapsed = 0;
+    for (uint32_t i = 0; i < submit_count; i++) {
+        auto start = std::chrono::steady_clock::now();
+        vkQueueSubmit(m_device->m_queue, 1, &submit_info, VK_NULL_HANDLE);
+        elapsed += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        vkQueueWaitIdle(m_device->m_queue);
+    }
+
+    printf("%u vkCmdCopyBuffer: %.1f us/vkQueueSubmit\n", copy_count, elapsed / submit_count);
+
+    ExpectNoErrors();
+}
+
+TEST_F(VkLayerPerfTest, UpdateDescriptorSetsBatchOverhead) {
+    TEST_DESCRIPTION("Write one descriptor at a time into many sets, interleaving the sets within a single "
+                     "vkUpdateDescriptorSets call, and report the time per call.");
+
+    const uint32_t set_count = 500;
+    const uint32_t descriptors_per_set = 20;
+    const uint32_t update_count = 10;
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkDescriptorPoolSize ds_type_count = {};
+    ds_type_count.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    ds_type_count.descriptorCount = set_count * descriptors_per_set;
+
+    VkDescriptorPoolCreateInfo ds_pool_ci = {};
+    ds_pool_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    ds_pool_ci.maxSets = set_count;
+    ds_pool_ci.poolSizeCount = 1;
+    ds_pool_ci.pPoolSizes = &ds_type_count;
+
+    VkDescriptorPool ds_pool;
+    VkResult err = vkCreateDescriptorPool(m_device->device(), &ds_pool_ci, NULL, &ds_pool);
+    ASSERT_VK_SUCCESS(err);
+
+    VkDescriptorSetLayoutBinding dsl_binding = {};
+    dsl_binding.binding = 0;
+    dsl_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    dsl_binding.descriptorCount = descriptors_per_set;
+    dsl_binding.stageFlags = VK_SHADER_STAGE_ALL;
+
+    VkDescriptorSetLayoutCreateInfo ds_layout_ci = {};
+    ds_layout_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    ds_layout_ci.bindingCount = 1;
+    ds_layout_ci.pBindings = &dsl_binding;
+    VkDescriptorSetLayout ds_layout;
+    err = vkCreateDescriptorSetLayout(m_device->device(), &ds_layout_ci, NULL, &ds_layout);
+    ASSERT_VK_SUCCESS(err);
+
+    std::vector<VkDescriptorSetLayout> layouts(set_count, ds_layout);
+    std::vector<VkDescriptorSet> sets(set_count);
+    VkDescriptorSetAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorSetCount = set_count;
+    alloc_info.descriptorPool = ds_pool;
+    alloc_info.pSetLayouts = layouts.data();
+    err = vkAllocateDescriptorSets(m_device->device(), &alloc_info, sets.data());
+    ASSERT_VK_SUCCESS(err);
+
+    VkMemoryPropertyFlags reqs = 0;
+    vk_testing::Buffer buffer;
+    buffer.init(*m_device, vk_testing::Buffer::create_info(256, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT), reqs);
+
+    VkDescriptorBufferInfo buffer_info = {};
+    buffer_info.buffer = buffer.handle();
+    buffer_info.offset = 0;
+    buffer_info.range = VK_WHOLE_SIZE;
+
+    // Array element major, so consecutive writes always target different sets
+    std::vector<VkWriteDescriptorSet> writes;
+    for (uint32_t element = 0; element < descriptors_per_set; element++) {
+        for (uint32_t set = 0; set < set_count; set++) {
+            VkWriteDescriptorSet write = {};
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = sets[set];
+            write.dstBinding = 0;
+            write.dstArrayElement = element;
+            write.descriptorCount = 1;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            write.pBufferInfo = &buffer_info;
+            writes.push_back(write);
+        }
+    }
+
+    double elapsed = 0;
+    for (uint32_t i = 0; i < update_count; i++) {
+        auto start = std::chrono::steady_clock::now();
+        vkUpdateDescriptorSets(m_device->device(), static_cast<uint32_t>(writes.size()), writes.data(), 0, NULL);
+        elapsed += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    printf("%u writes over %u sets: %.1f us/vkUpdateDescriptorSets\n", static_cast<uint32_t>(writes.size()), set_count,
+           elapsed / update_count);
+
+    ExpectNoErrors();
+
+    vkDestroyDescriptorSetLayout(m_device->device(), ds_layout, NULL);
+    vkDestroyDescriptorPool(m_device->device(), ds_pool, NULL);
+}
+
+TEST_F(VkLayerPerfTest, CommandBufferCallOverhead) {
+    TEST_DESCRIPTION("Record a large number of trivial commands and report the average time per call "
+                     "through the full layer stack.");
+
+    const uint32_t call_count = 1000000;
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    BeginCommandBuffer();
+    VkCommandBuffer command_buffer = m_commandBuffer->GetBufferHandle();
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < call_count; i++) {
+        vkCmdSetStencilReference(command_buffer, VK_STENCIL_FRONT_AND_BACK, i & 0xff);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    EndCommandBuffer();
+
+    printf("vkCmdSetStencilReference: %.1f ns/call\n", elapsed / call_count);
+
+    ExpectNoErrors();
+}
+
+#if GTEST_IS_THREADSAFE
+struct record_thread_data_struct {
+    VkCommandBuffer commandBuffer;
+    uint32_t iterations;
+};
+
+extern "C" void *RecordDynamicState(void *arg) {
+    struct record_thread_data_struct *data = (struct record_thread_data_struct *)arg;
+    VkViewport viewport = {0.0f, 0.0f, 64.0f, 64.0f, 0.0f, 1.0f};
+    VkRect2D scissor = {{0, 0}, {64, 64}};
+    const float blend_constants[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+    for (uint32_t i = 0; i < data->iterations; i++) {
+        vkCmdSetViewport(data->commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(data->commandBuffer, 0, 1, &scissor);
+        vkCmdSetBlendConstants(data->commandBuffer, blend_constants);
+        vkCmdSetStencilReference(data->commandBuffer, VK_STENCIL_FRONT_AND_BACK, i & 0xff);
+    }
+    return NULL;
+}
+
+TEST_F(VkLayerPerfTest, ThreadedCommandBufferRecordingScaling) {
+    TEST_DESCRIPTION("Record into separate command buffers from 1, 2, 4 and 8 threads and report "
+                     "the recording rate, which should scale with the thread count.");
+
+    const uint32_t max_threads = 8;
+    const uint32_t iterations = 20000;
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkCommandPool command_pools[max_threads];
+    VkCommandBuffer command_buffers[max_threads];
+    for (uint32_t i = 0; i < max_threads; i++) {
+        VkCommandPoolCreateInfo pool_create_info{};
+        pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        pool_create_info.queueFamilyIndex = m_device->graphics_queue_node_index_;
+        pool_create_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        vkCreateCommandPool(m_device->device(), &pool_create_info, nullptr, &command_pools[i]);
+
+        VkCommandBufferAllocateInfo command_buffer_allocate_info{};
+        command_buffer_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        command_buffer_allocate_info.commandPool = command_pools[i];
+        command_buffer_allocate_info.commandBufferCount = 1;
+        command_buffer_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        vkAllocateCommandBuffers(m_device->device(), &command_buffer_allocate_info, &command_buffers[i]);
+    }
+
+    for (uint32_t thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+        test_platform_thread threads[max_threads];
+        struct record_thread_data_struct data[max_threads];
+        VkCommandBufferBeginInfo begin_info{};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        for (uint32_t i = 0; i < thread_count; i++) {
+            vkBeginCommandBuffer(command_buffers[i], &begin_info);
+            data[i].commandBuffer = command_buffers[i];
+            data[i].iterations = iterations;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < thread_count; i++) {
+            test_platform_thread_create(&threads[i], RecordDynamicState, (void *)&data[i]);
+        }
+        for (uint32_t i = 0; i < thread_count; i++) {
+            test_platform_thread_join(threads[i], NULL);
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (uint32_t i = 0; i < thread_count; i++) {
+            vkEndCommandBuffer(command_buffers[i]);
+            vkResetCommandBuffer(command_buffers[i], 0);
+        }
+        printf("%u recording thread(s): %.0f commands/s\n", thread_count, (4.0 * iterations * thread_count) / elapsed);
+    }
+
+    for (uint32_t i = 0; i < max_threads; i++) {
+        vkFreeCommandBuffers(m_device->device(), command_pools[i], 1, &command_buffers[i]);
+        vkDestroyCommandPool(m_device->device(), command_pools[i], NULL);
+    }
+
+    ExpectNoErrors();
+}
+#endif // GTEST_IS_THREADSAFE
+
+TEST_F(VkLayerPerfTest, ShaderModuleCreationOverhead) {
+    TEST_DESCRIPTION("Compile a small corpus of shaders, including a large generated compute "
+                     "shader, and report the time spent per vkCreateShaderModule call. This "
+                     "covers SPIR-V validation plus the layer building its def index.");
+
+    const uint32_t iteration_count = 200;
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    // Straight-line code produces a fresh id per operation, so this gives a module with tens of thousands of ids
+    std::string large_cs = "#version 450\n"
+                           "layout(local_size_x=64) in;\n"
+                           "layout(set=0, binding=0) buffer block { float data[]; };\n"
+                           "void main(){\n"
+                           "   uint i = gl_GlobalInvocationID.x;\n"
+                           "   float acc = data[i];\n";
+    for (uint32_t i = 0; i < 4000; i++) {
+        large_cs += "   acc = acc * " + std::to_string(i + 1) + ".0 + data[(i + " + std::to_string(i) + "u) & 255u];\n";
+    }
+    large_cs += "   data[i] = acc;\n"
+                "}\n";
+
+    struct {
+        const char *name;
+        VkShaderStageFlagBits stage;
+        std::string source;
+    } corpus[] = {
+        {"vertex", VK_SHADER_STAGE_VERTEX_BIT, perfVertShaderText},
+        {"fragment", VK_SHADER_STAGE_FRAGMENT_BIT, perfFragShaderText},
+        {"large compute", VK_SHADER_STAGE_COMPUTE_BIT, large_cs},
+    };
+
+    for (auto const &shader : corpus) {
+        std::vector<unsigned int> spv;
+        ASSERT_TRUE(GLSLtoSPV(shader.stage, shader.source.c_str(), spv));
+
+        VkShaderModuleCreateInfo moduleCreateInfo = {};
+        moduleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleCreateInfo.codeSize = spv.size() * sizeof(unsigned int);
+        moduleCreateInfo.pCode = spv.data();
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iteration_count; i++) {
+            VkShaderModule module;
+            ASSERT_VK_SUCCESS(vkCreateShaderModule(m_device->device(), &moduleCreateInfo, NULL, &module));
+            vkDestroyShaderModule(m_device->device(), module, NULL);
+        }
+        auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        printf("%s shader (%u words, id bound %u): %.1f us/module\n", shader.name, (uint32_t)spv.size(), spv[3],
+               elapsed / iteration_count);
+    }
+
+    ExpectNoErrors();
+}
+
+int main(int argc, char **argv) {
+    int result;
+
+#ifdef ANDROID
+    int vulkanSupport = InitVulkan();
+    if (vulkanSupport == 0)
+        return 1;
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    VkTestFramework::InitArgs(&argc, argv);
+
+    ::testing::AddGlobalTestEnvironment(new TestEnvironment);
+
+    result = RUN_ALL_TESTS();
+
+    VkTestFramework::Finish();
+    return result;
+}
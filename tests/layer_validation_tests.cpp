@@ -29,6 +29,13 @@
 #include "vk_layer_config.h"
 #include "icd-spv.h"
 
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+
 #define GLM_FORCE_RADIANS
 #include "glm/glm.hpp"
 #include <glm/gtc/matrix_transform.hpp>
@@ -1256,6 +1263,126 @@ TEST_F(VkLayerTest, InvalidMemoryAliasing) {
     vkFreeMemory(m_device->device(), mem_img, NULL);
 }
 
+TEST_F(VkLayerTest, InvalidMemoryAliasingSuballocated) {
+    TEST_DESCRIPTION("Suballocate many small buffers and one buffer spanning "
+                     "all of them out of one memory object, then bind an image "
+                     "past the buffers and one over a buffer in the middle. "
+                     "Only the second image binding aliases.");
+    VkResult err;
+    bool pass;
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    const uint32_t buffer_count = 64;
+
+    VkBufferCreateInfo buf_info = {};
+    buf_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buf_info.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    buf_info.size = 256;
+    buf_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    std::vector<VkBuffer> buffers(buffer_count);
+    for (auto &buffer : buffers) {
+        err = vkCreateBuffer(m_device->device(), &buf_info, NULL, &buffer);
+        ASSERT_VK_SUCCESS(err);
+    }
+
+    VkImageCreateInfo image_create_info = {};
+    image_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_create_info.imageType = VK_IMAGE_TYPE_2D;
+    image_create_info.format = VK_FORMAT_R8G8B8A8_UNORM;
+    image_create_info.extent.width = 16;
+    image_create_info.extent.height = 16;
+    image_create_info.extent.depth = 1;
+    image_create_info.mipLevels = 1;
+    image_create_info.arrayLayers = 1;
+    image_create_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    image_create_info.tiling = VK_IMAGE_TILING_LINEAR;
+    image_create_info.initialLayout = VK_IMAGE_LAYOUT_PREINITIALIZED;
+    image_create_info.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    image_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkImage image, aliased_image;
+    err = vkCreateImage(m_device->device(), &image_create_info, NULL, &image);
+    ASSERT_VK_SUCCESS(err);
+    err = vkCreateImage(m_device->device(), &image_create_info, NULL,
+                        &aliased_image);
+    ASSERT_VK_SUCCESS(err);
+
+    VkMemoryRequirements buff_mem_reqs, img_mem_reqs;
+    vkGetBufferMemoryRequirements(m_device->device(), buffers[0],
+                                  &buff_mem_reqs);
+    vkGetImageMemoryRequirements(m_device->device(), image, &img_mem_reqs);
+
+    // Keep every binding on its own bufferImageGranularity page so that only
+    // real overlaps are reported
+    VkDeviceSize align = std::max<VkDeviceSize>(
+        m_device->props.limits.bufferImageGranularity,
+        std::max(buff_mem_reqs.alignment, img_mem_reqs.alignment));
+    align = std::max<VkDeviceSize>(align, 1);
+    VkDeviceSize stride =
+        (buff_mem_reqs.size + align - 1) / align * align;
+    VkDeviceSize buffers_size = stride * buffer_count;
+    VkDeviceSize image_size = (img_mem_reqs.size + align - 1) / align * align;
+
+    VkBuffer wide_buffer;
+    buf_info.size = buffers_size;
+    err = vkCreateBuffer(m_device->device(), &buf_info, NULL, &wide_buffer);
+    ASSERT_VK_SUCCESS(err);
+    VkMemoryRequirements wide_mem_reqs;
+    vkGetBufferMemoryRequirements(m_device->device(), wide_buffer,
+                                  &wide_mem_reqs);
+
+    VkMemoryAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize =
+        std::max(buffers_size, wide_mem_reqs.size) + image_size;
+    pass = m_device->phy().set_memory_type(buff_mem_reqs.memoryTypeBits &
+                                               img_mem_reqs.memoryTypeBits,
+                                           &alloc_info, 0);
+    if (!pass || wide_mem_reqs.size > buffers_size) {
+        for (auto buffer : buffers) {
+            vkDestroyBuffer(m_device->device(), buffer, NULL);
+        }
+        vkDestroyBuffer(m_device->device(), wide_buffer, NULL);
+        vkDestroyImage(m_device->device(), image, NULL);
+        vkDestroyImage(m_device->device(), aliased_image, NULL);
+        return;
+    }
+
+    VkDeviceMemory mem;
+    err = vkAllocateMemory(m_device->device(), &alloc_info, NULL, &mem);
+    ASSERT_VK_SUCCESS(err);
+
+    // Buffers may alias one another, and the image after them touches none
+    m_errorMonitor->ExpectSuccess();
+    err = vkBindBufferMemory(m_device->device(), wide_buffer, mem, 0);
+    ASSERT_VK_SUCCESS(err);
+    for (uint32_t i = 0; i < buffer_count; i++) {
+        err = vkBindBufferMemory(m_device->device(), buffers[i], mem,
+                                 i * stride);
+        ASSERT_VK_SUCCESS(err);
+    }
+    err = vkBindImageMemory(m_device->device(), image, mem, buffers_size);
+    ASSERT_VK_SUCCESS(err);
+    m_errorMonitor->VerifyNotFound();
+
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                         " is aliased with buffer 0x");
+    // VALIDATION FAILURE due to image mapping overlapping the middle buffers
+    // and the buffer spanning all of them
+    err = vkBindImageMemory(m_device->device(), aliased_image, mem,
+                            (buffer_count / 2) * stride);
+    m_errorMonitor->VerifyFound();
+
+    for (auto buffer : buffers) {
+        vkDestroyBuffer(m_device->device(), buffer, NULL);
+    }
+    vkDestroyBuffer(m_device->device(), wide_buffer, NULL);
+    vkDestroyImage(m_device->device(), image, NULL);
+    vkDestroyImage(m_device->device(), aliased_image, NULL);
+    vkFreeMemory(m_device->device(), mem, NULL);
+}
+
 TEST_F(VkLayerTest, InvalidMemoryMapping) {
     TEST_DESCRIPTION("Attempt to map memory in a number of incorrect ways");
     VkResult err;
@@ -1375,6 +1502,255 @@ TEST_F(VkLayerTest, InvalidMemoryMapping) {
     vkFreeMemory(m_device->device(), mem, NULL);
 }
 
+TEST_F(VkLayerTest, DuplicateMessageLimitKeepsSkip) {
+    TEST_DESCRIPTION("Map already-mapped memory more times than the "
+                     "duplicate message limit allows and verify that the "
+                     "suppressed repeats are still skipped because the "
+                     "callback asked for the first one to be.");
+    VkResult err;
+    bool pass;
+
+    // The duplicate message limit is read at instance creation, so start
+    // over with a fresh instance
+    setLayerOption("lunarg_core_validation.duplicate_message_limit", "1");
+    TearDown();
+    SetUp();
+    setLayerOption("lunarg_core_validation.duplicate_message_limit", "0");
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkBuffer buffer;
+    VkBufferCreateInfo buf_info = {};
+    buf_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buf_info.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    buf_info.size = 256;
+    buf_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    err = vkCreateBuffer(m_device->device(), &buf_info, NULL, &buffer);
+    ASSERT_VK_SUCCESS(err);
+
+    VkMemoryRequirements mem_reqs;
+    vkGetBufferMemoryRequirements(m_device->device(), buffer, &mem_reqs);
+    VkMemoryAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = mem_reqs.size;
+    pass = m_device->phy().set_memory_type(mem_reqs.memoryTypeBits, &alloc_info,
+                                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+    if (!pass) {
+        vkDestroyBuffer(m_device->device(), buffer, NULL);
+        return;
+    }
+    VkDeviceMemory mem;
+    err = vkAllocateMemory(m_device->device(), &alloc_info, NULL, &mem);
+    ASSERT_VK_SUCCESS(err);
+
+    uint8_t *pData;
+    err = vkMapMemory(m_device->device(), mem, 0, mem_reqs.size, 0,
+                      (void **)&pData);
+    ASSERT_VK_SUCCESS(err);
+
+    // The error monitor asks for the first report to be skipped
+    m_errorMonitor->SetDesiredFailureMsg(
+        VK_DEBUG_REPORT_ERROR_BIT_EXT,
+        "VkMapMemory: Attempting to map memory on an already-mapped object ");
+    err = vkMapMemory(m_device->device(), mem, 0, mem_reqs.size, 0,
+                      (void **)&pData);
+    m_errorMonitor->VerifyFound();
+    ASSERT_EQ(VK_ERROR_VALIDATION_FAILED_EXT, err);
+
+    // Repeats are over the limit and never reach the callback, but must
+    // still be skipped rather than passed down to the driver
+    m_errorMonitor->ExpectSuccess();
+    for (int i = 0; i < 4; i++) {
+        err = vkMapMemory(m_device->device(), mem, 0, mem_reqs.size, 0,
+                          (void **)&pData);
+        ASSERT_EQ(VK_ERROR_VALIDATION_FAILED_EXT, err);
+    }
+    m_errorMonitor->VerifyNotFound();
+
+    vkUnmapMemory(m_device->device(), mem);
+    vkFreeMemory(m_device->device(), mem, NULL);
+    vkDestroyBuffer(m_device->device(), buffer, NULL);
+}
+
+TEST_F(VkLayerTest, ProfileFileWrittenAtInstanceDestroy) {
+    TEST_DESCRIPTION("Profile core validation's entry points, destroy the "
+                     "instance and verify the profile file lists the calls "
+                     "made with their counts and sane percentiles.");
+    static const char *profile_filename = "layer_profile_test.csv";
+    static const uint32_t event_count = 5;
+    VkResult err;
+
+    // The profile file is chosen at instance creation and written when the
+    // instance is destroyed, so profile a fresh instance of our own
+    remove(profile_filename);
+    setLayerOption("lunarg_core_validation.profile_filename",
+                   profile_filename);
+    TearDown();
+    SetUp();
+    setLayerOption("lunarg_core_validation.profile_filename", "");
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkEventCreateInfo event_info = {};
+    event_info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    for (uint32_t i = 0; i < event_count; i++) {
+        VkEvent event;
+        err = vkCreateEvent(m_device->device(), &event_info, NULL, &event);
+        ASSERT_VK_SUCCESS(err);
+        vkDestroyEvent(m_device->device(), event, NULL);
+    }
+
+    // Destroying the profiled instance writes the final totals. Start over
+    // with an unprofiled one for the fixture to tear down.
+    TearDown();
+    SetUp();
+
+    std::ifstream profile(profile_filename);
+    ASSERT_TRUE(profile.good()) << "Profile file was not written";
+    std::string line;
+    std::getline(profile, line);
+    EXPECT_EQ("entry_point,calls,self_total_ns,self_p50_ns,self_p99_ns,"
+              "dispatch_total_ns",
+              line);
+    std::map<std::string, std::vector<uint64_t>> columns;
+    while (std::getline(profile, line)) {
+        std::stringstream fields(line);
+        std::string name, field;
+        std::getline(fields, name, ',');
+        while (std::getline(fields, field, ',')) {
+            columns[name].push_back(strtoull(field.c_str(), NULL, 10));
+        }
+        // calls, self_total_ns, self_p50_ns, self_p99_ns, dispatch_total_ns
+        ASSERT_EQ(5u, columns[name].size()) << line;
+        EXPECT_LE(columns[name][2], columns[name][3]) << line;
+    }
+    profile.close();
+    remove(profile_filename);
+
+    ASSERT_EQ(1u, columns.count("vkCreateEvent"));
+    ASSERT_EQ(1u, columns.count("vkDestroyEvent"));
+    EXPECT_EQ(event_count, columns["vkCreateEvent"][0]);
+    EXPECT_EQ(event_count, columns["vkDestroyEvent"][0]);
+}
+
+TEST_F(VkLayerTest, NoncoherentGuardPageShadowFlush) {
+    TEST_DESCRIPTION("Write through a guard page shadow of non-coherent "
+                     "memory and check that flushing copies the written "
+                     "pages to the driver's mapping.");
+    VkResult err;
+    bool pass;
+
+    // The shadow kind is latched at device creation, so replace the
+    // framework's device with one created while guard pages are enabled
+    std::vector<const char *> device_layer_names;
+    std::vector<const char *> device_extension_names;
+    device_layer_names.push_back("VK_LAYER_LUNARG_core_validation");
+    setLayerOption("lunarg_core_validation.noncoherent_memory_shadow",
+                   "guard_pages");
+    delete m_device;
+    m_device = new VkDeviceObj(0, gpu(), device_layer_names,
+                               device_extension_names);
+    m_device->get_device_queue();
+    setLayerOption("lunarg_core_validation.noncoherent_memory_shadow",
+                   "fill");
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    static const VkDeviceSize buffer_size = 0x3000;
+    VkBuffer buffer;
+    VkBufferCreateInfo buf_info = {};
+    buf_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buf_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    buf_info.size = buffer_size;
+    buf_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    err = vkCreateBuffer(m_device->device(), &buf_info, NULL, &buffer);
+    ASSERT_VK_SUCCESS(err);
+
+    VkMemoryRequirements mem_reqs;
+    vkGetBufferMemoryRequirements(m_device->device(), buffer, &mem_reqs);
+    VkMemoryAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = mem_reqs.size;
+    pass = m_device->phy().set_memory_type(
+        mem_reqs.memoryTypeBits, &alloc_info,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (!pass) {
+        printf("No non-coherent host visible memory type; skipped.\n");
+        vkDestroyBuffer(m_device->device(), buffer, NULL);
+        return;
+    }
+    VkDeviceMemory mem;
+    err = vkAllocateMemory(m_device->device(), &alloc_info, NULL, &mem);
+    ASSERT_VK_SUCCESS(err);
+    err = vkBindBufferMemory(m_device->device(), buffer, mem, 0);
+    ASSERT_VK_SUCCESS(err);
+
+    VkMemoryPropertyFlags readback_props =
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    vk_testing::Buffer readback;
+    readback.init_as_dst(*m_device, buffer_size, readback_props);
+
+    m_errorMonitor->ExpectSuccess();
+
+    uint8_t *pData;
+    err = vkMapMemory(m_device->device(), mem, 0, VK_WHOLE_SIZE, 0,
+                      (void **)&pData);
+    ASSERT_VK_SUCCESS(err);
+    for (VkDeviceSize i = 0; i < buffer_size; ++i) {
+        pData[i] = static_cast<uint8_t>(i);
+    }
+    VkMappedMemoryRange mmr = {};
+    mmr.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    mmr.memory = mem;
+    mmr.offset = 0;
+    mmr.size = VK_WHOLE_SIZE;
+    err = vkFlushMappedMemoryRanges(m_device->device(), 1, &mmr);
+    ASSERT_VK_SUCCESS(err);
+
+    // Pages are protected again after a flush, so a second write to one of
+    // them has to be caught and flushed as well
+    static const VkDeviceSize second_offset = 0x1800;
+    static const VkDeviceSize second_size = 0x100;
+    for (VkDeviceSize i = second_offset; i < second_offset + second_size;
+         ++i) {
+        pData[i] = 0xA5;
+    }
+    mmr.offset = second_offset;
+    mmr.size = second_size;
+    err = vkFlushMappedMemoryRanges(m_device->device(), 1, &mmr);
+    ASSERT_VK_SUCCESS(err);
+
+    // Reads through the shadow do not see the driver's mapping, so have the
+    // device copy what the flushes delivered into coherent memory
+    VkBufferCopy region = {};
+    region.size = buffer_size;
+    BeginCommandBuffer();
+    vkCmdCopyBuffer(m_commandBuffer->GetBufferHandle(), buffer,
+                    readback.handle(), 1, &region);
+    EndCommandBuffer();
+    QueueCommandBuffer();
+
+    const uint8_t *pReadback =
+        static_cast<const uint8_t *>(readback.memory().map());
+    uint32_t mismatches = 0;
+    for (VkDeviceSize i = 0; i < buffer_size; ++i) {
+        uint8_t expected =
+            (i >= second_offset && i < second_offset + second_size)
+                ? 0xA5
+                : static_cast<uint8_t>(i);
+        if (pReadback[i] != expected) {
+            ++mismatches;
+        }
+    }
+    EXPECT_EQ(0u, mismatches);
+    readback.memory().unmap();
+    vkUnmapMemory(m_device->device(), mem);
+
+    m_errorMonitor->VerifyNotFound();
+
+    vkDestroyBuffer(m_device->device(), buffer, NULL);
+    vkFreeMemory(m_device->device(), mem, NULL);
+}
+
 TEST_F(VkLayerTest, EnableWsiBeforeUse) {
     VkResult err;
     bool pass;
@@ -2720,6 +3096,49 @@ TEST_F(VkLayerTest, BindMemoryToDestroyedObject) {
     vkFreeMemory(m_device->device(), mem, NULL);
 }
 
+TEST_F(VkLayerTest, ObjectTableChurnLookups) {
+    TEST_DESCRIPTION("Create enough events to grow the object tracker's "
+                     "event table, destroy and recreate half of them, and "
+                     "verify every live event is still found and a destroyed "
+                     "one is reported.");
+
+    const uint32_t event_count = 1000;
+
+    m_errorMonitor->ExpectSuccess();
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkEventCreateInfo event_info = {};
+    event_info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    std::vector<VkEvent> events(event_count);
+    for (uint32_t i = 0; i < event_count; i++) {
+        ASSERT_VK_SUCCESS(
+            vkCreateEvent(m_device->device(), &event_info, NULL, &events[i]));
+    }
+    // Leave erased entries scattered through the table, then reuse nodes
+    for (uint32_t i = 0; i < event_count; i += 2) {
+        vkDestroyEvent(m_device->device(), events[i], NULL);
+    }
+    for (uint32_t i = 0; i < event_count; i += 2) {
+        ASSERT_VK_SUCCESS(
+            vkCreateEvent(m_device->device(), &event_info, NULL, &events[i]));
+    }
+    for (uint32_t i = 0; i < event_count; i++) {
+        vkGetEventStatus(m_device->device(), events[i]);
+    }
+
+    m_errorMonitor->VerifyNotFound();
+
+    for (uint32_t i = 0; i < event_count; i++) {
+        vkDestroyEvent(m_device->device(), events[i], NULL);
+    }
+
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                         "Invalid VkEvent Object ");
+    vkGetEventStatus(m_device->device(), events[event_count - 1]);
+    m_errorMonitor->VerifyFound();
+}
+
 #endif // OBJ_TRACKER_TESTS
 
 #if DRAW_STATE_TESTS
@@ -3922,51 +4341,172 @@ TEST_F(VkLayerTest, TwoSubmitInfosWithSemaphoreOneQueueSubmitsOneFence) {
     m_errorMonitor->VerifyNotFound();
 }
 
-TEST_F(VkLayerTest, DynamicDepthBiasNotBound) {
-    TEST_DESCRIPTION(
-        "Run a simple draw calls to validate failure when Depth Bias dynamic "
-        "state is required but not correctly bound.");
+TEST_F(VkLayerTest, SemaphoreInUseDestroyed) {
+    TEST_DESCRIPTION("Submit a command buffer that signals a semaphore, then "
+                     "destroy the semaphore before the submission completes.");
 
-    // Dynamic depth bias
-    m_errorMonitor->SetDesiredFailureMsg(
-        VK_DEBUG_REPORT_ERROR_BIT_EXT,
-        "Dynamic depth bias state not set for this command buffer");
-    VKTriangleTest(bindStateVertShaderText, bindStateFragShaderText,
-                   BsoFailDepthBias);
-    m_errorMonitor->VerifyFound();
-}
+    ASSERT_NO_FATAL_FAILURE(InitState());
 
-TEST_F(VkLayerTest, DynamicLineWidthNotBound) {
-    TEST_DESCRIPTION(
-        "Run a simple draw calls to validate failure when Line Width dynamic "
-        "state is required but not correctly bound.");
+    VkSemaphore semaphore;
+    VkSemaphoreCreateInfo semaphore_create_info{};
+    semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    vkCreateSemaphore(m_device->device(), &semaphore_create_info, nullptr,
+                      &semaphore);
 
-    // Dynamic line width
-    m_errorMonitor->SetDesiredFailureMsg(
-        VK_DEBUG_REPORT_ERROR_BIT_EXT,
-        "Dynamic line width state not set for this command buffer");
-    VKTriangleTest(bindStateVertShaderText, bindStateFragShaderText,
-                   BsoFailLineWidth);
-    m_errorMonitor->VerifyFound();
-}
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    VkCommandBuffer command_buffer = m_commandBuffer->GetBufferHandle();
+    vkBeginCommandBuffer(command_buffer, &begin_info);
+    vkCmdSetStencilReference(command_buffer, VK_STENCIL_FRONT_AND_BACK, 0);
+    vkEndCommandBuffer(command_buffer);
 
-TEST_F(VkLayerTest, DynamicViewportNotBound) {
-    TEST_DESCRIPTION(
-        "Run a simple draw calls to validate failure when Viewport dynamic "
-        "state is required but not correctly bound.");
+    VkSubmitInfo submit_info{};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer;
+    submit_info.signalSemaphoreCount = 1;
+    submit_info.pSignalSemaphores = &semaphore;
+    vkQueueSubmit(m_device->m_queue, 1, &submit_info, VK_NULL_HANDLE);
 
-    // Dynamic viewport state
-    m_errorMonitor->SetDesiredFailureMsg(
-        VK_DEBUG_REPORT_ERROR_BIT_EXT,
-        "Dynamic viewport state not set for this command buffer");
-    VKTriangleTest(bindStateVertShaderText, bindStateFragShaderText,
-                   BsoFailViewport);
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                         "which is in use.");
+    vkDestroySemaphore(m_device->device(), semaphore, nullptr);
     m_errorMonitor->VerifyFound();
+
+    vkQueueWaitIdle(m_device->m_queue);
 }
 
-TEST_F(VkLayerTest, DynamicScissorNotBound) {
-    TEST_DESCRIPTION(
-        "Run a simple draw calls to validate failure when Scissor dynamic "
+TEST_F(VkLayerTest, DescriptorSetFreedBeforeSubmit) {
+    TEST_DESCRIPTION("Bind a descriptor set into a command buffer, end the "
+                     "command buffer, free the set and then submit the "
+                     "command buffer.");
+    VkResult err;
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkDescriptorPoolSize ds_type_count = {};
+    ds_type_count.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    ds_type_count.descriptorCount = 1;
+
+    VkDescriptorPoolCreateInfo ds_pool_ci = {};
+    ds_pool_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    ds_pool_ci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    ds_pool_ci.maxSets = 1;
+    ds_pool_ci.poolSizeCount = 1;
+    ds_pool_ci.pPoolSizes = &ds_type_count;
+
+    VkDescriptorPool ds_pool;
+    err =
+        vkCreateDescriptorPool(m_device->device(), &ds_pool_ci, NULL, &ds_pool);
+    ASSERT_VK_SUCCESS(err);
+
+    VkDescriptorSetLayoutBinding dsl_binding = {};
+    dsl_binding.binding = 0;
+    dsl_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    dsl_binding.descriptorCount = 1;
+    dsl_binding.stageFlags = VK_SHADER_STAGE_ALL;
+
+    VkDescriptorSetLayoutCreateInfo ds_layout_ci = {};
+    ds_layout_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    ds_layout_ci.bindingCount = 1;
+    ds_layout_ci.pBindings = &dsl_binding;
+    VkDescriptorSetLayout ds_layout;
+    err = vkCreateDescriptorSetLayout(m_device->device(), &ds_layout_ci, NULL,
+                                      &ds_layout);
+    ASSERT_VK_SUCCESS(err);
+
+    VkDescriptorSet descriptor_set;
+    VkDescriptorSetAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.descriptorPool = ds_pool;
+    alloc_info.pSetLayouts = &ds_layout;
+    err = vkAllocateDescriptorSets(m_device->device(), &alloc_info,
+                                   &descriptor_set);
+    ASSERT_VK_SUCCESS(err);
+
+    VkPipelineLayoutCreateInfo pipeline_layout_ci = {};
+    pipeline_layout_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipeline_layout_ci.setLayoutCount = 1;
+    pipeline_layout_ci.pSetLayouts = &ds_layout;
+
+    VkPipelineLayout pipeline_layout;
+    err = vkCreatePipelineLayout(m_device->device(), &pipeline_layout_ci, NULL,
+                                 &pipeline_layout);
+    ASSERT_VK_SUCCESS(err);
+
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    VkCommandBuffer command_buffer = m_commandBuffer->GetBufferHandle();
+    vkBeginCommandBuffer(command_buffer, &begin_info);
+    vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            pipeline_layout, 0, 1, &descriptor_set, 0, NULL);
+    vkEndCommandBuffer(command_buffer);
+
+    // The set goes away after the command buffer recorded its submit list
+    vkFreeDescriptorSets(m_device->device(), ds_pool, 1, &descriptor_set);
+
+    m_errorMonitor->SetDesiredFailureMsg(
+        VK_DEBUG_REPORT_ERROR_BIT_EXT,
+        "Cannot submit cmd buffer using deleted descriptor set");
+    VkSubmitInfo submit_info{};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer;
+    vkQueueSubmit(m_device->m_queue, 1, &submit_info, VK_NULL_HANDLE);
+    m_errorMonitor->VerifyFound();
+
+    vkQueueWaitIdle(m_device->m_queue);
+    vkDestroyPipelineLayout(m_device->device(), pipeline_layout, NULL);
+    vkDestroyDescriptorSetLayout(m_device->device(), ds_layout, NULL);
+    vkDestroyDescriptorPool(m_device->device(), ds_pool, NULL);
+}
+
+TEST_F(VkLayerTest, DynamicDepthBiasNotBound) {
+    TEST_DESCRIPTION(
+        "Run a simple draw calls to validate failure when Depth Bias dynamic "
+        "state is required but not correctly bound.");
+
+    // Dynamic depth bias
+    m_errorMonitor->SetDesiredFailureMsg(
+        VK_DEBUG_REPORT_ERROR_BIT_EXT,
+        "Dynamic depth bias state not set for this command buffer");
+    VKTriangleTest(bindStateVertShaderText, bindStateFragShaderText,
+                   BsoFailDepthBias);
+    m_errorMonitor->VerifyFound();
+}
+
+TEST_F(VkLayerTest, DynamicLineWidthNotBound) {
+    TEST_DESCRIPTION(
+        "Run a simple draw calls to validate failure when Line Width dynamic "
+        "state is required but not correctly bound.");
+
+    // Dynamic line width
+    m_errorMonitor->SetDesiredFailureMsg(
+        VK_DEBUG_REPORT_ERROR_BIT_EXT,
+        "Dynamic line width state not set for this command buffer");
+    VKTriangleTest(bindStateVertShaderText, bindStateFragShaderText,
+                   BsoFailLineWidth);
+    m_errorMonitor->VerifyFound();
+}
+
+TEST_F(VkLayerTest, DynamicViewportNotBound) {
+    TEST_DESCRIPTION(
+        "Run a simple draw calls to validate failure when Viewport dynamic "
+        "state is required but not correctly bound.");
+
+    // Dynamic viewport state
+    m_errorMonitor->SetDesiredFailureMsg(
+        VK_DEBUG_REPORT_ERROR_BIT_EXT,
+        "Dynamic viewport state not set for this command buffer");
+    VKTriangleTest(bindStateVertShaderText, bindStateFragShaderText,
+                   BsoFailViewport);
+    m_errorMonitor->VerifyFound();
+}
+
+TEST_F(VkLayerTest, DynamicScissorNotBound) {
+    TEST_DESCRIPTION(
+        "Run a simple draw calls to validate failure when Scissor dynamic "
         "state is required but not correctly bound.");
 
     // Dynamic scissor state
@@ -4236,6 +4776,72 @@ TEST_F(VkLayerTest, InvalidDescriptorPool) {
     m_errorMonitor->VerifyFound();
 }
 
+TEST_F(VkLayerTest, FreeDescriptorSetAfterPoolReset) {
+    // Resetting a Descriptor Pool frees its Descriptor Sets, so freeing one
+    // of them afterwards is freeing an object that no longer exists.
+    // ObjectTracker should catch this.
+    VkResult err;
+
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                         "Has it already been destroyed?");
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkDescriptorPoolSize ds_type_count = {};
+    ds_type_count.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    ds_type_count.descriptorCount = 1;
+
+    VkDescriptorPoolCreateInfo ds_pool_ci = {};
+    ds_pool_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    ds_pool_ci.pNext = NULL;
+    ds_pool_ci.maxSets = 1;
+    ds_pool_ci.poolSizeCount = 1;
+    ds_pool_ci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    ds_pool_ci.pPoolSizes = &ds_type_count;
+
+    VkDescriptorPool ds_pool;
+    err =
+        vkCreateDescriptorPool(m_device->device(), &ds_pool_ci, NULL, &ds_pool);
+    ASSERT_VK_SUCCESS(err);
+
+    VkDescriptorSetLayoutBinding dsl_binding = {};
+    dsl_binding.binding = 0;
+    dsl_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    dsl_binding.descriptorCount = 1;
+    dsl_binding.stageFlags = VK_SHADER_STAGE_ALL;
+    dsl_binding.pImmutableSamplers = NULL;
+
+    VkDescriptorSetLayoutCreateInfo ds_layout_ci = {};
+    ds_layout_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    ds_layout_ci.pNext = NULL;
+    ds_layout_ci.bindingCount = 1;
+    ds_layout_ci.pBindings = &dsl_binding;
+
+    VkDescriptorSetLayout ds_layout;
+    err = vkCreateDescriptorSetLayout(m_device->device(), &ds_layout_ci, NULL,
+                                      &ds_layout);
+    ASSERT_VK_SUCCESS(err);
+
+    VkDescriptorSet descriptorSet;
+    VkDescriptorSetAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.descriptorPool = ds_pool;
+    alloc_info.pSetLayouts = &ds_layout;
+    err = vkAllocateDescriptorSets(m_device->device(), &alloc_info,
+                                   &descriptorSet);
+    ASSERT_VK_SUCCESS(err);
+
+    err = vkResetDescriptorPool(m_device->device(), ds_pool, 0);
+    ASSERT_VK_SUCCESS(err);
+
+    vkFreeDescriptorSets(m_device->device(), ds_pool, 1, &descriptorSet);
+    m_errorMonitor->VerifyFound();
+
+    vkDestroyDescriptorSetLayout(m_device->device(), ds_layout, NULL);
+    vkDestroyDescriptorPool(m_device->device(), ds_pool, NULL);
+}
+
 TEST_F(VkLayerTest, InvalidDescriptorSet) {
     // Attempt to bind an invalid Descriptor Set to a valid Command Buffer
     // ObjectTracker should catch this.
@@ -4426,6 +5032,109 @@ TEST_F(VkLayerTest, DescriptorSetNotUpdated) {
     vkDestroyDescriptorPool(m_device->device(), ds_pool, NULL);
 }
 
+TEST_F(VkLayerTest, DescriptorSetNotUpdatedRepeatedDraw) {
+    TEST_DESCRIPTION("Draw twice with the same never-updated descriptor set "
+                     "bound. The callback does not ask for the first draw to "
+                     "be skipped, and the second draw must still be reported "
+                     "rather than treated as already validated.");
+    VkResult err;
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+    ASSERT_NO_FATAL_FAILURE(InitViewport());
+    ASSERT_NO_FATAL_FAILURE(InitRenderTarget());
+    VkDescriptorPoolSize ds_type_count = {};
+    ds_type_count.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    ds_type_count.descriptorCount = 1;
+
+    VkDescriptorPoolCreateInfo ds_pool_ci = {};
+    ds_pool_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    ds_pool_ci.maxSets = 1;
+    ds_pool_ci.poolSizeCount = 1;
+    ds_pool_ci.pPoolSizes = &ds_type_count;
+
+    VkDescriptorPool ds_pool;
+    err =
+        vkCreateDescriptorPool(m_device->device(), &ds_pool_ci, NULL, &ds_pool);
+    ASSERT_VK_SUCCESS(err);
+
+    VkDescriptorSetLayoutBinding dsl_binding = {};
+    dsl_binding.binding = 0;
+    dsl_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    dsl_binding.descriptorCount = 1;
+    dsl_binding.stageFlags = VK_SHADER_STAGE_ALL;
+
+    VkDescriptorSetLayoutCreateInfo ds_layout_ci = {};
+    ds_layout_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    ds_layout_ci.bindingCount = 1;
+    ds_layout_ci.pBindings = &dsl_binding;
+    VkDescriptorSetLayout ds_layout;
+    err = vkCreateDescriptorSetLayout(m_device->device(), &ds_layout_ci, NULL,
+                                      &ds_layout);
+    ASSERT_VK_SUCCESS(err);
+
+    VkDescriptorSet descriptorSet;
+    VkDescriptorSetAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.descriptorPool = ds_pool;
+    alloc_info.pSetLayouts = &ds_layout;
+    err = vkAllocateDescriptorSets(m_device->device(), &alloc_info,
+                                   &descriptorSet);
+    ASSERT_VK_SUCCESS(err);
+
+    VkPipelineLayoutCreateInfo pipeline_layout_ci = {};
+    pipeline_layout_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipeline_layout_ci.setLayoutCount = 1;
+    pipeline_layout_ci.pSetLayouts = &ds_layout;
+
+    VkPipelineLayout pipeline_layout;
+    err = vkCreatePipelineLayout(m_device->device(), &pipeline_layout_ci, NULL,
+                                 &pipeline_layout);
+    ASSERT_VK_SUCCESS(err);
+
+    char const *fsSource =
+        "#version 450\n"
+        "\n"
+        "layout(location=0) out vec4 x;\n"
+        "layout(set=0) layout(binding=0) uniform foo { int x; int y; } bar;\n"
+        "void main(){\n"
+        "   x = vec4(bar.y);\n"
+        "}\n";
+    VkShaderObj vs(m_device, bindStateVertShaderText,
+                   VK_SHADER_STAGE_VERTEX_BIT, this);
+    VkShaderObj fs(m_device, fsSource, VK_SHADER_STAGE_FRAGMENT_BIT, this);
+
+    VkPipelineObj pipe(m_device);
+    pipe.AddShader(&vs);
+    pipe.AddShader(&fs);
+    pipe.AddColorAttachment();
+    pipe.CreateVKPipeline(pipeline_layout, renderPass());
+
+    BeginCommandBuffer();
+    vkCmdBindPipeline(m_commandBuffer->GetBufferHandle(),
+                      VK_PIPELINE_BIND_POINT_GRAPHICS, pipe.handle());
+    vkCmdBindDescriptorSets(m_commandBuffer->GetBufferHandle(),
+                            VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout, 0,
+                            1, &descriptorSet, 0, NULL);
+
+    // The monitor only returns true (skip) for the message it is looking for,
+    // so looking for something else lets the first draw through unskipped
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                         "message that is never reported");
+    Draw(1, 0, 0, 0);
+
+    m_errorMonitor->SetDesiredFailureMsg(
+        VK_DEBUG_REPORT_ERROR_BIT_EXT,
+        " It is now being used to draw so this will result in undefined "
+        "behavior.");
+    Draw(1, 0, 0, 0);
+    m_errorMonitor->VerifyFound();
+
+    vkDestroyPipelineLayout(m_device->device(), pipeline_layout, NULL);
+    vkDestroyDescriptorSetLayout(m_device->device(), ds_layout, NULL);
+    vkDestroyDescriptorPool(m_device->device(), ds_pool, NULL);
+}
+
 TEST_F(VkLayerTest, InvalidBufferViewObject) {
     // Create a single TEXEL_BUFFER descriptor and send it an invalid bufferView
     VkResult err;
@@ -5649,6 +6358,62 @@ TEST_F(VkLayerTest, InvalidPipelineCreateState) {
     vkDestroyDescriptorSetLayout(m_device->device(), ds_layout, NULL);
     vkDestroyDescriptorPool(m_device->device(), ds_pool, NULL);
 }
+TEST_F(VkLayerTest, InvalidPipelineCreateStateInBatch) {
+    // Create a batch of Gfx Pipelines w/o a VS in a single call so that the
+    // entries are validated across the pipeline worker pool
+    VkResult err;
+
+    m_errorMonitor->SetDesiredFailureMsg(
+        VK_DEBUG_REPORT_ERROR_BIT_EXT,
+        "Invalid Pipeline CreateInfo State: Vtx Shader required");
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+    ASSERT_NO_FATAL_FAILURE(InitRenderTarget());
+
+    VkPipelineLayoutCreateInfo pipeline_layout_ci = {};
+    pipeline_layout_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+
+    VkPipelineLayout pipeline_layout;
+    err = vkCreatePipelineLayout(m_device->device(), &pipeline_layout_ci, NULL,
+                                 &pipeline_layout);
+    ASSERT_VK_SUCCESS(err);
+
+    VkViewport vp = {}; // Just need dummy vp to point to
+    VkRect2D sc = {};   // dummy scissor to point to
+
+    VkPipelineViewportStateCreateInfo vp_state_ci = {};
+    vp_state_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    vp_state_ci.scissorCount = 1;
+    vp_state_ci.pScissors = &sc;
+    vp_state_ci.viewportCount = 1;
+    vp_state_ci.pViewports = &vp;
+
+    VkPipelineRasterizationStateCreateInfo rs_state_ci = {};
+    rs_state_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rs_state_ci.polygonMode = VK_POLYGON_MODE_FILL;
+    rs_state_ci.cullMode = VK_CULL_MODE_BACK_BIT;
+    rs_state_ci.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+    const uint32_t pipeline_count = 8;
+    std::vector<VkGraphicsPipelineCreateInfo> gp_cis(pipeline_count);
+    for (auto &gp_ci : gp_cis) {
+        gp_ci.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        gp_ci.pViewportState = &vp_state_ci;
+        gp_ci.pRasterizationState = &rs_state_ci;
+        gp_ci.flags = VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT;
+        gp_ci.layout = pipeline_layout;
+        gp_ci.renderPass = renderPass();
+    }
+
+    std::vector<VkPipeline> pipelines(pipeline_count, VK_NULL_HANDLE);
+    err = vkCreateGraphicsPipelines(m_device->device(), VK_NULL_HANDLE,
+                                    pipeline_count, gp_cis.data(), NULL,
+                                    pipelines.data());
+
+    m_errorMonitor->VerifyFound();
+
+    vkDestroyPipelineLayout(m_device->device(), pipeline_layout, NULL);
+}
 /*// TODO : This test should be good, but needs Tess support in compiler to run
 TEST_F(VkLayerTest, InvalidPatchControlPoints)
 {
@@ -7025,9 +7790,65 @@ TEST_F(VkLayerTest, InvalidBarriers) {
     // Leave aspectMask at COLOR on purpose
     vkCmdPipelineBarrier(m_commandBuffer->GetBufferHandle(),
                          VK_PIPELINE_STAGE_HOST_BIT,
-                         VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 0, nullptr, 0,
-                         nullptr, 1, &img_barrier);
+                         VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 0, nullptr, 0,
+                         nullptr, 1, &img_barrier);
+    m_errorMonitor->VerifyFound();
+}
+
+TEST_F(VkLayerTest, DisabledChecksSkipOnlyNamedCategory) {
+    TEST_DESCRIPTION("Disable the barriers check category, along with an "
+                     "unknown one that is reported, and verify that barrier "
+                     "errors are skipped while other errors are still "
+                     "reported.");
+
+    // The enabled categories are read at device creation, so replace the
+    // framework's device with one created while barriers are disabled
+    std::vector<const char *> device_layer_names;
+    std::vector<const char *> device_extension_names;
+    device_layer_names.push_back("VK_LAYER_LUNARG_core_validation");
+    setLayerOption("lunarg_core_validation.disabled_checks",
+                   "barriers, no_such_category");
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_WARNING_BIT_EXT,
+                                         "no_such_category");
+    delete m_device;
+    m_device = new VkDeviceObj(0, gpu(), device_layer_names,
+                               device_extension_names);
+    m_device->get_device_queue();
+    setLayerOption("lunarg_core_validation.disabled_checks", "none");
+    m_errorMonitor->VerifyFound();
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+    ASSERT_NO_FATAL_FAILURE(InitRenderTarget());
+
+    VkQueryPool query_pool;
+    VkQueryPoolCreateInfo query_pool_create_info{};
+    query_pool_create_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    query_pool_create_info.queryType = VK_QUERY_TYPE_OCCLUSION;
+    query_pool_create_info.queryCount = 1;
+    vkCreateQueryPool(m_device->device(), &query_pool_create_info, nullptr,
+                      &query_pool);
+
+    // BeginCommandBuffer() starts a render pass, where barriers are invalid
+    BeginCommandBuffer();
+    m_errorMonitor->ExpectSuccess();
+    VkMemoryBarrier mem_barrier = {};
+    mem_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    mem_barrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT;
+    mem_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(m_commandBuffer->GetBufferHandle(),
+                         VK_PIPELINE_STAGE_HOST_BIT,
+                         VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 1,
+                         &mem_barrier, 0, nullptr, 0, nullptr);
+    m_errorMonitor->VerifyNotFound();
+
+    // Resetting a query pool inside a render pass is not a barrier check
+    m_errorMonitor->SetDesiredFailureMsg(
+        VK_DEBUG_REPORT_ERROR_BIT_EXT,
+        "It is invalid to issue this call inside an active render pass");
+    vkCmdResetQueryPool(m_commandBuffer->GetBufferHandle(), query_pool, 0, 1);
     m_errorMonitor->VerifyFound();
+
+    vkDestroyQueryPool(m_device->device(), query_pool, nullptr);
 }
 
 TEST_F(VkLayerTest, IdxBufferAlignmentError) {
@@ -7992,6 +8813,127 @@ TEST_F(VkLayerTest, CopyDescriptorUpdateErrors) {
     vkDestroyDescriptorPool(m_device->device(), ds_pool, NULL);
 }
 
+// This is a positive test. No errors should be generated.
+TEST_F(VkLayerTest, CopyCombinedImageSamplerDescriptors) {
+    TEST_DESCRIPTION("Write combined image sampler descriptors into one set, "
+                     "copy them into a second set and back, and verify the "
+                     "copies validate as combined image samplers.");
+    VkResult err;
+
+    m_errorMonitor->ExpectSuccess();
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+    VkDescriptorPoolSize ds_type_count = {};
+    ds_type_count.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    ds_type_count.descriptorCount = 4;
+
+    VkDescriptorPoolCreateInfo ds_pool_ci = {};
+    ds_pool_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    ds_pool_ci.maxSets = 2;
+    ds_pool_ci.poolSizeCount = 1;
+    ds_pool_ci.pPoolSizes = &ds_type_count;
+
+    VkDescriptorPool ds_pool;
+    err =
+        vkCreateDescriptorPool(m_device->device(), &ds_pool_ci, NULL, &ds_pool);
+    ASSERT_VK_SUCCESS(err);
+
+    VkDescriptorSetLayoutBinding dsl_binding = {};
+    dsl_binding.binding = 0;
+    dsl_binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    dsl_binding.descriptorCount = 2;
+    dsl_binding.stageFlags = VK_SHADER_STAGE_ALL;
+
+    VkDescriptorSetLayoutCreateInfo ds_layout_ci = {};
+    ds_layout_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    ds_layout_ci.bindingCount = 1;
+    ds_layout_ci.pBindings = &dsl_binding;
+    VkDescriptorSetLayout ds_layout;
+    err = vkCreateDescriptorSetLayout(m_device->device(), &ds_layout_ci, NULL,
+                                      &ds_layout);
+    ASSERT_VK_SUCCESS(err);
+
+    VkDescriptorSetLayout layouts[2] = {ds_layout, ds_layout};
+    VkDescriptorSet descriptor_sets[2];
+    VkDescriptorSetAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorSetCount = 2;
+    alloc_info.descriptorPool = ds_pool;
+    alloc_info.pSetLayouts = layouts;
+    err = vkAllocateDescriptorSets(m_device->device(), &alloc_info,
+                                   descriptor_sets);
+    ASSERT_VK_SUCCESS(err);
+
+    VkSamplerCreateInfo sampler_ci = {};
+    sampler_ci.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    sampler_ci.magFilter = VK_FILTER_NEAREST;
+    sampler_ci.minFilter = VK_FILTER_NEAREST;
+    sampler_ci.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    sampler_ci.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_ci.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_ci.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_ci.maxAnisotropy = 1;
+    sampler_ci.compareOp = VK_COMPARE_OP_NEVER;
+    sampler_ci.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+
+    VkSampler sampler;
+    err = vkCreateSampler(m_device->device(), &sampler_ci, NULL, &sampler);
+    ASSERT_VK_SUCCESS(err);
+
+    VkImageObj image(m_device);
+    image.init(32, 32, VK_FORMAT_B8G8R8A8_UNORM, VK_IMAGE_USAGE_SAMPLED_BIT,
+               VK_IMAGE_TILING_OPTIMAL, 0);
+    ASSERT_TRUE(image.initialized());
+
+    VkImageViewCreateInfo view_ci = {};
+    view_ci.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view_ci.image = image.handle();
+    view_ci.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    view_ci.format = VK_FORMAT_B8G8R8A8_UNORM;
+    view_ci.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    view_ci.subresourceRange.levelCount = 1;
+    view_ci.subresourceRange.layerCount = 1;
+    VkImageView view;
+    err = vkCreateImageView(m_device->device(), &view_ci, NULL, &view);
+    ASSERT_VK_SUCCESS(err);
+
+    VkDescriptorImageInfo image_info[2] = {};
+    for (uint32_t i = 0; i < 2; i++) {
+        image_info[i].sampler = sampler;
+        image_info[i].imageView = view;
+        image_info[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+
+    VkWriteDescriptorSet descriptor_write = {};
+    descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptor_write.dstSet = descriptor_sets[0];
+    descriptor_write.dstBinding = 0;
+    descriptor_write.descriptorCount = 2;
+    descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptor_write.pImageInfo = image_info;
+    vkUpdateDescriptorSets(m_device->device(), 1, &descriptor_write, 0, NULL);
+
+    // The second copy reads the descriptors the first one wrote
+    VkCopyDescriptorSet copy_ds_update[2] = {};
+    for (uint32_t i = 0; i < 2; i++) {
+        copy_ds_update[i].sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
+        copy_ds_update[i].srcSet = descriptor_sets[i];
+        copy_ds_update[i].srcBinding = 0;
+        copy_ds_update[i].dstSet = descriptor_sets[1 - i];
+        copy_ds_update[i].dstBinding = 0;
+        copy_ds_update[i].descriptorCount = 2;
+        vkUpdateDescriptorSets(m_device->device(), 0, NULL, 1,
+                               &copy_ds_update[i]);
+    }
+
+    m_errorMonitor->VerifyNotFound();
+
+    vkDestroyImageView(m_device->device(), view, NULL);
+    vkDestroySampler(m_device->device(), sampler, NULL);
+    vkDestroyDescriptorSetLayout(m_device->device(), ds_layout, NULL);
+    vkDestroyDescriptorPool(m_device->device(), ds_pool, NULL);
+}
+
 TEST_F(VkLayerTest, NumSamplesMismatch) {
     // Create CommandBuffer where MSAA samples doesn't match RenderPass
     // sampleCount
@@ -8569,46 +9511,453 @@ TEST_F(VkLayerTest, InvalidImageLayout) {
     attach.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
     m_errorMonitor->SetDesiredFailureMsg(
         VK_DEBUG_REPORT_ERROR_BIT_EXT,
-        "Layout for color attachment is VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL but can only be COLOR_ATTACHMENT_OPTIMAL or GENERAL.");
-    vkCreateRenderPass(m_device->device(), &rpci, NULL, &rp);
+        "Layout for color attachment is VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL but can only be COLOR_ATTACHMENT_OPTIMAL or GENERAL.");
+    vkCreateRenderPass(m_device->device(), &rpci, NULL, &rp);
+    m_errorMonitor->VerifyFound();
+    subpass.colorAttachmentCount = 0;
+    subpass.pDepthStencilAttachment = &attach;
+    attach.layout = VK_IMAGE_LAYOUT_GENERAL;
+    // perf warning for GENERAL layout on DS attachment
+    m_errorMonitor->SetDesiredFailureMsg(
+        VK_DEBUG_REPORT_PERFORMANCE_WARNING_BIT_EXT,
+        "Layout for depth attachment is GENERAL but should be DEPTH_STENCIL_ATTACHMENT_OPTIMAL.");
+    vkCreateRenderPass(m_device->device(), &rpci, NULL, &rp);
+    m_errorMonitor->VerifyFound();
+    // error w/ non-ds opt or GENERAL layout for color attachment
+    attach.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    m_errorMonitor->SetDesiredFailureMsg(
+        VK_DEBUG_REPORT_ERROR_BIT_EXT,
+        "Layout for depth attachment is VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL but can only be DEPTH_STENCIL_ATTACHMENT_OPTIMAL or GENERAL.");
+    vkCreateRenderPass(m_device->device(), &rpci, NULL, &rp);
+    m_errorMonitor->VerifyFound();
+    // For this error we need a valid renderpass so create default one
+    attach.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+    attach.attachment = 0;
+    attach_desc.format = VK_FORMAT_D24_UNORM_S8_UINT;
+    attach_desc.samples = VK_SAMPLE_COUNT_1_BIT;
+    attach_desc.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    attach_desc.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attach_desc.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    // Can't do a CLEAR load on READ_ONLY initialLayout
+    attach_desc.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    attach_desc.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+    attach_desc.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                         " with invalid first layout "
+                                         "VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_"
+                                         "ONLY_OPTIMAL");
+    vkCreateRenderPass(m_device->device(), &rpci, NULL, &rp);
+    m_errorMonitor->VerifyFound();
+
+    vkDestroyImage(m_device->device(), src_image, NULL);
+    vkDestroyImage(m_device->device(), dst_image, NULL);
+}
+
+TEST_F(VkLayerTest, InvalidImageLayoutLargeArray) {
+    TEST_DESCRIPTION("Transition every subresource of an image with many array "
+                     "layers and a full mip chain, then transition one layer in "
+                     "the middle to another layout and verify that a whole "
+                     "image transition from the old layout is flagged.");
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkImageCreateInfo image_create_info = {};
+    image_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_create_info.imageType = VK_IMAGE_TYPE_2D;
+    image_create_info.format = VK_FORMAT_B8G8R8A8_UNORM;
+    image_create_info.extent.width = 256;
+    image_create_info.extent.height = 256;
+    image_create_info.extent.depth = 1;
+    image_create_info.mipLevels = 9;
+    image_create_info.arrayLayers = std::min<uint32_t>(2048, m_device->props.limits.maxImageArrayLayers);
+    image_create_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    image_create_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    image_create_info.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+    VkImage image;
+    VkResult err = vkCreateImage(m_device->device(), &image_create_info, NULL, &image);
+    ASSERT_VK_SUCCESS(err);
+
+    BeginCommandBuffer();
+    VkImageMemoryBarrier image_barrier = {};
+    image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barrier.image = image;
+    image_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    image_barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+    image_barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+
+    // Whole image transitions back and forth should be silent
+    m_errorMonitor->ExpectSuccess();
+    image_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    image_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    vkCmdPipelineBarrier(m_commandBuffer->handle(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         0, 0, NULL, 0, NULL, 1, &image_barrier);
+    image_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    image_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    vkCmdPipelineBarrier(m_commandBuffer->handle(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         0, 0, NULL, 0, NULL, 1, &image_barrier);
+    m_errorMonitor->VerifyNotFound();
+
+    // Only the middle of the array is in the wrong layout
+    image_barrier.subresourceRange.baseArrayLayer = image_create_info.arrayLayers / 2;
+    image_barrier.subresourceRange.layerCount = 1;
+    image_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    image_barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    vkCmdPipelineBarrier(m_commandBuffer->handle(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         0, 0, NULL, 0, NULL, 1, &image_barrier);
+    image_barrier.subresourceRange.baseArrayLayer = 0;
+    image_barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                         "You cannot transition the layout from VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL when "
+                                         "current layout is VK_IMAGE_LAYOUT_GENERAL.");
+    vkCmdPipelineBarrier(m_commandBuffer->handle(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         0, 0, NULL, 0, NULL, 1, &image_barrier);
+    m_errorMonitor->VerifyFound();
+    EndCommandBuffer();
+
+    vkDestroyImage(m_device->device(), image, NULL);
+}
+
+// This is a positive test. No errors should be generated.
+TEST_F(VkLayerTest, ResetCommandPoolReleaseResources) {
+    TEST_DESCRIPTION("Free command buffers back to their pool, reset the pool "
+                     "with VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT, then "
+                     "allocate and record from it again.");
+
+    const uint32_t command_buffer_count = 4;
+
+    m_errorMonitor->ExpectSuccess();
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkCommandPool command_pool;
+    VkCommandPoolCreateInfo pool_create_info{};
+    pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_create_info.queueFamilyIndex = m_device->graphics_queue_node_index_;
+    vkCreateCommandPool(m_device->device(), &pool_create_info, nullptr,
+                        &command_pool);
+
+    VkCommandBuffer command_buffers[command_buffer_count];
+    VkCommandBufferAllocateInfo command_buffer_allocate_info{};
+    command_buffer_allocate_info.sType =
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    command_buffer_allocate_info.commandPool = command_pool;
+    command_buffer_allocate_info.commandBufferCount = command_buffer_count;
+    command_buffer_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+
+    for (uint32_t i = 0; i < 2; i++) {
+        vkAllocateCommandBuffers(m_device->device(),
+                                 &command_buffer_allocate_info,
+                                 command_buffers);
+        for (auto command_buffer : command_buffers) {
+            vkBeginCommandBuffer(command_buffer, &begin_info);
+            vkCmdSetStencilReference(command_buffer,
+                                     VK_STENCIL_FRONT_AND_BACK, i);
+            vkEndCommandBuffer(command_buffer);
+        }
+        vkFreeCommandBuffers(m_device->device(), command_pool,
+                             command_buffer_count, command_buffers);
+        vkResetCommandPool(m_device->device(), command_pool,
+                           VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT);
+    }
+
+    vkDestroyCommandPool(m_device->device(), command_pool, NULL);
+
+    m_errorMonitor->VerifyNotFound();
+}
+
+TEST_F(VkLayerTest, WaitEventsStageMaskMismatchAtSubmit) {
+    TEST_DESCRIPTION("Set an event and wait on it in one command buffer with "
+                     "a srcStageMask that does not match the stage it was set "
+                     "in. The mismatch is only known, and reported, at "
+                     "vkQueueSubmit.");
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkEvent event;
+    VkEventCreateInfo event_create_info{};
+    event_create_info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    vkCreateEvent(m_device->device(), &event_create_info, nullptr, &event);
+
+    m_errorMonitor->ExpectSuccess();
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    VkCommandBuffer command_buffer = m_commandBuffer->GetBufferHandle();
+    vkBeginCommandBuffer(command_buffer, &begin_info);
+    vkCmdSetEvent(command_buffer, event, VK_PIPELINE_STAGE_TRANSFER_BIT);
+    vkCmdWaitEvents(command_buffer, 1, &event,
+                    VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                    VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, 0, nullptr,
+                    0, nullptr);
+    vkEndCommandBuffer(command_buffer);
+    m_errorMonitor->VerifyNotFound();
+
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                         "using srcStageMask 0x");
+    VkSubmitInfo submit_info{};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer;
+    vkQueueSubmit(m_device->m_queue, 1, &submit_info, VK_NULL_HANDLE);
+    m_errorMonitor->VerifyFound();
+
+    vkQueueWaitIdle(m_device->m_queue);
+    vkDestroyEvent(m_device->device(), event, nullptr);
+}
+
+TEST_F(VkLayerTest, CopyUnavailableQueryAtSubmit) {
+    TEST_DESCRIPTION("Reset a query pool and copy its results in one command "
+                     "buffer without ever ending a query. The copy of an "
+                     "unavailable query is reported at vkQueueSubmit.");
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkQueryPool query_pool;
+    VkQueryPoolCreateInfo query_pool_create_info{};
+    query_pool_create_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    query_pool_create_info.queryType = VK_QUERY_TYPE_OCCLUSION;
+    query_pool_create_info.queryCount = 4;
+    vkCreateQueryPool(m_device->device(), &query_pool_create_info, nullptr,
+                      &query_pool);
+
+    VkMemoryPropertyFlags reqs = 0;
+    vk_testing::Buffer buffer;
+    buffer.init_as_dst(*m_device, (VkDeviceSize)256, reqs);
+
+    m_errorMonitor->ExpectSuccess();
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    VkCommandBuffer command_buffer = m_commandBuffer->GetBufferHandle();
+    vkBeginCommandBuffer(command_buffer, &begin_info);
+    vkCmdResetQueryPool(command_buffer, query_pool, 0, 4);
+    vkCmdCopyQueryPoolResults(command_buffer, query_pool, 0, 4,
+                              buffer.handle(), 0, sizeof(uint32_t), 0);
+    vkEndCommandBuffer(command_buffer);
+    m_errorMonitor->VerifyNotFound();
+
+    m_errorMonitor->SetDesiredFailureMsg(
+        VK_DEBUG_REPORT_ERROR_BIT_EXT,
+        "Requesting a copy from query to buffer with invalid query");
+    VkSubmitInfo submit_info{};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer;
+    vkQueueSubmit(m_device->m_queue, 1, &submit_info, VK_NULL_HANDLE);
+    m_errorMonitor->VerifyFound();
+
+    vkQueueWaitIdle(m_device->m_queue);
+    vkDestroyQueryPool(m_device->device(), query_pool, nullptr);
+}
+
+TEST_F(VkLayerTest, SubmitOnlyModeDefersRecordChecks) {
+    TEST_DESCRIPTION("In submit_only validation mode, skip a check made "
+                     "while recording but still report an error found at "
+                     "vkQueueSubmit.");
+
+    // The mode is read at device creation, so replace the framework's device
+    // with one created in submit_only mode
+    std::vector<const char *> device_layer_names;
+    std::vector<const char *> device_extension_names;
+    device_layer_names.push_back("VK_LAYER_LUNARG_core_validation");
+    setLayerOption("lunarg_core_validation.validation_mode", "submit_only");
+    delete m_device;
+    m_device = new VkDeviceObj(0, gpu(), device_layer_names,
+                               device_extension_names);
+    m_device->get_device_queue();
+    setLayerOption("lunarg_core_validation.validation_mode", "full");
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+    ASSERT_NO_FATAL_FAILURE(InitRenderTarget());
+
+    VkQueryPool query_pool;
+    VkQueryPoolCreateInfo query_pool_create_info{};
+    query_pool_create_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    query_pool_create_info.queryType = VK_QUERY_TYPE_OCCLUSION;
+    query_pool_create_info.queryCount = 4;
+    vkCreateQueryPool(m_device->device(), &query_pool_create_info, nullptr,
+                      &query_pool);
+
+    VkMemoryPropertyFlags reqs = 0;
+    vk_testing::Buffer buffer;
+    buffer.init_as_dst(*m_device, (VkDeviceSize)256, reqs);
+
+    m_errorMonitor->ExpectSuccess();
+    // Clearing a whole attachment before any draw gets a performance warning
+    // while recording in full mode
+    BeginCommandBuffer();
+    VkClearAttachment color_attachment = {};
+    color_attachment.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    color_attachment.colorAttachment = 0;
+    VkClearRect clear_rect = {
+        {{0, 0}, {(uint32_t)m_width, (uint32_t)m_height}}, 0, 1};
+    vkCmdClearAttachments(m_commandBuffer->GetBufferHandle(), 1,
+                          &color_attachment, 1, &clear_rect);
+    m_commandBuffer->EndRenderPass();
+    // Copying queries that were reset but never ended is caught at submit
+    vkCmdResetQueryPool(m_commandBuffer->GetBufferHandle(), query_pool, 0, 4);
+    vkCmdCopyQueryPoolResults(m_commandBuffer->GetBufferHandle(), query_pool,
+                              0, 4, buffer.handle(), 0, sizeof(uint32_t), 0);
+    m_commandBuffer->EndCommandBuffer();
+    m_errorMonitor->VerifyNotFound();
+
+    m_errorMonitor->SetDesiredFailureMsg(
+        VK_DEBUG_REPORT_ERROR_BIT_EXT,
+        "Requesting a copy from query to buffer with invalid query");
+    VkCommandBuffer command_buffer = m_commandBuffer->GetBufferHandle();
+    VkSubmitInfo submit_info{};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer;
+    vkQueueSubmit(m_device->m_queue, 1, &submit_info, VK_NULL_HANDLE);
     m_errorMonitor->VerifyFound();
-    subpass.colorAttachmentCount = 0;
-    subpass.pDepthStencilAttachment = &attach;
-    attach.layout = VK_IMAGE_LAYOUT_GENERAL;
-    // perf warning for GENERAL layout on DS attachment
-    m_errorMonitor->SetDesiredFailureMsg(
-        VK_DEBUG_REPORT_PERFORMANCE_WARNING_BIT_EXT,
-        "Layout for depth attachment is GENERAL but should be DEPTH_STENCIL_ATTACHMENT_OPTIMAL.");
-    vkCreateRenderPass(m_device->device(), &rpci, NULL, &rp);
+
+    vkQueueWaitIdle(m_device->m_queue);
+    vkDestroyQueryPool(m_device->device(), query_pool, nullptr);
+}
+
+TEST_F(VkLayerTest, QueryIndexOutOfRange) {
+    TEST_DESCRIPTION("Begin a query and write a timestamp at indices past the "
+                     "end of their query pools.");
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkQueryPool occlusion_pool;
+    VkQueryPool timestamp_pool;
+    VkQueryPoolCreateInfo query_pool_create_info{};
+    query_pool_create_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    query_pool_create_info.queryType = VK_QUERY_TYPE_OCCLUSION;
+    query_pool_create_info.queryCount = 4;
+    vkCreateQueryPool(m_device->device(), &query_pool_create_info, nullptr,
+                      &occlusion_pool);
+    query_pool_create_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    vkCreateQueryPool(m_device->device(), &query_pool_create_info, nullptr,
+                      &timestamp_pool);
+
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    VkCommandBuffer command_buffer = m_commandBuffer->GetBufferHandle();
+    vkBeginCommandBuffer(command_buffer, &begin_info);
+
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                         "is outside queryPool");
+    vkCmdBeginQuery(command_buffer, occlusion_pool, 4, 0);
     m_errorMonitor->VerifyFound();
-    // error w/ non-ds opt or GENERAL layout for color attachment
-    attach.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-    m_errorMonitor->SetDesiredFailureMsg(
-        VK_DEBUG_REPORT_ERROR_BIT_EXT,
-        "Layout for depth attachment is VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL but can only be DEPTH_STENCIL_ATTACHMENT_OPTIMAL or GENERAL.");
-    vkCreateRenderPass(m_device->device(), &rpci, NULL, &rp);
+
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                         "is outside queryPool");
+    vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                        timestamp_pool, 0x7FFFFFFF);
     m_errorMonitor->VerifyFound();
-    // For this error we need a valid renderpass so create default one
-    attach.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-    attach.attachment = 0;
-    attach_desc.format = VK_FORMAT_D24_UNORM_S8_UINT;
-    attach_desc.samples = VK_SAMPLE_COUNT_1_BIT;
-    attach_desc.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    attach_desc.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    attach_desc.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    // Can't do a CLEAR load on READ_ONLY initialLayout
-    attach_desc.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    attach_desc.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-    attach_desc.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
     m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
-                                         " with invalid first layout "
-                                         "VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_"
-                                         "ONLY_OPTIMAL");
-    vkCreateRenderPass(m_device->device(), &rpci, NULL, &rp);
+                                         "is outside queryPool");
+    vkCmdResetQueryPool(command_buffer, timestamp_pool, 2, 4);
     m_errorMonitor->VerifyFound();
 
-    vkDestroyImage(m_device->device(), src_image, NULL);
-    vkDestroyImage(m_device->device(), dst_image, NULL);
+    // The rejected query was never started, so nothing is left in progress
+    m_errorMonitor->ExpectSuccess();
+    vkEndCommandBuffer(command_buffer);
+    m_errorMonitor->VerifyNotFound();
+
+    vkDestroyQueryPool(m_device->device(), occlusion_pool, nullptr);
+    vkDestroyQueryPool(m_device->device(), timestamp_pool, nullptr);
+}
+
+TEST_F(VkLayerTest, UpdateDescriptorSetsGroupedWriteIndex) {
+    TEST_DESCRIPTION("Interleave enough single descriptor writes across many "
+                     "sets that vkUpdateDescriptorSets validates them on the "
+                     "worker pool, make one write invalid and verify the "
+                     "error names that write's index.");
+
+    const uint32_t set_count = 150;
+    const uint32_t descriptors_per_set = 2;
+    // Second element of set 61, with the writes array element major
+    const uint32_t bad_write = set_count + 61;
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkDescriptorPoolSize ds_type_count = {};
+    ds_type_count.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    ds_type_count.descriptorCount = set_count * descriptors_per_set;
+
+    VkDescriptorPoolCreateInfo ds_pool_ci = {};
+    ds_pool_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    ds_pool_ci.maxSets = set_count;
+    ds_pool_ci.poolSizeCount = 1;
+    ds_pool_ci.pPoolSizes = &ds_type_count;
+
+    VkDescriptorPool ds_pool;
+    VkResult err =
+        vkCreateDescriptorPool(m_device->device(), &ds_pool_ci, NULL, &ds_pool);
+    ASSERT_VK_SUCCESS(err);
+
+    VkDescriptorSetLayoutBinding dsl_binding = {};
+    dsl_binding.binding = 0;
+    dsl_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    dsl_binding.descriptorCount = descriptors_per_set;
+    dsl_binding.stageFlags = VK_SHADER_STAGE_ALL;
+
+    VkDescriptorSetLayoutCreateInfo ds_layout_ci = {};
+    ds_layout_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    ds_layout_ci.bindingCount = 1;
+    ds_layout_ci.pBindings = &dsl_binding;
+    VkDescriptorSetLayout ds_layout;
+    err = vkCreateDescriptorSetLayout(m_device->device(), &ds_layout_ci, NULL,
+                                      &ds_layout);
+    ASSERT_VK_SUCCESS(err);
+
+    std::vector<VkDescriptorSetLayout> layouts(set_count, ds_layout);
+    std::vector<VkDescriptorSet> sets(set_count);
+    VkDescriptorSetAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorSetCount = set_count;
+    alloc_info.descriptorPool = ds_pool;
+    alloc_info.pSetLayouts = layouts.data();
+    err = vkAllocateDescriptorSets(m_device->device(), &alloc_info,
+                                   sets.data());
+    ASSERT_VK_SUCCESS(err);
+
+    VkMemoryPropertyFlags reqs = 0;
+    vk_testing::Buffer buffer;
+    buffer.init(*m_device, vk_testing::Buffer::create_info(
+                               256, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT),
+                reqs);
+
+    VkDescriptorBufferInfo buffer_info = {};
+    buffer_info.buffer = buffer.handle();
+    buffer_info.offset = 0;
+    buffer_info.range = VK_WHOLE_SIZE;
+
+    std::vector<VkWriteDescriptorSet> writes;
+    for (uint32_t element = 0; element < descriptors_per_set; element++) {
+        for (uint32_t set = 0; set < set_count; set++) {
+            VkWriteDescriptorSet write = {};
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = sets[set];
+            write.dstBinding = 0;
+            write.dstArrayElement = element;
+            write.descriptorCount = 1;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            write.pBufferInfo = &buffer_info;
+            writes.push_back(write);
+        }
+    }
+    writes[bad_write].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+
+    m_errorMonitor->SetDesiredFailureMsg(
+        VK_DEBUG_REPORT_ERROR_BIT_EXT,
+        "failed write update validation of pDescriptorWrites[211] ");
+    vkUpdateDescriptorSets(m_device->device(),
+                           static_cast<uint32_t>(writes.size()), writes.data(),
+                           0, NULL);
+    m_errorMonitor->VerifyFound();
+
+    vkDestroyDescriptorSetLayout(m_device->device(), ds_layout, NULL);
+    vkDestroyDescriptorPool(m_device->device(), ds_pool, NULL);
 }
 #endif // DRAW_STATE_TESTS
 
@@ -8681,6 +10030,227 @@ TEST_F(VkLayerTest, ThreadCommandBufferCollision) {
 
     vkDestroyEvent(device(), event, NULL);
 }
+
+// This is a positive test. No errors should be generated.
+TEST_F(VkLayerTest, ThreadSharedObjectReadNoCollision) {
+    TEST_DESCRIPTION("Record into two command buffers from separate pools on "
+                     "two threads, both reading the same event, and verify "
+                     "concurrent reads of one object are not reported.");
+    test_platform_thread thread;
+
+    m_errorMonitor->ExpectSuccess();
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkEventCreateInfo event_info = {};
+    event_info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    VkEvent event;
+    VkResult err = vkCreateEvent(device(), &event_info, NULL, &event);
+    ASSERT_VK_SUCCESS(err);
+
+    VkCommandPool command_pools[2];
+    VkCommandBuffer command_buffers[2];
+    struct thread_data_struct data[2];
+    for (uint32_t i = 0; i < 2; i++) {
+        VkCommandPoolCreateInfo pool_create_info{};
+        pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        pool_create_info.queueFamilyIndex =
+            m_device->graphics_queue_node_index_;
+        vkCreateCommandPool(m_device->device(), &pool_create_info, nullptr,
+                            &command_pools[i]);
+
+        VkCommandBufferAllocateInfo command_buffer_allocate_info{};
+        command_buffer_allocate_info.sType =
+            VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        command_buffer_allocate_info.commandPool = command_pools[i];
+        command_buffer_allocate_info.commandBufferCount = 1;
+        command_buffer_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        vkAllocateCommandBuffers(m_device->device(),
+                                 &command_buffer_allocate_info,
+                                 &command_buffers[i]);
+
+        VkCommandBufferBeginInfo begin_info{};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        vkBeginCommandBuffer(command_buffers[i], &begin_info);
+
+        data[i].commandBuffer = command_buffers[i];
+        data[i].event = event;
+        data[i].bailout = false;
+    }
+
+    test_platform_thread_create(&thread, AddToCommandBuffer, (void *)&data[0]);
+    AddToCommandBuffer(&data[1]);
+    test_platform_thread_join(thread, NULL);
+
+    for (uint32_t i = 0; i < 2; i++) {
+        vkEndCommandBuffer(command_buffers[i]);
+        vkFreeCommandBuffers(m_device->device(), command_pools[i], 1,
+                             &command_buffers[i]);
+        vkDestroyCommandPool(m_device->device(), command_pools[i], NULL);
+    }
+
+    m_errorMonitor->VerifyNotFound();
+
+    vkDestroyEvent(device(), event, NULL);
+}
+
+struct sampled_fence_thread_data_struct {
+    VkDevice device;
+    VkFence fences[2];
+    std::atomic<bool> waiting;
+};
+
+// Wait on the first fence. A thread's first call is always tracked, so the
+// fence is in use by this thread for the length of the wait.
+extern "C" void *WaitForFirstFence(void *arg) {
+    struct sampled_fence_thread_data_struct *data =
+        (struct sampled_fence_thread_data_struct *)arg;
+    data->waiting = true;
+    vkWaitForFences(data->device, 1, &data->fences[0], VK_TRUE,
+                    500000000ull);
+    return NULL;
+}
+
+// Reset the fence the other thread is waiting on from this thread's second
+// call, which is the untracked one when 1 in every 2 calls is tracked
+extern "C" void *ResetWaitedFenceSecond(void *arg) {
+    struct sampled_fence_thread_data_struct *data =
+        (struct sampled_fence_thread_data_struct *)arg;
+    while (!data->waiting) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    vkResetFences(data->device, 1, &data->fences[1]);
+    vkResetFences(data->device, 1, &data->fences[0]);
+    return NULL;
+}
+
+// This is a positive test. No errors should be generated.
+TEST_F(VkLayerTest, ThreadSampledCallNotTracked) {
+    TEST_DESCRIPTION("Track 1 in every 2 calls on each thread and reset a "
+                     "fence from an untracked call while another thread "
+                     "waits on it in a tracked one, and verify the "
+                     "untracked call is not reported.");
+    test_platform_thread threads[2];
+
+    // The sampling settings are read when an instance is created while no
+    // other instance exists, so start over with a fresh instance
+    setLayerOption("google_threading.sample_rate", "2");
+    TearDown();
+    SetUp();
+    setLayerOption("google_threading.sample_rate", "1");
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    struct sampled_fence_thread_data_struct data;
+    data.device = m_device->device();
+    data.waiting = false;
+    VkFenceCreateInfo fence_info = {};
+    fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    for (uint32_t i = 0; i < 2; i++) {
+        VkResult err =
+            vkCreateFence(m_device->device(), &fence_info, NULL,
+                          &data.fences[i]);
+        ASSERT_VK_SUCCESS(err);
+    }
+
+    m_errorMonitor->ExpectSuccess();
+    // Each thread's calls are counted from its first one, so use new threads
+    test_platform_thread_create(&threads[0], WaitForFirstFence,
+                                (void *)&data);
+    test_platform_thread_create(&threads[1], ResetWaitedFenceSecond,
+                                (void *)&data);
+    test_platform_thread_join(threads[0], NULL);
+    test_platform_thread_join(threads[1], NULL);
+    m_errorMonitor->VerifyNotFound();
+
+    for (uint32_t i = 0; i < 2; i++) {
+        vkDestroyFence(m_device->device(), data.fences[i], NULL);
+    }
+}
+
+struct pool_span_thread_data_struct {
+    VkCommandBuffer commandBuffer;
+    std::atomic<bool> began;
+    bool bailout;
+};
+
+// Record into a command buffer until the other thread has reported the
+// collision, or for at most five seconds
+extern "C" void *RecordUntilBailout(void *arg) {
+    struct pool_span_thread_data_struct *data =
+        (struct pool_span_thread_data_struct *)arg;
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    vkBeginCommandBuffer(data->commandBuffer, &begin_info);
+    data->began = true;
+    auto start = std::chrono::steady_clock::now();
+    while (!data->bailout &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+        std::this_thread::yield();
+    }
+    vkEndCommandBuffer(data->commandBuffer);
+    return NULL;
+}
+
+TEST_F(VkLayerTest, ThreadCommandPoolRecordingSpanCollision) {
+    TEST_DESCRIPTION("With command_pool_tracking = recording, begin a second "
+                     "command buffer from a pool while another thread is "
+                     "recording into the first, with no call of that thread "
+                     "in progress, and verify the overlap is reported.");
+    test_platform_thread thread;
+
+    // The pool tracking setting is read when an instance is created while no
+    // other instance exists, so start over with a fresh instance
+    setLayerOption("google_threading.command_pool_tracking", "recording");
+    TearDown();
+    SetUp();
+    setLayerOption("google_threading.command_pool_tracking", "call");
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    VkCommandPool command_pool;
+    VkCommandPoolCreateInfo pool_create_info{};
+    pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_create_info.queueFamilyIndex = m_device->graphics_queue_node_index_;
+    vkCreateCommandPool(m_device->device(), &pool_create_info, nullptr,
+                        &command_pool);
+
+    VkCommandBuffer command_buffers[2];
+    VkCommandBufferAllocateInfo command_buffer_allocate_info{};
+    command_buffer_allocate_info.sType =
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    command_buffer_allocate_info.commandPool = command_pool;
+    command_buffer_allocate_info.commandBufferCount = 2;
+    command_buffer_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    vkAllocateCommandBuffers(m_device->device(), &command_buffer_allocate_info,
+                             command_buffers);
+
+    struct pool_span_thread_data_struct data;
+    data.commandBuffer = command_buffers[0];
+    data.began = false;
+    data.bailout = false;
+    test_platform_thread_create(&thread, RecordUntilBailout, (void *)&data);
+    while (!data.began) {
+        std::this_thread::yield();
+    }
+
+    // The collision report lets the other thread end its recording, which
+    // releases the pool this call then waits for
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                         "THREADING ERROR");
+    m_errorMonitor->SetBailout(&data.bailout);
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    vkBeginCommandBuffer(command_buffers[1], &begin_info);
+    test_platform_thread_join(thread, NULL);
+    m_errorMonitor->SetBailout(NULL);
+    m_errorMonitor->VerifyFound();
+
+    vkEndCommandBuffer(command_buffers[1]);
+    vkFreeCommandBuffers(m_device->device(), command_pool, 2, command_buffers);
+    vkDestroyCommandPool(m_device->device(), command_pool, NULL);
+}
 #endif // GTEST_IS_THREADSAFE
 #endif // THREADING_TESTS
 
@@ -8735,6 +10305,29 @@ TEST_F(VkLayerTest, InvalidSPIRVMagic) {
     m_errorMonitor->VerifyFound();
 }
 
+TEST_F(VkLayerTest, InvalidSPIRVZeroLengthInstruction) {
+    TEST_DESCRIPTION("Create a shader module whose first instruction claims "
+                     "a word count of zero, and verify it is reported "
+                     "without the layer trying to walk its instructions.");
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                         "SPIR-V module not valid");
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    // Header: magic, version 1.0, generator, id bound, schema; then an
+    // instruction word with a word count of zero
+    const uint32_t code[] = {0x07230203, 0x00010000, 0, 10, 0, 0};
+
+    VkShaderModule module;
+    VkShaderModuleCreateInfo moduleCreateInfo = {};
+    moduleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    moduleCreateInfo.pCode = code;
+    moduleCreateInfo.codeSize = sizeof(code);
+    vkCreateShaderModule(m_device->device(), &moduleCreateInfo, NULL, &module);
+
+    m_errorMonitor->VerifyFound();
+}
+
 #if 0
 // Not currently covered by SPIRV-Tools validator
 TEST_F(VkLayerTest, InvalidSPIRVVersion) {
@@ -10103,6 +11696,56 @@ TEST_F(VkLayerTest, CreatePipelinePushConstantsNotInLayout) {
     m_errorMonitor->VerifyFound();
 }
 
+TEST_F(VkLayerTest, CreatePipelineShaderModuleReusedAcrossPipelines) {
+    TEST_DESCRIPTION("Create two pipelines from the same shader modules and verify "
+                     "that the shader reflection cached by the first pipeline still "
+                     "reports errors for the second.");
+
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    char const *vsSource =
+        "#version 450\n"
+        "\n"
+        "layout(location=0) out int x;\n"
+        "out gl_PerVertex {\n"
+        "    vec4 gl_Position;\n"
+        "};\n"
+        "void main(){\n"
+        "   x = 0;\n"
+        "   gl_Position = vec4(1);\n"
+        "}\n";
+    char const *fsSource =
+        "#version 450\n"
+        "\n"
+        "layout(location=0) in float x;\n" /* VS writes int */
+        "layout(location=0) out vec4 color;\n"
+        "void main(){\n"
+        "   color = vec4(x);\n"
+        "}\n";
+
+    VkShaderObj vs(m_device, vsSource, VK_SHADER_STAGE_VERTEX_BIT, this);
+    VkShaderObj fs(m_device, fsSource, VK_SHADER_STAGE_FRAGMENT_BIT, this);
+
+    ASSERT_NO_FATAL_FAILURE(InitRenderTarget());
+
+    VkDescriptorSetObj descriptorSet(m_device);
+    descriptorSet.AppendDummy();
+    descriptorSet.CreateVKDescriptorSet(m_commandBuffer);
+
+    for (uint32_t i = 0; i < 2; i++) {
+        m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                             "Type mismatch on location 0");
+
+        VkPipelineObj pipe(m_device);
+        pipe.AddColorAttachment();
+        pipe.AddShader(&vs);
+        pipe.AddShader(&fs);
+        pipe.CreateVKPipeline(descriptorSet.GetPipelineLayout(), renderPass());
+
+        m_errorMonitor->VerifyFound();
+    }
+}
+
 TEST_F(VkLayerTest, CreateComputePipelineMissingDescriptor) {
     m_errorMonitor->SetDesiredFailureMsg(
         VK_DEBUG_REPORT_ERROR_BIT_EXT,
@@ -775,7 +775,7 @@ class ObjectTrackerSubcommand(Subcommand):
     def generate_maps(self):
         maps_txt = []
         for o in vulkan.object_type_list:
-            maps_txt.append('std::unordered_map<uint64_t, OBJTRACK_NODE*> %sMap;' % (o))
+            maps_txt.append('object_node_map %sMap;' % (o))
         return "\n".join(maps_txt)
 
     def _gather_object_uses(self, obj_list, struct_type, obj_set):
@@ -821,12 +821,11 @@ class ObjectTrackerSubcommand(Subcommand):
             procs_txt.append('        "OBJ[%llu] : CREATE %s object 0x%" PRIxLEAST64 , object_track_index++, string_VkDebugReportObjectTypeEXT(objType),')
             procs_txt.append('        (uint64_t)(vkObj));')
             procs_txt.append('')
-            procs_txt.append('    OBJTRACK_NODE* pNewObjNode = new OBJTRACK_NODE;')
+            procs_txt.append('    OBJTRACK_NODE* pNewObjNode = %sMap.insert((uint64_t)vkObj);' % (o))
             procs_txt.append('    pNewObjNode->belongsTo = (uint64_t)dispatchable_object;')
             procs_txt.append('    pNewObjNode->objType = objType;')
             procs_txt.append('    pNewObjNode->status  = OBJSTATUS_NONE;')
             procs_txt.append('    pNewObjNode->vkObj  = (uint64_t)(vkObj);')
-            procs_txt.append('    %sMap[(uint64_t)vkObj] = pNewObjNode;' % (o))
             procs_txt.append('    uint32_t objIndex = objTypeToIndex(objType);')
             procs_txt.append('    numObjs[objIndex]++;')
             procs_txt.append('    numTotalObjs++;')
@@ -851,7 +850,6 @@ class ObjectTrackerSubcommand(Subcommand):
             procs_txt.append('           "OBJ_STAT Destroy %s obj 0x%" PRIxLEAST64 " (%" PRIu64 " total objs remain & %" PRIu64 " %s objs).",')
             procs_txt.append('            string_VkDebugReportObjectTypeEXT(pNode->objType), (uint64_t)(object), numTotalObjs, numObjs[objIndex],')
             procs_txt.append('            string_VkDebugReportObjectTypeEXT(pNode->objType));')
-            procs_txt.append('        delete pNode;')
             procs_txt.append('        %sMap.erase(it);' % (o))
             procs_txt.append('    } else {')
             procs_txt.append('        log_msg(mdd(dispatchable_object), VK_DEBUG_REPORT_ERROR_BIT_EXT, (VkDebugReportObjectTypeEXT ) 0,')
@@ -875,7 +873,7 @@ class ObjectTrackerSubcommand(Subcommand):
             procs_txt.append('{')
             procs_txt.append('    if (null_allowed && (object == VK_NULL_HANDLE))')
             procs_txt.append('        return false;')
-            procs_txt.append('    if (%sMap.find((uint64_t)object) == %sMap.end()) {' % (do, do))
+            procs_txt.append('    if (!%sMap.contains((uint64_t)object)) {' % (do))
             procs_txt.append('        return log_msg(mdd(dispatchable_object), VK_DEBUG_REPORT_ERROR_BIT_EXT, objType, (uint64_t)(object), __LINE__, OBJTRACK_INVALID_OBJECT, "OBJTRACK",')
             procs_txt.append('            "Invalid %s Object 0x%%" PRIx64 ,(uint64_t)(object));' % do)
             procs_txt.append('    }')
@@ -894,10 +892,9 @@ class ObjectTrackerSubcommand(Subcommand):
                 procs_txt.append('        return false;')
                 if o == "VkImage":
                     procs_txt.append('    // We need to validate normal image objects and those from the swapchain')
-                    procs_txt.append('    if ((%sMap.find((uint64_t)object) == %sMap.end()) &&' % (o, o))
-                    procs_txt.append('        (swapchainImageMap.find((uint64_t)object) == swapchainImageMap.end())) {')
+                    procs_txt.append('    if (!%sMap.contains((uint64_t)object) && !swapchainImageMap.contains((uint64_t)object)) {' % (o))
                 else:
-                    procs_txt.append('    if (%sMap.find((uint64_t)object) == %sMap.end()) {' % (o, o))
+                    procs_txt.append('    if (!%sMap.contains((uint64_t)object)) {' % (o))
                 procs_txt.append('        return log_msg(mdd(dispatchable_object), VK_DEBUG_REPORT_ERROR_BIT_EXT, objType, (uint64_t)(object), __LINE__, OBJTRACK_INVALID_OBJECT, "OBJTRACK",')
                 procs_txt.append('            "Invalid %s Object 0x%%" PRIx64, (uint64_t)(object));' % o)
                 procs_txt.append('    }')
@@ -914,6 +911,7 @@ class ObjectTrackerSubcommand(Subcommand):
         gedi_txt.append('VkInstance instance,')
         gedi_txt.append('const VkAllocationCallbacks* pAllocator)')
         gedi_txt.append('{')
+        gedi_txt.append('    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyInstance");')
         gedi_txt.append('    std::unique_lock<std::mutex> lock(global_lock);')
         gedi_txt.append('')
         gedi_txt.append('    dispatch_key key = get_dispatch_key(instance);')
@@ -962,7 +960,7 @@ class ObjectTrackerSubcommand(Subcommand):
         gedi_txt.append('    }')
         gedi_txt.append('')
         gedi_txt.append('    VkLayerInstanceDispatchTable *pInstanceTable = get_dispatch_table(object_tracker_instance_table_map, instance);')
-        gedi_txt.append('    pInstanceTable->DestroyInstance(instance, pAllocator);')
+        gedi_txt.append('    LAYER_PROFILE_DISPATCH(profiler, pInstanceTable->DestroyInstance(instance, pAllocator));')
         gedi_txt.append('')
         gedi_txt.append('    // Disable and cleanup the temporary callback(s):')
         gedi_txt.append('    if (callback_setup) {')
@@ -984,6 +982,7 @@ class ObjectTrackerSubcommand(Subcommand):
         gedi_txt.append('    }')
         gedi_txt.append('')
         gedi_txt.append('    layer_debug_report_destroy_instance(mid(instance));')
+        gedi_txt.append('    layer_profile_stop(&profiler);')
         gedi_txt.append('    layer_data_map.erase(key);')
         gedi_txt.append('')
         gedi_txt.append('    instanceExtMap.erase(pInstanceTable);')
@@ -1001,6 +1000,7 @@ class ObjectTrackerSubcommand(Subcommand):
         gedd_txt.append('VkDevice device,')
         gedd_txt.append('const VkAllocationCallbacks* pAllocator)')
         gedd_txt.append('{')
+        gedd_txt.append('    LAYER_PROFILE_ENTRY_POINT(profiler, "vkDestroyDevice");')
         gedd_txt.append('    std::unique_lock<std::mutex> lock(global_lock);')
         gedd_txt.append('    validate_device(device, device, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, false);')
         gedd_txt.append('')
@@ -1029,7 +1029,7 @@ class ObjectTrackerSubcommand(Subcommand):
         gedd_txt.append('')
         gedd_txt.append('    dispatch_key key = get_dispatch_key(device);')
         gedd_txt.append('    VkLayerDispatchTable *pDisp = get_dispatch_table(object_tracker_device_table_map, device);')
-        gedd_txt.append('    pDisp->DestroyDevice(device, pAllocator);')
+        gedd_txt.append('    LAYER_PROFILE_DISPATCH(profiler, pDisp->DestroyDevice(device, pAllocator));')
         gedd_txt.append('    object_tracker_device_table_map.erase(key);')
         gedd_txt.append('')
         gedd_txt.append('}')
@@ -1055,8 +1055,8 @@ class ObjectTrackerSubcommand(Subcommand):
             s_code += '%sif ((%sdescriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER) ||\n'      % (indent, prefix)
             s_code += '%s    (%sdescriptorType == VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER)   ) {\n'   % (indent, prefix)
         elif name == 'pBeginInfo->pInheritanceInfo':
-            s_code += '%sOBJTRACK_NODE* pNode = VkCommandBufferMap[(uint64_t)commandBuffer];\n'       % (indent)
-            s_code += '%sif ((%s) && (pNode->status & OBJSTATUS_COMMAND_BUFFER_SECONDARY)) {\n'       % (indent, name)
+            s_code += '%sOBJTRACK_NODE* pNode = VkCommandBufferMap.get((uint64_t)commandBuffer);\n'   % (indent)
+            s_code += '%sif ((%s) && pNode && (pNode->status & OBJSTATUS_COMMAND_BUFFER_SECONDARY)) {\n' % (indent, name)
         else:
             s_code += '%sif (%s) {\n' % (indent, name)
         return s_code
@@ -1159,6 +1159,7 @@ class ObjectTrackerSubcommand(Subcommand):
             "AllocateCommandBuffers",
             "FreeCommandBuffers",
             "DestroyDescriptorPool",
+            "ResetDescriptorPool",
             "DestroyCommandPool",
             "MapMemory",
             "UnmapMemory",
@@ -1243,13 +1244,13 @@ class ObjectTrackerSubcommand(Subcommand):
             last_param_index = -1 # For create funcs don't validate last object
         (struct_uses, local_decls) = get_object_uses(vulkan.object_type_list, proto.params[:last_param_index])
         funcs = []
-        mutex_unlock = False
         funcs.append('%s\n' % self.lineinfo.get())
         if proto.name in explicit_object_tracker_functions:
             funcs.append('%s%s\n'
                      '{\n'
+                     '    LAYER_PROFILE_ENTRY_POINT(profiler, "vk%s");\n'
                      '    return explicit_%s;\n'
-                     '}' % (qual, decl, proto.c_call()))
+                     '}' % (qual, decl, proto.name, proto.c_call()))
             return "".join(funcs)
         # Temporarily prevent  DestroySurface call from being generated until WSI layer support is fleshed out
         elif 'DestroyInstance' in proto.name or 'DestroyDevice' in proto.name:
@@ -1285,18 +1286,11 @@ class ObjectTrackerSubcommand(Subcommand):
                 destroy_line += '        destroy_%s(%s, %s);\n' % (name, param0_name, proto.params[-2].name)
                 destroy_line += '    }\n'
             indent = '    '
+            # Object lookups take the lock of the object type's map, so validation does not need global_lock
             if len(struct_uses) > 0:
                 using_line += '%sbool skipCall = false;\n' % (indent)
-                if not mutex_unlock:
-                    using_line += '%s{\n' % (indent)
-                    indent += '    '
-                    using_line += '%sstd::lock_guard<std::mutex> lock(global_lock);\n' % (indent)
-                    mutex_unlock = True
                 using_line += '// objects to validate: %s\n' % str(sorted(struct_uses))
                 using_line += self._gen_obj_validate_code(struct_uses, obj_type_mapping, proto.name, valid_null_object_names, param0_name, indent, '', 0)
-            if mutex_unlock:
-                indent = indent[4:]
-                using_line += '%s}\n' % (indent)
             if len(struct_uses) > 0:
                 using_line += '    if (skipCall)\n'
                 if proto.ret == "bool":
@@ -1327,12 +1321,14 @@ class ObjectTrackerSubcommand(Subcommand):
                 funcs.append('%s' % wsi_ifdef(proto.name))
             funcs.append('%s%s\n'
                      '{\n'
+                     '    LAYER_PROFILE_ENTRY_POINT(profiler, "vk%s");\n'
                      '%s'
                      '%s'
-                     '    %sget_dispatch_table(object_tracker_%s_table_map, %s)->%s;\n'
+                     '    %sLAYER_PROFILE_DISPATCH(profiler, get_dispatch_table(object_tracker_%s_table_map, %s)->%s);\n'
                      '%s'
                      '%s'
-                     '}' % (qual, decl, using_line, destroy_line, ret_val, table_type, dispatch_param, proto.c_call(), create_line, stmt))
+                     '}' % (qual, decl, proto.name, using_line, destroy_line, ret_val, table_type, dispatch_param, proto.c_call(),
+                            create_line, stmt))
             if wsi_name(proto.name):
                 funcs.append('%s' % wsi_endif(proto.name))
         return "\n\n".join(funcs)